@@ -0,0 +1,433 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+
+#include "boost/filesystem.hpp"
+#include "boost/format.hpp"
+#include "boost/lexical_cast.hpp"
+#include "boost/algorithm/string/split.hpp"
+#include "boost/algorithm/string/classification.hpp"
+
+#include "tbb/task_scheduler_init.h"
+#include "tbb/tick_count.h"
+
+#include "IECore/Exception.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace IECoreBenchmark;
+
+//////////////////////////////////////////////////////////////////////////
+// Options
+//////////////////////////////////////////////////////////////////////////
+
+Options::Options()
+	:	minIterations( 3 ), minTime( 0.5 ), scale( 1.0f ),
+		dataDirectory( ( boost::filesystem::temp_directory_path() / "IECoreBenchmark" ).string() )
+{
+	const int maxThreads = tbb::task_scheduler_init::default_num_threads();
+	for( int t = 1; t < maxThreads; t *= 2 )
+	{
+		threadCounts.push_back( t );
+	}
+	threadCounts.push_back( maxThreads );
+}
+
+size_t Options::scaled( size_t size ) const
+{
+	return std::max( (size_t)1, (size_t)( (double)size * scale ) );
+}
+
+std::string Options::dataFileName( const std::string &fileName ) const
+{
+	return ( boost::filesystem::path( dataDirectory ) / fileName ).string();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Benchmark
+//////////////////////////////////////////////////////////////////////////
+
+Benchmark::Benchmark( const std::string &name, const std::string &units )
+	:	m_name( name ), m_units( units )
+{
+}
+
+Benchmark::~Benchmark()
+{
+}
+
+const std::string &Benchmark::name() const
+{
+	return m_name;
+}
+
+const std::string &Benchmark::units() const
+{
+	return m_units;
+}
+
+void Benchmark::setUp()
+{
+}
+
+void Benchmark::tearDown()
+{
+}
+
+size_t Benchmark::itemsPerRun() const
+{
+	return 0;
+}
+
+bool Benchmark::threaded() const
+{
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Result
+//////////////////////////////////////////////////////////////////////////
+
+Result::Result()
+	:	threads( 0 ), iterations( 0 ), minTime( 0 ), meanTime( 0 ), maxTime( 0 ), throughput( 0 )
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Running
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Don't want to spend forever on very fast benchmarks - they
+// should be made to do more work per run instead.
+const size_t g_maxIterations = 1000;
+
+Result timeBenchmark( Benchmark *benchmark, int threads, const Options &options )
+{
+	tbb::task_scheduler_init scheduler( threads );
+
+	// warm up caches and the thread pool, so that
+	// the first timed run is not penalised.
+	benchmark->run();
+
+	Result result;
+	result.name = benchmark->name();
+	result.units = benchmark->units();
+	result.threads = threads;
+	result.minTime = std::numeric_limits<double>::max();
+
+	double totalTime = 0;
+	while(
+		( result.iterations < options.minIterations || totalTime < options.minTime ) &&
+		result.iterations < g_maxIterations
+	)
+	{
+		const tbb::tick_count t0 = tbb::tick_count::now();
+		benchmark->run();
+		const double t = ( tbb::tick_count::now() - t0 ).seconds();
+
+		result.iterations++;
+		totalTime += t;
+		result.minTime = std::min( result.minTime, t );
+		result.maxTime = std::max( result.maxTime, t );
+	}
+
+	result.meanTime = totalTime / result.iterations;
+	if( !result.units.empty() && result.minTime > 0 )
+	{
+		result.throughput = (double)benchmark->itemsPerRun() / result.minTime;
+	}
+
+	return result;
+}
+
+void printResult( const Result &result )
+{
+	cout << boost::format( "  %3d threads : %10.6fs min %10.6fs mean (%d iterations)" ) % result.threads % result.minTime % result.meanTime % result.iterations;
+	if( !result.units.empty() )
+	{
+		cout << boost::format( " %.4g %s/sec" ) % result.throughput % result.units;
+	}
+	cout << endl;
+}
+
+std::string escape( const std::string &s )
+{
+	std::string result;
+	for( std::string::const_iterator it = s.begin(); it != s.end(); ++it )
+	{
+		if( *it == '"' || *it == '\\' )
+		{
+			result.push_back( '\\' );
+		}
+		result.push_back( *it );
+	}
+	return result;
+}
+
+} // namespace
+
+size_t IECoreBenchmark::run( const BenchmarkSuite &suite, const Options &options, Results &results )
+{
+	boost::filesystem::create_directories( options.dataDirectory );
+
+	size_t numFailures = 0;
+
+	const int maxThreads = *std::max_element( options.threadCounts.begin(), options.threadCounts.end() );
+
+	for( BenchmarkSuite::const_iterator it = suite.begin(), eIt = suite.end(); it != eIt; ++it )
+	{
+		Benchmark *benchmark = it->get();
+		if( benchmark->name().find( options.filter ) == std::string::npos )
+		{
+			continue;
+		}
+
+		cout << benchmark->name() << endl;
+
+		try
+		{
+			{
+				tbb::task_scheduler_init scheduler( maxThreads );
+				benchmark->setUp();
+			}
+
+			if( benchmark->threaded() )
+			{
+				for( std::vector<int>::const_iterator tIt = options.threadCounts.begin(), tEIt = options.threadCounts.end(); tIt != tEIt; ++tIt )
+				{
+					results.push_back( timeBenchmark( benchmark, *tIt, options ) );
+					printResult( results.back() );
+				}
+			}
+			else
+			{
+				results.push_back( timeBenchmark( benchmark, 1, options ) );
+				printResult( results.back() );
+			}
+
+			benchmark->tearDown();
+		}
+		catch( const std::exception &e )
+		{
+			cout << "  FAILED : " << e.what() << endl;
+			numFailures++;
+			try
+			{
+				benchmark->tearDown();
+			}
+			catch( ... )
+			{
+				// we've already reported the original failure
+			}
+		}
+	}
+
+	return numFailures;
+}
+
+void IECoreBenchmark::writeJSON( const Results &results, const Options &options, std::ostream &o )
+{
+	o << "{\n";
+	o << "  \"scale\" : " << options.scale << ",\n";
+	o << "  \"hardwareConcurrency\" : " << tbb::task_scheduler_init::default_num_threads() << ",\n";
+	o << "  \"filter\" : \"" << escape( options.filter ) << "\",\n";
+	o << "  \"threadCounts\" : [ ";
+	for( std::vector<int>::const_iterator it = options.threadCounts.begin(), eIt = options.threadCounts.end(); it != eIt; ++it )
+	{
+		o << *it << ( it + 1 != eIt ? ", " : " " );
+	}
+	o << "],\n";
+	o << "  \"results\" : [\n";
+
+	o << std::setprecision( 9 );
+	for( Results::const_iterator it = results.begin(), eIt = results.end(); it != eIt; ++it )
+	{
+		o << "    { ";
+		o << "\"name\" : \"" << escape( it->name ) << "\", ";
+		o << "\"threads\" : " << it->threads << ", ";
+		o << "\"iterations\" : " << it->iterations << ", ";
+		o << "\"minTime\" : " << it->minTime << ", ";
+		o << "\"meanTime\" : " << it->meanTime << ", ";
+		o << "\"maxTime\" : " << it->maxTime << ", ";
+		o << "\"units\" : \"" << escape( it->units ) << "\", ";
+		o << "\"throughput\" : " << it->throughput;
+		o << " }" << ( it + 1 != eIt ? "," : "" ) << "\n";
+	}
+
+	o << "  ]\n";
+	o << "}\n";
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Program
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+void printUsage( const char *program )
+{
+	cerr << "Usage : " << program << " [options]\n\n";
+	cerr << "  -threads 1,2,4      Thread counts to run threaded benchmarks with\n";
+	cerr << "  -filter name        Run only benchmarks whose names contain name\n";
+	cerr << "  -minIterations n    Minimum number of timed runs per benchmark\n";
+	cerr << "  -minTime seconds    Minimum total time spent timing each benchmark\n";
+	cerr << "  -scale factor       Multiplier for the size of the synthetic data\n";
+	cerr << "  -dataDirectory dir  Directory for temporary files\n";
+	cerr << "  -output file.json   File to write JSON results to, for use with compareResults.py\n";
+	cerr << "  -list               List the benchmarks without running them\n";
+}
+
+} // namespace
+
+int IECoreBenchmark::runProgram( int argc, char *argv[], AddBenchmarksFunction addBenchmarks )
+{
+	Options options;
+	bool list = false;
+
+	try
+	{
+		for( int i = 1; i < argc; ++i )
+		{
+			const std::string arg = argv[i];
+			if( arg == "-list" )
+			{
+				list = true;
+				continue;
+			}
+			else if( arg == "-help" || arg == "-h" )
+			{
+				printUsage( argv[0] );
+				return 0;
+			}
+
+			if( i + 1 >= argc )
+			{
+				throw IECore::InvalidArgumentException( "Missing value for " + arg );
+			}
+			const std::string value = argv[++i];
+
+			if( arg == "-threads" )
+			{
+				std::vector<std::string> tokens;
+				boost::split( tokens, value, boost::is_any_of( "," ) );
+				options.threadCounts.clear();
+				for( std::vector<std::string>::const_iterator it = tokens.begin(); it != tokens.end(); ++it )
+				{
+					options.threadCounts.push_back( boost::lexical_cast<int>( *it ) );
+				}
+			}
+			else if( arg == "-filter" )
+			{
+				options.filter = value;
+			}
+			else if( arg == "-minIterations" )
+			{
+				options.minIterations = boost::lexical_cast<size_t>( value );
+			}
+			else if( arg == "-minTime" )
+			{
+				options.minTime = boost::lexical_cast<double>( value );
+			}
+			else if( arg == "-scale" )
+			{
+				options.scale = boost::lexical_cast<float>( value );
+			}
+			else if( arg == "-dataDirectory" )
+			{
+				options.dataDirectory = value;
+			}
+			else if( arg == "-output" )
+			{
+				options.outputFileName = value;
+			}
+			else
+			{
+				throw IECore::InvalidArgumentException( "Unknown argument " + arg );
+			}
+		}
+	}
+	catch( const std::exception &e )
+	{
+		cerr << "ERROR : " << e.what() << "\n\n";
+		printUsage( argv[0] );
+		return 1;
+	}
+
+	BenchmarkSuite suite;
+	addBenchmarks( suite, options );
+
+	if( list )
+	{
+		for( BenchmarkSuite::const_iterator it = suite.begin(), eIt = suite.end(); it != eIt; ++it )
+		{
+			if( (*it)->name().find( options.filter ) != std::string::npos )
+			{
+				cout << (*it)->name() << endl;
+			}
+		}
+		return 0;
+	}
+
+	Results results;
+	const size_t numFailures = run( suite, options, results );
+
+	if( !options.outputFileName.empty() )
+	{
+		std::ofstream o( options.outputFileName.c_str() );
+		writeJSON( results, options, o );
+		if( !o )
+		{
+			cerr << "ERROR : Failed to write " << options.outputFileName << endl;
+			return 1;
+		}
+	}
+
+	if( numFailures )
+	{
+		cerr << "ERROR : " << numFailures << " benchmark" << ( numFailures > 1 ? "s" : "" ) << " failed" << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECOREBENCHMARK_BENCHMARK_H
+#define IECOREBENCHMARK_BENCHMARK_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "boost/noncopyable.hpp"
+#include "boost/shared_ptr.hpp"
+
+namespace IECoreBenchmark
+{
+
+/// Options controlling a run of the benchmark suite, as
+/// specified on the command line of IECoreBenchmark.
+struct Options
+{
+
+	Options();
+
+	/// The thread counts to run each threaded benchmark with.
+	/// Defaults to powers of two up to the hardware concurrency.
+	std::vector<int> threadCounts;
+	/// Only benchmarks whose names contain this string are run.
+	std::string filter;
+	/// Each benchmark is run at least minIterations times,
+	/// and until at least minTime seconds have elapsed.
+	size_t minIterations;
+	double minTime;
+	/// Multiplier applied to the size of all the synthetic data,
+	/// so that the suite can be made to run quickly as a smoke test
+	/// or slowly to reduce noise.
+	float scale;
+	/// Directory used for any files generated by the benchmarks.
+	std::string dataDirectory;
+	/// File to write JSON results to, or empty for none.
+	std::string outputFileName;
+
+	/// Returns the given size multiplied by scale, and clamped
+	/// to be at least 1.
+	size_t scaled( size_t size ) const;
+	/// Returns a path within dataDirectory.
+	std::string dataFileName( const std::string &fileName ) const;
+
+};
+
+/// Base class for all benchmarks. Expensive preparation such as the
+/// generation of synthetic data should be done in setUp(), which is
+/// not timed, so that run() measures only the operation of interest.
+class Benchmark : boost::noncopyable
+{
+
+	public :
+
+		/// The name should be of the form "ClassName.operation". If units
+		/// is not empty, throughput is reported in units per second, using
+		/// itemsPerRun().
+		Benchmark( const std::string &name, const std::string &units = "" );
+		virtual ~Benchmark();
+
+		const std::string &name() const;
+		const std::string &units() const;
+
+		/// Called once before run() is called with any thread count.
+		virtual void setUp();
+		/// Performs the operation being timed. Called repeatedly,
+		/// so must leave the benchmark ready to be run again.
+		virtual void run() = 0;
+		/// Called once after all runs are complete, and should
+		/// free any memory or files allocated by setUp().
+		virtual void tearDown();
+
+		/// The number of items processed by each call to run(), used to
+		/// report throughput. May be called only after setUp().
+		virtual size_t itemsPerRun() const;
+		/// Should return false for benchmarks which don't use TBB, so that
+		/// they are run only with a single thread.
+		virtual bool threaded() const;
+
+	private :
+
+		std::string m_name;
+		std::string m_units;
+
+};
+
+typedef boost::shared_ptr<Benchmark> BenchmarkPtr;
+typedef std::vector<BenchmarkPtr> BenchmarkSuite;
+
+/// The timings for a single benchmark at a single thread count.
+struct Result
+{
+
+	Result();
+
+	std::string name;
+	std::string units;
+	int threads;
+	size_t iterations;
+	/// Times per iteration, in seconds.
+	double minTime;
+	double meanTime;
+	double maxTime;
+	/// In units per second, computed from minTime.
+	double throughput;
+
+};
+
+typedef std::vector<Result> Results;
+
+/// Runs all the benchmarks matching the filter, appending to results
+/// and printing progress to std::cout. A benchmark which throws is
+/// reported and skipped, so that the remainder of the suite still runs.
+/// Returns the number of benchmarks which failed.
+size_t run( const BenchmarkSuite &suite, const Options &options, Results &results );
+
+/// Writes the results as a JSON document suitable for comparison
+/// with compareResults.py.
+void writeJSON( const Results &results, const Options &options, std::ostream &o );
+
+typedef void (*AddBenchmarksFunction)( BenchmarkSuite &suite, const Options &options );
+
+/// Implements main() for a benchmark program. The command line is parsed
+/// into Options, which are passed to addBenchmarks() to populate the suite,
+/// and the benchmarks are then listed or run and their results written.
+/// Returns the exit status for the program.
+int runProgram( int argc, char *argv[], AddBenchmarksFunction addBenchmarks );
+
+} // namespace IECoreBenchmark
+
+#endif // IECOREBENCHMARK_BENCHMARK_H
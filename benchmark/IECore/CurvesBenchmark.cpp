@@ -0,0 +1,219 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+#include "OpenEXR/ImathRandom.h"
+
+#include "IECore/CurveLineariser.h"
+#include "IECore/CurveExtrudeOp.h"
+#include "IECore/CurvesPrimitiveEvaluator.h"
+
+#include "Generators.h"
+#include "CurvesBenchmark.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreBenchmark;
+
+namespace
+{
+
+const int g_verticesPerCurve = 8;
+
+class CurveLineariserOperate : public Benchmark
+{
+
+	public :
+
+		CurveLineariserOperate( const Options &options )
+			:	Benchmark( "CurveLineariser.operate", "curves" ), m_numCurves( options.scaled( 100000 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			m_op = new CurveLineariser;
+			m_op->inputParameter()->setValue( generateCurves( m_numCurves, g_verticesPerCurve ) );
+		}
+
+		virtual void run()
+		{
+			m_op->operate();
+		}
+
+		virtual void tearDown()
+		{
+			m_op = 0;
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numCurves;
+		}
+
+	private :
+
+		size_t m_numCurves;
+		CurveLineariserPtr m_op;
+
+};
+
+class CurveExtrudeOpOperate : public Benchmark
+{
+
+	public :
+
+		CurveExtrudeOpOperate( const Options &options )
+			:	Benchmark( "CurveExtrudeOp.operate", "curves" ), m_numCurves( options.scaled( 10000 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			m_op = new CurveExtrudeOp;
+			m_op->curvesParameter()->setValue( generateCurves( m_numCurves, g_verticesPerCurve ) );
+		}
+
+		virtual void run()
+		{
+			m_op->operate();
+		}
+
+		virtual void tearDown()
+		{
+			m_op = 0;
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numCurves;
+		}
+
+	private :
+
+		size_t m_numCurves;
+		CurveExtrudeOpPtr m_op;
+
+};
+
+// Uses the batch queries on CurvesPrimitiveEvaluator to evaluate
+// positions at random points on the curves, or to find the closest
+// points on the curves to random points in space.
+class CurvesPrimitiveEvaluatorQuery : public Benchmark
+{
+
+	public :
+
+		CurvesPrimitiveEvaluatorQuery( const std::string &name, const Options &options, bool closestPoints )
+			:	Benchmark( name, "queries" ),
+				m_numCurves( options.scaled( 100000 ) ), m_numQueries( options.scaled( 1000000 ) ),
+				m_closestPoints( closestPoints )
+		{
+		}
+
+		virtual void setUp()
+		{
+			m_evaluator = new CurvesPrimitiveEvaluator( generateCurves( m_numCurves, g_verticesPerCurve ) );
+
+			if( m_closestPoints )
+			{
+				m_points = generatePoints( m_numQueries, Box3f( V3f( -1.2f ), V3f( 1.2f ) ) )->readable();
+			}
+			else
+			{
+				Rand48 r( 0 );
+				m_curveIndices.resize( m_numQueries );
+				m_v.resize( m_numQueries );
+				for( size_t i = 0; i < m_numQueries; ++i )
+				{
+					m_curveIndices[i] = r.nexti() % m_numCurves;
+					m_v[i] = r.nextf();
+				}
+			}
+
+			// make sure the tables used by the queries are
+			// built before timing starts.
+			run();
+		}
+
+		virtual void run()
+		{
+			if( m_closestPoints )
+			{
+				m_evaluator->closestPoints( m_points, m_curveIndices, m_v );
+			}
+			else
+			{
+				m_evaluator->pointsAtV( m_curveIndices, m_v, m_points );
+			}
+		}
+
+		virtual void tearDown()
+		{
+			m_evaluator = 0;
+			std::vector<V3f>().swap( m_points );
+			std::vector<unsigned>().swap( m_curveIndices );
+			std::vector<float>().swap( m_v );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numQueries;
+		}
+
+	private :
+
+		size_t m_numCurves;
+		size_t m_numQueries;
+		bool m_closestPoints;
+
+		CurvesPrimitiveEvaluatorPtr m_evaluator;
+		std::vector<V3f> m_points;
+		std::vector<unsigned> m_curveIndices;
+		std::vector<float> m_v;
+
+};
+
+} // namespace
+
+void IECoreBenchmark::addCurvesBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	suite.push_back( BenchmarkPtr( new CurveLineariserOperate( options ) ) );
+	suite.push_back( BenchmarkPtr( new CurveExtrudeOpOperate( options ) ) );
+	suite.push_back( BenchmarkPtr( new CurvesPrimitiveEvaluatorQuery( "CurvesPrimitiveEvaluator.pointsAtV", options, false ) ) );
+	suite.push_back( BenchmarkPtr( new CurvesPrimitiveEvaluatorQuery( "CurvesPrimitiveEvaluator.closestPoints", options, true ) ) );
+}
@@ -0,0 +1,161 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <ctime>
+
+#include "boost/filesystem.hpp"
+
+#include "IECore/FileSequenceFunctions.h"
+
+#include "Generators.h"
+#include "FileSequenceBenchmark.h"
+
+using namespace std;
+using namespace IECore;
+using namespace IECoreBenchmark;
+
+namespace
+{
+
+const size_t g_framesPerSequence = 99;
+
+class FindSequences : public Benchmark
+{
+
+	public :
+
+		FindSequences( const Options &options )
+			:	Benchmark( "FileSequenceFunctions.findSequences", "names" ), m_numSequences( options.scaled( 5000 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			generateFileNames( m_numSequences, g_framesPerSequence, m_names );
+		}
+
+		virtual void run()
+		{
+			std::vector<FileSequencePtr> sequences;
+			findSequences( m_names, sequences );
+			if( sequences.size() != m_numSequences )
+			{
+				throw Exception( "Unexpected number of sequences" );
+			}
+		}
+
+		virtual void tearDown()
+		{
+			std::vector<std::string>().swap( m_names );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_names.size();
+		}
+
+	private :
+
+		size_t m_numSequences;
+		std::vector<std::string> m_names;
+
+};
+
+// Lists a directory of empty files, optionally using the
+// cache. Creating files is slow, so by default we use fewer
+// than for findSequences, but the scale option can be used to
+// test with directories of hundreds of thousands of files.
+class Ls : public Benchmark
+{
+
+	public :
+
+		Ls( const std::string &name, const Options &options, bool useCache )
+			:	Benchmark( name, "files" ),
+				m_directory( options.dataFileName( "ls" ) ),
+				m_numSequences( options.scaled( 500 ) ), m_useCache( useCache ), m_numFiles( 0 )
+		{
+		}
+
+		virtual void setUp()
+		{
+			boost::filesystem::create_directories( m_directory );
+
+			std::vector<std::string> names;
+			generateFileNames( m_numSequences, g_framesPerSequence, names );
+			for( std::vector<std::string>::const_iterator it = names.begin(), eIt = names.end(); it != eIt; ++it )
+			{
+				std::ofstream f( ( boost::filesystem::path( m_directory ) / *it ).string().c_str() );
+			}
+			m_numFiles = names.size();
+
+			// ls() won't reuse a cached listing taken in the same
+			// second as the last modification, so backdate it.
+			boost::filesystem::last_write_time( m_directory, time( 0 ) - 10 );
+		}
+
+		virtual void run()
+		{
+			std::vector<FileSequencePtr> sequences;
+			ls( m_directory, sequences, 2, m_useCache );
+		}
+
+		virtual void tearDown()
+		{
+			boost::filesystem::remove_all( m_directory );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numFiles;
+		}
+
+	private :
+
+		std::string m_directory;
+		size_t m_numSequences;
+		bool m_useCache;
+		size_t m_numFiles;
+
+};
+
+} // namespace
+
+void IECoreBenchmark::addFileSequenceBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	suite.push_back( BenchmarkPtr( new FindSequences( options ) ) );
+	suite.push_back( BenchmarkPtr( new Ls( "FileSequenceFunctions.ls", options, false ) ) );
+	suite.push_back( BenchmarkPtr( new Ls( "FileSequenceFunctions.lsCached", options, true ) ) );
+}
@@ -0,0 +1,230 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "boost/format.hpp"
+
+#include "OpenEXR/ImathRandom.h"
+
+#include "IECore/SceneCache.h"
+#include "IECore/SimpleTypedData.h"
+#include "IECore/PerlinNoise.h"
+
+#ifdef IECORE_WITH_DEEPEXR
+#include "IECore/DeepImageWriter.h"
+#include "IECore/DeepPixel.h"
+#endif
+
+#include "Generators.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+
+namespace
+{
+
+void writeLocation( SceneInterface *location, const MeshPrimitive *mesh, int depth, int branching, int numSamples, size_t &leafIndex )
+{
+	if( depth == 0 )
+	{
+		// perturb each mesh slightly, so that the SceneCache can't
+		// deduplicate them and the file size is representative.
+		MeshPrimitivePtr leafMesh = mesh->copy();
+		V3fVectorDataPtr pData = leafMesh->variableData<V3fVectorData>( "P" );
+		const V3f offset( 0, 0, (float)leafIndex * 1e-3f );
+		std::vector<V3f> &p = pData->writable();
+		for( std::vector<V3f>::iterator it = p.begin(); it != p.end(); ++it )
+		{
+			*it += offset;
+		}
+		leafIndex++;
+
+		for( int s = 0; s < numSamples; ++s )
+		{
+			location->writeObject( leafMesh.get(), s / 24.0 );
+		}
+		return;
+	}
+
+	for( int i = 0; i < branching; ++i )
+	{
+		SceneInterfacePtr child = location->createChild( boost::str( boost::format( "child%d" ) % i ) );
+		for( int s = 0; s < numSamples; ++s )
+		{
+			M44d m;
+			m.setTranslation( V3d( i * 2.5, s * 0.1, 0 ) );
+			child->writeTransform( new M44dData( m ), s / 24.0 );
+		}
+		writeLocation( child.get(), mesh, depth - 1, branching, numSamples, leafIndex );
+	}
+}
+
+} // namespace
+
+namespace IECoreBenchmark
+{
+
+MeshPrimitivePtr generateMesh( int divisions )
+{
+	return MeshPrimitive::createSphere( 1.0f, -1.0f, 1.0f, 360.0f, V2i( divisions ) );
+}
+
+V3fVectorDataPtr generatePoints( size_t numPoints, const Box3f &bound, unsigned long seed )
+{
+	Rand48 r( seed );
+	V3fVectorDataPtr result = new V3fVectorData;
+	std::vector<V3f> &p = result->writable();
+	p.resize( numPoints );
+	for( std::vector<V3f>::iterator it = p.begin(); it != p.end(); ++it )
+	{
+		for( int a = 0; a < 3; ++a )
+		{
+			(*it)[a] = r.nextf( bound.min[a], bound.max[a] );
+		}
+	}
+	return result;
+}
+
+CurvesPrimitivePtr generateCurves( size_t numCurves, int verticesPerCurve, unsigned long seed )
+{
+	Rand48 r( seed );
+	PerlinNoiseV3fV3f noise( seed );
+
+	IntVectorDataPtr verticesPerCurveData = new IntVectorData;
+	verticesPerCurveData->writable().resize( numCurves, verticesPerCurve );
+
+	V3fVectorDataPtr pData = new V3fVectorData;
+	std::vector<V3f> &p = pData->writable();
+	p.reserve( numCurves * verticesPerCurve );
+
+	const float segmentLength = 0.2f / (float)verticesPerCurve;
+	for( size_t i = 0; i < numCurves; ++i )
+	{
+		const V3f root = hollowSphereRand<V3f>( r );
+		V3f v = root;
+		for( int j = 0; j < verticesPerCurve; ++j )
+		{
+			p.push_back( v );
+			v += ( root + noise.noise( v * 10.0f ) ).normalized() * segmentLength;
+		}
+	}
+
+	return new CurvesPrimitive( verticesPerCurveData, CubicBasisf::bSpline(), false, pData );
+}
+
+ImagePrimitivePtr generateImage( int width, int height, unsigned long seed )
+{
+	const Box2i window( V2i( 0 ), V2i( width - 1, height - 1 ) );
+	ImagePrimitivePtr result = new ImagePrimitive( window, window );
+
+	Rand48 r( seed );
+	const char *channelNames[] = { "R", "G", "B", "A" };
+	for( int c = 0; c < 4; ++c )
+	{
+		std::vector<float> &channel = result->createChannel<float>( channelNames[c] )->writable();
+		std::vector<float>::iterator it = channel.begin();
+		for( int y = 0; y < height; ++y )
+		{
+			for( int x = 0; x < width; ++x, ++it )
+			{
+				const float gradient = c == 3 ? 1.0f : (float)( c % 2 ? x : y ) / (float)std::max( width, height );
+				*it = gradient + r.nextf( -0.02f, 0.02f );
+			}
+		}
+	}
+
+	return result;
+}
+
+#ifdef IECORE_WITH_DEEPEXR
+
+void generateDeepImage( const std::string &fileName, int width, int height, int samplesPerPixel )
+{
+	DeepImageWriterPtr writer = DeepImageWriter::create( fileName );
+	writer->resolutionParameter()->setTypedValue( V2i( width, height ) );
+
+	Rand48 r( 0 );
+	for( int y = 0; y < height; ++y )
+	{
+		for( int x = 0; x < width; ++x )
+		{
+			DeepPixelPtr pixel = new DeepPixel( "RGBA", samplesPerPixel );
+			float depth = r.nextf( 1.0f, 2.0f );
+			for( int s = 0; s < samplesPerPixel; ++s )
+			{
+				const float alpha = r.nextf( 0.1f, 0.5f );
+				const float channels[4] = { r.nextf() * alpha, r.nextf() * alpha, r.nextf() * alpha, alpha };
+				pixel->addSample( depth, channels );
+				depth += r.nextf( 0.01f, 0.1f );
+			}
+			writer->writePixel( x, y, pixel.get() );
+		}
+	}
+}
+
+#endif
+
+void generateSceneCache( const std::string &fileName, int depth, int branching, int meshDivisions, int numSamples )
+{
+	SceneCachePtr root = new SceneCache( fileName, IndexedIO::Write );
+	MeshPrimitivePtr mesh = generateMesh( meshDivisions );
+	size_t leafIndex = 0;
+	writeLocation( root.get(), mesh.get(), depth, branching, numSamples, leafIndex );
+}
+
+void generateFileNames( size_t numSequences, size_t framesPerSequence, std::vector<std::string> &names )
+{
+	names.clear();
+	names.reserve( numSequences * ( framesPerSequence + 1 ) );
+	for( size_t i = 0; i < numSequences; ++i )
+	{
+		for( size_t f = 1; f <= framesPerSequence; ++f )
+		{
+			names.push_back( boost::str( boost::format( "shot%d_beauty.%04d.exr" ) % i % f ) );
+		}
+		names.push_back( boost::str( boost::format( "shot%d_notes.txt" ) % i ) );
+	}
+
+	// fisher-yates, so the order doesn't depend on the
+	// implementation of std::random_shuffle.
+	Rand48 r( 0 );
+	for( size_t i = names.size() - 1; i > 0; --i )
+	{
+		std::swap( names[i], names[r.nexti() % ( i + 1 )] );
+	}
+}
+
+} // namespace IECoreBenchmark
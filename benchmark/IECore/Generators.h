@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECOREBENCHMARK_GENERATORS_H
+#define IECOREBENCHMARK_GENERATORS_H
+
+#include <string>
+#include <vector>
+
+#include "IECore/MeshPrimitive.h"
+#include "IECore/CurvesPrimitive.h"
+#include "IECore/ImagePrimitive.h"
+#include "IECore/VectorTypedData.h"
+
+/// Functions for generating the synthetic data used by the benchmarks.
+/// All are deterministic, so that results are comparable between runs.
+namespace IECoreBenchmark
+{
+
+/// Returns a unit sphere with the specified number of divisions
+/// in each direction, and therefore roughly 2 * divisions^2 faces.
+IECore::MeshPrimitivePtr generateMesh( int divisions );
+
+/// Returns points distributed uniformly at random within the bound.
+IECore::V3fVectorDataPtr generatePoints( size_t numPoints, const Imath::Box3f &bound, unsigned long seed = 0 );
+
+/// Returns a groom-like set of cubic curves, each rooted at a random
+/// point on the unit sphere and growing outwards with a little wiggle.
+IECore::CurvesPrimitivePtr generateCurves( size_t numCurves, int verticesPerCurve, unsigned long seed = 0 );
+
+/// Returns an image with float RGBA channels containing smooth gradients
+/// overlaid with noise, so that compression ratios are representative of
+/// real renders rather than of flat colour.
+IECore::ImagePrimitivePtr generateImage( int width, int height, unsigned long seed = 0 );
+
+#ifdef IECORE_WITH_DEEPEXR
+
+/// Writes a deep image with RGBA channels and the specified number of
+/// samples in each pixel.
+void generateDeepImage( const std::string &fileName, int width, int height, int samplesPerPixel );
+
+#endif
+
+/// Writes a SceneCache containing a hierarchy of the specified depth,
+/// with branching children at each level. Every location has an animated
+/// transform, and every leaf has a mesh with the specified divisions.
+void generateSceneCache( const std::string &fileName, int depth, int branching, int meshDivisions, int numSamples = 2 );
+
+/// Fills names with the names of the files in numSequences sequences
+/// of framesPerSequence frames each, plus one unrelated name per
+/// sequence, all in pseudo-random order.
+void generateFileNames( size_t numSequences, size_t framesPerSequence, std::vector<std::string> &names );
+
+} // namespace IECoreBenchmark
+
+#endif // IECOREBENCHMARK_GENERATORS_H
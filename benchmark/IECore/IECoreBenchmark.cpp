@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+#include "IndexedIOBenchmark.h"
+#include "LRUCacheBenchmark.h"
+#include "KDTreeBenchmark.h"
+#include "MeshPrimitiveEvaluatorBenchmark.h"
+#include "TypedDataBenchmark.h"
+#include "ImageBenchmark.h"
+#include "SceneCacheBenchmark.h"
+#include "NoiseBenchmark.h"
+#include "CurvesBenchmark.h"
+#include "FileSequenceBenchmark.h"
+
+using namespace IECoreBenchmark;
+
+namespace
+{
+
+void addBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	addIndexedIOBenchmarks( suite, options );
+	addLRUCacheBenchmarks( suite, options );
+	addKDTreeBenchmarks( suite, options );
+	addMeshPrimitiveEvaluatorBenchmarks( suite, options );
+	addTypedDataBenchmarks( suite, options );
+	addImageBenchmarks( suite, options );
+	addSceneCacheBenchmarks( suite, options );
+	addNoiseBenchmarks( suite, options );
+	addCurvesBenchmarks( suite, options );
+	addFileSequenceBenchmarks( suite, options );
+}
+
+} // namespace
+
+int main( int argc, char *argv[] )
+{
+	return runProgram( argc, argv, addBenchmarks );
+}
@@ -0,0 +1,368 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/filesystem.hpp"
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+#include "OpenEXR/ImathRandom.h"
+
+#include "IECore/Reader.h"
+#include "IECore/Writer.h"
+#include "IECore/CompoundParameter.h"
+#include "IECore/ImageCache.h"
+
+#ifdef IECORE_WITH_DEEPEXR
+#include "IECore/DeepImageReader.h"
+#endif
+
+#include "Generators.h"
+#include "ImageBenchmark.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreBenchmark;
+
+namespace
+{
+
+void writeImage( const ImagePrimitive *image, const std::string &fileName, const std::string &compression )
+{
+	WriterPtr writer = Writer::create( const_cast<ImagePrimitive *>( image ), fileName );
+	if( !compression.empty() )
+	{
+		writer->parameters()->parameter<Parameter>( "compression" )->setValue( compression );
+	}
+	writer->write();
+}
+
+class ImageWrite : public Benchmark
+{
+
+	public :
+
+		// If compression is empty, the default for the format is used.
+		ImageWrite( const Options &options, const std::string &extension, const std::string &compression = "" )
+			:	Benchmark( "ImageWriter." + extension + ( compression.empty() ? "" : "." + compression ), "pixels" ),
+				m_fileName( options.dataFileName( "imageWrite." + extension ) ), m_compression( compression ),
+				m_size( (int)options.scaled( 2048 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			m_image = generateImage( m_size, m_size );
+		}
+
+		virtual void run()
+		{
+			writeImage( m_image.get(), m_fileName, m_compression );
+		}
+
+		virtual void tearDown()
+		{
+			m_image = 0;
+			boost::filesystem::remove( m_fileName );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_size * m_size;
+		}
+
+	private :
+
+		std::string m_fileName;
+		std::string m_compression;
+		int m_size;
+		ImagePrimitivePtr m_image;
+
+};
+
+class ImageRead : public Benchmark
+{
+
+	public :
+
+		ImageRead( const Options &options, const std::string &extension, const std::string &compression = "" )
+			:	Benchmark( "ImageReader." + extension + ( compression.empty() ? "" : "." + compression ), "pixels" ),
+				m_fileName( options.dataFileName( "imageRead." + extension ) ), m_compression( compression ),
+				m_size( (int)options.scaled( 2048 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			ImagePrimitivePtr image = generateImage( m_size, m_size );
+			writeImage( image.get(), m_fileName, m_compression );
+		}
+
+		virtual void run()
+		{
+			Reader::create( m_fileName )->read();
+		}
+
+		virtual void tearDown()
+		{
+			boost::filesystem::remove( m_fileName );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_size * m_size;
+		}
+
+	private :
+
+		std::string m_fileName;
+		std::string m_compression;
+		int m_size;
+
+};
+
+// Makes random samples from an EXR file in parallel, through a cache
+// which is large enough to hold only a quarter of the sampled channel.
+class ImageCacheSample : public Benchmark
+{
+
+	public :
+
+		ImageCacheSample( const Options &options )
+			:	Benchmark( "ImageCache.sample", "samples" ),
+				m_fileName( options.dataFileName( "imageCacheSample.exr" ) ),
+				m_size( (int)options.scaled( 2048 ) ), m_numSamples( options.scaled( 1000000 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			ImagePrimitivePtr image = generateImage( m_size, m_size );
+			writeImage( image.get(), m_fileName, "" );
+
+			Rand48 r( 0 );
+			m_samplePositions.resize( m_numSamples );
+			for( std::vector<V2i>::iterator it = m_samplePositions.begin(); it != m_samplePositions.end(); ++it )
+			{
+				*it = V2i( r.nexti() % m_size, r.nexti() % m_size );
+			}
+		}
+
+		virtual void run()
+		{
+			// a new cache each time, so we measure the cost of reading
+			// tiles as well as of looking them up.
+			ImageCachePtr cache = new ImageCache( m_size * m_size * sizeof( float ) / 4 );
+			Sample sample( cache.get(), m_fileName, m_samplePositions );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_numSamples ), sample );
+		}
+
+		virtual void tearDown()
+		{
+			std::vector<V2i>().swap( m_samplePositions );
+			boost::filesystem::remove( m_fileName );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numSamples;
+		}
+
+	private :
+
+		class Sample
+		{
+
+			public :
+
+				Sample( ImageCache *cache, const std::string &fileName, const std::vector<V2i> &positions )
+					:	m_cache( cache ), m_fileName( fileName ), m_positions( positions )
+				{
+				}
+
+				void operator()( const tbb::blocked_range<size_t> &range ) const
+				{
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						m_cache->sample( m_fileName, "R", m_positions[i].x, m_positions[i].y );
+					}
+				}
+
+			private :
+
+				ImageCache *m_cache;
+				const std::string &m_fileName;
+				const std::vector<V2i> &m_positions;
+
+		};
+
+		std::string m_fileName;
+		int m_size;
+		size_t m_numSamples;
+		std::vector<V2i> m_samplePositions;
+
+};
+
+#ifdef IECORE_WITH_DEEPEXR
+
+class DeepImageWrite : public Benchmark
+{
+
+	public :
+
+		DeepImageWrite( const Options &options )
+			:	Benchmark( "DeepImageWriter.exr", "pixels" ),
+				m_fileName( options.dataFileName( "deepImageWrite.exr" ) ),
+				m_size( (int)options.scaled( 512 ) )
+		{
+		}
+
+		virtual void run()
+		{
+			generateDeepImage( m_fileName, m_size, m_size, 8 );
+		}
+
+		virtual void tearDown()
+		{
+			boost::filesystem::remove( m_fileName );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_size * m_size;
+		}
+
+		virtual bool threaded() const
+		{
+			return false;
+		}
+
+	private :
+
+		std::string m_fileName;
+		int m_size;
+
+};
+
+class DeepImageRead : public Benchmark
+{
+
+	public :
+
+		DeepImageRead( const Options &options )
+			:	Benchmark( "DeepImageReader.exr", "pixels" ),
+				m_fileName( options.dataFileName( "deepImageRead.exr" ) ),
+				m_size( (int)options.scaled( 512 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			generateDeepImage( m_fileName, m_size, m_size, 8 );
+		}
+
+		virtual void run()
+		{
+			DeepImageReaderPtr reader = runTimeCast<DeepImageReader>( Reader::create( m_fileName ) );
+			for( int y = 0; y < m_size; ++y )
+			{
+				for( int x = 0; x < m_size; ++x )
+				{
+					reader->readPixel( x, y );
+				}
+			}
+		}
+
+		virtual void tearDown()
+		{
+			boost::filesystem::remove( m_fileName );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_size * m_size;
+		}
+
+		virtual bool threaded() const
+		{
+			return false;
+		}
+
+	private :
+
+		std::string m_fileName;
+		int m_size;
+
+};
+
+#endif
+
+} // namespace
+
+void IECoreBenchmark::addImageBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	const char *exrCompressions[] = { "none", "rle", "zips", "zip", "piz", "pxr24", "b44", 0 };
+	for( const char **c = exrCompressions; *c; ++c )
+	{
+		suite.push_back( BenchmarkPtr( new ImageWrite( options, "exr", *c ) ) );
+		suite.push_back( BenchmarkPtr( new ImageRead( options, "exr", *c ) ) );
+	}
+
+#ifdef IECORE_WITH_TIFF
+	const char *tiffCompressions[] = { "none", "lzw", "deflate", 0 };
+	for( const char **c = tiffCompressions; *c; ++c )
+	{
+		suite.push_back( BenchmarkPtr( new ImageWrite( options, "tif", *c ) ) );
+		suite.push_back( BenchmarkPtr( new ImageRead( options, "tif", *c ) ) );
+	}
+#endif
+
+#ifdef IECORE_WITH_PNG
+	suite.push_back( BenchmarkPtr( new ImageWrite( options, "png" ) ) );
+	suite.push_back( BenchmarkPtr( new ImageRead( options, "png" ) ) );
+#endif
+
+#ifdef IECORE_WITH_JPEG
+	suite.push_back( BenchmarkPtr( new ImageWrite( options, "jpg" ) ) );
+	suite.push_back( BenchmarkPtr( new ImageRead( options, "jpg" ) ) );
+#endif
+
+	suite.push_back( BenchmarkPtr( new ImageCacheSample( options ) ) );
+
+#ifdef IECORE_WITH_DEEPEXR
+	suite.push_back( BenchmarkPtr( new DeepImageWrite( options ) ) );
+	suite.push_back( BenchmarkPtr( new DeepImageRead( options ) ) );
+#endif
+}
@@ -0,0 +1,201 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/filesystem.hpp"
+#include "boost/format.hpp"
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+#include "IECore/FileIndexedIO.h"
+
+#include "IndexedIOBenchmark.h"
+
+using namespace std;
+using namespace IECore;
+using namespace IECoreBenchmark;
+
+namespace
+{
+
+const size_t g_entriesPerDirectory = 100;
+const size_t g_entrySize = 1000;
+
+IndexedIO::EntryID directoryName( size_t i )
+{
+	return boost::str( boost::format( "directory%d" ) % i );
+}
+
+IndexedIO::EntryID entryName( size_t i )
+{
+	return boost::str( boost::format( "entry%d" ) % i );
+}
+
+// Writes numEntries arrays of floats, grouped into subdirectories.
+void writeFile( const std::string &fileName, size_t numEntries )
+{
+	std::vector<float> data( g_entrySize );
+	for( size_t i = 0; i < g_entrySize; ++i )
+	{
+		data[i] = (float)i;
+	}
+
+	IndexedIOPtr io = new FileIndexedIO( fileName, IndexedIO::rootPath, IndexedIO::Write );
+	IndexedIOPtr directory;
+	for( size_t i = 0; i < numEntries; ++i )
+	{
+		if( i % g_entriesPerDirectory == 0 )
+		{
+			directory = io->createSubdirectory( directoryName( i / g_entriesPerDirectory ) );
+		}
+		directory->write( entryName( i ), &data[0], data.size() );
+	}
+}
+
+class StreamIndexedIOWrite : public Benchmark
+{
+
+	public :
+
+		StreamIndexedIOWrite( const Options &options )
+			:	Benchmark( "StreamIndexedIO.write", "bytes" ),
+				m_fileName( options.dataFileName( "streamIndexedIOWrite.fio" ) ),
+				m_numEntries( options.scaled( 10000 ) )
+		{
+		}
+
+		virtual void run()
+		{
+			writeFile( m_fileName, m_numEntries );
+		}
+
+		virtual void tearDown()
+		{
+			boost::filesystem::remove( m_fileName );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numEntries * g_entrySize * sizeof( float );
+		}
+
+		virtual bool threaded() const
+		{
+			return false;
+		}
+
+	private :
+
+		std::string m_fileName;
+		size_t m_numEntries;
+
+};
+
+class StreamIndexedIORead : public Benchmark
+{
+
+	public :
+
+		StreamIndexedIORead( const Options &options )
+			:	Benchmark( "StreamIndexedIO.read", "bytes" ),
+				m_fileName( options.dataFileName( "streamIndexedIORead.fio" ) ),
+				m_numEntries( options.scaled( 10000 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			writeFile( m_fileName, m_numEntries );
+		}
+
+		virtual void run()
+		{
+			// reopen the file each time, so we include the cost of reading
+			// the index, and don't benefit from any caching from the last run.
+			ConstIndexedIOPtr io = new FileIndexedIO( m_fileName, IndexedIO::rootPath, IndexedIO::Read );
+			ReadEntries reader( io.get() );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_numEntries ), reader );
+		}
+
+		virtual void tearDown()
+		{
+			boost::filesystem::remove( m_fileName );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numEntries * g_entrySize * sizeof( float );
+		}
+
+	private :
+
+		class ReadEntries
+		{
+
+			public :
+
+				ReadEntries( const IndexedIO *io )
+					:	m_io( io )
+				{
+				}
+
+				void operator()( const tbb::blocked_range<size_t> &range ) const
+				{
+					std::vector<float> data( g_entrySize );
+					float *dataPtr = &data[0];
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						ConstIndexedIOPtr directory = m_io->subdirectory( directoryName( i / g_entriesPerDirectory ) );
+						directory->read( entryName( i ), dataPtr, data.size() );
+					}
+				}
+
+			private :
+
+				const IndexedIO *m_io;
+
+		};
+
+		std::string m_fileName;
+		size_t m_numEntries;
+
+};
+
+} // namespace
+
+void IECoreBenchmark::addIndexedIOBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	suite.push_back( BenchmarkPtr( new StreamIndexedIOWrite( options ) ) );
+	suite.push_back( BenchmarkPtr( new StreamIndexedIORead( options ) ) );
+}
@@ -0,0 +1,190 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+#include "IECore/KDTree.h"
+
+#include "Generators.h"
+#include "KDTreeBenchmark.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreBenchmark;
+
+namespace
+{
+
+class KDTreeBuild : public Benchmark
+{
+
+	public :
+
+		KDTreeBuild( const Options &options )
+			:	Benchmark( "KDTree.build", "points" ), m_numPoints( options.scaled( 1000000 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			m_points = generatePoints( m_numPoints, Box3f( V3f( -1 ), V3f( 1 ) ) );
+		}
+
+		virtual void run()
+		{
+			const std::vector<V3f> &p = m_points->readable();
+			V3fTree tree( p.begin(), p.end() );
+		}
+
+		virtual void tearDown()
+		{
+			m_points = 0;
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numPoints;
+		}
+
+		virtual bool threaded() const
+		{
+			return false;
+		}
+
+	private :
+
+		size_t m_numPoints;
+		V3fVectorDataPtr m_points;
+
+};
+
+// Performs parallel queries against a tree of uniformly distributed
+// points, using either nearestNeighbour() or nearestNNeighbours().
+class KDTreeQuery : public Benchmark
+{
+
+	public :
+
+		KDTreeQuery( const std::string &name, const Options &options, unsigned numNeighbours )
+			:	Benchmark( name, "queries" ),
+				m_numPoints( options.scaled( 1000000 ) ), m_numQueries( options.scaled( 1000000 ) ),
+				m_numNeighbours( numNeighbours )
+		{
+		}
+
+		virtual void setUp()
+		{
+			const Box3f bound( V3f( -1 ), V3f( 1 ) );
+			m_points = generatePoints( m_numPoints, bound, 0 );
+			m_queries = generatePoints( m_numQueries, bound, 1 );
+			m_tree.init( m_points->readable().begin(), m_points->readable().end() );
+		}
+
+		virtual void run()
+		{
+			Query query( m_tree, m_queries->readable(), m_numNeighbours );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_numQueries ), query );
+		}
+
+		virtual void tearDown()
+		{
+			m_tree = V3fTree();
+			m_points = 0;
+			m_queries = 0;
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numQueries;
+		}
+
+	private :
+
+		class Query
+		{
+
+			public :
+
+				Query( const V3fTree &tree, const std::vector<V3f> &queries, unsigned numNeighbours )
+					:	m_tree( tree ), m_queries( queries ), m_numNeighbours( numNeighbours )
+				{
+				}
+
+				void operator()( const tbb::blocked_range<size_t> &range ) const
+				{
+					if( m_numNeighbours == 1 )
+					{
+						for( size_t i = range.begin(); i != range.end(); ++i )
+						{
+							m_tree.nearestNeighbour( m_queries[i] );
+						}
+					}
+					else
+					{
+						std::vector<V3fTree::Neighbour> neighbours;
+						for( size_t i = range.begin(); i != range.end(); ++i )
+						{
+							m_tree.nearestNNeighbours( m_queries[i], m_numNeighbours, neighbours );
+						}
+					}
+				}
+
+			private :
+
+				const V3fTree &m_tree;
+				const std::vector<V3f> &m_queries;
+				unsigned m_numNeighbours;
+
+		};
+
+		size_t m_numPoints;
+		size_t m_numQueries;
+		unsigned m_numNeighbours;
+
+		V3fVectorDataPtr m_points;
+		V3fVectorDataPtr m_queries;
+		V3fTree m_tree;
+
+};
+
+} // namespace
+
+void IECoreBenchmark::addKDTreeBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	suite.push_back( BenchmarkPtr( new KDTreeBuild( options ) ) );
+	suite.push_back( BenchmarkPtr( new KDTreeQuery( "KDTree.nearestNeighbour", options, 1 ) ) );
+	suite.push_back( BenchmarkPtr( new KDTreeQuery( "KDTree.nearestNNeighbours", options, 8 ) ) );
+}
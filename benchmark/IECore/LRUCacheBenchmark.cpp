@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+#include "IECore/LRUCache.h"
+
+#include "LRUCacheBenchmark.h"
+
+using namespace std;
+using namespace IECore;
+using namespace IECoreBenchmark;
+
+namespace
+{
+
+typedef LRUCache<size_t, size_t> Cache;
+
+size_t getter( const size_t &key, Cache::Cost &cost )
+{
+	cost = 1;
+	return key * 2;
+}
+
+// Performs numQueries gets from the cache in parallel, cycling through
+// numKeys different keys. The cache is sized to hold a fraction of the
+// keys - because the keys are visited cyclically, a cache holding all
+// of them gives only hits, and a cache holding fewer gives only misses.
+class LRUCacheGet : public Benchmark
+{
+
+	public :
+
+		LRUCacheGet( const std::string &name, const Options &options, size_t numKeys, float cachedFraction )
+			:	Benchmark( name, "gets" ),
+				m_numKeys( options.scaled( numKeys ) ),
+				m_numQueries( options.scaled( 1000000 ) ),
+				m_cache( getter, std::max( (Cache::Cost)1, (Cache::Cost)( m_numKeys * cachedFraction ) ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			for( size_t i = 0; i < m_numKeys; ++i )
+			{
+				m_cache.get( i );
+			}
+		}
+
+		virtual void run()
+		{
+			Get get( m_cache, m_numKeys );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_numQueries ), get );
+		}
+
+		virtual void tearDown()
+		{
+			m_cache.clear();
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numQueries;
+		}
+
+	private :
+
+		class Get
+		{
+
+			public :
+
+				Get( Cache &cache, size_t numKeys )
+					:	m_cache( cache ), m_numKeys( numKeys )
+				{
+				}
+
+				void operator()( const tbb::blocked_range<size_t> &range ) const
+				{
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						// scatter the keys so that neighbouring queries,
+						// which typically run on the same thread, don't
+						// share keys.
+						const size_t key = ( i * 7919 ) % m_numKeys;
+						if( m_cache.get( key ) != key * 2 )
+						{
+							throw Exception( "Unexpected value from LRUCache" );
+						}
+					}
+				}
+
+			private :
+
+				Cache &m_cache;
+				size_t m_numKeys;
+
+		};
+
+		size_t m_numKeys;
+		size_t m_numQueries;
+		Cache m_cache;
+
+};
+
+} // namespace
+
+void IECoreBenchmark::addLRUCacheBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	suite.push_back( BenchmarkPtr( new LRUCacheGet( "LRUCache.getHits", options, 10000, 1.0f ) ) );
+	suite.push_back( BenchmarkPtr( new LRUCacheGet( "LRUCache.getMisses", options, 10000, 0.01f ) ) );
+}
@@ -0,0 +1,301 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+#include "OpenEXR/ImathRandom.h"
+
+#include "IECore/MeshPrimitiveEvaluator.h"
+#include "IECore/TriangulateOp.h"
+
+#include "Generators.h"
+#include "MeshPrimitiveEvaluatorBenchmark.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreBenchmark;
+
+namespace
+{
+
+MeshPrimitivePtr generateTriangulatedMesh( int divisions )
+{
+	TriangulateOpPtr op = new TriangulateOp();
+	op->inputParameter()->setValue( generateMesh( divisions ) );
+	op->copyParameter()->setTypedValue( false );
+	return runTimeCast<MeshPrimitive>( op->operate() );
+}
+
+class MeshPrimitiveEvaluatorBuild : public Benchmark
+{
+
+	public :
+
+		MeshPrimitiveEvaluatorBuild( const Options &options )
+			:	Benchmark( "MeshPrimitiveEvaluator.build", "triangles" ),
+				m_divisions( (int)options.scaled( 500 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			m_mesh = generateTriangulatedMesh( m_divisions );
+		}
+
+		virtual void run()
+		{
+			MeshPrimitiveEvaluatorPtr evaluator = new MeshPrimitiveEvaluator( m_mesh );
+		}
+
+		virtual void tearDown()
+		{
+			m_mesh = 0;
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_mesh->numFaces();
+		}
+
+		virtual bool threaded() const
+		{
+			return false;
+		}
+
+	private :
+
+		int m_divisions;
+		MeshPrimitivePtr m_mesh;
+
+};
+
+class MeshPrimitiveEvaluatorClosestPoint : public Benchmark
+{
+
+	public :
+
+		MeshPrimitiveEvaluatorClosestPoint( const Options &options )
+			:	Benchmark( "MeshPrimitiveEvaluator.closestPoint", "queries" ),
+				m_divisions( (int)options.scaled( 500 ) ), m_numQueries( options.scaled( 1000000 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			m_evaluator = new MeshPrimitiveEvaluator( generateTriangulatedMesh( m_divisions ) );
+			m_queries = generatePoints( m_numQueries, Box3f( V3f( -2 ), V3f( 2 ) ) );
+		}
+
+		virtual void run()
+		{
+			ClosestPoint closestPoint( m_evaluator.get(), m_queries->readable() );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_numQueries ), closestPoint );
+		}
+
+		virtual void tearDown()
+		{
+			m_evaluator = 0;
+			m_queries = 0;
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numQueries;
+		}
+
+	private :
+
+		class ClosestPoint
+		{
+
+			public :
+
+				ClosestPoint( const MeshPrimitiveEvaluator *evaluator, const std::vector<V3f> &queries )
+					:	m_evaluator( evaluator ), m_queries( queries )
+				{
+				}
+
+				void operator()( const tbb::blocked_range<size_t> &range ) const
+				{
+					PrimitiveEvaluator::ResultPtr result = m_evaluator->createResult();
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						m_evaluator->closestPoint( m_queries[i], result.get() );
+					}
+				}
+
+			private :
+
+				const MeshPrimitiveEvaluator *m_evaluator;
+				const std::vector<V3f> &m_queries;
+
+		};
+
+		int m_divisions;
+		size_t m_numQueries;
+		MeshPrimitiveEvaluatorPtr m_evaluator;
+		V3fVectorDataPtr m_queries;
+
+};
+
+// Measures ray tracing throughput, either using the batch intersectRays()
+// method, or using intersectionPoint() for each ray in parallel, so the two
+// can be compared. Coherent rays are arranged as if from a camera looking
+// at the mesh, and incoherent rays have random origins and directions.
+class MeshPrimitiveEvaluatorIntersect : public Benchmark
+{
+
+	public :
+
+		MeshPrimitiveEvaluatorIntersect( const std::string &name, const Options &options, bool batch, bool coherent )
+			:	Benchmark( name, "rays" ),
+				m_divisions( (int)options.scaled( 500 ) ), m_numRays( options.scaled( 1000000 ) ),
+				m_batch( batch ), m_coherent( coherent )
+		{
+		}
+
+		virtual void setUp()
+		{
+			m_evaluator = new MeshPrimitiveEvaluator( generateTriangulatedMesh( m_divisions ) );
+
+			m_origins.resize( m_numRays );
+			m_directions.resize( m_numRays );
+			if( m_coherent )
+			{
+				const size_t width = std::max( (size_t)1, (size_t)sqrt( (double)m_numRays ) );
+				for( size_t i = 0; i < m_numRays; ++i )
+				{
+					const V2f ndc( (float)( i % width ) / (float)width, (float)( i / width ) / (float)width );
+					m_origins[i] = V3f( 0, 0, 5 );
+					m_directions[i] = V3f( ndc.x - 0.5f, ndc.y - 0.5f, -2.0f );
+				}
+			}
+			else
+			{
+				Rand48 r( 0 );
+				for( size_t i = 0; i < m_numRays; ++i )
+				{
+					m_origins[i] = hollowSphereRand<V3f>( r ) * 3.0f;
+					m_directions[i] = hollowSphereRand<V3f>( r );
+				}
+			}
+		}
+
+		virtual void run()
+		{
+			if( m_batch )
+			{
+				m_evaluator->intersectRays( m_origins, m_directions, m_distances, m_triangleIndices, m_barycentricCoordinates );
+			}
+			else
+			{
+				IntersectionPoint intersectionPoint( m_evaluator.get(), m_origins, m_directions );
+				tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_numRays ), intersectionPoint );
+			}
+		}
+
+		virtual void tearDown()
+		{
+			m_evaluator = 0;
+			std::vector<V3f>().swap( m_origins );
+			std::vector<V3f>().swap( m_directions );
+			std::vector<float>().swap( m_distances );
+			std::vector<int>().swap( m_triangleIndices );
+			std::vector<V3f>().swap( m_barycentricCoordinates );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numRays;
+		}
+
+	private :
+
+		class IntersectionPoint
+		{
+
+			public :
+
+				IntersectionPoint( const MeshPrimitiveEvaluator *evaluator, const std::vector<V3f> &origins, const std::vector<V3f> &directions )
+					:	m_evaluator( evaluator ), m_origins( origins ), m_directions( directions )
+				{
+				}
+
+				void operator()( const tbb::blocked_range<size_t> &range ) const
+				{
+					PrimitiveEvaluator::ResultPtr result = m_evaluator->createResult();
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						m_evaluator->intersectionPoint( m_origins[i], m_directions[i], result.get() );
+					}
+				}
+
+			private :
+
+				const MeshPrimitiveEvaluator *m_evaluator;
+				const std::vector<V3f> &m_origins;
+				const std::vector<V3f> &m_directions;
+
+		};
+
+		int m_divisions;
+		size_t m_numRays;
+		bool m_batch;
+		bool m_coherent;
+
+		MeshPrimitiveEvaluatorPtr m_evaluator;
+		std::vector<V3f> m_origins;
+		std::vector<V3f> m_directions;
+
+		std::vector<float> m_distances;
+		std::vector<int> m_triangleIndices;
+		std::vector<V3f> m_barycentricCoordinates;
+
+};
+
+} // namespace
+
+void IECoreBenchmark::addMeshPrimitiveEvaluatorBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	suite.push_back( BenchmarkPtr( new MeshPrimitiveEvaluatorBuild( options ) ) );
+	suite.push_back( BenchmarkPtr( new MeshPrimitiveEvaluatorClosestPoint( options ) ) );
+	suite.push_back( BenchmarkPtr( new MeshPrimitiveEvaluatorIntersect( "MeshPrimitiveEvaluator.intersectRays.coherent", options, true, true ) ) );
+	suite.push_back( BenchmarkPtr( new MeshPrimitiveEvaluatorIntersect( "MeshPrimitiveEvaluator.intersectRays.incoherent", options, true, false ) ) );
+	suite.push_back( BenchmarkPtr( new MeshPrimitiveEvaluatorIntersect( "MeshPrimitiveEvaluator.intersectionPoint.coherent", options, false, true ) ) );
+	suite.push_back( BenchmarkPtr( new MeshPrimitiveEvaluatorIntersect( "MeshPrimitiveEvaluator.intersectionPoint.incoherent", options, false, false ) ) );
+}
@@ -0,0 +1,167 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "IECore/NoiseAlgo.h"
+
+#include "Generators.h"
+#include "NoiseBenchmark.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreBenchmark;
+
+namespace
+{
+
+// Evaluates PerlinNoiseV3fV3f for many points, either one point
+// at a time or using the batch form of noise().
+class PerlinNoiseEvaluate : public Benchmark
+{
+
+	public :
+
+		PerlinNoiseEvaluate( const std::string &name, const Options &options, bool batch )
+			:	Benchmark( name, "points" ), m_numPoints( options.scaled( 1000000 ) ), m_batch( batch )
+		{
+		}
+
+		virtual void setUp()
+		{
+			m_points = generatePoints( m_numPoints, Box3f( V3f( -10 ), V3f( 10 ) ) );
+			m_result.resize( m_numPoints );
+		}
+
+		virtual void run()
+		{
+			const std::vector<V3f> &p = m_points->readable();
+			if( m_batch )
+			{
+				m_noise.noise( &p[0], &m_result[0], m_numPoints );
+			}
+			else
+			{
+				for( size_t i = 0; i < m_numPoints; ++i )
+				{
+					m_result[i] = m_noise.noise( p[i] );
+				}
+			}
+		}
+
+		virtual void tearDown()
+		{
+			m_points = 0;
+			std::vector<V3f>().swap( m_result );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numPoints;
+		}
+
+		virtual bool threaded() const
+		{
+			return false;
+		}
+
+	private :
+
+		size_t m_numPoints;
+		bool m_batch;
+		PerlinNoiseV3fV3f m_noise;
+		V3fVectorDataPtr m_points;
+		std::vector<V3f> m_result;
+
+};
+
+// Displaces points in parallel using NoiseAlgo::displace(), with
+// either noise or turbulence.
+class NoiseAlgoDisplace : public Benchmark
+{
+
+	public :
+
+		NoiseAlgoDisplace( const std::string &name, const Options &options, bool turbulence )
+			:	Benchmark( name, "points" ), m_numPoints( options.scaled( 1000000 ) ), m_useTurbulence( turbulence )
+		{
+		}
+
+		virtual void setUp()
+		{
+			m_points = generatePoints( m_numPoints, Box3f( V3f( -10 ), V3f( 10 ) ) );
+		}
+
+		virtual void run()
+		{
+			// the displacement is small, so repeated runs
+			// don't change the distribution of the points much.
+			if( m_useTurbulence )
+			{
+				NoiseAlgo::displace( m_points.get(), m_turbulence, 1.0f, V3f( 1e-3f ) );
+			}
+			else
+			{
+				NoiseAlgo::displace( m_points.get(), m_noise, 1.0f, V3f( 1e-3f ) );
+			}
+		}
+
+		virtual void tearDown()
+		{
+			m_points = 0;
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numPoints;
+		}
+
+	private :
+
+		size_t m_numPoints;
+		bool m_useTurbulence;
+		PerlinNoiseV3fV3f m_noise;
+		TurbulenceV3fV3f m_turbulence;
+		V3fVectorDataPtr m_points;
+
+};
+
+} // namespace
+
+void IECoreBenchmark::addNoiseBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	suite.push_back( BenchmarkPtr( new PerlinNoiseEvaluate( "PerlinNoise.noise", options, false ) ) );
+	suite.push_back( BenchmarkPtr( new PerlinNoiseEvaluate( "PerlinNoise.noiseBatch", options, true ) ) );
+	suite.push_back( BenchmarkPtr( new NoiseAlgoDisplace( "NoiseAlgo.displaceNoise", options, false ) ) );
+	suite.push_back( BenchmarkPtr( new NoiseAlgoDisplace( "NoiseAlgo.displaceTurbulence", options, true ) ) );
+}
@@ -0,0 +1,208 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/filesystem.hpp"
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/atomic.h"
+
+#include "IECore/SceneCache.h"
+
+#include "Generators.h"
+#include "SceneCacheBenchmark.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreBenchmark;
+
+namespace
+{
+
+const int g_depth = 4;
+
+size_t numLocations( int depth, int branching )
+{
+	size_t result = 0;
+	size_t numAtLevel = 1;
+	for( int d = 0; d < depth; ++d )
+	{
+		numAtLevel *= branching;
+		result += numAtLevel;
+	}
+	return result;
+}
+
+class SceneCacheWrite : public Benchmark
+{
+
+	public :
+
+		SceneCacheWrite( const Options &options )
+			:	Benchmark( "SceneCache.write", "locations" ),
+				m_fileName( options.dataFileName( "sceneCacheWrite.scc" ) ),
+				m_branching( (int)options.scaled( 8 ) ), m_meshDivisions( (int)options.scaled( 20 ) )
+		{
+		}
+
+		virtual void run()
+		{
+			generateSceneCache( m_fileName, g_depth, m_branching, m_meshDivisions );
+		}
+
+		virtual void tearDown()
+		{
+			boost::filesystem::remove( m_fileName );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return numLocations( g_depth, m_branching );
+		}
+
+		virtual bool threaded() const
+		{
+			return false;
+		}
+
+	private :
+
+		std::string m_fileName;
+		int m_branching;
+		int m_meshDivisions;
+
+};
+
+// Traverses the whole hierarchy in parallel, reading the bound and
+// transform at every location and the object wherever there is one.
+class SceneCacheRead : public Benchmark
+{
+
+	public :
+
+		SceneCacheRead( const Options &options )
+			:	Benchmark( "SceneCache.read", "locations" ),
+				m_fileName( options.dataFileName( "sceneCacheRead.scc" ) ),
+				m_branching( (int)options.scaled( 8 ) ), m_meshDivisions( (int)options.scaled( 20 ) )
+		{
+		}
+
+		virtual void setUp()
+		{
+			generateSceneCache( m_fileName, g_depth, m_branching, m_meshDivisions );
+		}
+
+		virtual void run()
+		{
+			// a new SceneCache each time, so we don't benefit
+			// from the caching done by the last run.
+			ConstSceneInterfacePtr root = new SceneCache( m_fileName, IndexedIO::Read );
+			tbb::atomic<size_t> locationCount;
+			locationCount = 0;
+			readLocation( root.get(), locationCount );
+			if( locationCount != numLocations( g_depth, m_branching ) )
+			{
+				throw Exception( "Unexpected location count" );
+			}
+		}
+
+		virtual void tearDown()
+		{
+			boost::filesystem::remove( m_fileName );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return numLocations( g_depth, m_branching );
+		}
+
+	private :
+
+		static void readLocation( const SceneInterface *location, tbb::atomic<size_t> &locationCount )
+		{
+			location->readBound( 0.0 );
+			if( location->hasObject() )
+			{
+				location->readObject( 0.0 );
+			}
+
+			SceneInterface::NameList childNames;
+			location->childNames( childNames );
+			ReadChildren readChildren( location, childNames, locationCount );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, childNames.size() ), readChildren );
+		}
+
+		class ReadChildren
+		{
+
+			public :
+
+				ReadChildren( const SceneInterface *parent, const SceneInterface::NameList &childNames, tbb::atomic<size_t> &locationCount )
+					:	m_parent( parent ), m_childNames( childNames ), m_locationCount( locationCount )
+				{
+				}
+
+				void operator()( const tbb::blocked_range<size_t> &range ) const
+				{
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						ConstSceneInterfacePtr child = m_parent->child( m_childNames[i] );
+						child->readTransformAsMatrix( 0.0 );
+						m_locationCount++;
+						readLocation( child.get(), m_locationCount );
+					}
+				}
+
+			private :
+
+				const SceneInterface *m_parent;
+				const SceneInterface::NameList &m_childNames;
+				tbb::atomic<size_t> &m_locationCount;
+
+		};
+
+		std::string m_fileName;
+		int m_branching;
+		int m_meshDivisions;
+
+};
+
+} // namespace
+
+void IECoreBenchmark::addSceneCacheBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	suite.push_back( BenchmarkPtr( new SceneCacheWrite( options ) ) );
+	suite.push_back( BenchmarkPtr( new SceneCacheRead( options ) ) );
+}
@@ -0,0 +1,141 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+## Compares the JSON results written by IECoreBenchmark with those from
+# a stored baseline, printing the change in time for each benchmark and
+# flagging those which have slowed down by more than a threshold. Exits
+# with a non-zero status if any regressions are found, if any baseline
+# results are missing from the current results, or if the two runs used
+# different scales or hardware, so it may be used in automated testing.
+# Baseline results which the current run didn't attempt, because of its
+# -filter or -threads arguments, are reported as skipped rather than missing.
+#
+# Usage : compareResults.py [-threshold 0.1] baseline.json current.json
+
+import sys
+import json
+
+def load( fileName ) :
+
+	with open( fileName ) as f :
+		document = json.load( f )
+
+	document["results"] = dict(
+		( ( r["name"], r["threads"] ), r ) for r in document["results"]
+	)
+
+	return document
+
+def compare( baseline, current, threshold ) :
+
+	regressions = []
+	missing = []
+
+	# Results written before the filter and thread counts were recorded
+	# can only be assumed to have used the thread counts they contain.
+	currentFilter = current.get( "filter", "" )
+	currentThreadCounts = set( current.get( "threadCounts", [ k[1] for k in current["results"].keys() ] ) )
+
+	baselineResults = baseline["results"]
+	currentResults = current["results"]
+	for key in sorted( set( baselineResults.keys() ) | set( currentResults.keys() ) ) :
+
+		name, threads = key
+		label = "%s (%d threads)" % ( name, threads )
+
+		if key not in currentResults :
+			if currentFilter not in name or threads not in currentThreadCounts :
+				print( "%-70s skipped" % label )
+			else :
+				print( "%-70s MISSING from current results" % label )
+				missing.append( label )
+			continue
+		elif key not in baselineResults :
+			print( "%-70s new" % label )
+			continue
+
+		# We compare minimum times, because they're the least affected
+		# by noise from other processes.
+		baselineTime = baselineResults[key]["minTime"]
+		currentTime = currentResults[key]["minTime"]
+		change = ( currentTime - baselineTime ) / baselineTime if baselineTime > 0 else 0.0
+
+		status = ""
+		if change > threshold :
+			status = "REGRESSION"
+			regressions.append( label )
+		elif change < -threshold :
+			status = "improvement"
+
+		print( "%-70s %10.6fs -> %10.6fs %+7.1f%% %s" % ( label, baselineTime, currentTime, change * 100, status ) )
+
+	return regressions, missing
+
+def main( args ) :
+
+	threshold = 0.1
+	if len( args ) >= 2 and args[0] == "-threshold" :
+		threshold = float( args[1] )
+		args = args[2:]
+
+	if len( args ) != 2 :
+		sys.stderr.write( "Usage : compareResults.py [-threshold 0.1] baseline.json current.json\n" )
+		return 2
+
+	baseline = load( args[0] )
+	current = load( args[1] )
+
+	# Timings at different scales or from different hardware are
+	# not comparable, so there is no point reporting them.
+	for setting in ( "scale", "hardwareConcurrency" ) :
+		if baseline[setting] != current[setting] :
+			sys.stderr.write( "ERROR : Baseline %s %s does not match current %s %s\n" % ( setting, baseline[setting], setting, current[setting] ) )
+			return 1
+
+	regressions, missing = compare( baseline, current, threshold )
+
+	if regressions :
+		print( "\n%d regression%s exceeding %d%% :\n" % ( len( regressions ), "s" if len( regressions ) > 1 else "", threshold * 100 ) )
+		for r in regressions :
+			print( "  " + r )
+
+	if missing :
+		print( "\n%d result%s missing :\n" % ( len( missing ), "s" if len( missing ) > 1 else "" ) )
+		for m in missing :
+			print( "  " + m )
+
+	return 1 if regressions or missing else 0
+
+if __name__ == "__main__" :
+	sys.exit( main( sys.argv[1:] ) )
@@ -0,0 +1,241 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include "boost/filesystem.hpp"
+#include "boost/format.hpp"
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/atomic.h"
+
+#include "Alembic/AbcGeom/OXform.h"
+#include "Alembic/AbcGeom/OPolyMesh.h"
+#ifdef IECOREALEMBIC_WITH_OGAWA
+#include "Alembic/AbcCoreOgawa/ReadWrite.h"
+#else
+#include "Alembic/AbcCoreHDF5/ReadWrite.h"
+#endif
+
+#include "IECore/Exception.h"
+
+#include "IECoreAlembic/AlembicScene.h"
+
+#include "AlembicSceneBenchmark.h"
+
+using namespace std;
+using namespace IECore;
+using namespace IECoreAlembic;
+using namespace IECoreBenchmark;
+using namespace IECoreAlembicBenchmark;
+
+namespace
+{
+
+const size_t g_numSamples = 10;
+
+// Writes an archive containing numMeshes animated grids, each parented
+// under its own xform. The points are different for every mesh and sample,
+// so that Alembic can't share any of the data between them.
+void generateArchive( const std::string &fileName, size_t numMeshes, int divisions )
+{
+	using namespace Alembic::Abc;
+	using namespace Alembic::AbcGeom;
+
+#ifdef IECOREALEMBIC_WITH_OGAWA
+	OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(), fileName );
+#else
+	OArchive archive( Alembic::AbcCoreHDF5::WriteArchive(), fileName );
+#endif
+
+	const uint32_t timeSamplingIndex = archive.addTimeSampling( TimeSampling( 1.0 / 24.0, 1.0 / 24.0 ) );
+
+	std::vector<int32_t> verticesPerFace( divisions * divisions, 4 );
+	std::vector<int32_t> vertexIds;
+	vertexIds.reserve( divisions * divisions * 4 );
+	for( int y = 0; y < divisions; ++y )
+	{
+		for( int x = 0; x < divisions; ++x )
+		{
+			const int i = y * ( divisions + 1 ) + x;
+			vertexIds.push_back( i );
+			vertexIds.push_back( i + 1 );
+			vertexIds.push_back( i + divisions + 2 );
+			vertexIds.push_back( i + divisions + 1 );
+		}
+	}
+
+	std::vector<Imath::V3f> positions( ( divisions + 1 ) * ( divisions + 1 ) );
+	for( size_t i = 0; i < numMeshes; ++i )
+	{
+		OXform xform( archive.getTop(), boost::str( boost::format( "xform%d" ) % i ) );
+		XformSample xformSample;
+		xformSample.setTranslation( Imath::V3d( i, 0, 0 ) );
+		xform.getSchema().set( xformSample );
+
+		OPolyMesh mesh( xform, "mesh", timeSamplingIndex );
+		for( size_t s = 0; s < g_numSamples; ++s )
+		{
+			for( int y = 0; y <= divisions; ++y )
+			{
+				for( int x = 0; x <= divisions; ++x )
+				{
+					positions[y * ( divisions + 1 ) + x] = Imath::V3f(
+						(float)x / divisions, (float)y / divisions,
+						0.1f * std::sin( (float)( x + y + i + s ) )
+					);
+				}
+			}
+			mesh.getSchema().set(
+				OPolyMeshSchema::Sample( V3fArraySample( positions ), Int32ArraySample( vertexIds ), Int32ArraySample( verticesPerFace ) )
+			);
+		}
+	}
+}
+
+// Traverses the whole hierarchy in parallel, reading the bound and
+// transform at every location and the object at every sample wherever
+// there is one. The number of Ogawa streams determines how many threads
+// can read from the file at once.
+class AlembicSceneRead : public Benchmark
+{
+
+	public :
+
+		AlembicSceneRead( const std::string &name, const Options &options, size_t numStreams )
+			:	Benchmark( name, "locations" ),
+				m_fileName( options.dataFileName( "alembicSceneRead.abc" ) ),
+				m_numMeshes( options.scaled( 64 ) ), m_meshDivisions( (int)options.scaled( 50 ) ),
+				m_numStreams( numStreams )
+		{
+		}
+
+		virtual void setUp()
+		{
+			generateArchive( m_fileName, m_numMeshes, m_meshDivisions );
+		}
+
+		virtual void run()
+		{
+			// a new AlembicScene each time, so we don't benefit
+			// from the caching done by the last run.
+			ConstSceneInterfacePtr root = new AlembicScene( m_fileName, IndexedIO::Read, m_numStreams );
+			tbb::atomic<size_t> locationCount;
+			locationCount = 0;
+			readLocation( root.get(), locationCount );
+			if( locationCount != itemsPerRun() )
+			{
+				throw Exception( "Unexpected location count" );
+			}
+		}
+
+		virtual void tearDown()
+		{
+			boost::filesystem::remove( m_fileName );
+		}
+
+		virtual size_t itemsPerRun() const
+		{
+			return m_numMeshes * 2;
+		}
+
+	private :
+
+		static void readLocation( const SceneInterface *location, tbb::atomic<size_t> &locationCount )
+		{
+			location->readBound( 0.0 );
+			if( location->hasObject() )
+			{
+				for( size_t s = 1; s <= g_numSamples; ++s )
+				{
+					location->readObject( s / 24.0 );
+				}
+			}
+
+			SceneInterface::NameList childNames;
+			location->childNames( childNames );
+			ReadChildren readChildren( location, childNames, locationCount );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, childNames.size() ), readChildren );
+		}
+
+		class ReadChildren
+		{
+
+			public :
+
+				ReadChildren( const SceneInterface *parent, const SceneInterface::NameList &childNames, tbb::atomic<size_t> &locationCount )
+					:	m_parent( parent ), m_childNames( childNames ), m_locationCount( locationCount )
+				{
+				}
+
+				void operator()( const tbb::blocked_range<size_t> &range ) const
+				{
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						ConstSceneInterfacePtr child = m_parent->child( m_childNames[i] );
+						child->readTransformAsMatrix( 0.0 );
+						m_locationCount++;
+						readLocation( child.get(), m_locationCount );
+					}
+				}
+
+			private :
+
+				const SceneInterface *m_parent;
+				const SceneInterface::NameList &m_childNames;
+				tbb::atomic<size_t> &m_locationCount;
+
+		};
+
+		std::string m_fileName;
+		size_t m_numMeshes;
+		int m_meshDivisions;
+		size_t m_numStreams;
+
+};
+
+} // namespace
+
+void IECoreAlembicBenchmark::addAlembicSceneBenchmarks( BenchmarkSuite &suite, const Options &options )
+{
+	suite.push_back( BenchmarkPtr( new AlembicSceneRead( "AlembicScene.read", options, 1 ) ) );
+#ifdef IECOREALEMBIC_WITH_OGAWA
+	// Compared with the above, this shows what is gained by giving each
+	// thread its own stream, at the cost of a file descriptor per stream.
+	const int maxThreads = *std::max_element( options.threadCounts.begin(), options.threadCounts.end() );
+	suite.push_back( BenchmarkPtr( new AlembicSceneRead( "AlembicScene.readMultipleStreams", options, maxThreads ) ) );
+#endif
+}
@@ -62,7 +62,10 @@ class IECOREALEMBIC_API AlembicInput : public IECore::RefCounted
 
 		IE_CORE_DECLAREMEMBERPTR( AlembicInput );
 
-		AlembicInput( const std::string &fileName );
+		/// For Ogawa archives, numStreams specifies the number of file streams
+		/// opened to service reads from multiple threads concurrently. It
+		/// has no effect for HDF5 archives.
+		AlembicInput( const std::string &fileName, size_t numStreams = 1 );
 		virtual ~AlembicInput();
 		
 		//! @name Metadata
@@ -0,0 +1,145 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECOREALEMBIC_ALEMBICSCENE_H
+#define IECOREALEMBIC_ALEMBICSCENE_H
+
+#include "IECore/SceneInterface.h"
+
+#include "IECoreAlembic/Export.h"
+#include "IECoreAlembic/TypeIds.h"
+#include "IECoreAlembic/AlembicInput.h"
+
+namespace IECoreAlembic
+{
+
+IE_CORE_FORWARDDECLARE( AlembicScene )
+
+/// An implementation of the SceneInterface for reading Alembic archives,
+/// allowing them to be used anywhere a SceneCache could be - including as the
+/// target of links in a LinkedScene. Each Alembic object is represented as a
+/// location in the scene - transforms are read from xform objects and objects
+/// are converted from geometry and camera objects using the FromAlembicConverters.
+///
+/// Converted objects and transforms are cached using ComputationCaches shared
+/// between all the locations of a scene, in the same way as for SceneCache.
+/// Bounds are read from those stored in the archive where possible, and are only
+/// computed from the children when they are not available.
+///
+/// Only reading is supported.
+class IECOREALEMBIC_API AlembicScene : public IECore::SceneInterface
+{
+
+	public :
+
+		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( AlembicScene, AlembicSceneTypeId, IECore::SceneInterface );
+
+		/// Opens the archive for reading - the only supported mode is IndexedIO::Read.
+		/// For Ogawa archives, numStreams specifies the number of file streams used
+		/// to service concurrent reads from multiple threads. The default value of 0
+		/// uses defaultNumStreams().
+		AlembicScene( const std::string &fileName, IECore::IndexedIO::OpenMode mode = IECore::IndexedIO::Read, size_t numStreams = 0 );
+		virtual ~AlembicScene();
+
+		/// Returns the number of Ogawa streams used when none is specified
+		/// to the constructor. This is taken from the IECOREALEMBIC_OGAWA_STREAMS
+		/// environment variable if it is set, and is otherwise 1. Each stream
+		/// holds its own file descriptor, so more streams should only be used
+		/// when concurrent reads from a modest number of archives are expected.
+		static size_t defaultNumStreams();
+
+		virtual std::string fileName() const;
+
+		virtual Name name() const;
+		virtual void path( Path &p ) const;
+
+		virtual Imath::Box3d readBound( double time ) const;
+		virtual void writeBound( const Imath::Box3d &bound, double time );
+
+		virtual IECore::ConstDataPtr readTransform( double time ) const;
+		virtual Imath::M44d readTransformAsMatrix( double time ) const;
+		virtual void writeTransform( const IECore::Data *transform, double time );
+
+		virtual bool hasAttribute( const Name &name ) const;
+		virtual void attributeNames( NameList &attrs ) const;
+		virtual IECore::ConstObjectPtr readAttribute( const Name &name, double time ) const;
+		virtual void writeAttribute( const Name &name, const IECore::Object *attribute, double time );
+
+		virtual bool hasTag( const Name &name, int filter = LocalTag ) const;
+		virtual void readTags( NameList &tags, int filter = LocalTag ) const;
+		virtual void writeTags( const NameList &tags );
+
+		virtual bool hasObject() const;
+		virtual IECore::ConstObjectPtr readObject( double time ) const;
+		virtual IECore::PrimitiveVariableMap readObjectPrimitiveVariables( const std::vector<IECore::InternedString> &primVarNames, double time ) const;
+		virtual void writeObject( const IECore::Object *object, double time );
+
+		virtual bool hasChild( const Name &name ) const;
+		virtual void childNames( NameList &childNames ) const;
+		virtual IECore::SceneInterfacePtr child( const Name &name, MissingBehaviour missingBehaviour = ThrowIfMissing );
+		virtual IECore::ConstSceneInterfacePtr child( const Name &name, MissingBehaviour missingBehaviour = ThrowIfMissing ) const;
+		virtual IECore::SceneInterfacePtr createChild( const Name &name );
+		virtual IECore::SceneInterfacePtr scene( const Path &path, MissingBehaviour missingBehaviour = ThrowIfMissing );
+		virtual IECore::ConstSceneInterfacePtr scene( const Path &path, MissingBehaviour missingBehaviour = ThrowIfMissing ) const;
+
+		virtual void hash( HashType hashType, double time, IECore::MurmurHash &h ) const;
+
+	private :
+
+		IE_CORE_FORWARDDECLARE( SharedData );
+
+		AlembicScene( SharedDataPtr sharedData, AlembicInputPtr input, const Path &path );
+
+		void init();
+
+		AlembicScenePtr childInternal( const Name &name, MissingBehaviour missingBehaviour ) const;
+		AlembicScenePtr sceneInternal( const Path &path, MissingBehaviour missingBehaviour ) const;
+
+		// Returns the sample indices and lerp factor for reading at the specified time.
+		double sampleInterval( double time, size_t &floorIndex, size_t &ceilIndex ) const;
+
+		IECore::ConstObjectPtr readObjectAtSample( size_t sampleIndex ) const;
+
+		SharedDataPtr m_sharedData;
+		AlembicInputPtr m_input;
+		Path m_path;
+		size_t m_numSamples;
+		bool m_hasObject;
+
+};
+
+} // namespace IECoreAlembic
+
+#endif // IECOREALEMBIC_ALEMBICSCENE_H
@@ -32,6 +32,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "OpenEXR/ImathBoxAlgo.h"
 
 #include "Alembic/AbcCoreHDF5/ReadWrite.h"
@@ -71,12 +73,13 @@ struct AlembicInput::DataMembers
 	TimeSamplingPtr timeSampling;
 };
 
-AlembicInput::AlembicInput( const std::string &fileName )
+AlembicInput::AlembicInput( const std::string &fileName, size_t numStreams )
 {
 	m_data = boost::shared_ptr<DataMembers>( new DataMembers );
 	
 #ifdef IECOREALEMBIC_WITH_OGAWA
 	Alembic::AbcCoreFactory::IFactory factory;
+	factory.setOgawaNumStreams( std::max( numStreams, (size_t)1 ) );
 	m_data->archive = boost::shared_ptr<IArchive>( new IArchive( factory.getArchive( fileName ) ) );
 	if( !m_data->archive->valid() )
 	{
@@ -0,0 +1,481 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "boost/format.hpp"
+#include "boost/lexical_cast.hpp"
+
+#include "OpenEXR/ImathBoxAlgo.h"
+
+#include "IECore/ComputationCache.h"
+#include "IECore/ObjectInterpolator.h"
+#include "IECore/Primitive.h"
+#include "IECore/SimpleTypedData.h"
+
+#include "IECoreAlembic/AlembicScene.h"
+
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreAlembic;
+
+IE_CORE_DEFINERUNTIMETYPED( AlembicScene );
+
+static SceneInterface::FileFormatDescription<AlembicScene> g_registrar( ".abc", IndexedIO::Read );
+
+//////////////////////////////////////////////////////////////////////////
+// SharedData
+//////////////////////////////////////////////////////////////////////////
+
+// Holds the state shared by all the locations within a scene, including the
+// caches. This lives for as long as any location from the scene is alive.
+class AlembicScene::SharedData : public RefCounted
+{
+
+	public :
+
+		SharedData( const std::string &fileName, AlembicInputPtr root )
+			:	fileName( fileName ),
+				root( root ),
+				objectCache( new ObjectCache( readObject, objectHash, 10000 ) ),
+				transformCache( new TransformCache( readTransform, transformHash, 1000 ) )
+		{
+		}
+
+		// We use the scene in the cache keys, but only to compute the results
+		// and the hashes - the scene is guaranteed to be alive while we do that,
+		// because it is the one making the request.
+		typedef std::pair<const AlembicScene *, size_t> ObjectCacheKey;
+		typedef std::pair<const AlembicScene *, size_t> TransformCacheKey;
+
+		typedef ComputationCache<ObjectCacheKey> ObjectCache;
+		typedef ComputationCache<TransformCacheKey> TransformCache;
+
+		const std::string fileName;
+		AlembicInputPtr root;
+		ObjectCache::Ptr objectCache;
+		TransformCache::Ptr transformCache;
+
+	private :
+
+		static void locationHash( const AlembicScene *scene, MurmurHash &h )
+		{
+			h.append( scene->m_sharedData->fileName );
+			for( Path::const_iterator it = scene->m_path.begin(), eIt = scene->m_path.end(); it != eIt; ++it )
+			{
+				h.append( *it );
+			}
+		}
+
+		static MurmurHash objectHash( const ObjectCacheKey &key )
+		{
+			MurmurHash h;
+			h.append( "object" );
+			locationHash( key.first, h );
+			h.append( (uint64_t)key.second );
+			return h;
+		}
+
+		static ConstObjectPtr readObject( const ObjectCacheKey &key )
+		{
+			return key.first->m_input->objectAtSample( key.second, RenderableTypeId );
+		}
+
+		static MurmurHash transformHash( const TransformCacheKey &key )
+		{
+			MurmurHash h;
+			h.append( "transform" );
+			locationHash( key.first, h );
+			h.append( (uint64_t)key.second );
+			return h;
+		}
+
+		static ConstObjectPtr readTransform( const TransformCacheKey &key )
+		{
+			return new M44dData( key.first->m_input->transformAtSample( key.second ) );
+		}
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// AlembicScene
+//////////////////////////////////////////////////////////////////////////
+
+AlembicScene::AlembicScene( const std::string &fileName, IndexedIO::OpenMode mode, size_t numStreams )
+{
+	if( mode & ( IndexedIO::Write | IndexedIO::Append ) )
+	{
+		throw InvalidArgumentException( "AlembicScene : Only IndexedIO::Read is supported" );
+	}
+
+	m_input = new AlembicInput( fileName, numStreams ? numStreams : defaultNumStreams() );
+	m_sharedData = new SharedData( fileName, m_input );
+	init();
+}
+
+AlembicScene::AlembicScene( SharedDataPtr sharedData, AlembicInputPtr input, const Path &path )
+	:	m_sharedData( sharedData ), m_input( input ), m_path( path )
+{
+	init();
+}
+
+AlembicScene::~AlembicScene()
+{
+}
+
+void AlembicScene::init()
+{
+	m_numSamples = m_input->numSamples();
+	if( m_numSamples )
+	{
+		// AlembicInput computes the time sampling lazily, which isn't
+		// safe if we're being used from multiple threads. Querying it
+		// here makes sure it is initialised before anyone else sees us.
+		m_input->timeAtSample( 0 );
+	}
+
+	// the root of the archive never has an object, and neither do
+	// xforms, whose only conversion is to a transform.
+	m_hasObject = m_path.size() && m_input->converter( RenderableTypeId );
+}
+
+size_t AlembicScene::defaultNumStreams()
+{
+	if( const char *s = getenv( "IECOREALEMBIC_OGAWA_STREAMS" ) )
+	{
+		return std::max( boost::lexical_cast<size_t>( s ), (size_t)1 );
+	}
+	return 1;
+}
+
+std::string AlembicScene::fileName() const
+{
+	return m_sharedData->fileName;
+}
+
+SceneInterface::Name AlembicScene::name() const
+{
+	return m_path.size() ? m_path.back() : rootName;
+}
+
+void AlembicScene::path( Path &p ) const
+{
+	p = m_path;
+}
+
+Imath::Box3d AlembicScene::readBound( double time ) const
+{
+	if( m_input->hasStoredBound() )
+	{
+		return m_input->boundAtTime( time );
+	}
+
+	// No stored bound, so we must compute one from the children. We do
+	// this ourselves rather than leave it to AlembicInput::boundAtTime(),
+	// so that the children's transforms come from our cache, and any
+	// stored bounds further down are used.
+	Box3d result;
+	NameList names;
+	childNames( names );
+	for( NameList::const_iterator it = names.begin(), eIt = names.end(); it != eIt; ++it )
+	{
+		ConstAlembicScenePtr c = childInternal( *it, ThrowIfMissing );
+		const Box3d childBound = c->readBound( time );
+		if( !childBound.isEmpty() )
+		{
+			result.extendBy( Imath::transform( childBound, c->readTransformAsMatrix( time ) ) );
+		}
+	}
+	return result;
+}
+
+void AlembicScene::writeBound( const Imath::Box3d &bound, double time )
+{
+	throw Exception( "AlembicScene::writeBound : Not supported" );
+}
+
+ConstDataPtr AlembicScene::readTransform( double time ) const
+{
+	size_t floorIndex, ceilIndex;
+	sampleInterval( time, floorIndex, ceilIndex );
+	if( floorIndex == ceilIndex )
+	{
+		return boost::static_pointer_cast<const Data>(
+			m_sharedData->transformCache->get( SharedData::TransformCacheKey( this, floorIndex ) )
+		);
+	}
+
+	// AlembicInput interpolates the individual xform ops rather than
+	// the matrices, so we can't build an interpolated transform from
+	// the cached samples. Times between samples are rarely reused
+	// anyway, so we just compute them directly.
+	return new M44dData( m_input->transformAtTime( time ) );
+}
+
+Imath::M44d AlembicScene::readTransformAsMatrix( double time ) const
+{
+	return boost::static_pointer_cast<const M44dData>( readTransform( time ) )->readable();
+}
+
+void AlembicScene::writeTransform( const Data *transform, double time )
+{
+	throw Exception( "AlembicScene::writeTransform : Not supported" );
+}
+
+bool AlembicScene::hasAttribute( const Name &name ) const
+{
+	return false;
+}
+
+void AlembicScene::attributeNames( NameList &attrs ) const
+{
+	attrs.clear();
+}
+
+ConstObjectPtr AlembicScene::readAttribute( const Name &name, double time ) const
+{
+	throw Exception( boost::str( boost::format( "AlembicScene::readAttribute : No attribute named \"%s\"" ) % name.value() ) );
+}
+
+void AlembicScene::writeAttribute( const Name &name, const Object *attribute, double time )
+{
+	throw Exception( "AlembicScene::writeAttribute : Not supported" );
+}
+
+bool AlembicScene::hasTag( const Name &name, int filter ) const
+{
+	return false;
+}
+
+void AlembicScene::readTags( NameList &tags, int filter ) const
+{
+	tags.clear();
+}
+
+void AlembicScene::writeTags( const NameList &tags )
+{
+	throw Exception( "AlembicScene::writeTags : Not supported" );
+}
+
+bool AlembicScene::hasObject() const
+{
+	return m_hasObject;
+}
+
+ConstObjectPtr AlembicScene::readObject( double time ) const
+{
+	if( !m_hasObject )
+	{
+		return 0;
+	}
+
+	size_t floorIndex, ceilIndex;
+	const double lerpFactor = sampleInterval( time, floorIndex, ceilIndex );
+
+	ConstObjectPtr floorObject = readObjectAtSample( floorIndex );
+	if( floorIndex == ceilIndex )
+	{
+		return floorObject;
+	}
+
+	ConstObjectPtr ceilObject = readObjectAtSample( ceilIndex );
+	ObjectPtr result = linearObjectInterpolation( floorObject.get(), ceilObject.get(), lerpFactor );
+	if( !result )
+	{
+		// not interpolable
+		return lerpFactor < 0.5 ? floorObject : ceilObject;
+	}
+	return result;
+}
+
+PrimitiveVariableMap AlembicScene::readObjectPrimitiveVariables( const std::vector<InternedString> &primVarNames, double time ) const
+{
+	ConstPrimitivePtr primitive = runTimeCast<const Primitive>( readObject( time ) );
+	if( !primitive )
+	{
+		throw Exception( "AlembicScene::readObjectPrimitiveVariables : Object is not a Primitive" );
+	}
+
+	PrimitiveVariableMap result;
+	for( std::vector<InternedString>::const_iterator it = primVarNames.begin(), eIt = primVarNames.end(); it != eIt; ++it )
+	{
+		PrimitiveVariableMap::const_iterator pIt = primitive->variables.find( *it );
+		if( pIt != primitive->variables.end() )
+		{
+			result.insert( *pIt );
+		}
+	}
+	return result;
+}
+
+void AlembicScene::writeObject( const Object *object, double time )
+{
+	throw Exception( "AlembicScene::writeObject : Not supported" );
+}
+
+bool AlembicScene::hasChild( const Name &name ) const
+{
+	NameList names;
+	childNames( names );
+	return std::find( names.begin(), names.end(), name ) != names.end();
+}
+
+void AlembicScene::childNames( NameList &childNames ) const
+{
+	ConstStringVectorDataPtr names = m_input->childNames();
+	childNames.clear();
+	childNames.insert( childNames.end(), names->readable().begin(), names->readable().end() );
+}
+
+SceneInterfacePtr AlembicScene::child( const Name &name, MissingBehaviour missingBehaviour )
+{
+	return childInternal( name, missingBehaviour );
+}
+
+ConstSceneInterfacePtr AlembicScene::child( const Name &name, MissingBehaviour missingBehaviour ) const
+{
+	return childInternal( name, missingBehaviour );
+}
+
+SceneInterfacePtr AlembicScene::createChild( const Name &name )
+{
+	throw Exception( "AlembicScene::createChild : Not supported" );
+}
+
+SceneInterfacePtr AlembicScene::scene( const Path &path, MissingBehaviour missingBehaviour )
+{
+	return sceneInternal( path, missingBehaviour );
+}
+
+ConstSceneInterfacePtr AlembicScene::scene( const Path &path, MissingBehaviour missingBehaviour ) const
+{
+	return sceneInternal( path, missingBehaviour );
+}
+
+void AlembicScene::hash( HashType hashType, double time, MurmurHash &h ) const
+{
+	SceneInterface::hash( hashType, time, h );
+
+	h.append( m_sharedData->fileName );
+	for( Path::const_iterator it = m_path.begin(), eIt = m_path.end(); it != eIt; ++it )
+	{
+		h.append( *it );
+	}
+	h.append( (int)hashType );
+
+	switch( hashType )
+	{
+		case TransformHash :
+		case ObjectHash :
+			{
+				// hash the samples rather than the time, so that
+				// static locations have the same hash at all times.
+				size_t floorIndex, ceilIndex;
+				h.append( sampleInterval( time, floorIndex, ceilIndex ) );
+				h.append( (uint64_t)floorIndex );
+				h.append( (uint64_t)ceilIndex );
+			}
+			break;
+		case BoundHash :
+			if( m_input->hasStoredBound() )
+			{
+				size_t floorIndex, ceilIndex;
+				h.append( sampleInterval( time, floorIndex, ceilIndex ) );
+				h.append( (uint64_t)floorIndex );
+				h.append( (uint64_t)ceilIndex );
+			}
+			else
+			{
+				h.append( time );
+			}
+			break;
+		case HierarchyHash :
+			h.append( time );
+			break;
+		case AttributesHash :
+		case ChildNamesHash :
+			break;
+	}
+}
+
+AlembicScenePtr AlembicScene::childInternal( const Name &name, MissingBehaviour missingBehaviour ) const
+{
+	if( !hasChild( name ) )
+	{
+		switch( missingBehaviour )
+		{
+			case NullIfMissing :
+				return 0;
+			case CreateIfMissing :
+				throw Exception( "AlembicScene::child : CreateIfMissing is not supported" );
+			default :
+				throw Exception( boost::str( boost::format( "AlembicScene::child : No child named \"%s\"" ) % name.value() ) );
+		}
+	}
+
+	Path childPath = m_path;
+	childPath.push_back( name );
+	return new AlembicScene( m_sharedData, m_input->child( name.value() ), childPath );
+}
+
+AlembicScenePtr AlembicScene::sceneInternal( const Path &path, MissingBehaviour missingBehaviour ) const
+{
+	AlembicScenePtr result = new AlembicScene( m_sharedData, m_sharedData->root, Path() );
+	for( Path::const_iterator it = path.begin(), eIt = path.end(); it != eIt; ++it )
+	{
+		result = result->childInternal( *it, missingBehaviour );
+		if( !result )
+		{
+			return 0;
+		}
+	}
+	return result;
+}
+
+double AlembicScene::sampleInterval( double time, size_t &floorIndex, size_t &ceilIndex ) const
+{
+	if( !m_numSamples )
+	{
+		floorIndex = ceilIndex = 0;
+		return 0.0;
+	}
+	return m_input->sampleIntervalAtTime( time, floorIndex, ceilIndex );
+}
+
+ConstObjectPtr AlembicScene::readObjectAtSample( size_t sampleIndex ) const
+{
+	return m_sharedData->objectCache->get( SharedData::ObjectCacheKey( this, sampleIndex ) );
+}
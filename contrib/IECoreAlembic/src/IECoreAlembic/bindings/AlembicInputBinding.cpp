@@ -70,7 +70,7 @@ static tuple sampleIntervalAtTime( AlembicInput *a, double time )
 void IECoreAlembicBindings::bindAlembicInput()
 {
 	IECorePython::RefCountedClass<AlembicInput, IECore::RefCounted>( "AlembicInput" )
-		.def( init<const std::string &>() )
+		.def( init<const std::string &, size_t>( ( arg( "fileName" ), arg( "numStreams" ) = 1 ) ) )
 		.def( "name", &AlembicInput::name, return_value_policy<copy_const_reference>() )
 		.def( "fullName", &AlembicInput::fullName, return_value_policy<copy_const_reference>() )
 		.def( "metaData", &AlembicInput::metaData )
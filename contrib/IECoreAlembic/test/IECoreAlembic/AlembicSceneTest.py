@@ -0,0 +1,215 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import os
+import threading
+import unittest
+
+import IECore
+import IECoreAlembic
+
+class AlembicSceneTest( unittest.TestCase ) :
+
+	def testConstructor( self ) :
+
+		self.assertRaises( Exception, IECoreAlembic.AlembicScene, "iDontExist.abc" )
+		self.assertRaises( Exception, IECoreAlembic.AlembicScene, os.path.dirname( __file__ ) + "/data/cube.abc", IECore.IndexedIO.OpenMode.Write )
+
+		s = IECoreAlembic.AlembicScene( os.path.dirname( __file__ ) + "/data/cube.abc" )
+		self.failUnless( isinstance( s, IECore.SceneInterface ) )
+		self.assertEqual( s.fileName(), os.path.dirname( __file__ ) + "/data/cube.abc" )
+
+		s = IECoreAlembic.AlembicScene( os.path.dirname( __file__ ) + "/data/cube.abc", numStreams = 4 )
+		self.assertEqual( s.childNames(), [ "group1" ] )
+
+		if "IECOREALEMBIC_OGAWA_STREAMS" not in os.environ :
+			self.assertEqual( IECoreAlembic.AlembicScene.defaultNumStreams(), 1 )
+		else :
+			self.failUnless( IECoreAlembic.AlembicScene.defaultNumStreams() > 0 )
+
+	def testCreate( self ) :
+
+		s = IECore.SceneInterface.create( os.path.dirname( __file__ ) + "/data/cube.abc", IECore.IndexedIO.OpenMode.Read )
+		self.failUnless( isinstance( s, IECoreAlembic.AlembicScene ) )
+
+	def testHierarchy( self ) :
+
+		s = IECoreAlembic.AlembicScene( os.path.dirname( __file__ ) + "/data/cube.abc" )
+		self.assertEqual( s.name(), "/" )
+		self.assertEqual( s.path(), [] )
+		self.assertEqual( s.childNames(), [ "group1" ] )
+		self.failUnless( s.hasChild( "group1" ) )
+		self.failIf( s.hasChild( "iDontExist" ) )
+
+		g = s.child( "group1" )
+		self.assertEqual( g.name(), "group1" )
+		self.assertEqual( g.path(), [ "group1" ] )
+		self.assertEqual( g.childNames(), [ "pCube1" ] )
+
+		c = g.child( "pCube1" )
+		self.assertEqual( c.path(), [ "group1", "pCube1" ] )
+		self.assertEqual( c.childNames(), [ "pCubeShape1" ] )
+
+		cs = s.scene( [ "group1", "pCube1", "pCubeShape1" ] )
+		self.assertEqual( cs.name(), "pCubeShape1" )
+		self.assertEqual( cs.childNames(), [] )
+
+		self.assertEqual( s.child( "iDontExist", IECore.SceneInterface.MissingBehaviour.NullIfMissing ), None )
+		self.assertRaises( Exception, s.child, "iDontExist" )
+		self.assertEqual( s.scene( [ "group1", "iDontExist" ], IECore.SceneInterface.MissingBehaviour.NullIfMissing ), None )
+		self.assertRaises( Exception, s.createChild, "newChild" )
+
+	def testObject( self ) :
+
+		s = IECoreAlembic.AlembicScene( os.path.dirname( __file__ ) + "/data/cube.abc" )
+		self.failIf( s.hasObject() )
+		self.failIf( s.child( "group1" ).hasObject() )
+		self.failIf( s.scene( [ "group1", "pCube1" ] ).hasObject() )
+
+		cs = s.scene( [ "group1", "pCube1", "pCubeShape1" ] )
+		self.failUnless( cs.hasObject() )
+		m = cs.readObject( 0 )
+		self.failUnless( isinstance( m, IECore.MeshPrimitive ) )
+
+		# reads are cached
+		self.failUnless( cs.readObject( 0 ).isSame( m ) )
+
+		v = cs.readObjectPrimitiveVariables( [ "P" ], 0 )
+		self.assertEqual( v.keys(), [ "P" ] )
+		self.assertEqual( v["P"].data, m["P"].data )
+
+	def testTransform( self ) :
+
+		s = IECoreAlembic.AlembicScene( os.path.dirname( __file__ ) + "/data/cube.abc" )
+		self.assertEqual( s.readTransformAsMatrix( 0 ), IECore.M44d() )
+
+		g = s.child( "group1" )
+		self.assertEqual( g.readTransformAsMatrix( 0 ), IECore.M44d.createScaled( IECore.V3d( 2 ) ) * IECore.M44d.createTranslated( IECore.V3d( 2, 0, 0 ) ) )
+		self.assertEqual( g.readTransform( 0 ), IECore.M44dData( g.readTransformAsMatrix( 0 ) ) )
+
+		c = g.child( "pCube1" )
+		self.assertEqual( c.readTransformAsMatrix( 0 ), IECore.M44d.createTranslated( IECore.V3d( -1, 0, 0 ) ) )
+
+	def testBound( self ) :
+
+		s = IECoreAlembic.AlembicScene( os.path.dirname( __file__ ) + "/data/cube.abc" )
+		self.assertEqual( s.readBound( 0 ), IECore.Box3d( IECore.V3d( -2 ), IECore.V3d( 2 ) ) )
+
+		cs = s.scene( [ "group1", "pCube1", "pCubeShape1" ] )
+		self.assertEqual( cs.readBound( 0 ), IECore.Box3d( IECore.V3d( -1 ), IECore.V3d( 1 ) ) )
+
+	def testComputedBound( self ) :
+
+		a = IECoreAlembic.AlembicInput( os.path.dirname( __file__ ) + "/data/noTopLevelStoredBounds.abc" )
+		s = IECoreAlembic.AlembicScene( os.path.dirname( __file__ ) + "/data/noTopLevelStoredBounds.abc" )
+		self.failIf( a.hasStoredBound() )
+		self.assertEqual( s.readBound( 0 ), a.boundAtSample( 0 ) )
+
+	def testAnimation( self ) :
+
+		a = IECoreAlembic.AlembicInput( os.path.dirname( __file__ ) + "/data/animatedCube.abc" )
+		s = IECoreAlembic.AlembicScene( os.path.dirname( __file__ ) + "/data/animatedCube.abc" )
+
+		t = s.child( "pCube1" )
+		ta = a.child( "pCube1" )
+		m = t.child( "pCubeShape1" )
+		ma = ta.child( "pCubeShape1" )
+
+		for i in range( 0, ta.numSamples() ) :
+
+			time = ta.timeAtSample( i )
+			self.assertEqual( t.readTransformAsMatrix( time ), ta.transformAtSample( i ) )
+			self.assertEqual( m.readObject( time ), ma.objectAtSample( i, IECore.MeshPrimitive.staticTypeId() ) )
+
+			if i < ta.numSamples() - 1 :
+				time += 1 / 48.0
+				self.assertEqual( t.readTransformAsMatrix( time ), ta.transformAtTime( time ) )
+				self.assertEqual(
+					m.readObject( time )["P"].data,
+					IECore.linearObjectInterpolation(
+						ma.objectAtSample( i, IECore.MeshPrimitive.staticTypeId() )["P"].data,
+						ma.objectAtSample( i + 1, IECore.MeshPrimitive.staticTypeId() )["P"].data,
+						0.5
+					)
+				)
+
+	def testHash( self ) :
+
+		s = IECoreAlembic.AlembicScene( os.path.dirname( __file__ ) + "/data/animatedCube.abc" )
+
+		# persp has a single sample, so its hashes shouldn't vary with time
+		p = s.child( "persp" )
+		self.assertEqual( p.hash( IECore.SceneInterface.HashType.TransformHash, 0 ), p.hash( IECore.SceneInterface.HashType.TransformHash, 1 ) )
+		self.assertEqual( p.hash( IECore.SceneInterface.HashType.ObjectHash, 0 ), p.hash( IECore.SceneInterface.HashType.ObjectHash, 1 ) )
+		# and its transform should be cached once, rather than once per time
+		self.assertTrue( p.readTransform( 0 ).isSame( p.readTransform( 1 ) ) )
+
+		# but pCube1 is animated
+		t = s.child( "pCube1" )
+		self.assertNotEqual( t.hash( IECore.SceneInterface.HashType.TransformHash, 1 / 24.0 ), t.hash( IECore.SceneInterface.HashType.TransformHash, 2 / 24.0 ) )
+		self.assertNotEqual( t.hash( IECore.SceneInterface.HashType.TransformHash, 1 / 24.0 ), p.hash( IECore.SceneInterface.HashType.TransformHash, 1 / 24.0 ) )
+
+	def testThreadedReads( self ) :
+
+		for numStreams in ( 1, 4 ) :
+			self.__testThreadedReads( numStreams )
+
+	def __testThreadedReads( self, numStreams ) :
+
+		s = IECoreAlembic.AlembicScene( os.path.dirname( __file__ ) + "/data/animatedCube.abc", numStreams = numStreams )
+		a = IECoreAlembic.AlembicInput( os.path.dirname( __file__ ) + "/data/animatedCube.abc" )
+		expected = [ a.child( "pCube1" ).child( "pCubeShape1" ).objectAtSample( i, IECore.MeshPrimitive.staticTypeId() ) for i in range( 0, 10 ) ]
+
+		errors = []
+		def read( threadIndex ) :
+			try :
+				m = s.scene( [ "pCube1", "pCubeShape1" ] )
+				for i in range( 0, 10 ) :
+					sample = ( i + threadIndex ) % 10
+					if m.readObject( ( sample + 1 ) / 24.0 ) != expected[sample] :
+						errors.append( "Unexpected object for sample %d" % sample )
+			except Exception, e :
+				errors.append( str( e ) )
+
+		threads = [ threading.Thread( target = read, args = ( i, ) ) for i in range( 0, 8 ) ]
+		for t in threads :
+			t.start()
+		for t in threads :
+			t.join()
+
+		self.assertEqual( errors, [], "numStreams = %d" % numStreams )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -35,27 +35,45 @@
 #ifndef IECOREAPPLESEED_BATCHPRIMITIVECONVERTER_H
 #define IECOREAPPLESEED_BATCHPRIMITIVECONVERTER_H
 
+#include <set>
+
 #include "boost/filesystem/path.hpp"
 
+#include "tbb/task_group.h"
+
 #include "IECoreAppleseed/private/PrimitiveConverter.h"
 
 namespace IECoreAppleseed
 {
 
 /// A PrimitiveConverter subclass that writes primitives to geometry files.
+/// Primitives are converted immediately, but the files are written in
+/// parallel by background tasks, and waitForDeferredConversions() must be
+/// called before the project is rendered.
 class BatchPrimitiveConverter : public PrimitiveConverter
 {
 	public :
 
 		BatchPrimitiveConverter( const boost::filesystem::path &projectPath, const foundation::SearchPaths &searchPaths );
 
+		virtual ~BatchPrimitiveConverter();
+
 		virtual void setOption( const std::string &name, IECore::ConstDataPtr value );
 
+		virtual void waitForDeferredConversions();
+
 	private :
 
+		class MeshWriter;
+
 		boost::filesystem::path m_projectPath;
 		std::string m_meshGeomExtension;
 
+		// the hashes of all the mesh files we've started writing, so
+		// we don't write duplicates.
+		std::set<IECore::MurmurHash> m_meshFiles;
+		tbb::task_group m_meshWriters;
+
 		virtual foundation::auto_release_ptr<renderer::Object> doConvertPrimitive( IECore::PrimitivePtr primitive,
 			const std::string &name );
 
@@ -69,8 +69,10 @@ class MotionBlockHandler : boost::noncopyable
 		bool insideMotionBlock() const;
 
 		void motionBegin( const std::set<float> &times );
+		/// Primitives are converted into mainAssembly, and instanced
+		/// into instanceParentAssembly.
 		void motionEnd( const AttributeState &attrState,
-			renderer::Assembly *mainAssembly );
+			renderer::Assembly *mainAssembly, renderer::Assembly *instanceParentAssembly );
 
 		void setTransform( const Imath::M44f &m );
 		void concatTransform( const Imath::M44f &m );
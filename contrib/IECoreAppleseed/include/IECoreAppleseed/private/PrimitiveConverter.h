@@ -73,6 +73,11 @@ class PrimitiveConverter : boost::noncopyable
 			const std::vector<IECore::PrimitivePtr> &primitives, const AttributeState &attrState,
 			const std::string &materialName, renderer::Assembly &parentAssembly );
 
+		/// Derived classes may defer some of the work of conversion, in which
+		/// case this must be called to complete it before the project is used.
+		/// The default implementation does nothing.
+		virtual void waitForDeferredConversions();
+
 	private :
 
 		virtual foundation::auto_release_ptr<renderer::Object> doConvertPrimitive( IECore::PrimitivePtr primitive,
@@ -35,6 +35,7 @@
 #ifndef IECOREAPPLESEED_RENDERERIMPLEMENTATION_H
 #define IECOREAPPLESEED_RENDERERIMPLEMENTATION_H
 
+#include <map>
 #include <memory>
 #include <stack>
 
@@ -141,6 +142,11 @@ class RendererImplementation : public IECore::Renderer
 
 		void createAssemblyInstance( const std::string &assemblyName );
 
+		// Returns the assembly that assembly instances should be
+		// added to - this is the main assembly unless we're inside an
+		// instanceBegin()/instanceEnd() block.
+		renderer::Assembly *currentAssembly();
+
 		template<class T>
 		const T *getOptionAs( const std::string &name ) const
 		{
@@ -177,6 +183,15 @@ class RendererImplementation : public IECore::Renderer
 		TransformStack m_transformStack;
 
 		renderer::Assembly *m_mainAssembly;
+
+		// instancing
+		typedef std::map<std::string, const renderer::Assembly *> InstanceMap;
+		InstanceMap m_instances;
+		renderer::Assembly *m_currentInstance;
+		// Counts the instanceBegin() calls which failed and have not
+		// yet been closed. Geometry is ignored while this is non-zero.
+		int m_ignoredInstanceDepth;
+
 		std::auto_ptr<LightHandler> m_lightHandler;
 		std::string m_currentShaderGroupName;
 		std::auto_ptr<PrimitiveConverter> m_primitiveConverter;
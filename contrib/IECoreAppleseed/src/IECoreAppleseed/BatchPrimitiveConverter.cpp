@@ -34,6 +34,7 @@
 
 #include "boost/filesystem/convenience.hpp"
 #include "boost/lexical_cast.hpp"
+#include "boost/shared_ptr.hpp"
 
 #include "foundation/math/scalar.h"
 
@@ -52,12 +53,68 @@ using namespace IECore;
 namespace asf = foundation;
 namespace asr = renderer;
 
+// Writes a converted mesh to a file. Run as a task by the
+// BatchPrimitiveConverter, which does the conversion itself so
+// that the task never references the caller's primitive.
+class IECoreAppleseed::BatchPrimitiveConverter::MeshWriter
+{
+
+	public :
+
+		MeshWriter( asf::auto_release_ptr<asr::MeshObject> mesh, const string &name, const filesystem::path &path )
+			:	m_mesh( mesh.release(), ReleaseMesh() ), m_name( name ), m_path( path )
+		{
+		}
+
+		void operator()() const
+		{
+			try
+			{
+				if( !asr::MeshObjectWriter::write( *m_mesh, m_name.c_str(), m_path.string().c_str() ) )
+				{
+					msg( Msg::Error, "IECoreAppleseed::BatchPrimitiveConverter", format( "Couldn't save mesh file \"%s\"." ) % m_path.string() );
+				}
+			}
+			catch( const std::exception &e )
+			{
+				msg( Msg::Error, "IECoreAppleseed::BatchPrimitiveConverter", e.what() );
+			}
+		}
+
+	private :
+
+		struct ReleaseMesh
+		{
+			void operator()( asr::MeshObject *mesh ) const
+			{
+				mesh->release();
+			}
+		};
+
+		// The task is copied by tbb::task_group::run(), so the
+		// mesh is shared rather than held by an auto_release_ptr.
+		boost::shared_ptr<asr::MeshObject> m_mesh;
+		string m_name;
+		filesystem::path m_path;
+
+};
+
 IECoreAppleseed::BatchPrimitiveConverter::BatchPrimitiveConverter( const filesystem::path &projectPath, const asf::SearchPaths &searchPaths ) : PrimitiveConverter( searchPaths )
 {
 	m_projectPath = projectPath;
 	m_meshGeomExtension = ".binarymesh";
 }
 
+IECoreAppleseed::BatchPrimitiveConverter::~BatchPrimitiveConverter()
+{
+	m_meshWriters.wait();
+}
+
+void IECoreAppleseed::BatchPrimitiveConverter::waitForDeferredConversions()
+{
+	m_meshWriters.wait();
+}
+
 void IECoreAppleseed::BatchPrimitiveConverter::setOption( const string &name, ConstDataPtr value )
 {
 	if( name == "as:mesh_file_format" )
@@ -94,25 +151,25 @@ asf::auto_release_ptr<asr::Object> IECoreAppleseed::BatchPrimitiveConverter::doC
 
 	if( primitive->typeId() == MeshPrimitiveTypeId )
 	{
-		// Check if we already have a mesh saved for this object.
+		// Check if we already have a mesh saved for this object, and if not,
+		// convert it now and write it in the background. Converting here means
+		// that an object referencing the file is only returned if the conversion
+		// succeeded.
 		string fileName = string( "_geometry/" ) + primitiveHash.toString() + m_meshGeomExtension;
-		filesystem::path p = m_projectPath / fileName;
-
-		if( !filesystem::exists( p ) )
+		if( m_meshFiles.insert( primitiveHash ).second )
 		{
-			asf::auto_release_ptr<asr::MeshObject> entity( MeshAlgo::convert( primitive.get() ) );
-			if( entity.get() == 0 )
-			{
-				msg( Msg::Warning, "IECoreAppleseed::BatchPrimitiveConverter", "Couldn't convert primitive." );
-				return asf::auto_release_ptr<asr::Object>();
-			}
-
-			// Write the mesh to a file.
-			p = m_projectPath / fileName;
-			if( !asr::MeshObjectWriter::write( *entity, name.c_str(), p.string().c_str() ) )
+			filesystem::path p = m_projectPath / fileName;
+			if( !filesystem::exists( p ) )
 			{
-				msg( Msg::Warning, "IECoreAppleseed::BatchPrimitiveConverter", "Couldn't save mesh primitive." );
-				return asf::auto_release_ptr<asr::Object>();
+				asf::auto_release_ptr<asr::MeshObject> entity( MeshAlgo::convert( primitive.get() ) );
+				if( entity.get() == 0 )
+				{
+					m_meshFiles.erase( primitiveHash );
+					msg( Msg::Warning, "IECoreAppleseed::BatchPrimitiveConverter", "Couldn't convert primitive." );
+					return asf::auto_release_ptr<asr::Object>();
+				}
+
+				m_meshWriters.run( MeshWriter( entity, name, p ) );
 			}
 		}
 
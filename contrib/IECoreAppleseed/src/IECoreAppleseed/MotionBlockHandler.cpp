@@ -66,7 +66,7 @@ void IECoreAppleseed::MotionBlockHandler::motionBegin( const set<float> &times )
 }
 
 void IECoreAppleseed::MotionBlockHandler::motionEnd( const AttributeState &attrState,
-	asr::Assembly *mainAssembly )
+	asr::Assembly *mainAssembly, asr::Assembly *instanceParentAssembly )
 {
 	assert( !m_times.empty() );
 
@@ -90,6 +90,7 @@ void IECoreAppleseed::MotionBlockHandler::motionEnd( const AttributeState &attrS
 
 		case PrimitiveBlock:
 			assert( mainAssembly );
+			assert( instanceParentAssembly );
 
 			if( const asr::Assembly *assembly = m_primitiveConverter.convertPrimitive( m_times, m_primitives, attrState, m_materialName, *mainAssembly ) )
 			{
@@ -105,7 +106,7 @@ void IECoreAppleseed::MotionBlockHandler::motionEnd( const AttributeState &attrS
 
 				asf::auto_release_ptr<asr::AssemblyInstance> assemblyInstance = asr::AssemblyInstanceFactory::create( assemblyInstanceName.c_str(), params, assemblyName.c_str() );
 				assemblyInstance->transform_sequence() = m_transformStack.top();
-				EntityAlgo::insertEntityWithUniqueName( mainAssembly->assembly_instances(), assemblyInstance, assemblyInstanceName );
+				EntityAlgo::insertEntityWithUniqueName( instanceParentAssembly->assembly_instances(), assemblyInstance, assemblyInstanceName );
 			}
 		break;
 
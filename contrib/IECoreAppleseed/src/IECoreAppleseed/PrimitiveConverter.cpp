@@ -79,6 +79,10 @@ void IECoreAppleseed::PrimitiveConverter::setOption( const string &name, ConstDa
 	}
 }
 
+void IECoreAppleseed::PrimitiveConverter::waitForDeferredConversions()
+{
+}
+
 void IECoreAppleseed::PrimitiveConverter::setShutterInterval( float openTime, float closeTime )
 {
 	m_shutterOpenTime = openTime;
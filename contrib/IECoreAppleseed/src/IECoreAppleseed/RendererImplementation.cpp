@@ -129,6 +129,8 @@ IECoreAppleseed::RendererImplementation::RendererImplementation( const string &f
 void IECoreAppleseed::RendererImplementation::constructCommon()
 {
 	m_mainAssembly = 0;
+	m_currentInstance = 0;
+	m_ignoredInstanceDepth = 0;
 
 	m_transformStack.clear();
 	m_attributeStack.push( AttributeState() );
@@ -495,6 +497,8 @@ void IECoreAppleseed::RendererImplementation::worldEnd()
 	asf::auto_release_ptr<asr::AssemblyInstance> assemblyInstance = asr::AssemblyInstanceFactory::create( "assembly_inst", asr::ParamArray(), "assembly" );
 	m_project->get_scene()->assembly_instances().insert( assemblyInstance );
 
+	m_primitiveConverter->waitForDeferredConversions();
+
 	// render or export the project
 	if( isEditable() )
 	{
@@ -737,7 +741,7 @@ void IECoreAppleseed::RendererImplementation::motionEnd()
 		return;
 	}
 
-	m_motionHandler->motionEnd( m_attributeStack.top(), m_mainAssembly );
+	m_motionHandler->motionEnd( m_attributeStack.top(), m_mainAssembly, currentAssembly() );
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -782,6 +786,13 @@ void IECoreAppleseed::RendererImplementation::mesh( ConstIntVectorDataPtr vertsP
 		return;
 	}
 
+	if( m_ignoredInstanceDepth )
+	{
+		// inside an instance block which failed to begin. the
+		// failure has already been reported.
+		return;
+	}
+
 	MeshPrimitivePtr mesh = new MeshPrimitive( vertsPerFace, vertIds, interpolation );
 	mesh->variables = primVars;
 
@@ -821,6 +832,11 @@ void IECoreAppleseed::RendererImplementation::geometry( const string &type, cons
 
 void IECoreAppleseed::RendererImplementation::procedural( Renderer::ProceduralPtr proc )
 {
+	if( m_ignoredInstanceDepth )
+	{
+		return;
+	}
+
 	// appleseed does not support procedurals yet, so we expand them immediately.
 	proc->render( this );
 }
@@ -829,19 +845,97 @@ void IECoreAppleseed::RendererImplementation::procedural( Renderer::ProceduralPt
 // instancing
 /////////////////////////////////////////////////////////////////////////////////////////
 
+// Instances are represented as assemblies which are children of the main
+// assembly, but which are never instanced directly. Primitives declared
+// inside an instance block are converted into the main assembly as usual,
+// so they participate in automatic instancing, and the instance assembly
+// holds only the assembly instances referencing them. Each call to instance()
+// then adds an assembly instance of the instance assembly with the current
+// transform. If instanceBegin() fails, everything up to the matching
+// instanceEnd() is ignored, rather than leaking into the enclosing assembly.
+
 void IECoreAppleseed::RendererImplementation::instanceBegin( const string &name, const CompoundDataMap &parameters )
 {
-	msg( Msg::Warning, "IECoreAppleseed::RendererImplementation::instanceBegin", "Not implemented." );
+	if( m_ignoredInstanceDepth )
+	{
+		// nested inside an instance block which failed to begin,
+		// so we ignore this one too, so that the ends still match.
+		m_ignoredInstanceDepth++;
+		return;
+	}
+
+	if( !m_mainAssembly )
+	{
+		msg( Msg::Warning, "IECoreAppleseed::RendererImplementation::instanceBegin", "Instance not inside world block, ignoring." );
+		m_ignoredInstanceDepth++;
+		return;
+	}
+
+	if( m_currentInstance )
+	{
+		msg( Msg::Warning, "IECoreAppleseed::RendererImplementation::instanceBegin", "Nested instances are not supported." );
+		m_ignoredInstanceDepth++;
+		return;
+	}
+
+	if( m_instances.find( name ) != m_instances.end() )
+	{
+		msg( Msg::Warning, "IECoreAppleseed::RendererImplementation::instanceBegin", format( "Instance \"%s\" already exists." ) % name );
+		m_ignoredInstanceDepth++;
+		return;
+	}
+
+	string assemblyName = name + "_instance_assembly";
+	asf::auto_release_ptr<asr::Assembly> assembly = asr::AssemblyFactory().create( assemblyName.c_str(), asr::ParamArray() );
+	m_currentInstance = assembly.get();
+	m_mainAssembly->assemblies().insert( assembly );
+	m_instances[name] = m_currentInstance;
+
+	// the contents of the instance are specified relative to
+	// the instance itself.
+	attributeBegin();
+	m_transformStack.setTransform( M44f() );
 }
 
 void IECoreAppleseed::RendererImplementation::instanceEnd()
 {
-	msg( Msg::Warning, "IECoreAppleseed::RendererImplementation::instanceEnd", "Not implemented." );
+	if( m_ignoredInstanceDepth )
+	{
+		m_ignoredInstanceDepth--;
+		return;
+	}
+
+	if( !m_currentInstance )
+	{
+		msg( Msg::Warning, "IECoreAppleseed::RendererImplementation::instanceEnd", "No matching instanceBegin() call." );
+		return;
+	}
+
+	attributeEnd();
+	m_currentInstance = 0;
 }
 
 void IECoreAppleseed::RendererImplementation::instance( const string &name )
 {
-	msg( Msg::Warning, "IECoreAppleseed::RendererImplementation::instance", "Not implemented." );
+	if( m_ignoredInstanceDepth )
+	{
+		return;
+	}
+
+	InstanceMap::const_iterator it = m_instances.find( name );
+	if( it == m_instances.end() )
+	{
+		msg( Msg::Warning, "IECoreAppleseed::RendererImplementation::instance", format( "No instance named \"%s\"." ) % name );
+		return;
+	}
+
+	if( it->second == m_currentInstance )
+	{
+		msg( Msg::Warning, "IECoreAppleseed::RendererImplementation::instance", format( "Instance \"%s\" cannot instance itself." ) % name );
+		return;
+	}
+
+	createAssemblyInstance( it->second->get_name() );
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -973,7 +1067,12 @@ void IECoreAppleseed::RendererImplementation::createAssemblyInstance( const stri
 	asf::auto_release_ptr<asr::AssemblyInstance> assemblyInstance = asr::AssemblyInstanceFactory::create( assemblyInstanceName.c_str(), params, assemblyName.c_str() );
 
 	assemblyInstance->transform_sequence() = m_transformStack.top();
-	EntityAlgo::insertEntityWithUniqueName( m_mainAssembly->assembly_instances(), assemblyInstance, assemblyInstanceName );
+	EntityAlgo::insertEntityWithUniqueName( currentAssembly()->assembly_instances(), assemblyInstance, assemblyInstanceName );
+}
+
+asr::Assembly *IECoreAppleseed::RendererImplementation::currentAssembly()
+{
+	return m_currentInstance ? m_currentInstance : m_mainAssembly;
 }
 
 bool RendererImplementation::insideMotionBlock() const
@@ -39,6 +39,7 @@ import IECore
 
 from AttributeTest import AttributeTest
 from CameraTest import CameraTest
+from InstancingTest import InstancingTest
 from LightTest import LightTest
 from MeshTest import MeshTest
 from MotionTest import MotionTest
@@ -0,0 +1,150 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import unittest
+
+import IECore
+import IECoreAppleseed
+
+import AppleseedTest
+
+class InstancingTest( AppleseedTest.TestCase ):
+
+	def testNamedInstances( self ) :
+
+		r = IECoreAppleseed.Renderer()
+		r.worldBegin()
+
+		self._createDefaultShader( r )
+
+		r.instanceBegin( "planes", {} )
+		IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) ).render( r )
+		IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -2 ), IECore.V2f( 2 ) ) ).render( r )
+		r.instanceEnd()
+
+		for i in range( 0, 10 ) :
+			r.attributeBegin()
+			r.concatTransform( IECore.M44f.createTranslated( IECore.V3f( i, 0, 0 ) ) )
+			r.instance( "planes" )
+			r.attributeEnd()
+
+		mainAssembly = self._getMainAssembly( r )
+
+		# the two planes, plus the assembly holding the instance.
+		self.assertEqual( len( mainAssembly.assemblies() ), 3 )
+		self.assertEqual( len( mainAssembly.assembly_instances() ), 10 )
+
+		instanceAssembly = mainAssembly.assemblies().get_by_name( "planes_instance_assembly" )
+		self.failUnless( instanceAssembly is not None )
+		self.assertEqual( len( instanceAssembly.assembly_instances() ), 2 )
+
+	def testInstanceContentsAreAutomaticallyInstanced( self ) :
+
+		r = IECoreAppleseed.Renderer()
+		r.worldBegin()
+
+		self._createDefaultShader( r )
+
+		m = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) )
+		m.render( r )
+
+		r.instanceBegin( "plane", {} )
+		m.render( r )
+		r.instanceEnd()
+
+		r.instance( "plane" )
+
+		# the plane inside the instance shares the geometry of the one outside it.
+		mainAssembly = self._getMainAssembly( r )
+		self.assertEqual( len( mainAssembly.assemblies() ), 2 )
+		self.assertEqual( len( mainAssembly.assembly_instances() ), 2 )
+
+	def testUnknownInstance( self ) :
+
+		r = IECoreAppleseed.Renderer()
+		r.worldBegin()
+
+		with IECore.CapturingMessageHandler() as mh :
+			r.instance( "iDontExist" )
+
+		self.assertEqual( len( mh.messages ), 1 )
+		self.assertEqual( mh.messages[0].level, IECore.Msg.Level.Warning )
+		self.assertEqual( len( self._getMainAssembly( r ).assembly_instances() ), 0 )
+
+	def testFailedInstanceBeginIgnoresContents( self ) :
+
+		r = IECoreAppleseed.Renderer()
+		r.worldBegin()
+
+		self._createDefaultShader( r )
+
+		r.instanceBegin( "plane", {} )
+		IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) ).render( r )
+		r.instanceEnd()
+
+		with IECore.CapturingMessageHandler() as mh :
+
+			# duplicate name
+			r.instanceBegin( "plane", {} )
+			IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -2 ), IECore.V2f( 2 ) ) ).render( r )
+			r.instanceEnd()
+
+			# nested instance
+			r.instanceBegin( "outer", {} )
+			r.instanceBegin( "inner", {} )
+			IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -3 ), IECore.V2f( 3 ) ) ).render( r )
+			r.instanceEnd()
+			IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -4 ), IECore.V2f( 4 ) ) ).render( r )
+			r.instanceEnd()
+
+		self.assertEqual( len( mh.messages ), 2 )
+		for m in mh.messages :
+			self.assertEqual( m.level, IECore.Msg.Level.Warning )
+
+		mainAssembly = self._getMainAssembly( r )
+
+		# the meshes following the failed instanceBegin() calls must not
+		# have leaked into the main assembly or the enclosing instance.
+		self.assertEqual( len( mainAssembly.assembly_instances() ), 0 )
+		self.assertEqual( len( mainAssembly.assemblies().get_by_name( "plane_instance_assembly" ).assembly_instances() ), 1 )
+		self.assertEqual( len( mainAssembly.assemblies().get_by_name( "outer_instance_assembly" ).assembly_instances() ), 1 )
+		self.failUnless( mainAssembly.assemblies().get_by_name( "inner_instance_assembly" ) is None )
+
+		# and the renderer should be back to normal once they're all closed.
+		IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -5 ), IECore.V2f( 5 ) ) ).render( r )
+		self.assertEqual( len( mainAssembly.assembly_instances() ), 1 )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -68,6 +68,29 @@ class RendererTest( AppleseedTest.TestCase ):
 
 		self.failUnless( os.path.exists( self.__appleseedFileName ) )
 
+	def testAppleseedOutputManyMeshes( self ) :
+
+		r = IECoreAppleseed.Renderer( self.__appleseedFileName )
+
+		with IECore.WorldBlock( r ) :
+
+			self._createDefaultShader( r )
+			for i in range( 0, 100 ) :
+				with IECore.AttributeBlock( r ) :
+					# every mesh is rendered twice, but should only be written once.
+					r.setAttribute( "name", IECore.StringData( "mesh%d" % ( i % 50 ) ) )
+					m = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 + i % 50 ) ) )
+					m.render( r )
+
+		self.failUnless( os.path.exists( self.__appleseedFileName ) )
+
+		# all the mesh files must have been written by the time the
+		# project has been.
+		meshFiles = [ f for f in os.listdir( self.__geometryDir ) if f.endswith( ".binarymesh" ) ]
+		self.assertEqual( len( meshFiles ), 50 )
+		for f in meshFiles :
+			self.failUnless( os.path.getsize( os.path.join( self.__geometryDir, f ) ) > 0 )
+
 	def tearDown( self ) :
 
 		for f in [
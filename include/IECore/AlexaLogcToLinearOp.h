@@ -55,7 +55,7 @@ class IECORE_API AlexaLogcToLinearOp : public ChannelOp
 
 	protected :
 
-		virtual void modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels );
+		virtual void modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow );
 
 		struct Converter;
 
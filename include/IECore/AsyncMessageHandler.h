@@ -0,0 +1,108 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_ASYNCMESSAGEHANDLER_H
+#define IECORE_ASYNCMESSAGEHANDLER_H
+
+#include "boost/scoped_ptr.hpp"
+
+#include "IECore/Export.h"
+#include "IECore/FilteredMessageHandler.h"
+
+namespace IECore
+{
+
+IE_CORE_FORWARDDECLARE( AsyncMessageHandler );
+
+/// A FilteredMessageHandler which returns from handle() immediately,
+/// leaving the output of the message to another handler on a background
+/// thread. This avoids the contention which otherwise occurs when many
+/// threads output messages at once, and means that slow handlers such as
+/// those implemented in Python don't hold up the threads doing the real
+/// work.
+///
+/// Identical messages are coalesced - once a message has been output
+/// maxRepeats times within a window of repeatWindow seconds, further repeats
+/// are counted but not output until the window has elapsed, at which point a
+/// single summary message is output and the message may be output again.
+/// Summaries are output for expired windows as later messages are processed,
+/// and for all outstanding windows by flush(). They are also output early if
+/// too many distinct messages are being counted, so that memory use remains
+/// bounded. A maxRepeats of 0 disables coalescing, and a repeatWindow of 0
+/// means that repeats are only summarised by flush(). If the queue fills
+/// because messages are arriving faster than they can be output, further
+/// messages are dropped and counted, and a warning is output on the next
+/// flush().
+/// \ingroup utilityGroup
+class IECORE_API AsyncMessageHandler : public FilteredMessageHandler
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( AsyncMessageHandler );
+
+		AsyncMessageHandler( MessageHandlerPtr handler, size_t maxQueueSize = 10000, size_t maxRepeats = 10, double repeatWindow = 10.0 );
+		/// Outputs any queued messages and repeat summaries before
+		/// returning. Handlers constructed from Python release the GIL
+		/// to do so, but C++ code which releases the last reference to a
+		/// handler with a Python downstream handler while holding the
+		/// GIL must call flush() with the GIL released first.
+		virtual ~AsyncMessageHandler();
+
+		/// \threading May be called concurrently from any number of threads.
+		/// Never blocks.
+		virtual void handle( Level level, const std::string &context, const std::string &message );
+
+		/// Blocks until all messages queued prior to the call have been
+		/// output, then outputs summaries for all coalesced repeats and
+		/// dropped messages, and resets the repeat counts.
+		void flush();
+
+		/// The total number of messages which have been dropped because
+		/// the queue was full.
+		size_t numDropped() const;
+		/// The total number of messages which have been coalesced
+		/// into repeat summaries rather than being output individually.
+		size_t numCoalesced() const;
+
+	private :
+
+		class Implementation;
+		boost::scoped_ptr<Implementation> m_implementation;
+
+};
+
+} // namespace IECore
+
+#endif // IECORE_ASYNCMESSAGEHANDLER_H
@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_BAKEDSPLINE_H
+#define IECORE_BAKEDSPLINE_H
+
+#include <vector>
+
+#include "IECore/Spline.h"
+
+namespace IECore
+{
+
+/// A representation of a Spline optimised for fast repeated evaluation,
+/// such as is needed when applying a ramp to every pixel of an image or
+/// every point of a primitive. The spline is sampled into a lookup table
+/// spanning its interval, and evaluation is then just a linear interpolation
+/// between the two nearest table entries, rather than the iterative solve
+/// performed by Spline::operator().
+///
+/// The resolution of the table is chosen adaptively during baking, to bring
+/// the error at the midpoints between table entries within a specified
+/// tolerance. The largest such error is available via maxError().
+/// \ingroup mathGroup
+template<typename X, typename Y>
+class BakedSpline
+{
+
+	public :
+
+		typedef X XType;
+		typedef Y YType;
+		typedef Spline<X, Y> SplineType;
+
+		/// Bakes the spline. The resolution starts at minResolution and the
+		/// number of table intervals is repeatedly doubled until the error at
+		/// the midpoint of every interval is within tolerance, or until the
+		/// next doubling would exceed maxResolution. Pass equal values for
+		/// minResolution and maxResolution to get a uniform table of a
+		/// specific size. Throws if the spline can't be evaluated.
+		BakedSpline( const SplineType &spline, X tolerance = X( 1e-4 ), size_t minResolution = 65, size_t maxResolution = 65537 );
+
+		/// Returns the range of the baked spline in the X direction. Values
+		/// outside this range evaluate to the values at the end points.
+		X xMin() const;
+		X xMax() const;
+
+		/// Returns the number of entries in the table.
+		size_t resolution() const;
+		/// Returns the largest difference between the baked and original splines
+		/// measured during baking. For multi-component types this is the largest
+		/// difference in any single component.
+		X maxError() const;
+
+		/// Evaluates the baked spline at x.
+		inline Y operator() ( X x ) const;
+		/// Evaluates the baked spline at n positions, placing the results in y.
+		inline void evaluate( const X *x, Y *y, size_t n ) const;
+
+	private :
+
+		X m_xMin;
+		X m_xMax;
+		X m_xScale;
+		X m_maxError;
+		std::vector<Y> m_values;
+
+};
+
+typedef BakedSpline<float, float> BakedSplineff;
+typedef BakedSpline<double, double> BakedSplinedd;
+
+typedef BakedSpline<float, Imath::Color3f> BakedSplinefColor3f;
+typedef BakedSpline<float, Imath::Color4f> BakedSplinefColor4f;
+
+} // namespace IECore
+
+#include "IECore/BakedSpline.inl"
+
+#endif // IECORE_BAKEDSPLINE_H
@@ -0,0 +1,186 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_BAKEDSPLINE_INL
+#define IECORE_BAKEDSPLINE_INL
+
+#include <algorithm>
+
+#include "OpenEXR/ImathMath.h"
+
+#include "IECore/Exception.h"
+#include "IECore/VectorTraits.h"
+
+namespace IECore
+{
+
+namespace Detail
+{
+
+template<typename X, typename Y>
+X bakedSplineError( const Y &a, const Y &b )
+{
+	typedef VectorTraits<Y> YTraits;
+	X result( 0 );
+	for( unsigned int i = 0; i < YTraits::dimensions(); ++i )
+	{
+		result = std::max( result, X( Imath::Math<X>::fabs( YTraits::get( a, i ) - YTraits::get( b, i ) ) ) );
+	}
+	return result;
+}
+
+} // namespace Detail
+
+template<typename X, typename Y>
+BakedSpline<X,Y>::BakedSpline( const SplineType &spline, X tolerance, size_t minResolution, size_t maxResolution )
+	:	m_xScale( 0 ), m_maxError( 0 )
+{
+	if( spline.points.size() < 4 )
+	{
+		throw InvalidArgumentException( "BakedSpline : Spline has less than 4 points." );
+	}
+
+	const typename SplineType::XInterval interval = spline.interval();
+	m_xMin = interval.lower();
+	m_xMax = interval.upper();
+	const X width = m_xMax - m_xMin;
+	if( !( width > X( 0 ) ) )
+	{
+		// degenerate spline - only one value is possible
+		m_values.push_back( spline( m_xMin ) );
+		return;
+	}
+
+	size_t numIntervals = std::max( minResolution, (size_t)2 ) - 1;
+	maxResolution = std::max( maxResolution, numIntervals + 1 );
+
+	m_values.resize( numIntervals + 1 );
+	for( size_t i = 0; i <= numIntervals; ++i )
+	{
+		m_values[i] = spline( m_xMin + width * X( i ) / X( numIntervals ) );
+	}
+
+	std::vector<Y> midValues;
+	std::vector<Y> newValues;
+	while( true )
+	{
+		// measure the error at the midpoint of each interval. we keep
+		// the exact values, because they become the new table entries
+		// if we need to increase the resolution.
+		midValues.resize( numIntervals );
+		m_maxError = X( 0 );
+		for( size_t i = 0; i < numIntervals; ++i )
+		{
+			midValues[i] = spline( m_xMin + width * ( X( i ) + X( 0.5 ) ) / X( numIntervals ) );
+			const Y lerped = m_values[i] + ( m_values[i+1] - m_values[i] ) * X( 0.5 );
+			m_maxError = std::max( m_maxError, Detail::bakedSplineError<X>( midValues[i], lerped ) );
+		}
+
+		if( m_maxError <= tolerance || numIntervals * 2 + 1 > maxResolution )
+		{
+			break;
+		}
+
+		// double the resolution by interleaving the midpoints
+		newValues.resize( numIntervals * 2 + 1 );
+		for( size_t i = 0; i < numIntervals; ++i )
+		{
+			newValues[i*2] = m_values[i];
+			newValues[i*2+1] = midValues[i];
+		}
+		newValues.back() = m_values.back();
+		m_values.swap( newValues );
+		numIntervals *= 2;
+	}
+
+	m_xScale = X( numIntervals ) / width;
+}
+
+template<typename X, typename Y>
+X BakedSpline<X,Y>::xMin() const
+{
+	return m_xMin;
+}
+
+template<typename X, typename Y>
+X BakedSpline<X,Y>::xMax() const
+{
+	return m_xMax;
+}
+
+template<typename X, typename Y>
+size_t BakedSpline<X,Y>::resolution() const
+{
+	return m_values.size();
+}
+
+template<typename X, typename Y>
+X BakedSpline<X,Y>::maxError() const
+{
+	return m_maxError;
+}
+
+template<typename X, typename Y>
+inline Y BakedSpline<X,Y>::operator() ( X x ) const
+{
+	const X f = ( x - m_xMin ) * m_xScale;
+	// written so that NaNs map to the first value
+	if( !( f > X( 0 ) ) )
+	{
+		return m_values.front();
+	}
+
+	const size_t last = m_values.size() - 1;
+	if( f >= X( last ) )
+	{
+		return m_values.back();
+	}
+
+	const size_t i = static_cast<size_t>( f );
+	const X t = f - X( i );
+	return m_values[i] + ( m_values[i+1] - m_values[i] ) * t;
+}
+
+template<typename X, typename Y>
+inline void BakedSpline<X,Y>::evaluate( const X *x, Y *y, size_t n ) const
+{
+	for( size_t i = 0; i < n; ++i )
+	{
+		y[i] = (*this)( x[i] );
+	}
+}
+
+} // namespace IECore
+
+#endif // IECORE_BAKEDSPLINE_INL
@@ -36,6 +36,7 @@
 #define IE_CORE_BYTEORDER_H
 
 #include <stdint.h>
+#include <cstddef>
 
 #include "boost/static_assert.hpp"
 
@@ -163,6 +164,20 @@ inline double reverseBytes<double>( const double &x )
 	return xx.d;
 }
 
+/// Reverses the byte order of the n values starting at data, in place.
+/// This is a plain loop over the single value form above, which compilers
+/// are able to turn into vectorised byte shuffles - use it in preference
+/// to a loop of your own when converting large arrays.
+template<typename T>
+inline void reverseBytes( T *data, size_t n )
+{
+	T *end = data + n;
+	for( ; data != end; ++data )
+	{
+		*data = reverseBytes( *data );
+	}
+}
+
 /// If running on a big endian platform,
 /// returns a copy of x with reversed bytes,
 /// otherwise returns x unchanged.
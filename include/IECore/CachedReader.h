@@ -36,6 +36,7 @@
 #define IE_CORE_CACHEDREADER_H
 
 #include "boost/shared_ptr.hpp"
+#include "boost/function.hpp"
 
 #include "IECore/Export.h"
 #include "IECore/ObjectPool.h"
@@ -79,8 +80,19 @@ class IECORE_API CachedReader : public RefCounted
 
 		/// As above, but also takes an Op which will be applied to
 		/// objects following loading. Will use the given ObjectPool to store the loaded objects.
+		/// Because the Op is shared, post-processing of concurrent loads is serialised - use
+		/// the constructor below to avoid this.
 		CachedReader( const SearchPath &paths, ConstModifyOpPtr postProcessor, ObjectPoolPtr objectPool = ObjectPool::defaultObjectPool() );
 
+		/// A function returning a new ModifyOp to be used for post-processing.
+		typedef boost::function<ModifyOpPtr ()> PostProcessorCreator;
+
+		/// As above, but uses postProcessorCreator to make a new post-processor
+		/// whenever one is needed and none is free, so that concurrent loads
+		/// may be post-processed concurrently. Post-processors are reused by
+		/// subsequent loads.
+		CachedReader( const SearchPath &paths, ObjectPoolPtr objectPool, const PostProcessorCreator &postProcessorCreator );
+
 		/// Searches for the given file and loads it if found.
 		/// Throws an exception in case it cannot be found or no suitable Reader
 		/// exists. The Object is returned with only const access as
@@ -110,6 +122,15 @@ class IECORE_API CachedReader : public RefCounted
 		/// Returns the ObjectPool object used by this CachedReader.
 		ObjectPool *objectPool() const;
 
+		/// Failures to load files are remembered, so that subsequent reads of the
+		/// same file fail immediately without searching for it or attempting to
+		/// read it again. By default failures are remembered until the file
+		/// is cleared, but a time to live in seconds may be specified here so
+		/// that files which appear later are eventually found. A value of
+		/// 0 disables the remembering of failures entirely.
+		void setErrorTimeToLive( double seconds );
+		double getErrorTimeToLive() const;
+
 		/// Returns a static CachedReader instance to be used by anything
 		/// wishing to share it's cache with others. It makes sense to use
 		/// this wherever possible to conserve memory. This initially
@@ -60,8 +60,9 @@ class IECORE_API ChannelOp : public ImagePrimitiveOp
 	protected :
 
 		typedef std::vector<FloatVectorDataPtr> ChannelVector;
+		typedef std::vector<float *> ChannelPointerVector;
 
-		/// Should be implemented by derived classes to modify the data in the passes channels in place.
+		/// May be implemented by derived classes to modify the data in the passed channels in place.
 		/// The base class will already have verified the following :
 		///
 		///		* the channels have an appropriate interpolation value - vertex, varying or facevarying.
@@ -72,7 +73,19 @@ class IECORE_API ChannelOp : public ImagePrimitiveOp
 		/// things are right now, every derived class is iterating over the channels vector - there's not much else they can do - so it would
 		/// make sense to move that step to the base class. If we pass a single channel at a time then we could also thread the computation of
 		/// the different channels.
-		virtual void modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels ) = 0;
+		///
+		/// The default implementation calls modifyChannelRows() in parallel for ranges of rows, so
+		/// derived classes performing pointwise operations need only implement that. Derived classes
+		/// performing inherently serial operations should instead implement modifyChannels(),
+		/// which opts out of the parallel execution. Derived classes which need to validate their
+		/// parameters before processing may implement modifyChannels() to do so, and then call
+		/// the base class implementation.
+		virtual void modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels );
+		/// May be implemented by derived classes to modify rows [beginRow, endRow) of the passed channels
+		/// in place, where row 0 is the first row of the dataWindow. Channels are passed as pointers to the
+		/// first pixel of the dataWindow. This is called concurrently from multiple threads, with non-overlapping
+		/// ranges of rows, so implementations must be threadsafe.
+		virtual void modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow );
 
 	private :
 
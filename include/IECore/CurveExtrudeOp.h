@@ -83,6 +83,7 @@ class IECORE_API CurveExtrudeOp : public Op
 		struct VaryingFn;
 		struct VertexFn;
 		struct UniformFn;
+		class BuildPatchMeshes;
 
 };
 
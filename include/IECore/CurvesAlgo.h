@@ -0,0 +1,65 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_CURVESALGO_H
+#define IECORE_CURVESALGO_H
+
+#include <vector>
+
+#include "OpenEXR/ImathVec.h"
+
+#include "IECore/CurvesPrimitive.h"
+
+namespace IECore
+{
+
+namespace CurvesAlgo
+{
+
+/// Merges all the curves into a single CurvesPrimitive in one pass, sizing
+/// the output data up front and copying topology and primitive variables in
+/// parallel. PrimitiveVariables which are missing from some of the inputs
+/// are expanded using a default value, unless removeNonMatchingPrimVars is
+/// true, in which case they are removed. If curveRanges is passed, it is
+/// filled with the [ start, end ) range of curves originating from each input.
+/// Throws if the inputs do not all share the same basis and periodicity.
+CurvesPrimitivePtr merge( const std::vector<const CurvesPrimitive *> &curves,
+	bool removeNonMatchingPrimVars = false,
+	std::vector<Imath::V2i> *curveRanges = 0
+);
+
+} // namespace CurvesAlgo
+} // namespace IECore
+
+#endif // IECORE_CURVESALGO_H
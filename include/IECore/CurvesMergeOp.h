@@ -43,6 +43,7 @@ namespace IECore
 {
 
 /// An op to merge one set of curves with another.
+/// \see CurvesAlgo::merge() for merging many sets of curves at once.
 /// \ingroup geometryProcessingGroup
 class IECORE_API CurvesMergeOp : public CurvesPrimitiveOp
 {
@@ -62,8 +63,6 @@ class IECORE_API CurvesMergeOp : public CurvesPrimitiveOp
 
 	private :
 
-		struct AppendPrimVars;
-
 		CurvesPrimitiveParameterPtr m_curvesParameter;
 
 };
@@ -147,6 +147,23 @@ class IECORE_API CurvesPrimitiveEvaluator : public PrimitiveEvaluator
 		float curveLength( unsigned curveIndex, float vStart=0.0f, float vEnd=1.0f ) const;
 		//@}
 
+		//! @name Batch query functions
+		/// These functions perform many queries in one call, running them in parallel and
+		/// without the overhead of initialising a Result per query. Positions are computed
+		/// from tables of per-segment polynomial coefficients, which are built in parallel on
+		/// first use, so each query costs a single cubic evaluation.
+		////////////////////////////////////////////////////////////////////////////////////////
+		//@{
+		/// Computes the position at each ( curveIndices[i], v[i] ) pair, and optionally the v
+		/// tangent. The results match those of pointAtV() followed by Result::point() and
+		/// Result::vTangent(). Returns false if any of the queries were invalid, in which case
+		/// the outputs for those queries are set to zero.
+		bool pointsAtV( const std::vector<unsigned> &curveIndices, const std::vector<float> &v, std::vector<Imath::V3f> &points, std::vector<Imath::V3f> *vTangents = 0 ) const;
+		/// Performs closestPoint() for each of the points, outputting the curve index and v
+		/// parameter of the closest location to each. Returns false if there are no curves.
+		bool closestPoints( const std::vector<Imath::V3f> &points, std::vector<unsigned> &curveIndices, std::vector<float> &v ) const;
+		//@}
+
 		//! @name Topology access
 		/// These functions make it easier to index curve data manually in cases where the
 		/// queries above are not sufficient.
@@ -182,6 +199,16 @@ class IECORE_API CurvesPrimitiveEvaluator : public PrimitiveEvaluator
 		std::vector<int> m_varyingDataOffsets; // one value per curve
 		PrimitiveVariable m_p;
 		
+		// Polynomial coefficients for each curve segment, four per segment, such that
+		// P( t ) = ( ( c[0] * t + c[1] ) * t + c[2] ) * t + c[3].
+		void buildSegments();
+		bool m_haveSegments;
+		tbb::mutex m_segmentsMutex;
+		std::vector<unsigned> m_segmentOffsets; // one value per curve, plus the total
+		std::vector<Imath::V3f> m_segmentCoefficients;
+		class SegmentBuilder;
+		class PointsAtVQuery;
+
 		void buildTree();
 		bool m_haveTree;
 		typedef tbb::mutex TreeMutex;
@@ -190,8 +217,10 @@ class IECORE_API CurvesPrimitiveEvaluator : public PrimitiveEvaluator
 		std::vector<Imath::Box3f> m_treeBounds;
 		struct Line;
 		std::vector<Line> m_treeLines;
+		class LineBuilder;
 		
 		void closestPointWalk( Box3fTree::NodeIndex nodeIndex, const Imath::V3f &p, unsigned &curveIndex, float &v, float &closestDistSquared ) const;
+		class ClosestPointsQuery;
 		
 };
 
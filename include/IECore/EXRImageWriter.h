@@ -50,9 +50,19 @@
 namespace IECore
 {
 
+/// \addtogroup environmentGroup
+///
+/// <b>IECORE_EXRIMAGEWRITER_THREADS</b><br>
+/// If set, and the OpenEXR global thread pool has not been configured by
+/// the time the first image is written, the pool is given this many threads.
+/// A value of 0 uses the number of hardware threads.
+
 /// The EXRImageWriter class serializes images to the OpenEXR HDR image format.
 /// N.B Both Shake and Nuke seem to assume channel names "R", "G", "B", and "A"
 /// - lowercase do not work as expected.
+/// Compression is performed in parallel if the OpenEXR global thread pool has
+/// threads. The pool is process wide, so it is left for the application to
+/// configure, unless IECORE_EXRIMAGEWRITER_THREADS is set.
 /// \ingroup ioGroup
 class IECORE_API EXRImageWriter : public ImageWriter
 {
@@ -71,6 +81,11 @@ class IECORE_API EXRImageWriter : public ImageWriter
 		IntParameter * compressionParameter();
 		const IntParameter * compressionParameter() const;
 
+		/// When nonzero, a tiled image is written using tiles of
+		/// this size, rather than a scanline image.
+		IntParameter * tileSizeParameter();
+		const IntParameter * tileSizeParameter() const;
+
 	private:
 
 		void constructCommon();
@@ -53,10 +53,14 @@ IECORE_API void findSequences( const std::vector< std::string > &names, std::vec
 IECORE_API void findSequences( const std::vector< std::string > &names, std::vector< FileSequencePtr > &sequences, size_t minSequenceSize );
 
 /// Generates all sequences with at least minSequenceSize elements residing in given directory in the form of a list of FileSequences.
-IECORE_API void ls( const std::string &path, std::vector< FileSequencePtr > &sequences, size_t minSequenceSize = 2 );
+/// If useCache is true, then the directory listing may be reused from a previous call, provided that the modification
+/// time of the directory shows it to be unchanged. This can make repeated browsing of very large directories much quicker,
+/// but relies on the filesystem maintaining directory modification times accurately.
+IECORE_API void ls( const std::string &path, std::vector< FileSequencePtr > &sequences, size_t minSequenceSize = 2, bool useCache = false );
 
 /// Attempts to find a sequence matching the given sequence template (e.g. with at least one '#' character).
-IECORE_API void ls( const std::string &sequencePath, FileSequencePtr &sequence, size_t minSequenceSize = 2 );
+/// The useCache argument is as described above.
+IECORE_API void ls( const std::string &sequencePath, FileSequencePtr &sequence, size_t minSequenceSize = 2, bool useCache = false );
 
 /// Returns a FrameList instance that "best" represents the specified list of integer
 /// frame numbers. This function attempts to be intelligent and uses a CompoundFrameList
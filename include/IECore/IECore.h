@@ -67,6 +67,8 @@ IECORE_API bool withJPEG();
 IECORE_API bool withFreeType();
 /// Returns true if IECore was built with PNG suppport
 IECORE_API bool withPNG();
+/// Returns true if IECore was built with Profiler instrumentation
+IECORE_API bool withProfiling();
 /// Returns true if IECore was built with Deep EXR support
 IECORE_API bool withDeepEXR();
 
@@ -133,6 +133,11 @@ class IECORE_API IFFFile : public RefCounted
 				template<typename T>
 				size_t read( std::vector<Imath::Vec3<T> > &data );
 
+				/// read n values from Chunk data, starting at the value with index first.
+				/// this allows large Chunks to be read piece by piece.
+				template<typename T>
+				void read( T *data, size_t first, size_t n );
+
 			private :
 				
 				Chunk( );
@@ -102,6 +102,25 @@ size_t IFFFile::Chunk::read( std::vector<Imath::Vec3<T> > &data )
 	return data.size();
 }
 
+template<typename T>
+void IFFFile::Chunk::read( T *data, size_t first, size_t n )
+{
+	if ( sizeof(T) * ( first + n ) > m_dataSize )
+	{
+		msg( Msg::Error, "IFFFile::Chunk::read()", boost::format( "Attempting to read %d pieces of data of size %d from index %d for a Chunk '%s' with dataSize %d." ) % n % sizeof(T) % first % m_type.name() % m_dataSize );
+		return;
+	}
+
+	m_file->m_iStream->seekg( m_filePosition + (std::streamoff)( first * sizeof(T) ), std::ios_base::beg );
+	m_file->m_iStream->read( (char *)data, n * sizeof(T) );
+
+	// IFF data is big endian
+	if( littleEndian() )
+	{
+		reverseBytes( data, n );
+	}
+}
+
 template<typename T>
 void IFFFile::Chunk::readData( T *dataBuffer, unsigned long n )
 {
@@ -0,0 +1,149 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_IMAGECACHE_H
+#define IECORE_IMAGECACHE_H
+
+#include "boost/shared_ptr.hpp"
+
+#include "OpenEXR/ImathBox.h"
+
+#include "IECore/Export.h"
+#include "IECore/RefCounted.h"
+#include "IECore/VectorTypedData.h"
+
+namespace IECore
+{
+
+IE_CORE_FORWARDDECLARE( ImageCache );
+
+/// \addtogroup environmentGroup
+///
+/// <b>IECORE_IMAGECACHE_MEMORY</b><br>
+/// Used to specify the memory limit for the default ImageCache. See
+/// ImageCache::defaultImageCache() for more information.
+///
+/// <b>IECORE_IMAGECACHE_FILES</b><br>
+/// Used to specify the limit on open files for the default ImageCache. See
+/// ImageCache::defaultImageCache() for more information.
+
+/// The ImageCache class provides access to individual pixels and regions of
+/// image files, without needing to load the whole image into memory. Images
+/// are divided into square tiles which are loaded on demand using the ImageReader
+/// for the file, and are held in a cache limited by memory consumption. The
+/// number of simultaneously open files is also limited, with the least recently
+/// used files being closed when necessary. All methods may be called concurrently
+/// from multiple threads.
+///
+/// Most ImageReaders can't read a region of an image without decoding the whole
+/// image into memory, and keep the decoded image for as long as they are open.
+/// The memory for these is included in the memory limit, as an upper bound based
+/// on the size of the data window, and such files are closed when that memory is
+/// reclaimed. Only EXR files can be read a tile at a time.
+///
+/// Pixel values are as returned by ImageReader::readChannel(), so no colorspace
+/// conversion is performed. Pixels outside the data window of the image have
+/// a value of 0.
+/// \ingroup ioGroup
+class IECORE_API ImageCache : public RefCounted
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( ImageCache );
+
+		/// Max memory is specified in bytes. Tiles are tileSize pixels square,
+		/// aligned to the origin of pixel space.
+		ImageCache( size_t maxMemory, size_t maxOpenFiles = 100, int tileSize = 64 );
+		virtual ~ImageCache();
+
+		int getTileSize() const;
+
+		/// Sets the maximum memory used by cached tiles and open files, discarding
+		/// tiles and closing files if necessary.
+		void setMaxMemoryUsage( size_t maxMemory );
+		size_t getMaxMemoryUsage() const;
+		/// Returns the memory currently used by cached tiles and the
+		/// decoded images held by open files.
+		size_t memoryUsage() const;
+
+		/// Sets the maximum number of files held open, closing files if necessary.
+		void setMaxOpenFiles( size_t maxOpenFiles );
+		size_t getMaxOpenFiles() const;
+
+		/// Discards all cached tiles and closes all files, so that subsequent
+		/// queries see any changes made to files on disk.
+		void clear();
+
+		//! @name Image queries
+		/// These throw if the file can't be opened or isn't an image.
+		////////////////////////////////////////////////////////////
+		//@{
+		Imath::Box2i dataWindow( const std::string &fileName );
+		Imath::Box2i displayWindow( const std::string &fileName );
+		void channelNames( const std::string &fileName, std::vector<std::string> &names );
+		//@}
+
+		//! @name Pixel access
+		/// These throw if the file or channel doesn't exist.
+		////////////////////////////////////////////////////////////
+		//@{
+		/// Returns the value of a single pixel.
+		float sample( const std::string &fileName, const std::string &channelName, int x, int y );
+		/// Returns the value at a continuous position in pixel space, using bilinear
+		/// interpolation between pixel centres. Pixel x, y has its centre at x + 0.5, y + 0.5.
+		float sample( const std::string &fileName, const std::string &channelName, const Imath::V2f &p );
+		/// Returns the pixels in the specified region, in the same layout as
+		/// ImageReader::readChannel().
+		FloatVectorDataPtr readRegion( const std::string &fileName, const std::string &channelName, const Imath::Box2i &region );
+		//@}
+
+		/// Returns a static ImageCache instance to be used by anything
+		/// wishing to share the cache with others. It makes sense to use
+		/// this wherever possible to conserve memory and file handles. This
+		/// initially has a memory limit specified in megabytes by the
+		/// IECORE_IMAGECACHE_MEMORY environment variable, and an open file
+		/// limit specified by the IECORE_IMAGECACHE_FILES environment variable.
+		static ImageCache *defaultImageCache();
+
+	private :
+
+		struct MemberData;
+		boost::shared_ptr<MemberData> m_data;
+
+};
+
+} // namespace IECore
+
+#endif // IECORE_IMAGECACHE_H
@@ -58,8 +58,8 @@ class IECORE_API ImagePremultiplyOp : public ChannelOp
 	protected :
 
 		virtual void modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels );
+		virtual void modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow );
 
-		struct ToFloatVectorData;
 		struct PremultFn;
 
 		StringParameterPtr m_alphaChannelNameParameter;
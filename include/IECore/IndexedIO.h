@@ -128,6 +128,7 @@ class IECORE_API IndexedIO : public RunTimeTyped
 		static const EntryIDList rootPath;
 
 		typedef IndexedIOPtr (*CreatorFn)(const std::string &, const EntryIDList &, IndexedIO::OpenMode );
+		typedef bool (*CanReadFn)( const std::string & );
 
 		/// Create an instance of a subclass which is able to open the IndexedIO structure found at "path".
 		/// Files can be opened for Read, Overwrite, or Append.
@@ -135,6 +136,8 @@ class IECORE_API IndexedIO : public RunTimeTyped
 		/// When opening a device in "Write" mode its contents below the root directory are removed.
 		/// For "Append" operations it is possible to write new files, or overwrite existing ones. It is not possible to overwrite entire directories, however.
 		/// \param path A file or directory on disk. The appropriate reader for reading/writing is determined by the path's extension.
+		/// When opening an existing file for reading and the extension isn't recognised, the contents of the file are used to
+		/// identify it instead, using the canRead functions registered by the implementations.
 		/// \param root The root point to 'mount' the structure.
 		/// \param mode A bitwise-ORed combination of constants which determine how the file system should be accessed.
 		static IndexedIOPtr create( const std::string &path, const EntryIDList &root, IndexedIO::OpenMode mode);
@@ -146,10 +149,13 @@ class IECORE_API IndexedIO : public RunTimeTyped
 		/// Static instantation of one of these (with a supported file extension) using a subclass as the template parameter  will register it
 		/// as a supported IndexedIO. This allows read and write operations to be performed generically, with the correct interface to
 		/// use being automatically determined by the system.
+		/// The optional canRead function is used to identify files whose extension doesn't
+		/// match any registered implementation.
 		template<class T>
 		struct Description
 		{
 			Description(const std::string &extension) { IndexedIO::registerCreator( extension, &T::create ); }
+			Description(const std::string &extension, CanReadFn canRead) { IndexedIO::registerCreator( extension, &T::create, canRead ); }
 		};
 
 		virtual ~IndexedIO();
@@ -546,9 +552,15 @@ class IECORE_API IndexedIO : public RunTimeTyped
 
 	private:
 		/// Register a new subclass that can handle the given extension
-		static void registerCreator( const std::string &extension, CreatorFn f );
+		static void registerCreator( const std::string &extension, CreatorFn f, CanReadFn canRead = 0 );
 
-		typedef std::map<std::string, CreatorFn> CreatorMap;
+		struct CreatorFns
+		{
+			CreatorFn creator;
+			CanReadFn canRead;
+		};
+
+		typedef std::map<std::string, CreatorFns> CreatorMap;
 		static CreatorMap &getCreateFns() { static CreatorMap *g_createFns = new CreatorMap(); return *g_createFns; }
 
 };
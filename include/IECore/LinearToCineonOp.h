@@ -65,7 +65,7 @@ class IECORE_API LinearToCineonOp : public ChannelOp
 
 	protected :
 
-		virtual void modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels );
+		virtual void modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow );
 
 		FloatParameterPtr m_filmGamma;
 		IntParameterPtr m_refWhiteVal;
@@ -157,7 +157,9 @@ class IECORE_API LinkedScene : public  SampledSceneInterface
 
 	private :
 
-		LinkedScene( SceneInterface *mainScene, const SceneInterface *linkedScene, int rootLinkDepth, bool readOnly, bool atLink, bool timeRemapped );
+		IE_CORE_FORWARDDECLARE( LinkCache );
+
+		LinkedScene( SceneInterface *mainScene, const SceneInterface *linkedScene, LinkCache *linkCache, int rootLinkDepth, bool readOnly, bool atLink, bool timeRemapped );
 
 		ConstSceneInterfacePtr expandLink( const StringData *fileName, const InternedStringVectorData *root, int &linkDepth );
 
@@ -174,6 +176,10 @@ class IECORE_API LinkedScene : public  SampledSceneInterface
 		bool m_atLink;
 		bool m_sampled;
 		bool m_timeRemapped;
+		// Recently resolved links, shared by all the locations of the scene,
+		// so that link targets aren't resolved on every visit. Limited by
+		// SharedSceneInterfaces::getMaxScenes().
+		LinkCachePtr m_linkCache;
 		// \todo: std::map< Path, LinkedScenes > for quick scene calls... built by scene... dies with the instance (usually only root uses it).
 
 		static const InternedString g_fileName;
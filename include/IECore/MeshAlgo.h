@@ -38,6 +38,8 @@
 #include <vector>
 #include <utility>
 
+#include "OpenEXR/ImathVec.h"
+
 #include "IECore/PrimitiveVariable.h"
 #include "IECore/MeshPrimitive.h"
 
@@ -54,6 +56,39 @@ std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangents( const MeshPri
 	const std::string &position = "P"
 );
 
+/// Merges all the meshes into a single mesh in one pass, sizing the
+/// output data up front and copying topology and primitive variables
+/// in parallel. PrimitiveVariables which are missing from some of the
+/// meshes are expanded using a default value, unless removeNonMatchingPrimVars
+/// is true, in which case they are removed. If faceRanges is passed, it
+/// is filled with the [ start, end ) range of faces originating from
+/// each input mesh. The interpolation of the first mesh is used for the
+/// result.
+MeshPrimitivePtr merge( const std::vector<const MeshPrimitive *> &meshes,
+	bool removeNonMatchingPrimVars = false,
+	std::vector<Imath::V2i> *faceRanges = 0
+);
+
+/// Prepares a mesh for drawing with a GL-style API, in which all data is
+/// supplied as flat arrays with one element per triangle vertex. Faces are
+/// triangulated as fans, as in TriangulateOp, and faces with fewer than three
+/// vertices are discarded. Uniform, Vertex, Varying and FaceVarying
+/// PrimitiveVariables are all expanded to FaceVarying interpolation, as in
+/// FaceVaryingPromotionOp, preserving the interpretation of GeometricData.
+/// Constant PrimitiveVariables are copied unchanged, and others whose data is
+/// not VectorTypedData are omitted from the result. If addMissingNormals is
+/// true and the mesh has no "N" PrimitiveVariable, then normals are computed
+/// as they would be by MeshNormalsOp - faceted for linear meshes and smooth for
+/// subdivision meshes. Throws if "P" is missing or any PrimitiveVariable is
+/// invalid.
+///
+/// \threading The triangulation and the expansion of each PrimitiveVariable
+/// run in parallel using TBB, writing directly into preallocated output data,
+/// and the call blocks until they are complete. The input mesh is not modified,
+/// so it is safe to call concurrently from several threads, provided no thread
+/// is modifying the mesh at the same time.
+MeshPrimitivePtr triangulateAndPromote( const MeshPrimitive *mesh, bool addMissingNormals = true );
+
 } // namespace MeshAlgo
 } // namespace IECore
 
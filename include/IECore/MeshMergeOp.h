@@ -43,6 +43,7 @@ namespace IECore
 {
 
 /// A MeshPrimitiveOp to merge one mesh with another.
+/// \see MeshAlgo::merge() for merging many meshes at once.
 /// \ingroup geometryProcessingGroup
 class IECORE_API MeshMergeOp : public MeshPrimitiveOp
 {
@@ -62,18 +63,6 @@ class IECORE_API MeshMergeOp : public MeshPrimitiveOp
 
 	private :
 
-		struct AppendPrimVars;
-		struct PrependPrimVars;
-		
-		template<class T>
-		struct DefaultValue;
-		
-		template<class T>
-		struct DefaultValue<Imath::Vec3<T> >;
-
-		template<class T>
-		struct DefaultValue<Imath::Vec2<T> >;
-
 		MeshPrimitiveParameterPtr m_meshParameter;
 		BoolParameterPtr m_removePrimVarsParameter;
 
@@ -125,6 +125,18 @@ class IECORE_API MeshPrimitiveEvaluator : public PrimitiveEvaluator
 		virtual int intersectionPoints( const Imath::V3f &origin, const Imath::V3f &direction,
 			std::vector<PrimitiveEvaluator::ResultPtr> &results, float maxDistance = Imath::limits<float>::max() ) const;
 
+		/// A query specific to the MeshPrimitiveEvaluator, which intersects many rays with the mesh in a single call,
+		/// returning the closest hit for each. The rays are traced in parallel, in small packets which share a single
+		/// traversal of the triangleBoundTree(), so this is much faster than repeated calls to intersectionPoint(),
+		/// particularly when the rays are coherent. For each ray, the distance to the hit, the index of the triangle
+		/// hit and the barycentric coordinates of the hit within that triangle are output. Rays which miss are given
+		/// a triangle index of -1. Returns the number of rays which hit.
+		size_t intersectRays(
+			const std::vector<Imath::V3f> &origins, const std::vector<Imath::V3f> &directions,
+			std::vector<float> &distances, std::vector<int> &triangleIndices, std::vector<Imath::V3f> &barycentricCoordinates,
+			float maxDistance = Imath::limits<float>::max()
+		) const;
+
 		/// A query specific to the MeshPrimitiveEvaluator, this just chooses a barycentric position on a specific triangle.
 		bool barycentricPosition( unsigned int triangleIndex, const Imath::V3f &barycentricCoordinates, PrimitiveEvaluator::Result *result ) const;
 
@@ -62,6 +62,7 @@ class IECORE_API NParticleReader : public ParticleReader
 		virtual unsigned long numParticles();
 		virtual void attributeNames( std::vector<std::string> &names );
 		virtual DataPtr readAttribute( const std::string &name );
+		virtual DataPtr readAttributeChunk( const std::string &name, unsigned long firstParticle, unsigned long numParticles );
 		
 		/// returns IntVectorData of all frames contained in the nCache
 		/// the frameIndex parameter should be set using an index into this IntVectorData
@@ -113,7 +114,7 @@ class IECORE_API NParticleReader : public ParticleReader
 		std::map<int, IFFFile::Chunk::ChunkIterator> frameToRootChildren;
 		
 		template<typename T, typename F>
-		typename T::Ptr filterAttr( const F * attr, float percentage );
+		typename T::Ptr filterAttr( const F * attr, float percentage, unsigned long firstParticle );
 };
 
 IE_CORE_DECLAREPTR( NParticleReader );
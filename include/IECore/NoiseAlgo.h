@@ -0,0 +1,66 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_NOISEALGO_H
+#define IECORE_NOISEALGO_H
+
+#include "OpenEXR/ImathVec.h"
+
+#include "IECore/VectorTypedData.h"
+#include "IECore/PerlinNoise.h"
+#include "IECore/Turbulence.h"
+
+namespace IECore
+{
+
+namespace NoiseAlgo
+{
+
+/// Displaces each point in place, using p += amplitude * noise( p * frequency ).
+/// Points are processed in parallel, using the batch form of the noise
+/// evaluation, so this is much faster than evaluating the noise for each point
+/// in turn.
+void displace( V3fVectorData *points, const PerlinNoiseV3fV3f &noise,
+	float frequency = 1.0f, const Imath::V3f &amplitude = Imath::V3f( 1.0f )
+);
+
+/// As above, but using turbulence rather than noise.
+void displace( V3fVectorData *points, const TurbulenceV3fV3f &turbulence,
+	float frequency = 1.0f, const Imath::V3f &amplitude = Imath::V3f( 1.0f )
+);
+
+} // namespace NoiseAlgo
+} // namespace IECore
+
+#endif // IECORE_NOISEALGO_H
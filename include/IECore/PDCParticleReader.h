@@ -39,6 +39,14 @@
 #include "IECore/ParticleReader.h"
 #include "IECore/VectorTypedData.h"
 
+namespace boost
+{
+namespace iostreams
+{
+class mapped_file_source;
+}
+}
+
 namespace IECore
 {
 
@@ -46,6 +54,8 @@ namespace IECore
 /// interface for Maya .pdc format particle caches. Percentage filtering
 /// of loaded particles is seeded using the particleId attribute, so
 /// is not only repeatable but also consistent from frame to frame.
+/// Attribute data is read through a memory mapping of the file where
+/// possible, falling back to regular stream reads otherwise.
 /// \ingroup ioGroup
 class IECORE_API PDCParticleReader : public ParticleReader
 {
@@ -63,6 +73,7 @@ class IECORE_API PDCParticleReader : public ParticleReader
 		virtual unsigned long numParticles();
 		virtual void attributeNames( std::vector<std::string> &names );
 		virtual DataPtr readAttribute( const std::string &name );
+		virtual DataPtr readAttributeChunk( const std::string &name, unsigned long firstParticle, unsigned long numParticles );
 
 	protected:
 		
@@ -93,6 +104,9 @@ class IECORE_API PDCParticleReader : public ParticleReader
 		// returns true on success and false on failure.
 		bool open();
 		std::ifstream *m_iStream;
+		// mapping of the whole file, used in preference to m_iStream
+		// for reading attribute data. may be 0 if mapping failed.
+		boost::iostreams::mapped_file_source *m_mappedFile;
 		std::string m_streamFileName;
 		struct
 		{
@@ -105,9 +119,14 @@ class IECORE_API PDCParticleReader : public ParticleReader
 
 		template<typename T>
 		void readElements( T *buffer, std::streampos pos, unsigned long n ) const;
+		// reads the range of particles from the array attribute starting at pos
+		template<typename T>
+		typename T::Ptr readArray( std::streampos pos, unsigned long firstParticle, unsigned long numParticles ) const;
 
-		// loads particleId in a completely unfiltered state
-		const Data * idAttribute();
+		// loads particleId for the range of particles in a completely unfiltered state.
+		// the ids for the whole file are cached, as they are needed for every attribute
+		// loaded by read().
+		ConstDataPtr idAttribute( unsigned long firstParticle, unsigned long numParticles );
 		DataPtr m_idAttribute;
 
 };
@@ -40,6 +40,7 @@
 #include "IECore/SimpleTypedParameter.h"
 #include "IECore/VectorTypedParameter.h"
 #include "IECore/NumericParameter.h"
+#include "IECore/PointsPrimitive.h"
 
 namespace IECore
 {
@@ -102,6 +103,22 @@ class IECORE_API ParticleReader : public Reader
 		/// exist. The type of Data is chosen automatically to best represent the
 		/// particle data.
 		virtual DataPtr readAttribute( const std::string &name ) = 0;
+		/// Reads the specified attribute for just the particles in the range
+		/// [firstParticle, firstParticle + numParticles), clamped to the number
+		/// of particles in the file. Percentage filtering is applied while reading,
+		/// and is consistent with readAttribute(), so that concatenating the chunks
+		/// for consecutive ranges gives exactly the result readAttribute() would.
+		/// This allows very large caches to be processed in a bounded amount
+		/// of memory. Attributes which don't vary per particle are returned whole
+		/// for every chunk. Returns 0 if the attribute doesn't exist. The default
+		/// implementation throws a NotImplementedException.
+		virtual DataPtr readAttributeChunk( const std::string &name, unsigned long firstParticle, unsigned long numParticles );
+		/// Returns a PointsPrimitive containing the attributes requested in
+		/// parameters() for the particles in the specified range, as returned
+		/// by readAttributeChunk(). Reading a large file in chunks yields the same
+		/// points as read(), without ever holding the whole of any attribute in
+		/// memory.
+		PointsPrimitivePtr readChunk( unsigned long firstParticle, unsigned long numParticles );
 		//@}
 
 	protected :
@@ -131,14 +148,20 @@ class IECORE_API ParticleReader : public Reader
 		/// Convenience function to filter prim vars at a given percentage.
 		/// The filtering is based on the particle id or based on the 
 		/// particle index if no id is provided.
+		/// When reading chunks, firstParticle must be set to the index of the first
+		/// particle in attr, so that filtering without ids remains consistent with a
+		/// read of the whole attribute.
 		template<typename T, typename F>
-		typename T::Ptr filterAttr( const F * attr, float percentage, const Data *idAttr ) const;
+		typename T::Ptr filterAttr( const F * attr, float percentage, const Data *idAttr, unsigned long firstParticle = 0 ) const;
 		
 		/// Returns the name of the original position primVar should we need to convert it to "P"
 		virtual std::string positionPrimVarName() = 0;
 
 	private :
 
+		// Implements both doOperation() and readChunk().
+		PointsPrimitivePtr readPoints( bool chunked, unsigned long firstParticle, unsigned long numParticles );
+
 		template<typename T, typename F, typename U >
 		typename T::Ptr filterAttr( const F * attr, float percentage, const std::vector< U > &ids ) const;
 
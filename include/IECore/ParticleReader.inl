@@ -38,12 +38,13 @@
 #include "OpenEXR/ImathRandom.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/Convert.h"
+#include "IECore/Random.h"
 
 namespace IECore
 {
 
 template<typename T, typename F >
-typename T::Ptr ParticleReader::filterAttr( const F *attr, float percentage, const Data *idAttr ) const
+typename T::Ptr ParticleReader::filterAttr( const F *attr, float percentage, const Data *idAttr, unsigned long firstParticle ) const
 {
 	if( percentage < 100.0f )
 	{
@@ -74,6 +75,8 @@ typename T::Ptr ParticleReader::filterAttr( const F *attr, float percentage, con
 			int seed = particlePercentageSeed();
 			Imath::Rand48 r;
 			r.init( seed );
+			// skip the random numbers belonging to the particles before this chunk
+			rand48Skip( r, firstParticle );
 			for( typename F::ValueType::size_type i=0; i<in.size(); i++ )
 			{
 				if( r.nextf() <= fraction )
@@ -115,10 +115,20 @@ class PerlinNoise
 		/// As above but performs antialiasing using frequency clamping.
 		inline Value operator()( const Point &p, PointBaseType filterWidth ) const;
 
+		/// Computes the noise values for n points, placing the results in
+		/// result. This gives identical results to calling noise() for each
+		/// point individually, but is significantly faster because points are
+		/// processed in batches, with the data arranged so that the compiler
+		/// can vectorise most of the work across the points in a batch.
+		void noise( const Point *p, Value *result, size_t n ) const;
+		/// As above but performs antialiasing using frequency clamping.
+		void noise( const Point *p, Value *result, size_t n, PointBaseType filterWidth ) const;
+
 	private :
 
 		inline Value noiseWalk( int *pi, const Point &pf, int d ) const;
 
+		static const unsigned int m_batchSize = 16;
 		static const unsigned int m_maxPointDimensions = 4;
 		static const unsigned int m_permSize = 256;
 		std::vector<unsigned int> m_perm;
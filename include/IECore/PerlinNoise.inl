@@ -147,6 +147,94 @@ inline typename PerlinNoise<P, V, F>::Value PerlinNoise<P, V, F>::operator()( co
 	return noise( p, filterWidth );
 }
 
+template<typename P, typename V, typename F>
+void PerlinNoise<P, V, F>::noise( const Point *p, Value *result, size_t n ) const
+{
+	const unsigned int numDimensions = PointTraits::dimensions();
+	const unsigned int numCorners = 1 << numDimensions;
+
+	// Per-batch working data, stored with the point index innermost so that
+	// the loops over the batch are amenable to vectorisation. The operations
+	// mirror those in noiseWalk() exactly, so that the results are identical.
+	PointBaseType pc[m_maxPointDimensions][m_batchSize];
+	int pi[m_maxPointDimensions][m_batchSize];
+	PointBaseType falloff[m_maxPointDimensions][m_batchSize];
+	Value corners[1 << m_maxPointDimensions][m_batchSize];
+
+	for( size_t batchBegin = 0; batchBegin < n; batchBegin += m_batchSize )
+	{
+		const size_t batchSize = std::min( n - batchBegin, (size_t)m_batchSize );
+		const Point *batchP = p + batchBegin;
+
+		for( unsigned int d = 0; d < numDimensions; ++d )
+		{
+			for( size_t i = 0; i < batchSize; ++i )
+			{
+				pc[d][i] = vecGet( batchP[i], d );
+				pi[d][i] = fastFloatFloor( pc[d][i] );
+				falloff[d][i] = m_falloff( pc[d][i] - pi[d][i] );
+			}
+		}
+
+		// compute the gradient contribution from each corner of the
+		// lattice cells. bit d of the corner index specifies the offset
+		// in dimension d.
+		for( unsigned int c = 0; c < numCorners; ++c )
+		{
+			for( size_t i = 0; i < batchSize; ++i )
+			{
+				unsigned int perm = 0;
+				for( unsigned int d = 0; d < numDimensions; ++d )
+				{
+					perm = m_perm[ perm+( ( pi[d][i] + ( ( c >> d ) & 1 ) ) & ( m_permSize-1 ) ) ];
+				}
+				const Value *grad = &m_grad[perm*numDimensions];
+				V g( 0 );
+				for( unsigned int d = 0; d < numDimensions; ++d )
+				{
+					g += grad[d] * ( pc[d][i] - ( pi[d][i] + (int)( ( c >> d ) & 1 ) ) );
+				}
+				corners[c][i] = g;
+			}
+		}
+
+		// interpolate between the corners, one dimension at a time,
+		// in the same order as noiseWalk() does.
+		unsigned int numValues = numCorners;
+		for( unsigned int d = 0; d < numDimensions; ++d )
+		{
+			numValues /= 2;
+			for( unsigned int c = 0; c < numValues; ++c )
+			{
+				for( size_t i = 0; i < batchSize; ++i )
+				{
+					corners[c][i] = Imath::lerp( corners[c*2][i], corners[c*2+1][i], falloff[d][i] );
+				}
+			}
+		}
+
+		std::copy( corners[0], corners[0] + batchSize, result + batchBegin );
+	}
+}
+
+template<typename P, typename V, typename F>
+void PerlinNoise<P, V, F>::noise( const Point *p, Value *result, size_t n, PointBaseType filterWidth ) const
+{
+	ValueBaseType w = 1.0 - smoothstep( ValueBaseType( 0.2 ), ValueBaseType( 0.6 ), filterWidth );
+	if( w > 0.0 )
+	{
+		noise( p, result, n );
+		for( size_t i = 0; i < n; ++i )
+		{
+			result[i] = w * result[i];
+		}
+	}
+	else
+	{
+		std::fill( result, result + n, Value( 0 ) );
+	}
+}
+
 template<typename P, typename V, typename F>
 inline typename PerlinNoise<P, V, F>::Value PerlinNoise<P, V, F>::noiseWalk( int *pi, const P &p, int d ) const
 {
@@ -0,0 +1,174 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECORE_PROFILER_H
+#define IECORE_PROFILER_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "boost/noncopyable.hpp"
+
+#include "IECore/Export.h"
+#include "IECore/InternedString.h"
+
+namespace IECore
+{
+
+namespace Detail
+{
+
+struct ProfilerThreadData;
+
+} // namespace Detail
+
+/// A low overhead profiler for finding out where time is spent across
+/// threads. Code is instrumented using the IECORE_PROFILE_SCOPE macro,
+/// which records the time spent in the enclosing scope, and scopes may
+/// be nested to build up a hierarchy of events for each thread. Recorded
+/// events can be exported in the Chrome trace format for viewing in
+/// chrome://tracing, or aggregated into per-name statistics.
+///
+/// Instrumentation only has an effect when IECore is built with the
+/// WITH_PROFILING option, which defines IECORE_WITH_PROFILING - otherwise
+/// IECORE_PROFILE_SCOPE compiles to nothing. Even when built in, nothing is
+/// recorded until setEnabled( true ) is called. The macros should only be
+/// used in source files, never in headers, so that code compiled without
+/// IECORE_WITH_PROFILING sees the same definitions as IECore itself.
+///
+/// IECore itself is instrumented in Op::operate(), Reader::read(), the
+/// StreamIndexedIO read methods, the SceneCache read and write methods, and
+/// the functions which compute values on a miss in the CachedReader,
+/// ImageCache, SceneCache, SharedSceneInterfaces and LinkedScene caches.
+///
+/// \threading All methods may be called while instrumented code is running
+/// on other threads, although the query methods block the threads they are
+/// reading from while they do so.
+/// \ingroup utilityGroup
+class IECORE_API Profiler
+{
+
+	public :
+
+		/// Turns recording on and off. Off by default.
+		static void setEnabled( bool enabled );
+		static bool getEnabled();
+
+		/// Discards all recorded events.
+		static void clear();
+
+		/// Limits the total number of events recorded, so that leaving the
+		/// profiler enabled can't exhaust memory. Each event takes 32 bytes,
+		/// and the default limit is 10 million events. Events beyond the limit
+		/// are discarded, and counted by numDroppedEvents() until the next
+		/// call to clear().
+		static void setMaxEvents( size_t maxEvents );
+		static size_t getMaxEvents();
+		static size_t numDroppedEvents();
+
+		/// Writes all recorded events as Chrome trace event JSON.
+		static void writeChromeTrace( std::ostream &o );
+		static void writeChromeTrace( const std::string &fileName );
+
+		/// Statistics aggregated across all threads for all events
+		/// with the same name. Times are in seconds, and selfTime
+		/// excludes time spent in nested scopes.
+		struct Statistics
+		{
+			Statistics();
+
+			std::string name;
+			size_t count;
+			double totalTime;
+			double selfTime;
+			double maxTime;
+		};
+
+		typedef std::vector<Statistics> StatisticsVector;
+
+		/// Fills the vector with statistics for all recorded events,
+		/// sorted by decreasing selfTime.
+		static void statistics( StatisticsVector &statistics );
+		/// Writes the statistics as a human readable table.
+		static void writeSummary( std::ostream &o );
+
+		/// Records the time spent between construction and destruction.
+		/// Typically used via IECORE_PROFILE_SCOPE rather than directly.
+		class IECORE_API Scope : boost::noncopyable
+		{
+
+			public :
+
+				/// The name must remain valid for the lifetime of the Profiler,
+				/// so should be a string literal. Names computed at runtime should
+				/// be interned by passing an InternedString instead. A null name
+				/// records nothing.
+				Scope( const char *name );
+				Scope( const InternedString &name );
+				~Scope();
+
+			private :
+
+				void begin( const char *name );
+
+				Detail::ProfilerThreadData *m_threadData;
+				Scope *m_parent;
+				const char *m_name;
+				double m_startTime;
+				double m_childTime;
+
+		};
+
+};
+
+} // namespace IECore
+
+#define IECORE_PROFILE_SCOPE_CONCATENATE_INTERNAL( A, B ) A##B
+#define IECORE_PROFILE_SCOPE_CONCATENATE( A, B ) IECORE_PROFILE_SCOPE_CONCATENATE_INTERNAL( A, B )
+
+/// IECORE_PROFILE_SCOPE( NAME ) records the enclosing scope using a string
+/// literal as the name. IECORE_PROFILE_SCOPE_DYNAMIC( NAME ) is for names computed
+/// at runtime - NAME is only evaluated if the profiler is enabled, and is interned
+/// so that it remains valid.
+#ifdef IECORE_WITH_PROFILING
+#define IECORE_PROFILE_SCOPE( NAME ) IECore::Profiler::Scope IECORE_PROFILE_SCOPE_CONCATENATE( profileScope, __LINE__ )( NAME )
+#define IECORE_PROFILE_SCOPE_DYNAMIC( NAME ) IECore::Profiler::Scope IECORE_PROFILE_SCOPE_CONCATENATE( profileScope, __LINE__ )( IECore::Profiler::getEnabled() ? IECore::InternedString( NAME ).c_str() : (const char *)0 )
+#else
+#define IECORE_PROFILE_SCOPE( NAME )
+#define IECORE_PROFILE_SCOPE_DYNAMIC( NAME )
+#endif
+
+#endif // IECORE_PROFILER_H
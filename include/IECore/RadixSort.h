@@ -95,6 +95,21 @@ class IECORE_API RadixSort
 		void checkResize( unsigned int s );
 };
 
+/// Fills sortedIndices with the indices of keys in ascending order of key, so that keys[sortedIndices[0]] is
+/// the smallest key. This matches the output of RadixSort::operator(), but uses a stable LSD radix sort
+/// which runs in parallel, and maintains no state between calls. Key may be float, int or unsigned int.
+/// \ingroup mathGroup
+template<typename Key>
+void parallelRadixSortIndices( const std::vector<Key> &keys, std::vector<unsigned int> &sortedIndices );
+
+/// Sorts keys into ascending order in parallel, applying the same reordering to values, which must
+/// be the same length as keys. The sort is stable. Key may be float, int or unsigned int.
+/// \ingroup mathGroup
+template<typename Key, typename Value>
+void parallelRadixSort( std::vector<Key> &keys, std::vector<Value> &values );
+
 } // namespace IECore
 
+#include "IECore/RadixSort.inl"
+
 #endif // IE_CORE_RADIXSORT_H
@@ -0,0 +1,311 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IE_CORE_RADIXSORT_INL
+#define IE_CORE_RADIXSORT_INL
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+#include "boost/static_assert.hpp"
+#include "boost/type_traits/is_same.hpp"
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+namespace IECore
+{
+
+namespace Detail
+{
+
+// Maps keys onto unsigned ints which sort in the same order,
+// so that all key types can share a single implementation.
+
+inline unsigned int radixSortKey( unsigned int key )
+{
+	return key;
+}
+
+inline unsigned int radixSortKey( int key )
+{
+	return static_cast<unsigned int>( key ) ^ 0x80000000;
+}
+
+inline unsigned int radixSortKey( float key )
+{
+	unsigned int u;
+	std::memcpy( &u, &key, sizeof( u ) );
+	// Negative floats are ordered backwards, so we flip all their bits.
+	// Positive floats just need to be moved above the negatives.
+	return ( u & 0x80000000 ) ? ~u : ( u | 0x80000000 );
+}
+
+struct RadixSortItem
+{
+	unsigned int key;
+	unsigned int index;
+};
+
+// The number of elements processed serially by each block of
+// the parallel passes. Blocks are independent of the number of
+// threads, so the result is deterministic.
+static const size_t g_radixSortBlockSize = 16384;
+
+template<typename Key>
+class RadixSortInitialise
+{
+
+	public :
+
+		RadixSortInitialise( const Key *keys, RadixSortItem *items )
+			:	m_keys( keys ), m_items( items )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_items[i].key = radixSortKey( m_keys[i] );
+				m_items[i].index = i;
+			}
+		}
+
+	private :
+
+		const Key *m_keys;
+		RadixSortItem *m_items;
+
+};
+
+class RadixSortHistogram
+{
+
+	public :
+
+		RadixSortHistogram( const RadixSortItem *items, size_t size, unsigned shift, unsigned int *counts )
+			:	m_items( items ), m_size( size ), m_shift( shift ), m_counts( counts )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t block = r.begin(); block != r.end(); ++block )
+			{
+				unsigned int *counts = m_counts + block * 256;
+				std::memset( counts, 0, 256 * sizeof( unsigned int ) );
+				const size_t end = std::min( m_size, ( block + 1 ) * g_radixSortBlockSize );
+				for( size_t i = block * g_radixSortBlockSize; i < end; ++i )
+				{
+					counts[ ( m_items[i].key >> m_shift ) & 0xff ]++;
+				}
+			}
+		}
+
+	private :
+
+		const RadixSortItem *m_items;
+		size_t m_size;
+		unsigned m_shift;
+		unsigned int *m_counts;
+
+};
+
+class RadixSortScatter
+{
+
+	public :
+
+		RadixSortScatter( const RadixSortItem *source, RadixSortItem *destination, size_t size, unsigned shift, unsigned int *offsets )
+			:	m_source( source ), m_destination( destination ), m_size( size ), m_shift( shift ), m_offsets( offsets )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t block = r.begin(); block != r.end(); ++block )
+			{
+				unsigned int *offsets = m_offsets + block * 256;
+				const size_t end = std::min( m_size, ( block + 1 ) * g_radixSortBlockSize );
+				for( size_t i = block * g_radixSortBlockSize; i < end; ++i )
+				{
+					m_destination[ offsets[ ( m_source[i].key >> m_shift ) & 0xff ]++ ] = m_source[i];
+				}
+			}
+		}
+
+	private :
+
+		const RadixSortItem *m_source;
+		RadixSortItem *m_destination;
+		size_t m_size;
+		unsigned m_shift;
+		unsigned int *m_offsets;
+
+};
+
+// Sorts items in place, using temp as scratch space. Each of the four 8 bit
+// passes computes per-block histograms in parallel, turns them into per-block
+// output offsets, and then scatters each block in parallel. Because each block
+// writes its elements in order to its own output ranges, the sort is stable.
+inline void parallelRadixSortItems( std::vector<RadixSortItem> &items, std::vector<RadixSortItem> &temp )
+{
+	const size_t size = items.size();
+	const size_t numBlocks = ( size + g_radixSortBlockSize - 1 ) / g_radixSortBlockSize;
+	temp.resize( size );
+
+	std::vector<unsigned int> counts( numBlocks * 256 );
+	for( unsigned shift = 0; shift < 32; shift += 8 )
+	{
+		RadixSortHistogram histogram( &items[0], size, shift, &counts[0] );
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, numBlocks, 1 ), histogram );
+
+		// Convert the counts into offsets, skipping the pass entirely
+		// if every element falls into the same bucket.
+
+		bool skip = false;
+		unsigned int offset = 0;
+		for( unsigned digit = 0; digit < 256 && !skip; ++digit )
+		{
+			const unsigned int digitStart = offset;
+			for( size_t block = 0; block < numBlocks; ++block )
+			{
+				unsigned int &c = counts[block * 256 + digit];
+				const unsigned int count = c;
+				c = offset;
+				offset += count;
+			}
+			skip = offset - digitStart == size;
+		}
+
+		if( skip )
+		{
+			continue;
+		}
+
+		RadixSortScatter scatter( &items[0], &temp[0], size, shift, &counts[0] );
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, numBlocks, 1 ), scatter );
+		items.swap( temp );
+	}
+}
+
+template<typename T>
+class RadixSortGather
+{
+
+	public :
+
+		RadixSortGather( const std::vector<RadixSortItem> &items, const std::vector<T> &source, std::vector<T> &destination )
+			:	m_items( items ), m_source( source ), m_destination( destination )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_destination[i] = m_source[ m_items[i].index ];
+			}
+		}
+
+	private :
+
+		const std::vector<RadixSortItem> &m_items;
+		const std::vector<T> &m_source;
+		std::vector<T> &m_destination;
+
+};
+
+template<typename Key>
+void parallelRadixSortItems( const std::vector<Key> &keys, std::vector<RadixSortItem> &items )
+{
+	BOOST_STATIC_ASSERT( sizeof( Key ) == 4 );
+
+	items.resize( keys.size() );
+	if( keys.empty() )
+	{
+		return;
+	}
+
+	RadixSortInitialise<Key> initialise( &keys[0], &items[0] );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, keys.size() ), initialise );
+
+	std::vector<RadixSortItem> temp;
+	parallelRadixSortItems( items, temp );
+}
+
+} // namespace Detail
+
+template<typename Key>
+void parallelRadixSortIndices( const std::vector<Key> &keys, std::vector<unsigned int> &sortedIndices )
+{
+	std::vector<Detail::RadixSortItem> items;
+	Detail::parallelRadixSortItems( keys, items );
+
+	sortedIndices.resize( items.size() );
+	for( size_t i = 0, e = items.size(); i < e; ++i )
+	{
+		sortedIndices[i] = items[i].index;
+	}
+}
+
+template<typename Key, typename Value>
+void parallelRadixSort( std::vector<Key> &keys, std::vector<Value> &values )
+{
+	// Neighbouring elements of a std::vector<bool> share storage,
+	// so they can't be written concurrently.
+	BOOST_STATIC_ASSERT( !( boost::is_same<Value, bool>::value ) );
+	assert( keys.size() == values.size() );
+
+	std::vector<Detail::RadixSortItem> items;
+	Detail::parallelRadixSortItems( keys, items );
+
+	const tbb::blocked_range<size_t> range( 0, items.size() );
+
+	std::vector<Key> sortedKeys( keys.size() );
+	Detail::RadixSortGather<Key> keyGather( items, keys, sortedKeys );
+	tbb::parallel_for( range, keyGather );
+	keys.swap( sortedKeys );
+
+	std::vector<Value> sortedValues( values.size() );
+	Detail::RadixSortGather<Value> valueGather( items, values, sortedValues );
+	tbb::parallel_for( range, valueGather );
+	values.swap( sortedValues );
+}
+
+} // namespace IECore
+
+#endif // IE_CORE_RADIXSORT_INL
@@ -53,6 +53,12 @@ Vec triangleRand( const Vec &v0, const Vec &v1, const Vec &v2, Rand &rand );
 template<class Vec, class Rand>
 Vec cosineHemisphereRand( Rand &rand );
 
+/// Advances the generator by n steps, leaving it in the same state as n calls
+/// to nextf() or nexti() would, but in O( log n ) time. This is useful for
+/// generating the values for one section of a long sequence without generating
+/// all the values that come before it.
+inline void rand48Skip( Imath::Rand48 &rand, unsigned long n );
+
 } // namespace IECore
 
 #include "IECore/Random.inl"
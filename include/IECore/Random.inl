@@ -35,6 +35,11 @@
 #ifndef IECORE_RANDOM_INL
 #define IECORE_RANDOM_INL
 
+#include <cstring>
+
+#include "boost/cstdint.hpp"
+#include "boost/static_assert.hpp"
+
 #include "OpenEXR/ImathMath.h"
 #include "OpenEXR/ImathVec.h"
 
@@ -76,6 +81,42 @@ Vec cosineHemisphereRand( Rand &rand )
 	return result;
 }
 
+inline void rand48Skip( Imath::Rand48 &rand, unsigned long n )
+{
+	// Rand48 is a linear congruential generator, x' = ( a * x + c ) mod 2^48, and
+	// n steps of it can be combined into a single step with a multiplier and increment
+	// computed by repeated squaring. Rand48 has no accessors for its state, which is
+	// held as three shorts in the layout used by erand48(), so we access it directly.
+	BOOST_STATIC_ASSERT( sizeof( Imath::Rand48 ) == 3 * sizeof( unsigned short ) );
+	unsigned short state[3];
+	memcpy( state, &rand, sizeof( state ) );
+
+	const boost::uint64_t mask = ( (boost::uint64_t)1 << 48 ) - 1;
+	boost::uint64_t a = (boost::uint64_t)0x5DEECE66D;
+	boost::uint64_t c = 0xB;
+	boost::uint64_t nA = 1;
+	boost::uint64_t nC = 0;
+	while( n )
+	{
+		if( n & 1 )
+		{
+			nA = ( nA * a ) & mask;
+			nC = ( nC * a + c ) & mask;
+		}
+		c = ( ( a + 1 ) * c ) & mask;
+		a = ( a * a ) & mask;
+		n >>= 1;
+	}
+
+	boost::uint64_t x = (boost::uint64_t)state[0] | (boost::uint64_t)state[1] << 16 | (boost::uint64_t)state[2] << 32;
+	x = ( nA * x + nC ) & mask;
+
+	state[0] = (unsigned short)( x & 0xFFFF );
+	state[1] = (unsigned short)( ( x >> 16 ) & 0xFFFF );
+	state[2] = (unsigned short)( ( x >> 32 ) & 0xFFFF );
+	memcpy( &rand, state, sizeof( state ) );
+}
+
 } // namespace IECore
 
 #endif // IECORE_RANDOM_INL
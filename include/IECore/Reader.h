@@ -36,6 +36,7 @@
 #define IE_CORE_READER_H
 
 #include <map>
+#include <set>
 #include <vector>
 
 #include "boost/function.hpp"
@@ -107,7 +108,32 @@ class IECORE_API Reader : public Op
 		/// canRead functions are called in a last ditch attempt to find a suitable reader. Typically
 		/// you will not call this function directly to register a reader type - you will instead use
 		/// the ReaderDescription registration utility class below.
-		static void registerReader( const std::string &extensions, CanReadFn canRead, CreatorFn creator, TypeId typeId );
+		///
+		/// The optional magicNumbers argument specifies the bytes found at the start of any file the
+		/// Reader can read, as space separated hexadecimal strings (e.g. "49492a00 4d4d002a"). When
+		/// these are provided, create() reads the start of the file once and uses it to rule Readers
+		/// in or out without calling their canRead functions, which typically each open the file again.
+		/// A Reader whose magic number is the only one to match is created without calling canRead at
+		/// all, so the magic numbers must only be provided if they are sufficient to identify the format,
+		/// unless another Reader registers the same ones. In that case canRead is used to choose between them.
+		static void registerReader( const std::string &extensions, CanReadFn canRead, CreatorFn creator, TypeId typeId, const std::string &magicNumbers = "" );
+
+		/// Counts of the work performed by create(), to aid in diagnosing slow
+		/// format detection. Every header read and canRead call typically
+		/// corresponds to the opening of a file.
+		struct CreateStatistics
+		{
+			CreateStatistics();
+			size_t creates;
+			size_t headerReads;
+			size_t canReadCalls;
+			size_t magicNumberMatches;
+		};
+
+		/// Returns the statistics accumulated since the last call to
+		/// resetCreateStatistics().
+		static CreateStatistics createStatistics();
+		static void resetCreateStatistics();
 		//@}
 		
 	protected :
@@ -123,12 +149,13 @@ class IECORE_API Reader : public Op
 		/// it is constructed. It assumes your Reader class has a constructor taking a fileName as
 		/// const std::string and also has a static canRead function matching the CanReadFn type.
 		/// Please note that it is essential that the canRead function simply returns true or false
-		/// and does not throw exceptions under any circumstances.
+		/// and does not throw exceptions under any circumstances. See registerReader() for a
+		/// description of the optional magicNumbers argument.
 		template<class T>
 		class ReaderDescription
 		{
 			public :
-				ReaderDescription( const std::string &extensions );
+				ReaderDescription( const std::string &extensions, const std::string &magicNumbers = "" );
 			private :
 				static ReaderPtr creator( const std::string &fileName );
 		};
@@ -142,10 +169,15 @@ class IECORE_API Reader : public Op
 			CreatorFn creator;
 			CanReadFn canRead;
 			TypeId typeId;
+			std::vector<std::string> magicNumbers;
 		};
-		typedef std::multimap<std::string, ReaderFns> ExtensionsToFnsMap;
+		typedef std::multimap<std::string, const ReaderFns *> ExtensionsToFnsMap;
 		static ExtensionsToFnsMap *extensionsToFns();
 
+		class FileHeader;
+		template<typename Iterator>
+		static const ReaderFns *findReader( Iterator begin, Iterator end, const std::string &fileName, FileHeader &header, std::set<const ReaderFns *> &visited );
+
 };
 
 } // namespace IECore
@@ -39,9 +39,9 @@ namespace IECore
 {
 
 template<class T>
-Reader::ReaderDescription<T>::ReaderDescription( const std::string &extensions )
+Reader::ReaderDescription<T>::ReaderDescription( const std::string &extensions, const std::string &magicNumbers )
 {
-	Reader::registerReader( extensions, T::canRead, creator, T::staticTypeId() );
+	Reader::registerReader( extensions, T::canRead, creator, T::staticTypeId(), magicNumbers );
 }
 
 template<class T>
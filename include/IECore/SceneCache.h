@@ -136,6 +136,33 @@ class IECORE_API SceneCache : public SampledSceneInterface
 
 		/// tells you if this scene cache is read only or writable:
 		bool readOnly() const;
+
+		/// Storage options for the primitive variables of objects written
+		/// with writeObject(). Anything other than FullPrecision trades precision
+		/// for file size, and is decoded transparently by readObject() and
+		/// readObjectPrimitiveVariables(). Only FloatVectorData, V2fVectorData and
+		/// V3fVectorData can be stored at reduced precision - other types are
+		/// always written at full precision.
+		enum PrimitiveVariableStorage
+		{
+			FullPrecision = 0,
+			/// Each component is stored as a 16 bit half.
+			HalfPrecision = 1,
+			/// Each component is stored as a 16 bit fixed point value relative to
+			/// the bounds of the data itself (the object bound in the case of "P"),
+			/// giving a maximum error of 1/131070th of the extent of the data.
+			FixedPoint = 2,
+			/// V3fVectorData of unit length (typically normals) is stored as a pair of
+			/// 16 bit octahedral coordinates, giving an angular error of less than 0.01
+			/// degrees. Vector lengths are not preserved.
+			Octahedral = 3
+		};
+
+		/// Sets the storage used for the named primitive variable in all objects
+		/// subsequently written to the file, at any location. Only available in
+		/// Write mode.
+		void setPrimitiveVariableStorage( const Name &primVarName, PrimitiveVariableStorage storage );
+		PrimitiveVariableStorage getPrimitiveVariableStorage( const Name &primVarName ) const;
 		
 		// The attribute names used to mark animated topology and primitive variables
 		// when SceneCache objects are Primitives.
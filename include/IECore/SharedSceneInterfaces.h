@@ -53,6 +53,25 @@ class IECORE_API SharedSceneInterfaces
 		
 		/// Clear the entire cache
 		static void clear();
+
+		/// Sets the maximum number of scenes which will be held open by the cache.
+		/// The default is 200, or the value of the IECORE_SHAREDSCENEINTERFACES_MAXSCENES
+		/// environment variable if it is set. This also limits the number of resolved
+		/// links kept open by each LinkedScene.
+		static void setMaxScenes( size_t maxScenes );
+		static size_t getMaxScenes();
+		/// Returns the number of scenes currently held open by the cache.
+		static size_t numScenes();
+
+		/// Returns the number of times a file has been opened by the cache since
+		/// startup or the last call to resetStatistics().
+		static size_t numOpens();
+		/// Returns the number of opens which were for files that had already
+		/// been opened and subsequently discarded from the cache. A high number
+		/// relative to numOpens() indicates that the cache is too small for the
+		/// working set of scenes.
+		static size_t numReopens();
+		static void resetStatistics();
 	
 	private :
 		
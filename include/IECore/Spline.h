@@ -86,6 +86,9 @@ class Spline
 
 		/// Uses solve() to evaluate the y value for a given x position.
 		inline Y operator() ( X x ) const;
+		/// Evaluates the y values for n x positions, placing the results in y.
+		/// When evaluating many values it may be much quicker to use a BakedSpline.
+		inline void evaluate( const X *x, Y *y, size_t n ) const;
 
 		/// Returns dY/dX at given X.
 		inline Y derivative( X x ) const;
@@ -204,6 +204,15 @@ inline Y Spline<X,Y>::operator() ( X x ) const
 	return c[0] * y[0] + c[1] * y[1] + c[2] * y[2] + c[3] * y[3];
 }
 
+template<typename X, typename Y>
+inline void Spline<X,Y>::evaluate( const X *x, Y *y, size_t n ) const
+{
+	for( size_t i = 0; i < n; ++i )
+	{
+		y[i] = (*this)( x[i] );
+	}
+}
+
 template<typename X, typename Y>
 inline Y Spline<X,Y>::derivative( X x ) const
 {
@@ -35,8 +35,11 @@
 #ifndef IECORE_SPLINEDATA_H
 #define IECORE_SPLINEDATA_H
 
+#include "boost/shared_ptr.hpp"
+
 #include "IECore/TypedData.h"
 #include "IECore/Spline.h"
+#include "IECore/BakedSpline.h"
 
 namespace IECore
 {
@@ -48,6 +51,14 @@ IECORE_DECLARE_TYPEDDATA( SplineddData, Splinedd, void, SharedDataHolder )
 IECORE_DECLARE_TYPEDDATA( SplinefColor3fData, SplinefColor3f, void, SharedDataHolder )
 IECORE_DECLARE_TYPEDDATA( SplinefColor4fData, SplinefColor4f, void, SharedDataHolder )
 
+/// Returns a baked form of the spline held by data, for use when evaluating
+/// it many times. Baked splines are cached using the hash of the data, so
+/// repeated calls for the same spline only bake it once.
+IECORE_API boost::shared_ptr<const BakedSplineff> bakedSpline( const SplineffData *data );
+IECORE_API boost::shared_ptr<const BakedSplinedd> bakedSpline( const SplineddData *data );
+IECORE_API boost::shared_ptr<const BakedSplinefColor3f> bakedSpline( const SplinefColor3fData *data );
+IECORE_API boost::shared_ptr<const BakedSplinefColor4f> bakedSpline( const SplinefColor4fData *data );
+
 }
 
 #endif // IECORE_SPLINEDATA_H
@@ -64,16 +64,40 @@ class SweepAndPrune
 			ZYX
 		} AxisOrder;
 
+		typedef std::pair<BoundIterator, BoundIterator> IntersectingPair;
+		typedef std::vector<IntersectingPair> IntersectingPairs;
+
 		SweepAndPrune();
 		virtual ~SweepAndPrune();
 
 		void intersectingBounds( BoundIterator first, BoundIterator last, Callback &cb, AxisOrder axisOrder = XZY );
 
+		/// Performs the same query as intersectingBounds(), but sorts and sweeps the bounds using
+		/// multiple threads. The callback is called concurrently from those threads, and must
+		/// therefore be thread safe.
+		void parallelIntersectingBounds( BoundIterator first, BoundIterator last, Callback &cb, AxisOrder axisOrder = XZY );
+		/// As above, but rather than using a callback, the intersecting pairs are gathered
+		/// separately by each thread and then appended to pairs. No synchronisation is
+		/// needed during the sweep, but the order of the pairs is unspecified.
+		void parallelIntersectingBounds( BoundIterator first, BoundIterator last, IntersectingPairs &pairs, AxisOrder axisOrder = XZY );
+
 	protected:
 
-		inline bool axisIntersects( const Bound &b1, const Bound &b2, char axis );
+		static inline bool axisIntersects( const Bound &b1, const Bound &b2, char axis );
 
 		RadixSort m_radixSort;
+
+	private :
+
+		static void axisOrderToAxes( AxisOrder axisOrder, char axes[3] );
+
+		template<typename F>
+		void parallelSweep( BoundIterator first, BoundIterator last, F &f, AxisOrder axisOrder );
+
+		template<typename F>
+		class ParallelSweep;
+		class GatherPairs;
+
 };
 
 } // namespace IECore
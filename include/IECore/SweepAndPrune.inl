@@ -42,6 +42,10 @@
 
 #include "boost/static_assert.hpp"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+
 #include "IECore/BoxTraits.h"
 #include "IECore/VectorOps.h"
 
@@ -72,19 +76,9 @@ bool SweepAndPrune<BoundIterator, CB>::axisIntersects( const Bound &b0, const Bo
 }
 
 template<typename BoundIterator, template<typename> class CB>
-void SweepAndPrune<BoundIterator, CB>::intersectingBounds( BoundIterator first, BoundIterator last, typename SweepAndPrune<BoundIterator, CB>::Callback &cb, AxisOrder axisOrder )
+void SweepAndPrune<BoundIterator, CB>::axisOrderToAxes( AxisOrder axisOrder, char axes[3] )
 {
-	unsigned long numBounds = std::distance( first, last );
-
-	/// Can't radix sort more than this!
-	assert( numBounds <= std::numeric_limits< uint32_t >::max() );
-
-	if (! numBounds )
-	{
-		return;
-	}
-
-	char axes[3] = { 0, 1, 2 };
+	axes[0] = 0; axes[1] = 1; axes[2] = 2;
 
 	switch (axisOrder)
 	{
@@ -105,6 +99,23 @@ void SweepAndPrune<BoundIterator, CB>::intersectingBounds( BoundIterator first,
 	}
 
 	assert( axes[0] + axes[1] + axes[2] == 3 );
+}
+
+template<typename BoundIterator, template<typename> class CB>
+void SweepAndPrune<BoundIterator, CB>::intersectingBounds( BoundIterator first, BoundIterator last, typename SweepAndPrune<BoundIterator, CB>::Callback &cb, AxisOrder axisOrder )
+{
+	unsigned long numBounds = std::distance( first, last );
+
+	/// Can't radix sort more than this!
+	assert( numBounds <= std::numeric_limits< uint32_t >::max() );
+
+	if (! numBounds )
+	{
+		return;
+	}
+
+	char axes[3];
+	axisOrderToAxes( axisOrder, axes );
 
 	typedef std::pair< bool, BoundIterator> IntervalId;
 
@@ -172,6 +183,145 @@ void SweepAndPrune<BoundIterator, CB>::intersectingBounds( BoundIterator first,
 	}
 }
 
+// The parallel sweep sorts the bounds by their minimum along the first axis, and then
+// for each bound scans forwards through the bounds which start before it ends. Each bound
+// can be scanned independently, so this parallelises trivially. Extents are sorted at
+// float precision, which is sufficient to order the scan because the conversion is
+// monotonic - full precision is always used for the intersection tests themselves.
+template<typename BoundIterator, template<typename> class CB>
+template<typename F>
+class SweepAndPrune<BoundIterator, CB>::ParallelSweep
+{
+
+	public :
+
+		ParallelSweep( const std::vector<BoundIterator> &bounds, const std::vector<unsigned int> &order, const std::vector<float> &sortedMins, const char *axes, F &f )
+			:	m_bounds( bounds ), m_order( order ), m_sortedMins( sortedMins ), m_axes( axes ), m_f( f )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			const size_t numBounds = m_order.size();
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				const BoundIterator b0 = m_bounds[ m_order[i] ];
+				const float max0 = vecGet( BoxTraits<Bound>::max( *b0 ), m_axes[0] );
+
+				for( size_t j = i + 1; j < numBounds && m_sortedMins[j] <= max0; ++j )
+				{
+					const BoundIterator b1 = m_bounds[ m_order[j] ];
+					if(
+						axisIntersects( *b0, *b1, m_axes[0] ) &&
+						axisIntersects( *b0, *b1, m_axes[1] ) &&
+						axisIntersects( *b0, *b1, m_axes[2] )
+					)
+					{
+						assert( b0->intersects( *b1 ) );
+						// Same argument order as the serial sweep, which passes the
+						// newly started bound first.
+						m_f( b1, b0 );
+					}
+				}
+			}
+		}
+
+	private :
+
+		const std::vector<BoundIterator> &m_bounds;
+		const std::vector<unsigned int> &m_order;
+		const std::vector<float> &m_sortedMins;
+		const char *m_axes;
+		F &m_f;
+
+};
+
+template<typename BoundIterator, template<typename> class CB>
+class SweepAndPrune<BoundIterator, CB>::GatherPairs
+{
+
+	public :
+
+		void operator()( BoundIterator b0, BoundIterator b1 )
+		{
+			m_pairs.local().push_back( IntersectingPair( b0, b1 ) );
+		}
+
+		void appendTo( IntersectingPairs &pairs )
+		{
+			size_t size = pairs.size();
+			for( typename tbb::enumerable_thread_specific<IntersectingPairs>::const_iterator it = m_pairs.begin(); it != m_pairs.end(); ++it )
+			{
+				size += it->size();
+			}
+			pairs.reserve( size );
+
+			for( typename tbb::enumerable_thread_specific<IntersectingPairs>::const_iterator it = m_pairs.begin(); it != m_pairs.end(); ++it )
+			{
+				pairs.insert( pairs.end(), it->begin(), it->end() );
+			}
+		}
+
+	private :
+
+		tbb::enumerable_thread_specific<IntersectingPairs> m_pairs;
+
+};
+
+template<typename BoundIterator, template<typename> class CB>
+template<typename F>
+void SweepAndPrune<BoundIterator, CB>::parallelSweep( BoundIterator first, BoundIterator last, F &f, AxisOrder axisOrder )
+{
+	const unsigned long numBounds = std::distance( first, last );
+
+	/// Can't radix sort more than this!
+	assert( numBounds <= std::numeric_limits< uint32_t >::max() );
+
+	if( !numBounds )
+	{
+		return;
+	}
+
+	char axes[3];
+	axisOrderToAxes( axisOrder, axes );
+
+	std::vector<BoundIterator> bounds;
+	std::vector<float> mins;
+	bounds.reserve( numBounds );
+	mins.reserve( numBounds );
+	for( BoundIterator it = first; it != last; ++it )
+	{
+		bounds.push_back( it );
+		mins.push_back( vecGet( BoxTraits<Bound>::min( *it ), axes[0] ) );
+	}
+
+	std::vector<unsigned int> order;
+	parallelRadixSortIndices( mins, order );
+
+	std::vector<float> sortedMins( numBounds );
+	for( size_t i = 0; i < numBounds; ++i )
+	{
+		sortedMins[i] = mins[ order[i] ];
+	}
+
+	ParallelSweep<F> sweep( bounds, order, sortedMins, axes, f );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numBounds ), sweep );
+}
+
+template<typename BoundIterator, template<typename> class CB>
+void SweepAndPrune<BoundIterator, CB>::parallelIntersectingBounds( BoundIterator first, BoundIterator last, Callback &cb, AxisOrder axisOrder )
+{
+	parallelSweep( first, last, cb, axisOrder );
+}
+
+template<typename BoundIterator, template<typename> class CB>
+void SweepAndPrune<BoundIterator, CB>::parallelIntersectingBounds( BoundIterator first, BoundIterator last, IntersectingPairs &pairs, AxisOrder axisOrder )
+{
+	GatherPairs gatherPairs;
+	parallelSweep( first, last, gatherPairs, axisOrder );
+	gatherPairs.appendTo( pairs );
+}
+
 } // namespace IECore
 
 
@@ -95,8 +95,8 @@ class IECORE_API TIFFImageWriter : public ImageWriter
 		                         const ImagePrimitive * image,
 		                         const Imath::Box2i &dataWindow	) const;
 
-		template<typename ChannelData>
-		struct ChannelConverter;
+		template<typename T>
+		struct ChannelInterleaver;
 
 		template<typename T>
 		void encodeChannels( const ImagePrimitive * image, const std::vector<std::string> &names,
@@ -51,6 +51,7 @@ Turbulence<N>::Turbulence( const Turbulence &other )
 	:	m_octaves( other.m_octaves ), m_gain( other.m_gain ), m_lacunarity( other.m_lacunarity ),
 		m_turbulent( other.m_turbulent ), m_noise( other.m_noise )
 {
+	calculateScaleAndOffset();
 }
 
 template<typename N>
@@ -177,6 +178,66 @@ typename Turbulence<N>::Value Turbulence<N>::turbulence( const Point &p, PointBa
 	return result;
 }
 
+template<typename N>
+void Turbulence<N>::turbulence( const Point *p, Value *result, size_t n ) const
+{
+	turbulence( p, result, n, 1.0e-6 );
+}
+
+template<typename N>
+void Turbulence<N>::turbulence( const Point *p, Value *result, size_t n, PointBaseType filterWidth ) const
+{
+	Point pp[m_batchSize];
+	Value v[m_batchSize];
+
+	for( size_t batchBegin = 0; batchBegin < n; batchBegin += m_batchSize )
+	{
+		const size_t batchSize = std::min( n - batchBegin, (size_t)m_batchSize );
+		const Point *batchP = p + batchBegin;
+		Value *batchResult = result + batchBegin;
+
+		for( size_t j=0; j<batchSize; j++ )
+		{
+			vecSetAll( batchResult[j], 0 );
+		}
+
+		// this mirrors the single point version exactly, so as to
+		// give identical results.
+		Point frequency; vecSetAll( frequency, 1 );
+		Value scale; vecSetAll( scale, 1 );
+		PointBaseType octaveFilterWidth = filterWidth;
+		for( unsigned int i=0; i<m_octaves; i++ )
+		{
+			for( size_t j=0; j<batchSize; j++ )
+			{
+				vecMul( batchP[j], frequency, pp[j] );
+			}
+			m_noise.noise( pp, v, batchSize, octaveFilterWidth );
+			for( size_t j=0; j<batchSize; j++ )
+			{
+				vecMul( v[j], scale, v[j] );
+				if( m_turbulent )
+				{
+					for( unsigned int k=0; k<VectorTraits<Value>::dimensions(); k++ )
+					{
+						vecSet( v[j], k, Imath::Math<ValueBaseType>::fabs( vecGet( v[j], k ) ) );
+					}
+				}
+				vecAdd( batchResult[j], v[j], batchResult[j] );
+			}
+			vecMul( scale, m_gain, scale );
+			vecMul( frequency, m_lacunarity, frequency );
+			octaveFilterWidth *= m_lacunarity;
+		}
+
+		for( size_t j=0; j<batchSize; j++ )
+		{
+			vecMul( batchResult[j], m_scale, batchResult[j] );
+			vecAdd( batchResult[j], m_offset, batchResult[j] );
+		}
+	}
+}
+
 } // namespace IECore
 
 #endif // IE_CORE_TURBULENCE_INL
@@ -0,0 +1,64 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_PRIMITIVEMERGE_H
+#define IECORE_PRIMITIVEMERGE_H
+
+#include <vector>
+
+#include "IECore/Primitive.h"
+
+namespace IECore
+{
+namespace Detail
+{
+
+/// Fills offsets with the position at which the primitive variable data of each
+/// input starts within the merged primitive variable data of the specified
+/// interpolation. The final entry holds the total merged size, so offsets
+/// will contain inputs.size() + 1 entries.
+void primitiveMergeOffsets( const std::vector<const Primitive *> &inputs, PrimitiveVariable::Interpolation interpolation, std::vector<size_t> &offsets );
+
+/// Adds the primitive variables of all the inputs to result, which must already have had
+/// the merged topology applied. Primitive variable data is sized up front and then copied
+/// in parallel. Variables that are missing from an input (or which have a different type or
+/// interpolation to the first input which provides them) are either filled with a default
+/// value or removed entirely, depending on removeNonMatchingPrimVars. Constant variables are
+/// taken from the first input which provides them.
+void mergePrimitiveVariables( const std::vector<const Primitive *> &inputs, Primitive *result, bool removeNonMatchingPrimVars );
+
+} // namespace Detail
+} // namespace IECore
+
+#endif // IECORE_PRIMITIVEMERGE_H
@@ -57,13 +57,53 @@ class IECOREGL_API CachedConverter : public IECore::RefCounted
 		/// Returns the object converted to an appropriate IECoreGL type, reusing
 		/// a previous conversion where possible.
 		IECore::ConstRunTimeTypedPtr convert( const IECore::Object *object );
-		
+
+		/// Asynchronous conversion
+		////////////////////////////////////////////////////////////
+		//@{
+		/// Returns true if the object can be converted by convertAsync()
+		/// on a background thread. This is the case for the IECore mesh,
+		/// curves and points primitives, whose conversions do not require
+		/// a gl context.
+		static bool asyncConvertible( const IECore::Object *object );
+		/// As for convert(), but returns immediately rather than waiting for
+		/// the conversion to complete. If a previous conversion is available
+		/// it is returned, and ready is set to true. Otherwise the conversion
+		/// is started on a background thread, ready is set to false, and a
+		/// BoxPrimitive matching the bound of the object is returned, so that
+		/// clients have something to draw in the meantime. Completed conversions
+		/// only become visible to convertAsync() once processPending() has been
+		/// called. If a background conversion fails, the error is reported once
+		/// and the placeholder is cached in place of the result, so that it is
+		/// returned with ready set to true until it is evicted from the cache or
+		/// clear() is called. Objects which are not asyncConvertible() are converted
+		/// immediately.
+		IECore::ConstRunTimeTypedPtr convertAsync( const IECore::Object *object, bool &ready );
+		/// Transfers completed background conversions into the cache, returning
+		/// the number transferred. The background threads only prepare the cpu side
+		/// data, and the vertex buffers for each newly transferred primitive are
+		/// created here. To avoid stalls the transfers are limited to approximately
+		/// maxMemory bytes of source data per call - it is expected that this is called
+		/// once per redraw from the main opengl thread. At least one conversion is
+		/// always transferred, so that progress is guaranteed.
+		size_t processPending( size_t maxMemory = 64 * 1024 * 1024 );
+		/// Returns the number of conversions which have been started by convertAsync()
+		/// but not yet transferred by processPending().
+		size_t numPending() const;
+		//@}
+
 		/// Returns the maximum amount of memory (in bytes) the cache will use.
 		size_t getMaxMemory() const;
 		/// Sets the maximum amount of memory the cache will use. If this
 		/// is less than memoryUsage() then cache removals will result.
 		void setMaxMemory( size_t maxMemory );
 
+		/// Removes all conversions from the cache, including the placeholders
+		/// cached for failed asynchronous conversions, so that they will be
+		/// converted again when next requested. Must be called from the main
+		/// opengl thread.
+		void clear();
+
 		/// The CachedConverter removes items from the cache during convert()
 		/// whenever it needs to free memory to make way for the new conversion.
 		/// However, if the call to convert() is made on a thread for which there's
@@ -0,0 +1,361 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <map>
+
+#include "boost/bind.hpp"
+#include "boost/format.hpp"
+#include "boost/tuple/tuple.hpp"
+#include "boost/tuple/tuple_comparison.hpp"
+
+#include "tbb/atomic.h"
+#include "tbb/concurrent_queue.h"
+#include "tbb/tbb_thread.h"
+#include "tbb/tick_count.h"
+
+#include "IECore/AsyncMessageHandler.h"
+#include "IECore/Exception.h"
+
+using namespace IECore;
+
+namespace
+{
+
+// The maximum number of distinct messages we track repeats
+// for, before outputting the summaries without waiting
+// for flush().
+const size_t g_maxRepeatCounts = 10000;
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Implementation
+//////////////////////////////////////////////////////////////////////////
+
+class AsyncMessageHandler::Implementation
+{
+
+	public :
+
+		Implementation( MessageHandler *handler, size_t maxQueueSize, size_t maxRepeats, double repeatWindow )
+			:	m_handler( handler ), m_maxRepeats( maxRepeats ), m_repeatWindow( repeatWindow ), m_lastRepeatExpiry( tbb::tick_count::now() )
+		{
+			m_numDropped = 0;
+			m_numDroppedSinceFlush = 0;
+			m_numCoalesced = 0;
+
+			m_queue.set_capacity( maxQueueSize );
+
+			tbb::tbb_thread thread( boost::bind( &Implementation::outputThread, this ) );
+			m_thread.swap( thread );
+		}
+
+		~Implementation()
+		{
+			// we use the blocking push() for control messages,
+			// because they must never be dropped.
+			m_queue.push( Message( Message::Stop ) );
+			m_thread.join();
+		}
+
+		void handle( Level level, const std::string &context, const std::string &message )
+		{
+			if( !m_queue.try_push( Message( level, context, message ) ) )
+			{
+				m_numDropped++;
+				m_numDroppedSinceFlush++;
+			}
+		}
+
+		void flush()
+		{
+			// the output thread signals completion by pushing
+			// to this queue, and we block until it does.
+			tbb::concurrent_bounded_queue<int> flushed;
+			Message m( Message::Flush );
+			m.flushed = &flushed;
+			m_queue.push( m );
+
+			int dummy;
+			flushed.pop( dummy );
+		}
+
+		size_t numDropped() const
+		{
+			return m_numDropped;
+		}
+
+		size_t numCoalesced() const
+		{
+			return m_numCoalesced;
+		}
+
+	private :
+
+		typedef boost::tuple<Level, std::string, std::string> RepeatKey;
+
+		struct RepeatCount
+		{
+
+			RepeatCount( const tbb::tick_count &start )
+				:	count( 0 ), start( start )
+			{
+			}
+
+			size_t count;
+			tbb::tick_count start;
+
+		};
+
+		typedef std::map<RepeatKey, RepeatCount> RepeatCounts;
+
+		struct Message
+		{
+
+			enum Type
+			{
+				Output,
+				Flush,
+				Stop
+			};
+
+			Message()
+				:	type( Output ), level( Invalid ), flushed( 0 )
+			{
+			}
+
+			Message( Type t )
+				:	type( t ), level( Invalid ), flushed( 0 )
+			{
+			}
+
+			Message( Level l, const std::string &c, const std::string &m )
+				:	type( Output ), level( l ), context( c ), message( m ), flushed( 0 )
+			{
+			}
+
+			Type type;
+			Level level;
+			std::string context;
+			std::string message;
+			tbb::concurrent_bounded_queue<int> *flushed;
+
+		};
+
+		void outputThread()
+		{
+			Message m;
+			while( true )
+			{
+				m_queue.pop( m );
+				switch( m.type )
+				{
+					case Message::Output :
+						output( m );
+						break;
+					case Message::Flush :
+						outputSummaries();
+						m.flushed->push( 0 );
+						break;
+					case Message::Stop :
+						outputSummaries();
+						return;
+				}
+			}
+		}
+
+		void output( const Message &m )
+		{
+			if( m_maxRepeats )
+			{
+				const tbb::tick_count now = tbb::tick_count::now();
+				expireRepeats( now );
+
+				const RepeatKey key( m.level, m.context, m.message );
+				RepeatCounts::iterator it = m_repeatCounts.find( key );
+				if( it == m_repeatCounts.end() )
+				{
+					if( m_repeatCounts.size() >= g_maxRepeatCounts )
+					{
+						outputSummaries();
+					}
+					it = m_repeatCounts.insert( RepeatCounts::value_type( key, RepeatCount( now ) ) ).first;
+				}
+				else if( windowElapsed( it->second.start, now ) )
+				{
+					// this message is still recurring, so we summarise the
+					// last window and start counting afresh, allowing it to
+					// be output again.
+					outputSummary( it );
+					it->second = RepeatCount( now );
+				}
+
+				if( ++it->second.count > m_maxRepeats )
+				{
+					m_numCoalesced++;
+					return;
+				}
+			}
+
+			outputToHandler( m.level, m.context, m.message );
+		}
+
+		bool windowElapsed( const tbb::tick_count &start, const tbb::tick_count &now ) const
+		{
+			return m_repeatWindow > 0 && ( now - start ).seconds() >= m_repeatWindow;
+		}
+
+		// Summarises and removes the counts for messages which haven't recurred
+		// within the window, so that their summaries aren't held back until the
+		// next flush(). To avoid visiting every count for every message, this
+		// is done at most once per window.
+		void expireRepeats( const tbb::tick_count &now )
+		{
+			if( !windowElapsed( m_lastRepeatExpiry, now ) )
+			{
+				return;
+			}
+			m_lastRepeatExpiry = now;
+
+			RepeatCounts::iterator it = m_repeatCounts.begin();
+			while( it != m_repeatCounts.end() )
+			{
+				if( windowElapsed( it->second.start, now ) )
+				{
+					outputSummary( it );
+					m_repeatCounts.erase( it++ );
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		void outputSummary( RepeatCounts::const_iterator it )
+		{
+			if( it->second.count > m_maxRepeats )
+			{
+				outputToHandler(
+					it->first.get<0>(), it->first.get<1>(),
+					it->first.get<2>() + boost::str( boost::format( " (repeated %d more times)" ) % ( it->second.count - m_maxRepeats ) )
+				);
+			}
+		}
+
+		void outputSummaries()
+		{
+			for( RepeatCounts::const_iterator it = m_repeatCounts.begin(), eIt = m_repeatCounts.end(); it != eIt; ++it )
+			{
+				outputSummary( it );
+			}
+			m_repeatCounts.clear();
+
+			const size_t numDropped = m_numDroppedSinceFlush.fetch_and_store( 0 );
+			if( numDropped )
+			{
+				outputToHandler(
+					Warning, "AsyncMessageHandler",
+					boost::str( boost::format( "%d messages were dropped because the queue was full" ) % numDropped )
+				);
+			}
+		}
+
+		void outputToHandler( Level level, const std::string &context, const std::string &message )
+		{
+			try
+			{
+				m_handler->handle( level, context, message );
+			}
+			catch( ... )
+			{
+				// there's nowhere to report the error, and letting
+				// it escape would terminate the process.
+			}
+		}
+
+		MessageHandler *m_handler;
+		const size_t m_maxRepeats;
+		const double m_repeatWindow;
+
+		tbb::concurrent_bounded_queue<Message> m_queue;
+		tbb::tbb_thread m_thread;
+
+		tbb::atomic<size_t> m_numDropped;
+		tbb::atomic<size_t> m_numDroppedSinceFlush;
+		tbb::atomic<size_t> m_numCoalesced;
+
+		// only accessed by the output thread
+		RepeatCounts m_repeatCounts;
+		tbb::tick_count m_lastRepeatExpiry;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// AsyncMessageHandler
+//////////////////////////////////////////////////////////////////////////
+
+AsyncMessageHandler::AsyncMessageHandler( MessageHandlerPtr handler, size_t maxQueueSize, size_t maxRepeats, double repeatWindow )
+	:	FilteredMessageHandler( handler )
+{
+	if( !maxQueueSize )
+	{
+		throw InvalidArgumentException( "AsyncMessageHandler : maxQueueSize must be greater than zero" );
+	}
+	m_implementation.reset( new Implementation( m_handler.get(), maxQueueSize, maxRepeats, repeatWindow ) );
+}
+
+AsyncMessageHandler::~AsyncMessageHandler()
+{
+}
+
+void AsyncMessageHandler::handle( Level level, const std::string &context, const std::string &message )
+{
+	m_implementation->handle( level, context, message );
+}
+
+void AsyncMessageHandler::flush()
+{
+	m_implementation->flush();
+}
+
+size_t AsyncMessageHandler::numDropped() const
+{
+	return m_implementation->numDropped();
+}
+
+size_t AsyncMessageHandler::numCoalesced() const
+{
+	return m_implementation->numCoalesced();
+}
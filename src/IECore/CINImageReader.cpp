@@ -70,7 +70,7 @@ struct CINImageReader::Header
 };
 
 IE_CORE_DEFINERUNTIMETYPED( CINImageReader );
-const Reader::ReaderDescription<CINImageReader> CINImageReader::m_readerDescription( "cin" );
+const Reader::ReaderDescription<CINImageReader> CINImageReader::m_readerDescription( "cin", "802a5fd7 d75f2a80" );
 
 CINImageReader::CINImageReader() :
 		ImageReader( "Reads Kodak Cineon (CIN) files." ),
@@ -33,7 +33,9 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "tbb/mutex.h"
-#include "tbb/concurrent_hash_map.h"
+#include "tbb/spin_rw_mutex.h"
+#include "tbb/concurrent_queue.h"
+#include "tbb/tick_count.h"
 
 #include "boost/format.hpp"
 #include "boost/lexical_cast.hpp"
@@ -43,6 +45,11 @@
 #include "IECore/Reader.h"
 #include "IECore/Object.h"
 #include "IECore/ModifyOp.h"
+#include "IECore/Profiler.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
 
 using namespace IECore;
 using namespace boost;
@@ -55,12 +62,16 @@ using namespace std;
 
 #define PARAM(file)	MemberData::ComputeParameters( file, m_data.get() )
 
+static const size_t g_maxFileErrors = 10000;
+static const size_t g_maxResolvedPaths = 100000;
+
 struct CachedReader::MemberData
 {
 	public :
 
-		MemberData(const SearchPath &paths, ConstModifyOpPtr postProcessor, ObjectPoolPtr objectPool )
-			:	m_searchPaths( paths ), m_cache( computeFn, hashFn, 10000, objectPool ), m_postProcessor( postProcessor )
+		MemberData(const SearchPath &paths, ConstModifyOpPtr postProcessor, const PostProcessorCreator &postProcessorCreator, ObjectPoolPtr objectPool )
+			:	m_searchPaths( paths ), m_cache( computeFn, hashFn, 10000, objectPool ), m_postProcessor( postProcessor ),
+				m_postProcessorCreator( postProcessorCreator ), m_errorTimeToLive( std::numeric_limits<double>::infinity() )
 		{
 		}
 
@@ -71,17 +82,183 @@ struct CachedReader::MemberData
 		Cache m_cache;
 		ConstModifyOpPtr m_postProcessor;
 		tbb::mutex m_postProcessorMutex;
-		typedef tbb::concurrent_hash_map< std::string, std::string > FileErrors;
+
+		PostProcessorCreator m_postProcessorCreator;
+		tbb::concurrent_queue<ModifyOpPtr> m_freePostProcessors;
+
+		// Errors are only accessed when loading files, so
+		// a simple map with a lock is adequate here.
+		struct FileError
+		{
+			std::string message;
+			tbb::tick_count time;
+		};
+		typedef std::map< std::string, FileError > FileErrors;
+		typedef tbb::spin_rw_mutex Mutex;
 		FileErrors m_fileErrors;
+		Mutex m_fileErrorsMutex;
+		double m_errorTimeToLive;
+
+		// Memoises the results of m_searchPaths.find(), so we don't
+		// need to hit the filesystem again when an object is evicted
+		// from the cache and reloaded.
+		typedef std::map< std::string, path > ResolvedPaths;
+		ResolvedPaths m_resolvedPaths;
+		Mutex m_resolvedPathsMutex;
+
+		// Returns true and fills errorMsg if the file failed
+		// to load recently.
+		bool fileError( const std::string &filePath, std::string &errorMsg )
+		{
+			Mutex::scoped_lock lock( m_fileErrorsMutex, /* write = */ false );
+			FileErrors::iterator it = m_fileErrors.find( filePath );
+			if( it == m_fileErrors.end() )
+			{
+				return false;
+			}
+
+			if( ( tbb::tick_count::now() - it->second.time ).seconds() < m_errorTimeToLive )
+			{
+				errorMsg = it->second.message;
+				return true;
+			}
+
+			// error has expired
+			if( lock.upgrade_to_writer() )
+			{
+				m_fileErrors.erase( it );
+			}
+			else
+			{
+				// lock was released during upgrade, so
+				// the iterator may not be valid any more.
+				m_fileErrors.erase( filePath );
+			}
+			return false;
+		}
+
+		void clearFileError( const std::string &filePath )
+		{
+			Mutex::scoped_lock lock( m_fileErrorsMutex );
+			m_fileErrors.erase( filePath );
+		}
+
+		void clearFileErrors()
+		{
+			Mutex::scoped_lock lock( m_fileErrorsMutex );
+			m_fileErrors.clear();
+		}
+
+		void clearResolvedPaths()
+		{
+			Mutex::scoped_lock lock( m_resolvedPathsMutex );
+			m_resolvedPaths.clear();
+		}
+
+		void clearResolvedPath( const std::string &filePath )
+		{
+			Mutex::scoped_lock lock( m_resolvedPathsMutex );
+			m_resolvedPaths.erase( filePath );
+		}
 
 	private :
 
 		void registerFileError( const std::string &filePath, const std::string &errorMsg )
 		{
-			FileErrors::accessor it;
-			if ( m_fileErrors.insert( it, filePath ) )
+			if( m_errorTimeToLive <= 0 )
+			{
+				return;
+			}
+
+			Mutex::scoped_lock lock( m_fileErrorsMutex );
+			if( m_fileErrors.size() >= g_maxFileErrors )
+			{
+				// remove expired errors to make room, falling back
+				// to removing everything if none have expired.
+				const tbb::tick_count now = tbb::tick_count::now();
+				for( FileErrors::iterator it = m_fileErrors.begin(); it != m_fileErrors.end(); )
+				{
+					FileErrors::iterator next = it; ++next;
+					if( ( now - it->second.time ).seconds() >= m_errorTimeToLive )
+					{
+						m_fileErrors.erase( it );
+					}
+					it = next;
+				}
+				if( m_fileErrors.size() >= g_maxFileErrors )
+				{
+					m_fileErrors.clear();
+				}
+			}
+
+			FileError &error = m_fileErrors[filePath];
+			error.message = errorMsg;
+			error.time = tbb::tick_count::now();
+		}
+
+		path resolvePath( const std::string &filePath )
+		{
+			{
+				Mutex::scoped_lock lock( m_resolvedPathsMutex, /* write = */ false );
+				ResolvedPaths::const_iterator it = m_resolvedPaths.find( filePath );
+				if( it != m_resolvedPaths.end() )
+				{
+					return it->second;
+				}
+			}
+
+			path result = m_searchPaths.find( filePath );
+			if( result.empty() )
+			{
+				// we don't memoise failures, because the file may appear
+				// later. the error cache deals with repeated failures instead.
+				return result;
+			}
+
+			Mutex::scoped_lock lock( m_resolvedPathsMutex );
+			if( m_resolvedPaths.size() >= g_maxResolvedPaths )
+			{
+				m_resolvedPaths.clear();
+			}
+			m_resolvedPaths[filePath] = result;
+			return result;
+		}
+
+		void postProcess( ObjectPtr &object )
+		{
+			if( m_postProcessorCreator )
+			{
+				ModifyOpPtr postProcessor;
+				if( !m_freePostProcessors.try_pop( postProcessor ) )
+				{
+					postProcessor = m_postProcessorCreator();
+					if( !postProcessor )
+					{
+						throw Exception( "Post-processor creator returned no ModifyOp" );
+					}
+				}
+
+				postProcessor->inputParameter()->setValue( object );
+				postProcessor->copyParameter()->setTypedValue( false );
+				postProcessor->operate();
+
+				// we only get here if operate() didn't throw, so we won't reuse
+				// post-processors which may have been left in a bad state.
+				m_freePostProcessors.push( postProcessor );
+			}
+			else if( m_postProcessor )
 			{
-				it->second = errorMsg;
+				/// \todo We need to allow arguments to be passed to Op::operate() directly
+				/// so that the same Op can be used from multiple threads with different arguments.
+				/// This means adding an overloaded operate() method but more importantly making sure
+				/// that all Ops only use their operands to access arguments and not go getting them
+				/// from the Parameters directly. Until then, the PostProcessorCreator constructor
+				/// provides a way of avoiding the lock.
+				tbb::mutex::scoped_lock l( m_postProcessorMutex );
+				ModifyOpPtr postProcessor = boost::const_pointer_cast<ModifyOp>( m_postProcessor );
+				postProcessor->inputParameter()->setValue( object );
+				postProcessor->copyParameter()->setTypedValue( false );
+				postProcessor->operate();
 			}
 		}
 
@@ -96,22 +273,23 @@ struct CachedReader::MemberData
 		// static function used by the cache mechanism to actually load the object data from file.
 		static ObjectPtr computeFn( const ComputeParameters &params )
 		{
+			IECORE_PROFILE_SCOPE( "CachedReader::computeFn" );
 			const std::string &filePath = params.first;
 			MemberData *data = params.second;
 
 			{
 				/// Check if the file failed before...
-				FileErrors::const_accessor cit;
-				if ( data->m_fileErrors.find( cit, filePath ) )
+				std::string errorMsg;
+				if ( data->fileError( filePath, errorMsg ) )
 				{
-					throw Exception( ( format( "Previous attempt to read %s failed: %s" ) % filePath % cit->second ).str() );
+					throw Exception( ( format( "Previous attempt to read %s failed: %s" ) % filePath % errorMsg ).str() );
 				}
 			}
 
 			ObjectPtr result(0);
 			try
 			{
-				path resolvedPath = data->m_searchPaths.find( filePath );
+				path resolvedPath = data->resolvePath( filePath );
 				if( resolvedPath.empty() )
 				{
 					string pathList;
@@ -143,19 +321,7 @@ struct CachedReader::MemberData
 					throw Exception( "Reader for '" + resolvedPath.string() + "' returned no data" );
 				}
 
-				if( data->m_postProcessor )
-				{
-					/// \todo We need to allow arguments to be passed to Op::operate() directly
-					/// so that the same Op can be used from multiple threads with different arguments.
-					/// This means adding an overloaded operate() method but more importantly making sure
-					/// that all Ops only use their operands to access arguments and not go getting them
-					/// from the Parameters directly.
-					tbb::mutex::scoped_lock l( data->m_postProcessorMutex );
-					ModifyOpPtr postProcessor = boost::const_pointer_cast<ModifyOp>( data->m_postProcessor );
-					postProcessor->inputParameter()->setValue( result );
-					postProcessor->copyParameter()->setTypedValue( false );
-					postProcessor->operate();
-				}
+				data->postProcess( result );
 			}
 			catch ( std::exception &e )
 			{
@@ -176,12 +342,17 @@ struct CachedReader::MemberData
 //////////////////////////////////////////////////////////////////////////
 
 CachedReader::CachedReader( const SearchPath &paths, ObjectPoolPtr objectPool  )
-	:	m_data( new MemberData( paths, 0, objectPool ) )
+	:	m_data( new MemberData( paths, 0, PostProcessorCreator(), objectPool ) )
 {
 }
 
 CachedReader::CachedReader( const SearchPath &paths, ConstModifyOpPtr postProcessor, ObjectPoolPtr objectPool )
-	:	m_data( new MemberData( paths, postProcessor, objectPool ) )
+	:	m_data( new MemberData( paths, postProcessor, PostProcessorCreator(), objectPool ) )
+{
+}
+
+CachedReader::CachedReader( const SearchPath &paths, ObjectPoolPtr objectPool, const PostProcessorCreator &postProcessorCreator )
+	:	m_data( new MemberData( paths, 0, postProcessorCreator, objectPool ) )
 {
 }
 
@@ -192,7 +363,7 @@ ConstObjectPtr CachedReader::read( const std::string &file )
 
 void CachedReader::insert( const std::string &file, ConstObjectPtr obj )
 {
-	m_data->m_fileErrors.erase( file );
+	m_data->clearFileError( file );
 	m_data->m_cache.set( PARAM(file), obj.get(), ObjectPool::StoreReference );
 }
 
@@ -200,8 +371,8 @@ bool CachedReader::cached( const std::string &file ) const
 {
 	{
 		/// Check if the file failed before...
-		MemberData::FileErrors::const_accessor cit;
-		if ( m_data->m_fileErrors.find( cit, file ) )
+		std::string errorMsg;
+		if ( m_data->fileError( file, errorMsg ) )
 		{
 			return false;
 		}
@@ -212,13 +383,15 @@ bool CachedReader::cached( const std::string &file ) const
 
 void CachedReader::clear()
 {
-	m_data->m_fileErrors.clear();
+	m_data->clearFileErrors();
+	m_data->clearResolvedPaths();
 	m_data->m_cache.clear();
 }
 
 void CachedReader::clear( const std::string &file )
 {
-	m_data->m_fileErrors.erase(file);
+	m_data->clearFileError( file );
+	m_data->clearResolvedPath( file );
 	m_data->m_cache.erase( PARAM(file) );
 }
 
@@ -236,6 +409,20 @@ void CachedReader::setSearchPath( const SearchPath &paths )
 	}
 }
 
+void CachedReader::setErrorTimeToLive( double seconds )
+{
+	m_data->m_errorTimeToLive = std::max( 0.0, seconds );
+	if( m_data->m_errorTimeToLive == 0 )
+	{
+		m_data->clearFileErrors();
+	}
+}
+
+double CachedReader::getErrorTimeToLive() const
+{
+	return m_data->m_errorTimeToLive;
+}
+
 ObjectPool *CachedReader::objectPool() const
 {
 	return m_data->m_cache.objectPool();
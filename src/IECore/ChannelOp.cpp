@@ -37,14 +37,48 @@
 #include "IECore/DespatchTypedData.h"
 #include "IECore/CompoundParameter.h"
 
+#include <algorithm>
+
 #include "boost/format.hpp"
 
+#include "tbb/parallel_for.h"
+
 using namespace IECore;
 using namespace std;
 using namespace boost;
 
 IE_CORE_DEFINERUNTIMETYPED( ChannelOp );
 
+namespace
+{
+
+class ModifyRows
+{
+
+	public :
+
+		ModifyRows( ChannelOp *op, void (ChannelOp::*modifyChannelRows)( const Imath::Box2i &, const Imath::Box2i &, const vector<float *> &, int, int ), const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const vector<float *> &channels )
+			:	m_op( op ), m_modifyChannelRows( modifyChannelRows ), m_displayWindow( displayWindow ), m_dataWindow( dataWindow ), m_channels( channels )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<int> &range ) const
+		{
+			( m_op->*m_modifyChannelRows )( m_displayWindow, m_dataWindow, m_channels, range.begin(), range.end() );
+		}
+
+	private :
+
+		ChannelOp *m_op;
+		void (ChannelOp::*m_modifyChannelRows)( const Imath::Box2i &, const Imath::Box2i &, const vector<float *> &, int, int );
+		const Imath::Box2i &m_displayWindow;
+		const Imath::Box2i &m_dataWindow;
+		const vector<float *> &m_channels;
+
+};
+
+} // namespace
+
 ChannelOp::ChannelOp( const std::string &description )
 	:	ImagePrimitiveOp( description )
 {
@@ -129,3 +163,27 @@ void ChannelOp::modifyTypedPrimitive( ImagePrimitive * image, const CompoundObje
 	modifyChannels( image->getDisplayWindow(), image->getDataWindow(), channels );
 	/// \todo Consider cases where the derived class invalidates the channel data (by changing its length)
 }
+
+void ChannelOp::modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels )
+{
+	// we call writable() up front, so that any copy-on-write
+	// duplication happens before we go parallel.
+	ChannelPointerVector channelPointers;
+	for( ChannelVector::iterator it = channels.begin(); it != channels.end(); ++it )
+	{
+		channelPointers.push_back( &(*it)->writable()[0] );
+	}
+
+	const int width = dataWindow.size().x + 1;
+	const int numRows = dataWindow.size().y + 1;
+	const int grainSize = std::max( 1, 16384 / width );
+	tbb::parallel_for(
+		tbb::blocked_range<int>( 0, numRows, grainSize ),
+		ModifyRows( this, &ChannelOp::modifyChannelRows, displayWindow, dataWindow, channelPointers )
+	);
+}
+
+void ChannelOp::modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow )
+{
+	throw NotImplementedException( "ChannelOp::modifyChannelRows : Derived classes must implement either modifyChannels() or modifyChannelRows()" );
+}
@@ -143,37 +143,27 @@ const IntParameter *CineonToLinearOp::refBlackValParameter() const
 struct CineonToLinearOp::Converter
 {
 
-		typedef void ReturnType;
-
 		Converter( float filmGamma, int refWhiteVal, int refBlackVal ) :
-			m_filmGamma(filmGamma), m_refWhiteVal(refWhiteVal), m_refBlackVal(refBlackVal)
+			m_converter( filmGamma, refWhiteVal, refBlackVal )
 		{
 		}
 
-		template<typename T>
-		ReturnType operator()( typename T::Ptr data )
+		void operator()( float *begin, float *end )
 		{
-			typedef typename T::ValueType Container;
-			typedef typename Container::value_type V;
-			typedef typename Container::iterator It;
-			CineonToLinearDataConversion< unsigned short, V > converter( m_filmGamma, m_refWhiteVal, m_refBlackVal );
-			It end = data->writable().end();
-			for ( It it = data->writable().begin(); it != end; it++ )
+			for ( float *it = begin; it != end; it++ )
 			{
-				unsigned short v = static_cast<unsigned short>( (*it < 0 ? (V)0. : ( *it > 1. ? (V)1. : *it )) * 1023.);
-				*it = converter( v );
+				unsigned short v = static_cast<unsigned short>( (*it < 0 ? 0.0f : ( *it > 1. ? 1.0f : *it )) * 1023.);
+				*it = m_converter( v );
 			}
 		}
 
 	private:
 
-		float m_filmGamma;
-		int m_refWhiteVal;
-		int m_refBlackVal;
+		CineonToLinearDataConversion< unsigned short, float > m_converter;
 
 };
 
-void CineonToLinearOp::modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels )
+void CineonToLinearOp::modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow )
 {
 	CineonToLinearOp::Converter converter(
 		filmGammaParameter()->getNumericValue(),
@@ -181,8 +171,9 @@ void CineonToLinearOp::modifyChannels( const Imath::Box2i &displayWindow, const
 		refBlackValParameter()->getNumericValue()
 	);
 
-	for ( ChannelVector::iterator it = channels.begin(); it != channels.end(); it++ )
+	const size_t width = dataWindow.size().x + 1;
+	for ( ChannelPointerVector::const_iterator it = channels.begin(); it != channels.end(); it++ )
 	{
-		despatchTypedData<CineonToLinearOp::Converter, TypeTraits::IsFloatVectorTypedData>( it->get(), converter );
+		converter( *it + beginRow * width, *it + endRow * width );
 	}
 }
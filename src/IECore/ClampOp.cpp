@@ -156,7 +156,7 @@ const FloatParameter *ClampOp::maxToParameter() const
 	return parameters()->parameter<FloatParameter>( "maxTo" );
 }
 
-void ClampOp::modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels )
+void ClampOp::modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow )
 {
 	float minValue = minParameter()->getNumericValue();
 	float maxValue = maxParameter()->getNumericValue();
@@ -164,10 +164,10 @@ void ClampOp::modifyChannels( const Imath::Box2i &displayWindow, const Imath::Bo
 	float minTo = enableMinToParameter()->getTypedValue() ? minToParameter()->getNumericValue() : minValue;
 	float maxTo = enableMaxToParameter()->getTypedValue() ? maxToParameter()->getNumericValue() : maxValue;
 	
+	const size_t width = dataWindow.size().x + 1;
 	for( unsigned i=0; i<channels.size(); i++ )
 	{
-		vector<float> &channel = channels[i]->writable();
-		for( vector<float>::iterator it = channel.begin(), eIt = channel.end(); it != eIt; it++ )
+		for( float *it = channels[i] + beginRow * width, *eIt = channels[i] + endRow * width; it != eIt; it++ )
 		{
 			*it = *it < minValue ? minTo : ( *it > maxValue ? maxTo : *it );
 		}
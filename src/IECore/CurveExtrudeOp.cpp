@@ -39,6 +39,9 @@
 
 #include "OpenEXR/ImathFrame.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include "IECore/Object.h"
 #include "IECore/Group.h"
 #include "IECore/CurvesPrimitive.h"
@@ -156,7 +159,9 @@ struct CurveExtrudeOp::VaryingFn
 		const unsigned uPoints = m_resolution.x;
 
 		typename T::Ptr newData = new T();
-		newData->writable().reserve( ( vPoints ) * uPoints );
+		typename T::ValueType &newValues = newData->writable();
+		newValues.resize( vPoints * uPoints );
+		typename T::ValueType::iterator out = newValues.begin();
 
 		for ( unsigned int v = 0; v < vPoints; v++ )
 		{
@@ -176,17 +181,15 @@ struct CurveExtrudeOp::VaryingFn
 				fSeg = fSeg - iSeg;
 			}
 
-			for ( unsigned u = 0; u < uPoints ; u ++)
-			{
-				Value value;
-				LinearInterpolator<Value>()(
-					data->readable()[ m_varyingOffset + iSeg ],
-					data->readable()[ m_varyingOffset + iSeg + 1],
-					fSeg,
-					value
-				);
-				newData->writable().push_back( value );
-			}
+			Value value;
+			LinearInterpolator<Value>()(
+				data->readable()[ m_varyingOffset + iSeg ],
+				data->readable()[ m_varyingOffset + iSeg + 1],
+				fSeg,
+				value
+			);
+			std::fill_n( out, uPoints, value );
+			out += uPoints;
 		}
 
 		return newData;
@@ -227,7 +230,9 @@ struct CurveExtrudeOp::VertexFn
 		const unsigned uPoints = m_resolution.x;
 
 		typename T::Ptr newData = new T();
-		newData->writable().reserve( ( vPoints + 2 ) * uPoints );
+		typename T::ValueType &newValues = newData->writable();
+		newValues.resize( ( vPoints + 2 ) * uPoints );
+		typename T::ValueType::iterator out = newValues.begin();
 
 		for ( unsigned int v = 0; v < vPoints; v++ )
 		{
@@ -252,20 +257,15 @@ struct CurveExtrudeOp::VertexFn
 			const size_t i0 = iSeg;
 			const size_t i1 = std::min( iSeg + 1, m_curves->variableSize( PrimitiveVariable::Varying, m_curveIndex ) );
 
-			for ( int x = 0; x < num; x++)
-			{
-				for ( unsigned u = 0; u < uPoints ; u ++)
-				{
-					Value value;
-					LinearInterpolator<Value>()(
-						data->readable()[ m_varyingOffset + i0 ],
-						data->readable()[ m_varyingOffset + i1],
-						fSeg,
-						value
-					);
-					newData->writable().push_back( value );
-				}
-			}
+			Value value;
+			LinearInterpolator<Value>()(
+				data->readable()[ m_varyingOffset + i0 ],
+				data->readable()[ m_varyingOffset + i1],
+				fSeg,
+				value
+			);
+			std::fill_n( out, num * uPoints, value );
+			out += num * uPoints;
 		}
 
 		return newData;
@@ -444,11 +444,8 @@ PatchMeshPrimitivePtr CurveExtrudeOp::buildPatchMesh( const CurvesPrimitive * cu
 
 	const V3fVectorData::ValueType &p = pData->readable();
 
-	V3fVectorData::ValueType resampledPoints;
-	resampledPoints.reserve( vPoints );
-
-	V3fVectorData::ValueType resampledTangents;
-	resampledPoints.reserve( vPoints );
+	V3fVectorData::ValueType resampledPoints( vPoints );
+	V3fVectorData::ValueType resampledTangents( vPoints );
 
 	/// \todo Make adaptive
 	for ( unsigned v = 0; v < vPoints; v ++)
@@ -487,14 +484,12 @@ PatchMeshPrimitivePtr CurveExtrudeOp::buildPatchMesh( const CurvesPrimitive * cu
 				p0, p1, p2, p3
 			);
 
-		resampledPoints.push_back( pt );
+		resampledPoints[v] = pt;
 
-		resampledTangents.push_back(
-			curves->basis().derivative(
-				fSeg,
-				p0, p1, p2, p3
-			).normalized()
-		);
+		resampledTangents[v] = curves->basis().derivative(
+			fSeg,
+			p0, p1, p2, p3
+		).normalized();
 
 	}
 	assert( resampledPoints.size() == vPoints );
@@ -505,8 +500,22 @@ PatchMeshPrimitivePtr CurveExtrudeOp::buildPatchMesh( const CurvesPrimitive * cu
 	buildReferenceFrames( resampledPoints, resampledTangents, frames );
 	assert( frames.size() == vPoints );
 
-	std::vector< V3f > patchP;
-	patchP.reserve( uPoints * ( vPoints + 2 ) );
+	// the circle is the same for every ring, so we compute it once
+	// and then just transform it into place for each frame.
+	std::vector< V3f > circle( uPoints );
+	for( unsigned int u = 0; u < uPoints; u++ )
+	{
+		/// We're periodic in 'u', so no need to close the curve.
+		/// Go from -PI to PI, in order to make the periodicity work, and to give the
+		/// surface the correct orientation.
+		float theta = -2.0 * M_PI * float(u) / float(uPoints) - M_PI;
+		circle[u] = V3f( 0.0, cos( theta ), sin( theta ) );
+	}
+
+	V3fVectorDataPtr patchPData = new V3fVectorData;
+	std::vector< V3f > &patchP = patchPData->writable();
+	patchP.resize( uPoints * ( vPoints + 2 ) );
+	std::vector< V3f >::iterator patchPIt = patchP.begin();
 
 	for ( unsigned int v = 0; v < vPoints; v++ )
 	{
@@ -531,31 +540,47 @@ PatchMeshPrimitivePtr CurveExtrudeOp::buildPatchMesh( const CurvesPrimitive * cu
 		{
 			for( unsigned int u = 0; u < uPoints; u++ )
 			{
-				/// We're periodic in 'u', so no need to close the curve.
-				/// Go from -PI to PI, in order to make the periodicity work, and to give the
-				/// surface the correct orientation.
-				float theta = -2.0 * M_PI * float(u) / float(uPoints) - M_PI;
-
-				V3f circlePoint(
-					0.0,
-					radius * cos( theta ),
-					radius * sin( theta )
-				);
-
-				circlePoint = circlePoint * frames[v];
-
-				patchP.push_back( circlePoint );
+				*patchPIt++ = ( circle[u] * radius ) * frames[v];
 			}
 		}
 	}
 
-	patchMesh->variables["P"] = PrimitiveVariable( PrimitiveVariable::Vertex, new V3fVectorData( patchP ) );
+	patchMesh->variables["P"] = PrimitiveVariable( PrimitiveVariable::Vertex, patchPData );
 
 	assert( patchMesh->arePrimitiveVariablesValid() );
 
 	return patchMesh;
 }
 
+class CurveExtrudeOp::BuildPatchMeshes
+{
+
+	public :
+
+		BuildPatchMeshes( const CurveExtrudeOp *op, const CurvesPrimitive *curves, const std::vector<unsigned> &vertexOffsets, const std::vector<unsigned> &varyingOffsets, std::vector<PatchMeshPrimitivePtr> &patchMeshes )
+			:	m_op( op ), m_curves( curves ), m_vertexOffsets( vertexOffsets ), m_varyingOffsets( varyingOffsets ), m_patchMeshes( patchMeshes )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			for( size_t curveIndex = range.begin(); curveIndex != range.end(); ++curveIndex )
+			{
+				m_patchMeshes[curveIndex] = m_op->buildPatchMesh( m_curves, curveIndex, m_vertexOffsets[curveIndex], m_varyingOffsets[curveIndex] );
+				assert( m_patchMeshes[curveIndex] );
+			}
+		}
+
+	private :
+
+		const CurveExtrudeOp *m_op;
+		const CurvesPrimitive *m_curves;
+		const std::vector<unsigned> &m_vertexOffsets;
+		const std::vector<unsigned> &m_varyingOffsets;
+		std::vector<PatchMeshPrimitivePtr> &m_patchMeshes;
+
+};
+
 ObjectPtr CurveExtrudeOp::doOperation( const CompoundObject * operands )
 {
 	CurvesPrimitive * curves = m_curvesParameter->getTypedValue<CurvesPrimitive>();
@@ -567,20 +592,31 @@ ObjectPtr CurveExtrudeOp::doOperation( const CompoundObject * operands )
 	const IntVectorData * verticesPerCurve = curves->verticesPerCurve();
 	assert( verticesPerCurve );
 
+	// compute the offset of each curve into the vertex and varying data up
+	// front, so that the patch meshes can then be built independently in parallel.
 	unsigned numCurves = verticesPerCurve->readable().size();
+	std::vector<unsigned> vertexOffsets( numCurves );
+	std::vector<unsigned> varyingOffsets( numCurves );
 	unsigned vertexOffset = 0;
 	unsigned varyingOffset = 0;
 	for ( unsigned curveIndex = 0; curveIndex < numCurves; curveIndex++ )
 	{
-		int numVertices = curves->variableSize( PrimitiveVariable::Vertex, curveIndex );
+		vertexOffsets[curveIndex] = vertexOffset;
+		varyingOffsets[curveIndex] = varyingOffset;
 
-		PatchMeshPrimitivePtr patchMesh = buildPatchMesh( curves, curveIndex, vertexOffset, varyingOffset );
-		assert( patchMesh );
+		vertexOffset += curves->variableSize( PrimitiveVariable::Vertex, curveIndex );
+		varyingOffset += curves->variableSize( PrimitiveVariable::Varying, curveIndex );
+	}
 
-		group->addChild( patchMesh );
+	std::vector<PatchMeshPrimitivePtr> patchMeshes( numCurves );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numCurves ),
+		BuildPatchMeshes( this, curves, vertexOffsets, varyingOffsets, patchMeshes )
+	);
 
-		vertexOffset += numVertices;
-		varyingOffset += curves->variableSize( PrimitiveVariable::Varying, curveIndex );
+	for( std::vector<PatchMeshPrimitivePtr>::const_iterator it = patchMeshes.begin(), eIt = patchMeshes.end(); it != eIt; ++it )
+	{
+		group->addChild( *it );
 	}
 
 	assert( group->children().size() == numCurves );
@@ -34,6 +34,9 @@
 
 #include "boost/format.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include "IECore/CurveLineariser.h"
 #include "IECore/CompoundParameter.h"
 #include "IECore/FastFloat.h"
@@ -43,6 +46,103 @@
 using namespace IECore;
 using namespace Imath;
 
+//////////////////////////////////////////////////////////////////////////
+// Implementation of LineariseCurves
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Computes the sample locations for a range of curves, and resamples any
+// primitive variables other than "P" into preallocated vectors, with each
+// curve writing from its own offset. This allows all the curves to be
+// processed in parallel. The positions themselves are computed afterwards
+// from the sample locations, using a single batch query.
+class LineariseCurves
+{
+
+	public :
+
+		LineariseCurves(
+			const CurvesPrimitiveEvaluator *evaluator, bool periodic,
+			const std::vector<int> &newVerticesPerCurve, const std::vector<size_t> &newVertexOffsets,
+			std::vector<unsigned> &sampleCurveIndices, std::vector<float> &sampleVs,
+			const std::vector<PrimitiveVariable> &primitiveVariables, const std::vector<TypeId> &primitiveVariableTypes,
+			const std::vector<void *> &primitiveVariableVectors
+		)
+			:	m_evaluator( evaluator ), m_periodic( periodic ), m_newVerticesPerCurve( newVerticesPerCurve ), m_newVertexOffsets( newVertexOffsets ),
+				m_sampleCurveIndices( sampleCurveIndices ), m_sampleVs( sampleVs ),
+				m_primitiveVariables( primitiveVariables ), m_primitiveVariableTypes( primitiveVariableTypes ), m_primitiveVariableVectors( primitiveVariableVectors )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			PrimitiveEvaluator::ResultPtr evaluatorResult = m_evaluator->createResult();
+
+			for( size_t curveIndex=range.begin(); curveIndex!=range.end(); curveIndex++ )
+			{
+				const int numVertices = m_newVerticesPerCurve[curveIndex];
+				size_t vertexIndex = m_newVertexOffsets[curveIndex];
+
+				float vStep = m_periodic ? ( 1.0f / (float)( numVertices ) ) : ( 1.0f / (float)( numVertices - 1 ) );
+				for( int i=0; i<numVertices; i++, vertexIndex++ )
+				{
+					float v = std::min( vStep * i, 1.0f );
+					m_sampleCurveIndices[vertexIndex] = curveIndex;
+					m_sampleVs[vertexIndex] = v;
+					if( m_primitiveVariables.empty() )
+					{
+						continue;
+					}
+
+					// the interpolation coefficients are computed once here,
+					// and then shared by all the primitive variables below.
+					m_evaluator->pointAtV( curveIndex, v, evaluatorResult.get() );
+					for( size_t j=0; j<m_primitiveVariables.size(); j++ )
+					{
+						switch( m_primitiveVariableTypes[j] )
+						{
+							case V3fVectorDataTypeId :
+								(*static_cast<std::vector<V3f> *>( m_primitiveVariableVectors[j] ))[vertexIndex] = evaluatorResult->vectorPrimVar( m_primitiveVariables[j] );
+								break;
+							case FloatVectorDataTypeId :
+								(*static_cast<std::vector<float> *>( m_primitiveVariableVectors[j] ))[vertexIndex] = evaluatorResult->floatPrimVar( m_primitiveVariables[j] );
+								break;
+							case IntVectorDataTypeId :
+								(*static_cast<std::vector<int> *>( m_primitiveVariableVectors[j] ))[vertexIndex] = evaluatorResult->intPrimVar( m_primitiveVariables[j] );
+								break;
+							case Color3fVectorDataTypeId :
+								(*static_cast<std::vector<Color3f> *>( m_primitiveVariableVectors[j] ))[vertexIndex] = evaluatorResult->colorPrimVar( m_primitiveVariables[j] );
+								break;
+							default :
+								assert( 0 ); // shouldn't get here
+						}
+					}
+				}
+			}
+		}
+
+	private :
+
+		const CurvesPrimitiveEvaluator *m_evaluator;
+		bool m_periodic;
+		const std::vector<int> &m_newVerticesPerCurve;
+		const std::vector<size_t> &m_newVertexOffsets;
+		std::vector<unsigned> &m_sampleCurveIndices;
+		std::vector<float> &m_sampleVs;
+		const std::vector<PrimitiveVariable> &m_primitiveVariables;
+		const std::vector<TypeId> &m_primitiveVariableTypes;
+		const std::vector<void *> &m_primitiveVariableVectors;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Implementation of CurveLineariser
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( CurveLineariser );
 
 CurveLineariser::CurveLineariser()
@@ -81,8 +181,9 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 	}
 	
 	CurvesPrimitiveEvaluatorPtr evaluator = new CurvesPrimitiveEvaluator( curves );
-	PrimitiveEvaluator::ResultPtr evaluatorResult = evaluator->createResult();
 	
+	// positions are computed separately, using the evaluator's batch query
+	std::vector<V3f> *positions = 0;
 	std::vector<PrimitiveVariable> primitiveVariables;
 	std::vector<TypeId> primitiveVariableTypes;
 	std::vector<void *> primitiveVariableVectors;
@@ -99,6 +200,15 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 				// fall through to process the variable
 				;
 		}
+
+		if( it->first == "P" && it->second.interpolation == PrimitiveVariable::Vertex )
+		{
+			if( V3fVectorData *p = runTimeCast<V3fVectorData>( it->second.data.get() ) )
+			{
+				positions = &p->writable();
+				continue;
+			}
+		}
 		
 		switch( it->second.data->typeId() )
 		{
@@ -107,7 +217,6 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 				primitiveVariables.push_back( evaluator->primitive()->variables.find( it->first )->second );
 				primitiveVariableTypes.push_back( V3fVectorDataTypeId );
 				std::vector<V3f> &v = static_cast<V3fVectorData *>( it->second.data.get() )->writable();
-				v.clear();
 				primitiveVariableVectors.push_back( &v );
 				break;
 			}
@@ -116,7 +225,6 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 				primitiveVariables.push_back( evaluator->primitive()->variables.find( it->first )->second );
 				primitiveVariableTypes.push_back( FloatVectorDataTypeId );
 				std::vector<float> &v = static_cast<FloatVectorData *>( it->second.data.get() )->writable();
-				v.clear();
 				primitiveVariableVectors.push_back( &v );
 				break;
 			}
@@ -125,7 +233,6 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 				primitiveVariables.push_back( evaluator->primitive()->variables.find( it->first )->second );
 				primitiveVariableTypes.push_back( IntVectorDataTypeId );
 				std::vector<int> &v = static_cast<IntVectorData *>( it->second.data.get() )->writable();
-				v.clear();
 				primitiveVariableVectors.push_back( &v );
 				break;
 			}
@@ -134,7 +241,6 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 				primitiveVariables.push_back( evaluator->primitive()->variables.find( it->first )->second );
 				primitiveVariableTypes.push_back( Color3fVectorDataTypeId );
 				std::vector<Color3f> &v = static_cast<Color3fVectorData *>( it->second.data.get() )->writable();
-				v.clear();
 				primitiveVariableVectors.push_back( &v );
 				break;
 			}
@@ -147,48 +253,67 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 		}
 	}
 	
+	// first pass : count the output vertices for each curve, so we can
+	// preallocate the outputs and know where each curve should write to.
+
 	size_t numCurves = curves->numCurves();
 	bool periodic = curves->periodic();
 	
 	IntVectorDataPtr newVerticesPerCurveData = new IntVectorData();
 	std::vector<int> &newVerticesPerCurve = newVerticesPerCurveData->writable();
 	newVerticesPerCurve.resize( numCurves );
+	std::vector<size_t> newVertexOffsets( numCurves );
 	
 	float verticesPerSegment = operands->member<FloatData>( "verticesPerSegment" )->readable();
 	
+	size_t newNumVertices = 0;
 	for( size_t curveIndex=0; curveIndex<numCurves; curveIndex++ )
 	{
 		int numVertices = fastFloatFloor( verticesPerSegment * (float)curves->numSegments( curveIndex ) );
 		numVertices = std::max( numVertices, periodic ? 3 : 2 );
-		
-		float vStep = periodic ? ( 1.0f / (float)( numVertices ) ) : ( 1.0f / (float)( numVertices - 1 ) );
-		for( int i=0; i<numVertices; i++ )
+		newVerticesPerCurve[curveIndex] = numVertices;
+		newVertexOffsets[curveIndex] = newNumVertices;
+		newNumVertices += numVertices;
+	}
+
+	for( size_t j=0; j<primitiveVariables.size(); j++ )
+	{
+		switch( primitiveVariableTypes[j] )
 		{
-			float v = std::min( vStep * i, 1.0f );
-			evaluator->pointAtV( curveIndex, v, evaluatorResult.get() );
-			for( size_t j=0; j<primitiveVariables.size(); j++ )
-			{
-				switch( primitiveVariableTypes[j] )
-				{
-					case V3fVectorDataTypeId :
-						static_cast<std::vector<V3f> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->vectorPrimVar( primitiveVariables[j] ) );
-						break;
-					case FloatVectorDataTypeId :
-						static_cast<std::vector<float> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->floatPrimVar( primitiveVariables[j] ) );
-						break;
-					case IntVectorDataTypeId :
-						static_cast<std::vector<int> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->intPrimVar( primitiveVariables[j] ) );
-						break;
-					case Color3fVectorDataTypeId :
-						static_cast<std::vector<Color3f> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->colorPrimVar( primitiveVariables[j] ) );
-						break;
-					default :
-						assert( 0 ); // shouldn't get here
-				}
-			}
+			case V3fVectorDataTypeId :
+				static_cast<std::vector<V3f> *>( primitiveVariableVectors[j] )->resize( newNumVertices );
+				break;
+			case FloatVectorDataTypeId :
+				static_cast<std::vector<float> *>( primitiveVariableVectors[j] )->resize( newNumVertices );
+				break;
+			case IntVectorDataTypeId :
+				static_cast<std::vector<int> *>( primitiveVariableVectors[j] )->resize( newNumVertices );
+				break;
+			case Color3fVectorDataTypeId :
+				static_cast<std::vector<Color3f> *>( primitiveVariableVectors[j] )->resize( newNumVertices );
+				break;
+			default :
+				assert( 0 ); // shouldn't get here
 		}
-		
-		newVerticesPerCurve[curveIndex] = numVertices;
+	}
+
+	// second pass : resample all the curves in parallel. this is safe
+	// because the evaluator holds its own copy of the input curves, so
+	// we're free to overwrite the primitive variables on the original.
+
+	std::vector<unsigned> sampleCurveIndices( newNumVertices );
+	std::vector<float> sampleVs( newNumVertices );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numCurves ),
+		LineariseCurves( evaluator.get(), periodic, newVerticesPerCurve, newVertexOffsets, sampleCurveIndices, sampleVs, primitiveVariables, primitiveVariableTypes, primitiveVariableVectors )
+	);
+
+	// third pass : evaluate the positions from the evaluator's per-segment
+	// polynomial tables, without the overhead of a Result per sample.
+
+	if( positions )
+	{
+		evaluator->pointsAtV( sampleCurveIndices, sampleVs, *positions );
 	}
 	
 	curves->setTopology( newVerticesPerCurveData, CubicBasisf::linear(), periodic );
@@ -0,0 +1,131 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/tbb.h"
+
+#include "IECore/CurvesAlgo.h"
+#include "IECore/Exception.h"
+#include "IECore/private/PrimitiveMerge.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+
+namespace
+{
+
+class MergeTopology
+{
+
+	public :
+
+		MergeTopology( const vector<const CurvesPrimitive *> &curves, const vector<size_t> &curveOffsets, vector<int> &verticesPerCurve )
+			:	m_curves( curves ), m_curveOffsets( curveOffsets ), m_verticesPerCurve( verticesPerCurve )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				const vector<int> &verticesPerCurve = m_curves[i]->verticesPerCurve()->readable();
+				std::copy( verticesPerCurve.begin(), verticesPerCurve.end(), m_verticesPerCurve.begin() + m_curveOffsets[i] );
+			}
+		}
+
+	private :
+
+		const vector<const CurvesPrimitive *> &m_curves;
+		const vector<size_t> &m_curveOffsets;
+		vector<int> &m_verticesPerCurve;
+
+};
+
+} // namespace
+
+namespace IECore
+{
+
+namespace CurvesAlgo
+{
+
+CurvesPrimitivePtr merge(
+	const std::vector<const CurvesPrimitive *> &curves,
+	bool removeNonMatchingPrimVars, /* = false */
+	std::vector<Imath::V2i> *curveRanges /* = 0 */
+)
+{
+	if( curves.empty() )
+	{
+		throw InvalidArgumentException( "CurvesAlgo::merge : No curves to merge." );
+	}
+
+	for( vector<const CurvesPrimitive *>::const_iterator it = curves.begin() + 1, eIt = curves.end(); it != eIt; ++it )
+	{
+		if( !( (*it)->basis() == curves[0]->basis() ) || (*it)->periodic() != curves[0]->periodic() )
+		{
+			throw InvalidArgumentException( "CurvesAlgo::merge : Curves must all have the same basis and periodicity." );
+		}
+	}
+
+	const vector<const Primitive *> primitives( curves.begin(), curves.end() );
+
+	vector<size_t> curveOffsets;
+	Detail::primitiveMergeOffsets( primitives, PrimitiveVariable::Uniform, curveOffsets );
+
+	IntVectorDataPtr verticesPerCurveData = new IntVectorData;
+	vector<int> &verticesPerCurve = verticesPerCurveData->writable();
+	verticesPerCurve.resize( curveOffsets.back() );
+
+	MergeTopology mergeTopology( curves, curveOffsets, verticesPerCurve );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, curves.size() ), mergeTopology );
+
+	CurvesPrimitivePtr result = new CurvesPrimitive( verticesPerCurveData, curves[0]->basis(), curves[0]->periodic() );
+	Detail::mergePrimitiveVariables( primitives, result.get(), removeNonMatchingPrimVars );
+
+	if( curveRanges )
+	{
+		curveRanges->resize( curves.size() );
+		for( size_t i = 0; i < curves.size(); ++i )
+		{
+			(*curveRanges)[i] = V2i( curveOffsets[i], curveOffsets[i+1] );
+		}
+	}
+
+	return result;
+}
+
+} // namespace CurvesAlgo
+
+} // namespace IECore
@@ -33,12 +33,8 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECore/CurvesMergeOp.h"
+#include "IECore/CurvesAlgo.h"
 #include "IECore/CompoundParameter.h"
-#include "IECore/NullObject.h"
-#include "IECore/DespatchTypedData.h"
-#include "IECore/TypeTraits.h"
-
-#include <algorithm>
 
 using namespace IECore;
 using namespace std;
@@ -71,60 +67,36 @@ const CurvesPrimitiveParameter * CurvesMergeOp::curvesParameter() const
 	return m_curvesParameter.get();
 }
 
-struct CurvesMergeOp::AppendPrimVars
+void CurvesMergeOp::modifyTypedPrimitive( CurvesPrimitive * curves, const CompoundObject * operands )
 {
-	typedef void ReturnType;
+	const CurvesPrimitive *curves2 = static_cast<const CurvesPrimitive *>( m_curvesParameter->getValue() );
 
-	AppendPrimVars( const CurvesPrimitive * curves2, const std::string &name )
-		:	m_curves2( curves2 ), m_name( name )
-	{
-	}
+	vector<const CurvesPrimitive *> inputs;
+	inputs.push_back( curves );
+	inputs.push_back( curves2 );
+	CurvesPrimitivePtr merged = CurvesAlgo::merge( inputs );
 
-	template<typename T>
-	ReturnType operator()( T * data )
-	{
+	curves->setTopology( merged->verticesPerCurve(), curves->basis(), curves->periodic() );
 
-		PrimitiveVariableMap::const_iterator it = m_curves2->variables.find( m_name );
-		if( it!=m_curves2->variables.end() )
+	// Constant PrimitiveVariables are left as they were on the input curves,
+	// and everything else is replaced with the merged data.
+	for( PrimitiveVariableMap::iterator it = curves->variables.begin(); it != curves->variables.end(); )
+	{
+		if( it->second.interpolation != PrimitiveVariable::Constant )
+		{
+			curves->variables.erase( it++ );
+		}
+		else
 		{
-			const T *data2 = runTimeCast<const T>( it->second.data.get() );
-			if( data2 )
-			{
-				data->writable().insert( data->writable().end(), data2->readable().begin(), data2->readable().end() );
-			}
+			++it;
 		}
 	}
 
-	private :
-
-		const CurvesPrimitive * m_curves2;
-		std::string m_name;
-
-};
-
-void CurvesMergeOp::modifyTypedPrimitive( CurvesPrimitive * curves, const CompoundObject * operands )
-{
-	const CurvesPrimitive *curves2 = static_cast<const CurvesPrimitive *>( m_curvesParameter->getValue() );
-
-	const vector<int> &verticesPerCurve1 = curves->verticesPerCurve()->readable();
-	const vector<int> &verticesPerCurve2 = curves2->verticesPerCurve()->readable();
-	
-	IntVectorDataPtr verticesPerCurveData = new IntVectorData;
-	vector<int> &verticesPerCurve = verticesPerCurveData->writable();
-	verticesPerCurve.resize( verticesPerCurve1.size() + verticesPerCurve2.size() );
-	
-	vector<int>::iterator it = copy( verticesPerCurve1.begin(), verticesPerCurve1.end(), verticesPerCurve.begin() );
-	copy( verticesPerCurve2.begin(), verticesPerCurve2.end(), it );
-
-	curves->setTopology( verticesPerCurveData, curves->basis(), curves->periodic() );
-
-	PrimitiveVariableMap::iterator pvIt;
-	for( pvIt=curves->variables.begin(); pvIt!=curves->variables.end(); pvIt++ )
+	for( PrimitiveVariableMap::const_iterator it = merged->variables.begin(); it != merged->variables.end(); ++it )
 	{
-		if( pvIt->second.interpolation!=PrimitiveVariable::Constant )
+		if( it->second.interpolation != PrimitiveVariable::Constant )
 		{
-			AppendPrimVars f( curves2, pvIt->first );
-			despatchTypedData<AppendPrimVars, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( pvIt->second.data.get(), f );
+			curves->variables.insert( *it );
 		}
 	}
 }
@@ -34,6 +34,10 @@
 
 #include "OpenEXR/ImathFun.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
+
 #include "IECore/CurvesPrimitiveEvaluator.h"
 #include "IECore/CurvesPrimitive.h"
 #include "IECore/Exception.h"
@@ -252,8 +256,8 @@ void CurvesPrimitiveEvaluator::Result::init( unsigned curveIndex, float v, const
 	{
 		m_coefficients[0] = 1.0f - m_segmentV;
 		m_coefficients[1] = m_segmentV;
-		m_derivativeCoefficients[0] = 1.0f;
-		m_derivativeCoefficients[1] = -1.0f;
+		m_derivativeCoefficients[0] = -1.0f;
+		m_derivativeCoefficients[1] = 1.0f;
 		m_vertexDataIndices[0] = m_varyingDataIndices[0] = o + i;
 		if( periodic )
 		{
@@ -300,6 +304,10 @@ struct CurvesPrimitiveEvaluator::Line
 {
 	public :
 	
+		Line()
+		{
+		}
+
 		Line( const V3f &p1, const V3f &p2, unsigned curveIndex, float vMin, float vMax )
 			:	m_lineSegment( p1, p2 ), m_curveIndex( curveIndex ), m_vMin( vMin ), m_vMax( vMax )
 		{
@@ -328,7 +336,7 @@ struct CurvesPrimitiveEvaluator::Line
 //////////////////////////////////////////////////////////////////////////
 
 CurvesPrimitiveEvaluator::CurvesPrimitiveEvaluator( ConstCurvesPrimitivePtr curves )
-	:	m_curvesPrimitive( curves->copy() ), m_verticesPerCurve( m_curvesPrimitive->verticesPerCurve()->readable() ), m_haveTree( false )
+	:	m_curvesPrimitive( curves->copy() ), m_verticesPerCurve( m_curvesPrimitive->verticesPerCurve()->readable() ), m_haveSegments( false ), m_haveTree( false )
 {
 	m_vertexDataOffsets.reserve( m_verticesPerCurve.size() );
 	m_varyingDataOffsets.reserve( m_verticesPerCurve.size() );
@@ -634,72 +642,384 @@ float CurvesPrimitiveEvaluator::curveLength( unsigned curveIndex, float vStart,
 	}
 }
 
-void CurvesPrimitiveEvaluator::buildTree()
+//////////////////////////////////////////////////////////////////////////
+// Implementation of segment tables and batch queries
+//////////////////////////////////////////////////////////////////////////
+
+namespace
 {
-	if( m_haveTree )
+
+// Maps v onto a segment and a parameter within that segment, in exactly
+// the same way as Result::init().
+inline unsigned segmentAndParameter( float v, unsigned numSegments, float &t )
+{
+	float vv = v * numSegments;
+	unsigned segment = min( (unsigned)fastFloatFloor( vv ), numSegments - 1 );
+	t = vv - segment;
+	return segment;
+}
+
+inline V3f evaluateSegment( const V3f *c, float t )
+{
+	return ( ( c[0] * t + c[1] ) * t + c[2] ) * t + c[3];
+}
+
+inline V3f evaluateSegmentDerivative( const V3f *c, float t )
+{
+	return ( c[0] * ( 3.0f * t ) + c[1] * 2.0f ) * t + c[2];
+}
+
+} // namespace
+
+class CurvesPrimitiveEvaluator::SegmentBuilder
+{
+
+	public :
+
+		SegmentBuilder( CurvesPrimitiveEvaluator *evaluator )
+			:	m_evaluator( evaluator ), m_p( static_cast<const V3fVectorData *>( evaluator->m_p.data.get() )->readable() )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			const CubicBasisf &basis = m_evaluator->m_curvesPrimitive->basis();
+			const bool linear = basis == CubicBasisf::linear();
+			const bool periodic = m_evaluator->m_curvesPrimitive->periodic();
+
+			for( size_t curveIndex = range.begin(); curveIndex != range.end(); ++curveIndex )
+			{
+				const unsigned numVertices = m_evaluator->m_verticesPerCurve[curveIndex];
+				const unsigned o = m_evaluator->m_vertexDataOffsets[curveIndex];
+				const unsigned firstSegment = m_evaluator->m_segmentOffsets[curveIndex];
+				const unsigned numSegments = m_evaluator->m_segmentOffsets[curveIndex+1] - firstSegment;
+
+				V3f *c = &(m_evaluator->m_segmentCoefficients[firstSegment * 4]);
+				for( unsigned segment = 0; segment < numSegments; ++segment, c += 4 )
+				{
+					const unsigned i = segment * basis.step;
+					if( linear )
+					{
+						const V3f &p0 = m_p[o + i];
+						const V3f &p1 = m_p[o + ( periodic ? ( i + 1 ) % numVertices : i + 1 )];
+						c[0] = c[1] = V3f( 0 );
+						c[2] = p1 - p0;
+						c[3] = p0;
+					}
+					else
+					{
+						V3f p[4];
+						for( unsigned k = 0; k < 4; ++k )
+						{
+							p[k] = m_p[o + ( periodic ? ( i + k ) % numVertices : i + k )];
+						}
+						// gather the basis matrix into the coefficients of the cubic polynomial,
+						// so that evaluation costs one Horner step per power of t.
+						for( unsigned j = 0; j < 4; ++j )
+						{
+							c[j] = basis.matrix[j][0] * p[0] + basis.matrix[j][1] * p[1] + basis.matrix[j][2] * p[2] + basis.matrix[j][3] * p[3];
+						}
+					}
+				}
+			}
+		}
+
+	private :
+
+		CurvesPrimitiveEvaluator *m_evaluator;
+		const std::vector<V3f> &m_p;
+
+};
+
+void CurvesPrimitiveEvaluator::buildSegments()
+{
+	if( m_haveSegments )
 	{
 		return;
 	}
-	
-	TreeMutex::scoped_lock lock( m_treeMutex );
-	if( m_haveTree )
+
+	tbb::mutex::scoped_lock lock( m_segmentsMutex );
+	if( m_haveSegments )
 	{
-		// another thread may have built the tree while we waited for the mutex
+		// another thread may have built the segments while we waited for the mutex
 		return;
 	}
-	
-	bool linear = m_curvesPrimitive->basis() == CubicBasisf::linear();
-	const std::vector<V3f> &p = static_cast<const V3fVectorData *>( m_p.data.get() )->readable();
-	PrimitiveEvaluator::ResultPtr result = createResult();
-	
-	size_t numCurves = m_curvesPrimitive->numCurves();
-	for( size_t curveIndex = 0; curveIndex<numCurves; curveIndex++ )
+
+	const size_t numCurves = m_verticesPerCurve.size();
+	m_segmentOffsets.resize( numCurves + 1 );
+	unsigned numSegments = 0;
+	for( size_t curveIndex = 0; curveIndex < numCurves; curveIndex++ )
 	{
-		if( linear )
+		m_segmentOffsets[curveIndex] = numSegments;
+		numSegments += m_curvesPrimitive->numSegments( curveIndex );
+	}
+	m_segmentOffsets[numCurves] = numSegments;
+
+	m_segmentCoefficients.resize( numSegments * 4 );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numCurves ), SegmentBuilder( this ) );
+
+	m_haveSegments = true;
+}
+
+class CurvesPrimitiveEvaluator::PointsAtVQuery
+{
+
+	public :
+
+		PointsAtVQuery( const CurvesPrimitiveEvaluator *evaluator, const std::vector<unsigned> &curveIndices, const std::vector<float> &v, std::vector<V3f> &points, std::vector<V3f> *vTangents )
+			:	m_evaluator( evaluator ), m_curveIndices( curveIndices ), m_v( v ), m_points( points ), m_vTangents( vTangents ), m_valid( true )
 		{
-			int numVertices = m_verticesPerCurve[curveIndex];
-			int vertIndex = m_vertexDataOffsets[curveIndex];
-			float prevV = 0.0f;
-			for( int i=0; i<numVertices; i++, vertIndex++ )
+		}
+
+		PointsAtVQuery( PointsAtVQuery &other, tbb::split )
+			:	m_evaluator( other.m_evaluator ), m_curveIndices( other.m_curveIndices ), m_v( other.m_v ), m_points( other.m_points ), m_vTangents( other.m_vTangents ), m_valid( true )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range )
+		{
+			const std::vector<unsigned> &segmentOffsets = m_evaluator->m_segmentOffsets;
+			const size_t numCurves = m_evaluator->m_verticesPerCurve.size();
+
+			for( size_t i = range.begin(); i != range.end(); ++i )
 			{
-				float v = clamp( (float)i/(float)(numVertices-1), 0.0f, 1.0f );
-				if( i!=0 )
+				const unsigned curveIndex = m_curveIndices[i];
+				const float v = m_v[i];
+				if( curveIndex >= numCurves || v < 0.0f || v > 1.0f || segmentOffsets[curveIndex+1] == segmentOffsets[curveIndex] )
 				{
-					Box3f b;
-					b.extendBy( p[vertIndex-1] );
-					b.extendBy( p[vertIndex] );
-					m_treeBounds.push_back( b );
-					m_treeLines.push_back( Line(  p[vertIndex-1], p[vertIndex], curveIndex, prevV, v ) );
+					// invalid query, or a degenerate curve with no segments to evaluate
+					m_points[i] = V3f( 0 );
+					if( m_vTangents )
+					{
+						(*m_vTangents)[i] = V3f( 0 );
+					}
+					m_valid = false;
+					continue;
+				}
+
+				const unsigned firstSegment = segmentOffsets[curveIndex];
+				float t;
+				const unsigned segment = segmentAndParameter( v, segmentOffsets[curveIndex+1] - firstSegment, t );
+				const V3f *c = &(m_evaluator->m_segmentCoefficients[( firstSegment + segment ) * 4]);
+
+				m_points[i] = evaluateSegment( c, t );
+				if( m_vTangents )
+				{
+					(*m_vTangents)[i] = evaluateSegmentDerivative( c, t );
 				}
-				prevV = v;				
 			}
 		}
-		else
+
+		void join( const PointsAtVQuery &other )
+		{
+			m_valid = m_valid && other.m_valid;
+		}
+
+		bool valid() const
 		{
-			unsigned numSegments = m_curvesPrimitive->numSegments( curveIndex );
-			int steps = numSegments * Line::linesPerCurveSegment();
-			V3f prevP( 0 );
-			float prevV = 0;
-			for( int i=0; i<steps; i++ )
+			return m_valid;
+		}
+
+	private :
+
+		const CurvesPrimitiveEvaluator *m_evaluator;
+		const std::vector<unsigned> &m_curveIndices;
+		const std::vector<float> &m_v;
+		std::vector<V3f> &m_points;
+		std::vector<V3f> *m_vTangents;
+		bool m_valid;
+
+};
+
+bool CurvesPrimitiveEvaluator::pointsAtV( const std::vector<unsigned> &curveIndices, const std::vector<float> &v, std::vector<Imath::V3f> &points, std::vector<Imath::V3f> *vTangents ) const
+{
+	if( curveIndices.size() != v.size() )
+	{
+		throw InvalidArgumentException( "CurvesPrimitiveEvaluator::pointsAtV : curveIndices and v must have the same length." );
+	}
+
+	// see comments in closestPoint() for the justification of the const_cast.
+	const_cast<CurvesPrimitiveEvaluator *>( this )->buildSegments();
+
+	points.resize( v.size() );
+	if( vTangents )
+	{
+		vTangents->resize( v.size() );
+	}
+
+	PointsAtVQuery query( this, curveIndices, v, points, vTangents );
+	tbb::parallel_reduce( tbb::blocked_range<size_t>( 0, v.size() ), query );
+	return query.valid();
+}
+
+class CurvesPrimitiveEvaluator::ClosestPointsQuery
+{
+
+	public :
+
+		ClosestPointsQuery( const CurvesPrimitiveEvaluator *evaluator, const std::vector<V3f> &points, std::vector<unsigned> &curveIndices, std::vector<float> &v )
+			:	m_evaluator( evaluator ), m_points( points ), m_curveIndices( curveIndices ), m_v( v )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				unsigned curveIndex = 0;
+				float v = -1;
+				float distSquared = Imath::limits<float>::max();
+				m_evaluator->closestPointWalk( m_evaluator->m_tree.rootIndex(), m_points[i], curveIndex, v, distSquared );
+				m_curveIndices[i] = curveIndex;
+				m_v[i] = v;
+			}
+		}
+
+	private :
+
+		const CurvesPrimitiveEvaluator *m_evaluator;
+		const std::vector<V3f> &m_points;
+		std::vector<unsigned> &m_curveIndices;
+		std::vector<float> &m_v;
+
+};
+
+bool CurvesPrimitiveEvaluator::closestPoints( const std::vector<Imath::V3f> &points, std::vector<unsigned> &curveIndices, std::vector<float> &v ) const
+{
+	if( !m_verticesPerCurve.size() )
+	{
+		return false;
+	}
+
+	// see comments in closestPoint() for the justification of the const_cast.
+	const_cast<CurvesPrimitiveEvaluator *>( this )->buildTree();
+
+	curveIndices.resize( points.size() );
+	v.resize( points.size() );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, points.size() ), ClosestPointsQuery( this, points, curveIndices, v ) );
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Implementation of tree building
+//////////////////////////////////////////////////////////////////////////
+
+class CurvesPrimitiveEvaluator::LineBuilder
+{
+
+	public :
+
+		LineBuilder( CurvesPrimitiveEvaluator *evaluator, const std::vector<size_t> &lineOffsets )
+			:	m_evaluator( evaluator ), m_lineOffsets( lineOffsets ), m_p( static_cast<const V3fVectorData *>( evaluator->m_p.data.get() )->readable() )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			const bool linear = m_evaluator->m_curvesPrimitive->basis() == CubicBasisf::linear();
+
+			for( size_t curveIndex = range.begin(); curveIndex != range.end(); ++curveIndex )
 			{
-				float v = clamp( (float)i/(float)(steps-1), 0.0f, 1.0f );
-				pointAtV( curveIndex, v, result.get() );
-				V3f p = result->point();
-				if( i!=0 )
+				size_t lineIndex = m_lineOffsets[curveIndex];
+				const size_t numLines = m_lineOffsets[curveIndex+1] - lineIndex;
+				if( !numLines )
+				{
+					continue;
+				}
+
+				if( linear )
 				{
-					Box3f b;
-					b.extendBy( prevP );
-					b.extendBy( p );
-					m_treeBounds.push_back( b );
-					m_treeLines.push_back( Line( prevP, p, curveIndex, prevV, v ) );
+					const unsigned o = m_evaluator->m_vertexDataOffsets[curveIndex];
+					float prevV = 0.0f;
+					for( size_t i = 1; i <= numLines; ++i, ++lineIndex )
+					{
+						const float v = clamp( (float)i/(float)numLines, 0.0f, 1.0f );
+						addLine( lineIndex, m_p[o+i-1], m_p[o+i], curveIndex, prevV, v );
+						prevV = v;
+					}
 				}
+				else
+				{
+					const unsigned firstSegment = m_evaluator->m_segmentOffsets[curveIndex];
+					const unsigned numSegments = m_evaluator->m_segmentOffsets[curveIndex+1] - firstSegment;
+					const V3f *coefficients = &(m_evaluator->m_segmentCoefficients[firstSegment * 4]);
 
-				prevP = p;
-				prevV = v;
+					V3f prevP = evaluateSegment( coefficients, 0.0f );
+					float prevV = 0.0f;
+					for( size_t i = 1; i <= numLines; ++i, ++lineIndex )
+					{
+						const float v = clamp( (float)i/(float)numLines, 0.0f, 1.0f );
+						float t;
+						const unsigned segment = segmentAndParameter( v, numSegments, t );
+						const V3f p = evaluateSegment( coefficients + segment * 4, t );
+						addLine( lineIndex, prevP, p, curveIndex, prevV, v );
+						prevP = p;
+						prevV = v;
+					}
+				}
 			}
 		}
+
+	private :
+
+		void addLine( size_t lineIndex, const V3f &p0, const V3f &p1, size_t curveIndex, float v0, float v1 ) const
+		{
+			Box3f &b = m_evaluator->m_treeBounds[lineIndex];
+			b.makeEmpty();
+			b.extendBy( p0 );
+			b.extendBy( p1 );
+			m_evaluator->m_treeLines[lineIndex] = Line( p0, p1, curveIndex, v0, v1 );
+		}
+
+		CurvesPrimitiveEvaluator *m_evaluator;
+		const std::vector<size_t> &m_lineOffsets;
+		const std::vector<V3f> &m_p;
+
+};
+
+void CurvesPrimitiveEvaluator::buildTree()
+{
+	if( m_haveTree )
+	{
+		return;
 	}
-	
+
+	TreeMutex::scoped_lock lock( m_treeMutex );
+	if( m_haveTree )
+	{
+		// another thread may have built the tree while we waited for the mutex
+		return;
+	}
+
+	// the cubic lines are sampled from the segment tables, so we need those first.
+	buildSegments();
+
+	// count the lines for each curve so we know where each one will write
+	// its output, and can then generate all the lines in parallel.
+	bool linear = m_curvesPrimitive->basis() == CubicBasisf::linear();
+	size_t numCurves = m_verticesPerCurve.size();
+	std::vector<size_t> lineOffsets( numCurves + 1 );
+	size_t numLines = 0;
+	for( size_t curveIndex = 0; curveIndex<numCurves; curveIndex++ )
+	{
+		lineOffsets[curveIndex] = numLines;
+		if( linear )
+		{
+			numLines += max( m_verticesPerCurve[curveIndex] - 1, 0 );
+		}
+		else
+		{
+			size_t steps = ( m_segmentOffsets[curveIndex+1] - m_segmentOffsets[curveIndex] ) * Line::linesPerCurveSegment();
+			numLines += steps ? steps - 1 : 0;
+		}
+	}
+	lineOffsets[numCurves] = numLines;
+
+	m_treeBounds.resize( numLines );
+	m_treeLines.resize( numLines );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numCurves ), LineBuilder( this, lineOffsets ) );
+
 	m_tree.init( m_treeBounds.begin(), m_treeBounds.end() );
 	m_haveTree = true;
 }
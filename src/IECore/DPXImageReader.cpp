@@ -66,7 +66,7 @@ struct DPXImageReader::Header
 	DPXImageOrientation m_imageOrientation;
 };
 
-const Reader::ReaderDescription<DPXImageReader> DPXImageReader::m_readerDescription("dpx");
+const Reader::ReaderDescription<DPXImageReader> DPXImageReader::m_readerDescription("dpx", "53445058 58504453");
 
 DPXImageReader::DPXImageReader() :
 		ImageReader( "Reads Digital Picture eXchange (DPX) files."),
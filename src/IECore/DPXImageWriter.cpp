@@ -46,9 +46,10 @@
 #include "IECore/private/dpx.h"
 
 #include "boost/date_time/posix_time/ptime.hpp"
-#include "boost/multi_array.hpp"
 #include "boost/format.hpp"
 
+#include "tbb/parallel_for.h"
+
 #include <fstream>
 
 using namespace IECore;
@@ -97,37 +98,66 @@ struct DPXImageWriter::ChannelConverter
 	}
 
 	template<typename T>
-			ReturnType operator()( T *dataContainer )
+	ReturnType operator()( T *dataContainer )
 	{
 		assert( dataContainer );
 
-		const typename T::ValueType &data = dataContainer->readable();
-
-		ScaledDataConversion<typename T::ValueType::value_type, float> converter;
-
-		typedef boost::multi_array_ref< const typename T::ValueType::value_type, 2 > SourceArray2D;
-		typedef boost::multi_array_ref< unsigned int, 2 > TargetArray2D;
-		
 		// Grab the display and data windows to avoid dereferencing pointers during the tight loop later...
 		const Box2i srcDisplayWindow = m_image->getDisplayWindow();
 		const Box2i srcDataWindow = m_image->getDataWindow();
-		
-		const SourceArray2D sourceData( &data[0], extents[ srcDataWindow.size().y + 1 ][ srcDataWindow.size().x + 1 ] );
-		TargetArray2D targetData( &m_imageBuffer[0], extents[ srcDisplayWindow.size().y + 1 ][ srcDisplayWindow.size().x + 1 ] );
 
 		const Box2i copyRegion = boxIntersection( m_dataWindow, boxIntersection( srcDisplayWindow, srcDataWindow ) );
-		
-		const unsigned int boxOffsetX = copyRegion.min.x - srcDisplayWindow.min.x;
-		const unsigned int boxOffsetY = copyRegion.min.y - srcDisplayWindow.min.y;
-
-		for ( int y = copyRegion.min.y; y <= copyRegion.max.y ; y++ )
+		if( copyRegion.isEmpty() )
 		{
-			for ( int x = copyRegion.min.x; x <= copyRegion.max.x ; x++ )
+			return;
+		}
+
+		tbb::parallel_for(
+			tbb::blocked_range<int>( copyRegion.min.y, copyRegion.max.y + 1 ),
+			PackRows<T>( dataContainer->readable(), srcDisplayWindow, srcDataWindow, copyRegion, m_bitShift, m_imageBuffer )
+		);
+	};
+
+	// Packs rows of a single channel into its 10 bit slot within the 32 bit words
+	// of the image buffer. Each row is independent, so they are packed in parallel.
+	template<typename T>
+	class PackRows
+	{
+
+		public :
+
+			PackRows( const typename T::ValueType &data, const Box2i &srcDisplayWindow, const Box2i &srcDataWindow, const Box2i &copyRegion, unsigned int bitShift, std::vector<unsigned int> &imageBuffer )
+				:	m_data( data ), m_srcDisplayWindow( srcDisplayWindow ), m_srcDataWindow( srcDataWindow ), m_copyRegion( copyRegion ), m_bitShift( bitShift ), m_imageBuffer( imageBuffer )
 			{
-				targetData[ (y - copyRegion.min.y) + boxOffsetY ][ (x - copyRegion.min.x) + boxOffsetX ]
-						|= std::min((unsigned int)1023, (unsigned int)(converter( sourceData[ y - srcDataWindow.min.y ][ x - srcDataWindow.min.x ] ) * 1023 )) << m_bitShift;
 			}
-		}
+
+			void operator()( const tbb::blocked_range<int> &range ) const
+			{
+				ScaledDataConversion<typename T::ValueType::value_type, float> converter;
+
+				const int srcWidth = m_srcDataWindow.size().x + 1;
+				const int dstWidth = m_srcDisplayWindow.size().x + 1;
+
+				for( int y = range.begin(); y != range.end(); ++y )
+				{
+					const typename T::ValueType::value_type *src = &m_data[0] + ( y - m_srcDataWindow.min.y ) * srcWidth + ( m_copyRegion.min.x - m_srcDataWindow.min.x );
+					unsigned int *dst = &m_imageBuffer[0] + ( y - m_srcDisplayWindow.min.y ) * dstWidth + ( m_copyRegion.min.x - m_srcDisplayWindow.min.x );
+					for( int x = m_copyRegion.min.x; x <= m_copyRegion.max.x; ++x, ++src, ++dst )
+					{
+						*dst |= std::min( (unsigned int)1023, (unsigned int)( converter( *src ) * 1023 ) ) << m_bitShift;
+					}
+				}
+			}
+
+		private :
+
+			const typename T::ValueType &m_data;
+			const Box2i &m_srcDisplayWindow;
+			const Box2i &m_srcDataWindow;
+			const Box2i &m_copyRegion;
+			unsigned int m_bitShift;
+			std::vector<unsigned int> &m_imageBuffer;
+
 	};
 
 	struct ErrorHandler
@@ -142,6 +172,34 @@ struct DPXImageWriter::ChannelConverter
 	};
 };
 
+namespace
+{
+
+class ToBigEndian
+{
+
+	public :
+
+		ToBigEndian( std::vector<unsigned int> &buffer )
+			:	m_buffer( buffer )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				m_buffer[i] = asBigEndian<>( m_buffer[i] );
+			}
+		}
+
+	private :
+
+		std::vector<unsigned int> &m_buffer;
+
+};
+
+} // namespace
 
 void DPXImageWriter::writeImage( const vector<string> &names, const ImagePrimitive *image, const Box2i &dataWindow ) const
 {
@@ -343,13 +401,10 @@ void DPXImageWriter::writeImage( const vector<string> &names, const ImagePrimiti
 	}
 
 	// write the buffer
-	for (int i = 0; i < displayWidth * displayHeight; ++i)
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, imageBuffer.size() ), ToBigEndian( imageBuffer ) );
+	out.write( (const char *)&imageBuffer[0], imageBuffer.size() * sizeof( unsigned int ) );
+	if ( out.fail() )
 	{
-		imageBuffer[i] = asBigEndian<>(imageBuffer[i]);
-		out.write( (const char *) (&imageBuffer[i]), sizeof(unsigned int) );
-		if ( out.fail() )
-		{
-			throw IOException( "DPXImageWriter: Error writing to " + fileName() );
-		}
+		throw IOException( "DPXImageWriter: Error writing to " + fileName() );
 	}
 }
@@ -58,7 +58,7 @@ inline size_t pixelTypeSize( Imf::PixelType p )
 
 IE_CORE_DEFINERUNTIMETYPED( EXRDeepImageReader );
 
-const Reader::ReaderDescription<EXRDeepImageReader> EXRDeepImageReader::g_readerDescription( "dexr exr" );
+const Reader::ReaderDescription<EXRDeepImageReader> EXRDeepImageReader::g_readerDescription( "dexr exr", "762f3101" );
 
 EXRDeepImageReader::EXRDeepImageReader()
 	:	DeepImageReader( "Reads EXR 2.0 deep image file format." ),
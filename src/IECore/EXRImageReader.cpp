@@ -77,7 +77,7 @@ using Imath::Box2i;
 
 IE_CORE_DEFINERUNTIMETYPED( EXRImageReader );
 
-const Reader::ReaderDescription<EXRImageReader> EXRImageReader::g_readerDescription("exr");
+const Reader::ReaderDescription<EXRImageReader> EXRImageReader::g_readerDescription("exr", "762f3101");
 
 EXRImageReader::EXRImageReader() :
 		ImageReader( "Reads ILM OpenEXR file format." ),
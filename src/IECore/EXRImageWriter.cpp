@@ -50,9 +50,16 @@
 #include "OpenEXR/ImfMatrixAttribute.h"
 #include "OpenEXR/ImfStringAttribute.h"
 #include "OpenEXR/ImfTimeCodeAttribute.h"
+#include "OpenEXR/ImfTiledOutputFile.h"
+#include "OpenEXR/ImfThreading.h"
 
 #include "boost/format.hpp"
+#include "boost/lexical_cast.hpp"
 
+#include "tbb/mutex.h"
+#include "tbb/task_scheduler_init.h"
+
+#include <cstdlib>
 #include <fstream>
 
 using namespace IECore;
@@ -65,6 +72,42 @@ using namespace Imf;
 
 IE_CORE_DEFINERUNTIMETYPED( EXRImageWriter )
 
+namespace
+{
+
+// OpenEXR only compresses in parallel if its global thread pool has been
+// given some threads. The pool belongs to the whole process, so we only
+// configure it if requested, and only if nobody else has already done so.
+// Images may be written from several threads at once, so the check is made
+// under a lock.
+tbb::mutex g_globalThreadCountMutex;
+bool g_globalThreadCountInitialised = false;
+
+void initialiseGlobalThreadCount()
+{
+	tbb::mutex::scoped_lock lock( g_globalThreadCountMutex );
+	if( g_globalThreadCountInitialised )
+	{
+		return;
+	}
+	g_globalThreadCountInitialised = true;
+
+	const char *t = getenv( "IECORE_EXRIMAGEWRITER_THREADS" );
+	if( !t || globalThreadCount() != 0 )
+	{
+		return;
+	}
+
+	int numThreads = boost::lexical_cast<int>( t );
+	if( numThreads == 0 )
+	{
+		numThreads = tbb::task_scheduler_init::default_num_threads();
+	}
+	setGlobalThreadCount( numThreads );
+}
+
+} // namespace
+
 const Writer::WriterDescription<EXRImageWriter> EXRImageWriter::m_writerDescription("exr");
 
 EXRImageWriter::EXRImageWriter()
@@ -117,6 +160,16 @@ void EXRImageWriter::constructCommon()
 
 	parameters()->addParameter( compressionParameter );
 
+	IntParameterPtr tileSizeParameter = new IntParameter(
+		"tileSize",
+		"The width and height of the tiles to write. When this is 0, "
+		"a scanline image is written instead.",
+		0,
+		0
+	);
+
+	parameters()->addParameter( tileSizeParameter );
+
 }
 
 std::string EXRImageWriter::destinationColorSpace() const
@@ -134,6 +187,16 @@ const IntParameter * EXRImageWriter::compressionParameter() const
 	return parameters()->parameter< IntParameter >( "compression" );
 }
 
+IntParameter * EXRImageWriter::tileSizeParameter()
+{
+	return parameters()->parameter< IntParameter >( "tileSize" );
+}
+
+const IntParameter * EXRImageWriter::tileSizeParameter() const
+{
+	return parameters()->parameter< IntParameter >( "tileSize" );
+}
+
 static void blindDataToHeader( const CompoundData *blindData, Imf::Header &header, std::string prefix = "" )
 {
 	const CompoundDataMap &map = blindData->readable();
@@ -282,11 +345,25 @@ void EXRImageWriter::writeImage( const vector<string> &names, const ImagePrimiti
 			}
 		}
 
+		initialiseGlobalThreadCount();
+
 		// create the output file, write, implicitly close
-		OutputFile out(fileName().c_str(), header);
+		const int tileSize = tileSizeParameter()->getNumericValue();
+		if( tileSize > 0 )
+		{
+			header.setTileDescription( TileDescription( tileSize, tileSize, ONE_LEVEL ) );
+			TiledOutputFile out( fileName().c_str(), header );
 
-		out.setFrameBuffer(fb);
-		out.writePixels(height);
+			out.setFrameBuffer( fb );
+			out.writeTiles( 0, out.numXTiles() - 1, 0, out.numYTiles() - 1 );
+		}
+		else
+		{
+			OutputFile out(fileName().c_str(), header);
+
+			out.setFrameBuffer(fb);
+			out.writePixels(height);
+		}
 	}
 	catch ( Exception &e )
 	{
@@ -197,7 +197,7 @@ bool FileIndexedIO::StreamFile::canRead( const std::string &path )
 //
 ///////////////////////////////////////////////
 
-static IndexedIO::Description<FileIndexedIO> registrar(".fio");
+static IndexedIO::Description<FileIndexedIO> registrar( ".fio", &FileIndexedIO::canRead );
 
 IndexedIOPtr FileIndexedIO::create(const std::string &path, const IndexedIO::EntryIDList &root, IndexedIO::OpenMode mode)
 {
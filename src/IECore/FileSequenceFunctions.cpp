@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <cassert>
 #include <math.h>
+#include <ctime>
 
 #include "boost/version.hpp"
 #include "boost/format.hpp"
@@ -44,6 +45,11 @@
 #include "boost/filesystem/path.hpp"
 #include "boost/filesystem/convenience.hpp"
 #include "boost/algorithm/string.hpp"
+#include "boost/functional/hash.hpp"
+#include "boost/shared_ptr.hpp"
+
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
 
 #include "IECore/Exception.h"
 #include "IECore/FileSequence.h"
@@ -51,6 +57,7 @@
 #include "IECore/CompoundFrameList.h"
 #include "IECore/EmptyFrameList.h"
 #include "IECore/FrameRange.h"
+#include "IECore/LRUCache.h"
 #include "IECore/ReversedFrameList.h"
 
 #if BOOST_VERSION < 103400
@@ -81,102 +88,373 @@
 
 using namespace IECore;
 
-void IECore::findSequences( const std::vector< std::string > &names, std::vector< FileSequencePtr > &sequences, size_t minSequenceSize )
+namespace
 {
-	sequences.clear();
 
-	/// this matches names of the form $prefix$frameNumber$suffix
-	/// placing each of those in a group of the resulting match.
-	/// both $prefix and $suffix may be the empty string and $frameNumber
-	/// may be preceded by a minus sign.
-	/// It also matches file extensions with 3 or 4 characters that contain numbers (for example: CR2, MP3 )
-	boost::regex matchExpression( std::string( "^([^#]*?)(-?[0-9]+)([^0-9#]*|[^0-9#]*\\.[a-zA-Z]{2,3}[0-9])$" ) );
+inline bool isDigit( char c )
+{
+	return c >= '0' && c <= '9';
+}
 
-	/// build a mapping from ($prefix, $suffix) to a list of $frameNumbers
-	typedef std::vector< std::string > Frames;
-	typedef std::map< std::pair< std::string, std::string >, Frames > SequenceMap;
+inline bool isLetter( char c )
+{
+	return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' );
+}
 
-	SequenceMap sequenceMap;
+/// Splits a name of the form $prefix$frameNumber$suffix, returning the
+/// [ frameBegin, frameEnd ) range of $frameNumber. Both $prefix and $suffix
+/// may be the empty string and $frameNumber may be preceded by a minus sign.
+/// $suffix may also end with a file extension of 2 or 3 letters followed by
+/// a number (for example: CR2, MP3). This gives the same results as matching
+/// against the regex "^([^#]*?)(-?[0-9]+)([^0-9#]*|[^0-9#]*\.[a-zA-Z]{2,3}[0-9])$",
+/// but is many times faster, which matters for directories containing
+/// hundreds of thousands of files.
+bool parseName( const std::string &name, size_t &frameBegin, size_t &frameEnd )
+{
+	if( name.find( '#' ) != std::string::npos )
+	{
+		return false;
+	}
 
-	for ( std::vector< std::string >::const_iterator it = names.begin(); it != names.end(); ++it )
+	// find the last run of digits.
+	size_t runEnd = name.size();
+	while( runEnd > 0 && !isDigit( name[runEnd-1] ) )
 	{
-		boost::smatch matches;
-		if ( boost::regex_match( *it, matches, matchExpression ) )
-		{
-			sequenceMap[
-				SequenceMap::key_type(
-					std::string( matches[1].first, matches[1].second ),
-					std::string( matches[3].first, matches[3].second )
-				)
-			].push_back( std::string( matches[2].first, matches[2].second ) );
-		}
+		runEnd--;
+	}
+	if( !runEnd )
+	{
+		return false;
+	}
+	size_t runBegin = runEnd - 1;
+	while( runBegin > 0 && isDigit( name[runBegin-1] ) )
+	{
+		runBegin--;
 	}
 
-	for ( SequenceMap::const_iterator it = sequenceMap.begin(); it != sequenceMap.end(); ++it )
+	// if the last run is a single digit terminating an extension,
+	// then the frame number is the run of digits before it, if
+	// there is one.
+	if( runEnd == name.size() && runEnd - runBegin == 1 )
 	{
-		const SequenceMap::key_type &fixes = it->first;
-		const Frames &frames = it->second;
-		// todo: could be more efficient by writing a custom comparison function that uses indexes
-		//	 into the const Frames vector rather than duplicating the strings and sorting them directly
-		Frames sortedFrames = frames;
-		std::sort( sortedFrames.begin(), sortedFrames.end() );
-
-		/// in diabolical cases the elements of frames may not all have the same padding
-		/// so we'll sort them out into padded and unpadded frame sequences here, by creating
-		/// a map of padding->list of frames. unpadded things will be considered to have a padding
-		/// of 1.
-		typedef std::vector< FrameList::Frame > NumericFrames;
-		typedef std::map< unsigned int, NumericFrames > PaddingToFramesMap;
-		PaddingToFramesMap paddingToFrames;
-		for ( Frames::const_iterator fIt = sortedFrames.begin(); fIt != sortedFrames.end(); ++fIt )
+		size_t extensionBegin = runBegin;
+		while( extensionBegin > 0 && isLetter( name[extensionBegin-1] ) && runBegin - extensionBegin < 4 )
 		{
-			std::string frame = *fIt;
-			int sign = 1;
-
-			assert( frame.size() );
-			if ( *frame.begin() == '-' )
+			extensionBegin--;
+		}
+		const size_t numLetters = runBegin - extensionBegin;
+		if( numLetters >= 2 && numLetters <= 3 && extensionBegin > 0 && name[extensionBegin-1] == '.' )
+		{
+			size_t previousRunEnd = extensionBegin - 1;
+			while( previousRunEnd > 0 && !isDigit( name[previousRunEnd-1] ) )
 			{
-				frame = frame.substr( 1, frame.size() - 1 );
-				sign = -1;
+				previousRunEnd--;
 			}
-			if ( *frame.begin() == '0' || paddingToFrames.find( frame.size() ) != paddingToFrames.end() )
+			if( previousRunEnd )
 			{
-				paddingToFrames[ frame.size() ].push_back( sign * boost::lexical_cast<FrameList::Frame>( frame ) );
+				runEnd = previousRunEnd;
+				runBegin = runEnd - 1;
+				while( runBegin > 0 && isDigit( name[runBegin-1] ) )
+				{
+					runBegin--;
+				}
 			}
-			else
+		}
+	}
+
+	frameBegin = ( runBegin > 0 && name[runBegin-1] == '-' ) ? runBegin - 1 : runBegin;
+	frameEnd = runEnd;
+	return true;
+}
+
+struct SplitName
+{
+	const std::string *name;
+	size_t frameBegin;
+	size_t frameEnd;
+	// hash of the prefix and suffix, used to accelerate grouping
+	size_t hash;
+};
+
+// Compares the $prefix, $suffix parts of two names.
+int compareFixes( const SplitName &a, const SplitName &b )
+{
+	if( int c = a.name->compare( 0, a.frameBegin, *b.name, 0, b.frameBegin ) )
+	{
+		return c;
+	}
+	return a.name->compare( a.frameEnd, std::string::npos, *b.name, b.frameEnd, std::string::npos );
+}
+
+// Orders names so that those from the same sequence are adjacent,
+// sorted by their frame number string.
+struct SplitNameLess
+{
+	bool operator()( const SplitName &a, const SplitName &b ) const
+	{
+		if( a.hash != b.hash )
+		{
+			return a.hash < b.hash;
+		}
+		if( int c = compareFixes( a, b ) )
+		{
+			return c < 0;
+		}
+		return a.name->compare( a.frameBegin, a.frameEnd - a.frameBegin, *b.name, b.frameBegin, b.frameEnd - b.frameBegin ) < 0;
+	}
+};
+
+// Orders groups by $prefix and then $suffix, so that sequences are returned
+// in a deterministic order.
+struct GroupLess
+{
+	GroupLess( const std::vector<SplitName> &splitNames )
+		:	m_splitNames( splitNames )
+	{
+	}
+
+	bool operator()( size_t a, size_t b ) const
+	{
+		return compareFixes( m_splitNames[a], m_splitNames[b] ) < 0;
+	}
+
+	const std::vector<SplitName> &m_splitNames;
+};
+
+class SplitNames
+{
+
+	public :
+
+		SplitNames( const std::vector<std::string> &names, std::vector<SplitName> &splitNames )
+			:	m_names( names ), m_splitNames( splitNames )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
 			{
-				paddingToFrames[ 1 ].push_back( sign * boost::lexical_cast<FrameList::Frame>( frame ) );
+				const std::string &name = m_names[i];
+				SplitName &splitName = m_splitNames[i];
+				if( !parseName( name, splitName.frameBegin, splitName.frameEnd ) )
+				{
+					splitName.name = 0;
+					continue;
+				}
+				splitName.name = &name;
+				splitName.hash = boost::hash_range( name.begin(), name.begin() + splitName.frameBegin );
+				boost::hash_combine( splitName.hash, boost::hash_range( name.begin() + splitName.frameEnd, name.end() ) );
 			}
 		}
 
-		for ( PaddingToFramesMap::iterator pIt = paddingToFrames.begin(); pIt != paddingToFrames.end(); ++pIt )
+	private :
+
+		const std::vector<std::string> &m_names;
+		std::vector<SplitName> &m_splitNames;
+
+};
+
+bool isNull( const SplitName &splitName )
+{
+	return !splitName.name;
+}
+
+// Makes the sequences for a single group of names sharing the same
+// $prefix and $suffix, with the names sorted by frame number string.
+void makeSequences( std::vector<SplitName>::const_iterator begin, std::vector<SplitName>::const_iterator end, size_t minSequenceSize, std::vector<FileSequencePtr> &sequences )
+{
+	/// in diabolical cases the elements of frames may not all have the same padding
+	/// so we'll sort them out into padded and unpadded frame sequences here, by creating
+	/// a map of padding->list of frames. unpadded things will be considered to have a padding
+	/// of 1.
+	typedef std::vector< FrameList::Frame > NumericFrames;
+	typedef std::map< unsigned int, NumericFrames > PaddingToFramesMap;
+	PaddingToFramesMap paddingToFrames;
+	for( std::vector<SplitName>::const_iterator it = begin; it != end; ++it )
+	{
+		std::string frame = it->name->substr( it->frameBegin, it->frameEnd - it->frameBegin );
+		int sign = 1;
+
+		assert( frame.size() );
+		if ( *frame.begin() == '-' )
+		{
+			frame = frame.substr( 1, frame.size() - 1 );
+			sign = -1;
+		}
+		if ( *frame.begin() == '0' || paddingToFrames.find( frame.size() ) != paddingToFrames.end() )
+		{
+			paddingToFrames[ frame.size() ].push_back( sign * boost::lexical_cast<FrameList::Frame>( frame ) );
+		}
+		else
 		{
-			const PaddingToFramesMap::key_type &padding = pIt->first;
-			NumericFrames &numericFrames = pIt->second;
-			std::sort( numericFrames.begin(), numericFrames.end() );
+			paddingToFrames[ 1 ].push_back( sign * boost::lexical_cast<FrameList::Frame>( frame ) );
+		}
+	}
+
+	const std::string &name = *begin->name;
+	const std::string prefix = name.substr( 0, begin->frameBegin );
+	const std::string suffix = name.substr( begin->frameEnd );
+
+	for ( PaddingToFramesMap::iterator pIt = paddingToFrames.begin(); pIt != paddingToFrames.end(); ++pIt )
+	{
+		const PaddingToFramesMap::key_type &padding = pIt->first;
+		NumericFrames &numericFrames = pIt->second;
+		std::sort( numericFrames.begin(), numericFrames.end() );
+
+		FrameListPtr frameList = frameListFromList( numericFrames );
+
+		std::vector< FrameList::Frame > expandedFrameList;
+		frameList->asList( expandedFrameList );
+
+		/// remove any sequences with less than the given minimum.
+		if ( expandedFrameList.size() >= minSequenceSize )
+		{
+			sequences.push_back(
+				new FileSequence(
+					prefix + std::string( padding, '#' ) + suffix,
+					frameList
+				)
+			);
+		}
+	}
+}
 
-			FrameListPtr frameList = frameListFromList( numericFrames );
+class MakeSequences
+{
 
-			std::vector< FrameList::Frame > expandedFrameList;
-			frameList->asList( expandedFrameList );
+	public :
 
-			/// remove any sequences with less than the given minimum.
-			if ( expandedFrameList.size() >= minSequenceSize )
+		MakeSequences( const std::vector<SplitName> &splitNames, const std::vector<size_t> &groupBegins, size_t minSequenceSize, std::vector<std::vector<FileSequencePtr> > &groupSequences )
+			:	m_splitNames( splitNames ), m_groupBegins( groupBegins ), m_minSequenceSize( minSequenceSize ), m_groupSequences( groupSequences )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			for( size_t i = range.begin(); i != range.end(); ++i )
 			{
-				std::string frameTemplate;
-				for ( PaddingToFramesMap::key_type i = 0; i < padding; i++ )
+				const size_t groupBegin = m_groupBegins[i];
+				size_t groupEnd = groupBegin + 1;
+				while( groupEnd < m_splitNames.size() && m_splitNames[groupEnd].hash == m_splitNames[groupBegin].hash && compareFixes( m_splitNames[groupEnd], m_splitNames[groupBegin] ) == 0 )
 				{
-					frameTemplate += "#";
+					groupEnd++;
 				}
-
-				sequences.push_back(
-					new FileSequence(
-						fixes.first + frameTemplate + fixes.second,
-						frameList
-					)
-				);
+				makeSequences( m_splitNames.begin() + groupBegin, m_splitNames.begin() + groupEnd, m_minSequenceSize, m_groupSequences[i] );
 			}
 		}
+
+	private :
+
+		const std::vector<SplitName> &m_splitNames;
+		const std::vector<size_t> &m_groupBegins;
+		size_t m_minSequenceSize;
+		std::vector<std::vector<FileSequencePtr> > &m_groupSequences;
+
+};
+
+struct DirectoryListing
+{
+	std::time_t modificationTime;
+	std::time_t listingTime;
+	std::vector<std::string> names;
+};
+
+typedef boost::shared_ptr<const DirectoryListing> ConstDirectoryListingPtr;
+
+/// Lists the file names in a directory. The directory_iterator doesn't
+/// need to stat the individual entries, so this is cheap even for huge
+/// directories on network filesystems.
+ConstDirectoryListingPtr listDirectory( const boost::filesystem::path &path )
+{
+	boost::shared_ptr<DirectoryListing> result( new DirectoryListing );
+	result->listingTime = std::time( 0 );
+	result->modificationTime = boost::filesystem::last_write_time( path );
+
+	boost::filesystem::directory_iterator end;
+	for ( boost::filesystem::directory_iterator it( path ); it != end; ++it )
+	{
+		result->names.push_back( it->path().PATH_TO_STRING );
+	}
+
+	return result;
+}
+
+ConstDirectoryListingPtr listingCacheGetter( const std::string &path, size_t &cost )
+{
+	ConstDirectoryListingPtr result = listDirectory( path );
+	cost = result->names.size();
+	return result;
+}
+
+typedef LRUCache<std::string, ConstDirectoryListingPtr> ListingCache;
+
+ListingCache &listingCache()
+{
+	// the cost is measured in file names
+	static ListingCache c( listingCacheGetter, 1000000 );
+	return c;
+}
+
+ConstDirectoryListingPtr directoryListing( const boost::filesystem::path &path, bool useCache )
+{
+	if( !useCache )
+	{
+		return listDirectory( path );
+	}
+
+	ListingCache &cache = listingCache();
+	const std::string key = path.string();
+	if( cache.cached( key ) )
+	{
+		ConstDirectoryListingPtr listing = cache.get( key );
+		// directory modification times typically have a resolution of a second,
+		// so a listing made in the same second as a modification may have missed
+		// changes. we only reuse listings which were made strictly afterwards.
+		if( listing->modificationTime < listing->listingTime && listing->modificationTime == boost::filesystem::last_write_time( path ) )
+		{
+			return listing;
+		}
+	}
+
+	ConstDirectoryListingPtr listing = listDirectory( path );
+	cache.set( key, listing, listing->names.size() );
+	return listing;
+}
+
+} // namespace
+
+void IECore::findSequences( const std::vector< std::string > &names, std::vector< FileSequencePtr > &sequences, size_t minSequenceSize )
+{
+	sequences.clear();
+
+	/// split each name into $prefix$frameNumber$suffix, discarding
+	/// any names which can't be part of a sequence.
+	std::vector<SplitName> splitNames( names.size() );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, names.size(), 1024 ), SplitNames( names, splitNames ) );
+	splitNames.erase( std::remove_if( splitNames.begin(), splitNames.end(), isNull ), splitNames.end() );
+
+	/// sort so that the names in each sequence are adjacent, and find the
+	/// start of each group of names with the same ($prefix, $suffix).
+	tbb::parallel_sort( splitNames.begin(), splitNames.end(), SplitNameLess() );
+
+	std::vector<size_t> groupBegins;
+	for( size_t i = 0; i < splitNames.size(); ++i )
+	{
+		if( !i || splitNames[i].hash != splitNames[i-1].hash || compareFixes( splitNames[i], splitNames[i-1] ) != 0 )
+		{
+			groupBegins.push_back( i );
+		}
+	}
+	std::sort( groupBegins.begin(), groupBegins.end(), GroupLess( splitNames ) );
+
+	/// make the sequences for each group in parallel.
+	std::vector<std::vector<FileSequencePtr> > groupSequences( groupBegins.size() );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, groupBegins.size() ), MakeSequences( splitNames, groupBegins, minSequenceSize, groupSequences ) );
+
+	for( std::vector<std::vector<FileSequencePtr> >::const_iterator it = groupSequences.begin(); it != groupSequences.end(); ++it )
+	{
+		sequences.insert( sequences.end(), it->begin(), it->end() );
 	}
 }
 
@@ -186,24 +464,18 @@ void IECore::findSequences( const std::vector< std::string > &names, std::vector
 	findSequences( names, sequences, 2 );
 }
 
-void IECore::ls( const std::string &path, std::vector< FileSequencePtr > &sequences, size_t minSequenceSize )
+void IECore::ls( const std::string &path, std::vector< FileSequencePtr > &sequences, size_t minSequenceSize, bool useCache )
 {
 	sequences.clear();
 
 	if ( boost::filesystem::is_directory( path ) )
 	{
-		boost::filesystem::directory_iterator end;
-	 	std::vector< std::string > files;
-		for ( boost::filesystem::directory_iterator it( path ); it != end; ++it )
-		{
-			files.push_back( it->path().PATH_TO_STRING );
-		}
-
-		findSequences( files, sequences, minSequenceSize );
+		ConstDirectoryListingPtr listing = directoryListing( path, useCache );
+		findSequences( listing->names, sequences, minSequenceSize );
 	}
 }
 
-void IECore::ls( const std::string &sequencePath, FileSequencePtr &sequence, size_t minSequenceSize )
+void IECore::ls( const std::string &sequencePath, FileSequencePtr &sequence, size_t minSequenceSize, bool useCache )
 {
 	sequence = 0;
 	boost::smatch matches;
@@ -236,13 +508,15 @@ void IECore::ls( const std::string &sequencePath, FileSequencePtr &sequence, siz
 		dirToCheck = ".";
 	}
 
-	boost::filesystem::directory_iterator end;
-
-	for ( boost::filesystem::directory_iterator it( dirToCheck ); it != end; ++it )
+	ConstDirectoryListingPtr listing = directoryListing( dirToCheck, useCache );
+	for ( std::vector<std::string>::const_iterator it = listing->names.begin(), eIt = listing->names.end(); it != eIt; ++it )
 	{
-		const std::string fileName = it->path().PATH_TO_STRING;
-
-		if ( fileName.size() >= std::min( prefix.size(), suffix.size() ) && fileName.substr( 0, prefix.size() ) == prefix && fileName.substr( fileName.size() - suffix.size(), suffix.size() ) == suffix )
+		const std::string &fileName = *it;
+		if (
+			fileName.size() >= prefix.size() + suffix.size() &&
+			fileName.compare( 0, prefix.size(), prefix ) == 0 &&
+			fileName.compare( fileName.size() - suffix.size(), suffix.size(), suffix ) == 0
+		)
 		{
 			files.push_back( ( dir / boost::filesystem::path( fileName ) ).string() );
 		}
@@ -128,6 +128,15 @@ bool withPNG()
 #endif
 }
 
+bool withProfiling()
+{
+#ifdef IECORE_WITH_PROFILING
+	return true;
+#else
+	return false;
+#endif
+}
+
 bool withDeepEXR()
 {
 #ifdef IECORE_WITH_DEEPEXR
@@ -0,0 +1,418 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/bind.hpp"
+#include "boost/lexical_cast.hpp"
+
+#include "tbb/mutex.h"
+
+#include "OpenEXR/ImathFun.h"
+
+#include "IECore/ImageCache.h"
+#include "IECore/ImageReader.h"
+#include "IECore/LRUCache.h"
+#include "IECore/MurmurHash.h"
+#include "IECore/BoxOps.h"
+#include "IECore/Exception.h"
+#include "IECore/Profiler.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// An open file. Readers aren't threadsafe, so access to the
+// reader and bufferCounted must be guarded by the mutex. The
+// header information is immutable and may be accessed freely.
+struct File
+{
+
+	File( const std::string &fileName )
+		:	bufferCounted( false )
+	{
+		ReaderPtr r = Reader::create( fileName );
+		reader = runTimeCast<ImageReader>( r );
+		if( !reader )
+		{
+			throw IOException( "ImageCache : \"" + fileName + "\" is not an image file" );
+		}
+		dataWindow = reader->dataWindow();
+		displayWindow = reader->displayWindow();
+		reader->channelNames( channelNames );
+
+		// Only the EXRImageReader reads the data window it is given directly.
+		// The others decode the whole image into a buffer on the first read
+		// and keep it until they are destroyed. We don't know the precision
+		// of that buffer, so we assume the worst.
+		if( reader->isInstanceOf( EXRImageReaderTypeId ) || dataWindow.isEmpty() )
+		{
+			bufferSize = 0;
+		}
+		else
+		{
+			const V2i size = dataWindow.size() + V2i( 1 );
+			bufferSize = (size_t)size.x * size.y * channelNames.size() * sizeof( float );
+		}
+	}
+
+	bool hasChannel( const std::string &channelName ) const
+	{
+		return find( channelNames.begin(), channelNames.end(), channelName ) != channelNames.end();
+	}
+
+	tbb::mutex mutex;
+	ImageReaderPtr reader;
+	// True if bufferSize has been added to the
+	// cost of a tile.
+	bool bufferCounted;
+
+	Box2i dataWindow;
+	Box2i displayWindow;
+	vector<string> channelNames;
+	size_t bufferSize;
+
+};
+
+typedef boost::shared_ptr<File> FilePtr;
+
+struct Tile
+{
+	// The section of the data window covered by the tile.
+	// Empty for tiles outside the data window.
+	Box2i bound;
+	ConstFloatVectorDataPtr data;
+	// The first tile read from a file whose reader keeps
+	// the whole image in memory also pays for that memory,
+	// and the file is closed when the tile is discarded.
+	std::string bufferedFileName;
+};
+
+typedef boost::shared_ptr<const Tile> ConstTilePtr;
+
+// Conceptually the key for a tile is just its hash, but the
+// key must also carry the file and channel names so that the
+// getter can load the tile. As for the CachedConverter, these are
+// never accessed outside of the getter.
+struct TileKey
+{
+
+	TileKey()
+		:	fileName( 0 ), channelName( 0 ), tileOrigin( 0 )
+	{
+	}
+
+	TileKey( const std::string &f, const std::string &c, const V2i &o )
+		:	fileName( &f ), channelName( &c ), tileOrigin( o )
+	{
+		hash.append( f );
+		hash.append( c );
+		hash.append( o );
+	}
+
+	bool operator == ( const TileKey &other ) const
+	{
+		return hash == other.hash;
+	}
+
+	mutable const std::string *fileName;
+	mutable const std::string *channelName;
+	V2i tileOrigin;
+	MurmurHash hash;
+
+};
+
+inline size_t tbb_hasher( const TileKey &tileKey )
+{
+	return tbb_hasher( tileKey.hash );
+}
+
+// Division rounding towards negative infinity, so that
+// tiles are aligned consistently across the origin.
+inline int floorDivide( int a, int b )
+{
+	return a >= 0 ? a / b : -( ( -a - 1 ) / b ) - 1;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MemberData
+//////////////////////////////////////////////////////////////////////////
+
+struct ImageCache::MemberData
+{
+
+	MemberData( size_t maxMemory, size_t maxOpenFiles, int tileSize )
+		:	tileSize( tileSize ),
+			files( fileGetter, maxOpenFiles ),
+			tiles( boost::bind( &MemberData::tileGetter, this, ::_1, ::_2 ), boost::bind( &MemberData::tileRemoved, this, ::_1, ::_2 ), maxMemory )
+	{
+		if( tileSize <= 0 )
+		{
+			throw InvalidArgumentException( "ImageCache : tileSize must be positive" );
+		}
+	}
+
+	const int tileSize;
+
+	typedef LRUCache<std::string, FilePtr> FileCache;
+	FileCache files;
+
+	typedef LRUCache<TileKey, ConstTilePtr> TileCache;
+	TileCache tiles;
+
+	static FilePtr fileGetter( const std::string &fileName, size_t &cost )
+	{
+		IECORE_PROFILE_SCOPE( "ImageCache::fileGetter" );
+		cost = 1;
+		return FilePtr( new File( fileName ) );
+	}
+
+	ConstTilePtr tileGetter( const TileKey &key, size_t &cost )
+	{
+		IECORE_PROFILE_SCOPE( "ImageCache::tileGetter" );
+		FilePtr file = files.get( *key.fileName );
+		if( !file->hasChannel( *key.channelName ) )
+		{
+			throw InvalidArgumentException( "ImageCache : \"" + *key.fileName + "\" has no channel \"" + *key.channelName + "\"" );
+		}
+
+		boost::shared_ptr<Tile> tile( new Tile );
+		tile->bound = boxIntersection( Box2i( key.tileOrigin, key.tileOrigin + V2i( tileSize - 1 ) ), file->dataWindow );
+		cost = sizeof( Tile );
+		if( tile->bound.isEmpty() )
+		{
+			return tile;
+		}
+
+		tbb::mutex::scoped_lock lock( file->mutex );
+		file->reader->dataWindowParameter()->setTypedValue( tile->bound );
+		tile->data = runTimeCast<const FloatVectorData>( file->reader->readChannel( *key.channelName ) );
+		if( !tile->data )
+		{
+			throw IOException( "ImageCache : Channel \"" + *key.channelName + "\" in \"" + *key.fileName + "\" did not load as FloatVectorData" );
+		}
+		cost += tile->data->readable().size() * sizeof( float );
+
+		if( file->bufferSize && !file->bufferCounted )
+		{
+			if( cost + file->bufferSize <= tiles.getMaxCost() )
+			{
+				file->bufferCounted = true;
+				cost += file->bufferSize;
+				tile->bufferedFileName = *key.fileName;
+			}
+			else
+			{
+				// The tile won't be cached if it pays for the buffer,
+				// so nothing would close the file. Close it now instead.
+				files.erase( *key.fileName );
+			}
+		}
+
+		return tile;
+	}
+
+	void tileRemoved( const TileKey &key, const ConstTilePtr &tile )
+	{
+		if( !tile->bufferedFileName.empty() )
+		{
+			files.erase( tile->bufferedFileName );
+		}
+	}
+
+	ConstTilePtr tile( const std::string &fileName, const std::string &channelName, const V2i &pixel )
+	{
+		const V2i tileOrigin( floorDivide( pixel.x, tileSize ) * tileSize, floorDivide( pixel.y, tileSize ) * tileSize );
+		return tiles.get( TileKey( fileName, channelName, tileOrigin ) );
+	}
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ImageCache
+//////////////////////////////////////////////////////////////////////////
+
+ImageCache::ImageCache( size_t maxMemory, size_t maxOpenFiles, int tileSize )
+	:	m_data( new MemberData( maxMemory, maxOpenFiles, tileSize ) )
+{
+}
+
+ImageCache::~ImageCache()
+{
+}
+
+int ImageCache::getTileSize() const
+{
+	return m_data->tileSize;
+}
+
+void ImageCache::setMaxMemoryUsage( size_t maxMemory )
+{
+	m_data->tiles.setMaxCost( maxMemory );
+}
+
+size_t ImageCache::getMaxMemoryUsage() const
+{
+	return m_data->tiles.getMaxCost();
+}
+
+size_t ImageCache::memoryUsage() const
+{
+	return m_data->tiles.currentCost();
+}
+
+void ImageCache::setMaxOpenFiles( size_t maxOpenFiles )
+{
+	m_data->files.setMaxCost( maxOpenFiles );
+}
+
+size_t ImageCache::getMaxOpenFiles() const
+{
+	return m_data->files.getMaxCost();
+}
+
+void ImageCache::clear()
+{
+	m_data->tiles.clear();
+	m_data->files.clear();
+}
+
+Imath::Box2i ImageCache::dataWindow( const std::string &fileName )
+{
+	return m_data->files.get( fileName )->dataWindow;
+}
+
+Imath::Box2i ImageCache::displayWindow( const std::string &fileName )
+{
+	return m_data->files.get( fileName )->displayWindow;
+}
+
+void ImageCache::channelNames( const std::string &fileName, std::vector<std::string> &names )
+{
+	names = m_data->files.get( fileName )->channelNames;
+}
+
+float ImageCache::sample( const std::string &fileName, const std::string &channelName, int x, int y )
+{
+	const V2i pixel( x, y );
+	ConstTilePtr tile = m_data->tile( fileName, channelName, pixel );
+	if( !tile->bound.intersects( pixel ) )
+	{
+		return 0.0f;
+	}
+
+	const int width = tile->bound.size().x + 1;
+	return tile->data->readable()[ ( y - tile->bound.min.y ) * width + x - tile->bound.min.x ];
+}
+
+float ImageCache::sample( const std::string &fileName, const std::string &channelName, const Imath::V2f &p )
+{
+	const float fx = p.x - 0.5f;
+	const float fy = p.y - 0.5f;
+	const int x = (int)floorf( fx );
+	const int y = (int)floorf( fy );
+	const float tx = fx - x;
+	const float ty = fy - y;
+
+	const float v00 = sample( fileName, channelName, x, y );
+	const float v10 = sample( fileName, channelName, x + 1, y );
+	const float v01 = sample( fileName, channelName, x, y + 1 );
+	const float v11 = sample( fileName, channelName, x + 1, y + 1 );
+
+	return lerp( lerp( v00, v10, tx ), lerp( v01, v11, tx ), ty );
+}
+
+FloatVectorDataPtr ImageCache::readRegion( const std::string &fileName, const std::string &channelName, const Imath::Box2i &region )
+{
+	FloatVectorDataPtr resultData = new FloatVectorData;
+	if( region.isEmpty() )
+	{
+		return resultData;
+	}
+
+	const int regionWidth = region.size().x + 1;
+	vector<float> &result = resultData->writable();
+	result.resize( regionWidth * ( region.size().y + 1 ), 0.0f );
+
+	const int tileSize = m_data->tileSize;
+	const V2i minTile( floorDivide( region.min.x, tileSize ), floorDivide( region.min.y, tileSize ) );
+	const V2i maxTile( floorDivide( region.max.x, tileSize ), floorDivide( region.max.y, tileSize ) );
+	for( int tileY = minTile.y; tileY <= maxTile.y; ++tileY )
+	{
+		for( int tileX = minTile.x; tileX <= maxTile.x; ++tileX )
+		{
+			ConstTilePtr tile = m_data->tile( fileName, channelName, V2i( tileX, tileY ) * tileSize );
+			const Box2i b = boxIntersection( tile->bound, region );
+			if( b.isEmpty() )
+			{
+				continue;
+			}
+
+			const int tileWidth = tile->bound.size().x + 1;
+			const vector<float> &tileData = tile->data->readable();
+			for( int y = b.min.y; y <= b.max.y; ++y )
+			{
+				const float *src = &tileData[ ( y - tile->bound.min.y ) * tileWidth + b.min.x - tile->bound.min.x ];
+				std::copy( src, src + b.size().x + 1, &result[ ( y - region.min.y ) * regionWidth + b.min.x - region.min.x ] );
+			}
+		}
+	}
+
+	return resultData;
+}
+
+ImageCache *ImageCache::defaultImageCache()
+{
+	static ImageCachePtr c = 0;
+	if( !c )
+	{
+		const char *m = getenv( "IECORE_IMAGECACHE_MEMORY" );
+		size_t mi = m ? boost::lexical_cast<size_t>( m ) : 500;
+		const char *f = getenv( "IECORE_IMAGECACHE_FILES" );
+		size_t fi = f ? boost::lexical_cast<size_t>( f ) : 100;
+		c = new ImageCache( 1024 * 1024 * mi, fi );
+	}
+	return c.get();
+}
+
+/// make sure the default cache is created at load time and avoid
+/// running conditions on multi-threaded environments.
+static ImageCachePtr initializer = ImageCache::defaultImageCache();
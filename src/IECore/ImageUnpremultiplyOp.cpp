@@ -37,7 +37,6 @@
 #include "IECore/DespatchTypedData.h"
 #include "IECore/TypedParameter.h"
 #include "IECore/CompoundParameter.h"
-#include "IECore/DataConvert.h"
 #include "IECore/ScaledDataConversion.h"
 
 using namespace IECore;
@@ -69,50 +68,37 @@ const StringParameter * ImageUnpremultiplyOp::alphaChannelNameParameter() const
 	return m_alphaChannelNameParameter.get();
 }
 
-struct ImageUnpremultiplyOp::ToFloatVectorData
-{
-	typedef FloatVectorDataPtr ReturnType;
-
-	template<typename T>
-	ReturnType operator()( const T *dataPtr )
-	{
-		return DataConvert< T, FloatVectorData, ScaledDataConversion< typename T::ValueType::value_type, float > >()( dataPtr );
-	}
-};
-
 struct ImageUnpremultiplyOp::UnpremultFn
 {
 	typedef void ReturnType;
 
-	const FloatVectorData * m_alphaChannel;
+	const ChannelPointerVector &m_channels;
+	size_t m_begin;
+	size_t m_end;
 
-	UnpremultFn( const FloatVectorData * alphaChannel ) : m_alphaChannel( alphaChannel )
+	UnpremultFn( const ChannelPointerVector &channels, size_t begin, size_t end )
+		:	m_channels( channels ), m_begin( begin ), m_end( end )
 	{
-		assert( m_alphaChannel );
 	}
 
 	template<typename T>
-	ReturnType operator()( T *dataPtr )
+	ReturnType operator()( const T *alphaData )
 	{
-		typedef typename T::ValueType Container;
-		typedef typename Container::value_type ValueType;
-
-		ScaledDataConversion< ValueType, float > toFloat;
-		ScaledDataConversion< float, ValueType > fromFloat;
-
-		FloatVectorData::ValueType::const_iterator alphaIt = m_alphaChannel->readable().begin();
+		typedef typename T::ValueType::value_type AlphaType;
+		ScaledDataConversion< AlphaType, float > toFloat;
 
-		Container &data = dataPtr->writable();
-		for ( typename Container::iterator it = data.begin(); it != data.end(); ++it, ++alphaIt )
+		for( ChannelPointerVector::const_iterator cIt = m_channels.begin(); cIt != m_channels.end(); ++cIt )
 		{
-			float channelValue = toFloat( *it );
-
-			if ( fabsf(*alphaIt) > 0.0f )
+			float *channel = *cIt;
+			typename T::ValueType::const_iterator alphaIt = alphaData->readable().begin() + m_begin;
+			for( float *it = channel + m_begin, *eIt = channel + m_end; it != eIt; ++it, ++alphaIt )
 			{
-				channelValue /= *alphaIt;
+				const float alpha = toFloat( *alphaIt );
+				if ( fabsf( alpha ) > 0.0f )
+				{
+					*it /= alpha;
+				}
 			}
-
-			*it = fromFloat( channelValue );
 		}
 	}
 };
@@ -136,11 +122,22 @@ void ImageUnpremultiplyOp::modifyChannels( const Imath::Box2i &displayWindow, co
 		throw InvalidArgumentException( "ImageUnpremultiplyOp: Cannot find specified alpha channel" );
 	}
 
-	FloatVectorDataPtr alphaData = despatchTypedData< ToFloatVectorData, TypeTraits::IsNumericVectorTypedData >( it->second.data.get() );
-
-	ImageUnpremultiplyOp::UnpremultFn fn( alphaData.get() );
-	for ( ChannelVector::iterator it = channels.begin(); it != channels.end(); it++ )
+	const size_t numPixels = ( dataWindow.size().x + 1 ) * ( dataWindow.size().y + 1 );
+	if ( despatchTypedData< TypedDataSize, TypeTraits::IsNumericVectorTypedData >( it->second.data.get() ) != numPixels )
 	{
-		despatchTypedData<ImageUnpremultiplyOp::UnpremultFn, TypeTraits::IsNumericVectorTypedData>( it->get(), fn );
+		throw InvalidArgumentException( "ImageUnpremultiplyOp: Alpha channel has wrong size" );
 	}
+
+	ChannelOp::modifyChannels( displayWindow, dataWindow, channels );
+}
+
+void ImageUnpremultiplyOp::modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow )
+{
+	ImagePrimitivePtr image = assertedStaticCast< ImagePrimitive >( inputParameter()->getValue() );
+	const PrimitiveVariableMap::const_iterator it = image->variables.find( m_alphaChannelNameParameter->getTypedValue() );
+	assert( it != image->variables.end() );
+
+	const size_t width = dataWindow.size().x + 1;
+	UnpremultFn fn( channels, beginRow * width, endRow * width );
+	despatchTypedData< UnpremultFn, TypeTraits::IsNumericVectorTypedData >( it->second.data.get(), fn );
 }
@@ -58,12 +58,25 @@ IndexedIOPtr IndexedIO::create( const std::string &path, const IndexedIO::EntryI
 	const CreatorMap &createFns = getCreateFns();
 
 	CreatorMap::const_iterator it = createFns.find(extension);
-	if (it == createFns.end())
+	if (it != createFns.end())
 	{
-		throw IOException(path);
+		return (it->second.creator)(path, root, mode);
 	}
 
-	return (it->second)(path, root, mode);
+	// unknown extension. if we're reading then we can
+	// try to identify the file from its contents.
+	if( (mode & IndexedIO::Read) && !(mode & (IndexedIO::Write | IndexedIO::Append)) )
+	{
+		for( it = createFns.begin(); it != createFns.end(); ++it )
+		{
+			if( it->second.canRead && it->second.canRead( path ) )
+			{
+				return (it->second.creator)(path, root, mode);
+			}
+		}
+	}
+
+	throw IOException(path);
 }
 
 void IndexedIO::supportedExtensions( std::vector<std::string> &extensions )
@@ -75,13 +88,16 @@ void IndexedIO::supportedExtensions( std::vector<std::string> &extensions )
 	}
 }
 
-void IndexedIO::registerCreator( const std::string &extension, CreatorFn f )
+void IndexedIO::registerCreator( const std::string &extension, CreatorFn f, CanReadFn canRead )
 {
 	CreatorMap &createFns = getCreateFns();
 
 	assert( createFns.find(extension) == createFns.end() );
 
-	createFns.insert( CreatorMap::value_type(extension, f) );
+	CreatorFns fns;
+	fns.creator = f;
+	fns.canRead = canRead;
+	createFns.insert( CreatorMap::value_type(extension, fns) );
 }
 
 IndexedIO::~IndexedIO()
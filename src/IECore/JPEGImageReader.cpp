@@ -63,7 +63,7 @@ using namespace std;
 
 IE_CORE_DEFINERUNTIMETYPED( JPEGImageReader );
 
-const Reader::ReaderDescription <JPEGImageReader> JPEGImageReader::m_readerDescription ("jpeg jpg");
+const Reader::ReaderDescription <JPEGImageReader> JPEGImageReader::m_readerDescription ("jpeg jpg", "ffd8ffe0 ffd8ffe1 ffd8ffdb e0ffd8ff e1ffd8ff dbffd8ff");
 
 JPEGImageReader::JPEGImageReader() :
 		ImageReader( "Reads Joint Photographic Experts Group (JPEG) files" )
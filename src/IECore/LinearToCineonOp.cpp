@@ -93,42 +93,33 @@ const IntParameter * LinearToCineonOp::refBlackValParameter() const
 
 struct LinearToCineonOp::Converter
 {
-		typedef void ReturnType;
-
 		Converter( float filmGamma, int refWhiteVal, int refBlackVal ) :
-			m_filmGamma(filmGamma), m_refWhiteVal(refWhiteVal), m_refBlackVal(refBlackVal)
+			m_converter( filmGamma, refWhiteVal, refBlackVal )
 		{
 		}
 
-		template<typename T>
-		ReturnType operator()( T * data )
+		void operator()( float *begin, float *end )
 		{
-			typedef typename T::ValueType Container;
-			typedef typename Container::value_type V;
-			typedef typename Container::iterator It;
-			LinearToCineonDataConversion< V, unsigned int > converter( m_filmGamma, m_refWhiteVal, m_refBlackVal );
-			It end = data->writable().end();
-			for ( It it = data->writable().begin(); it != end; it++ )
+			for ( float *it = begin; it != end; it++ )
 			{
-				*it = static_cast<V>(converter( *it ) / 1023.);
+				*it = static_cast<float>(m_converter( *it ) / 1023.);
 			}
 		}
 
 	private:
 
-		float m_filmGamma;
-		int m_refWhiteVal;
-		int m_refBlackVal;
+		LinearToCineonDataConversion< float, unsigned int > m_converter;
 
 };
 
-void LinearToCineonOp::modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels )
+void LinearToCineonOp::modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow )
 {
 	LinearToCineonOp::Converter converter( filmGammaParameter()->getNumericValue(),
 											refWhiteValParameter()->getNumericValue(),
 											refBlackValParameter()->getNumericValue() );
-	for ( ChannelVector::iterator it = channels.begin(); it != channels.end(); it++ )
+	const size_t width = dataWindow.size().x + 1;
+	for ( ChannelPointerVector::const_iterator it = channels.begin(); it != channels.end(); it++ )
 	{
-		despatchTypedData<LinearToCineonOp::Converter, TypeTraits::IsFloatVectorTypedData>( it->get(), converter );
+		converter( *it + beginRow * width, *it + endRow * width );
 	}
 }
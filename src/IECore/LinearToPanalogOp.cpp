@@ -56,28 +56,22 @@ LinearToPanalogOp::~LinearToPanalogOp()
 
 struct LinearToPanalogOp::Converter
 {
-	typedef void ReturnType;
-
-	template<typename T>
-	ReturnType operator()( T * data )
+	void operator()( float *begin, float *end ) const
 	{
-		typedef typename T::ValueType Container;
-		typedef typename Container::value_type V;
-		typedef typename Container::iterator It;
-		LinearToPanalogDataConversion< V, V > converter;
-		It end = data->writable().end();
-		for ( It it = data->writable().begin(); it != end; it++ )
+		LinearToPanalogDataConversion< float, float > converter;
+		for ( float *it = begin; it != end; it++ )
 		{
 			*it = converter( *it );
 		}
 	}
 };
 
-void LinearToPanalogOp::modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels )
+void LinearToPanalogOp::modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow )
 {
+	const size_t width = dataWindow.size().x + 1;
 	LinearToPanalogOp::Converter converter;
-	for ( ChannelVector::iterator it = channels.begin(); it != channels.end(); it++ )
+	for ( ChannelPointerVector::const_iterator it = channels.begin(); it != channels.end(); it++ )
 	{
-		despatchTypedData<LinearToPanalogOp::Converter, TypeTraits::IsFloatVectorTypedData>( it->get(), converter );
+		converter( *it + beginRow * width, *it + endRow * width );
 	}
 }
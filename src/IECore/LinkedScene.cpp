@@ -37,10 +37,13 @@
 #include "IECore/FileIndexedIO.h"
 #include "IECore/SharedSceneInterfaces.h"
 #include "IECore/MessageHandler.h"
+#include "IECore/LRUCache.h"
+#include "IECore/Profiler.h"
 
 #include <set>
 
 #include "boost/foreach.hpp"
+
 using namespace IECore;
 
 IE_CORE_DEFINERUNTIMETYPEDDESCRIPTION( LinkedScene )
@@ -67,7 +70,95 @@ const InternedString LinkedScene::g_root("root");
 const InternedString LinkedScene::g_time("time");
 
 
-LinkedScene::LinkedScene( const std::string &fileName, IndexedIO::OpenMode mode ) : m_mainScene(0), m_linkedScene(0), m_rootLinkDepth(0), m_readOnly(mode & IndexedIO::Read), m_atLink(false), m_sampled(true), m_timeRemapped(false)
+namespace
+{
+
+struct LinkKey
+{
+
+	LinkKey()
+	{
+	}
+
+	LinkKey( const std::string &fileName, const SceneInterface::Path &root )
+		:	fileName( fileName ), root( root )
+	{
+	}
+
+	bool operator == ( const LinkKey &other ) const
+	{
+		return fileName == other.fileName && root == other.root;
+	}
+
+	std::string fileName;
+	SceneInterface::Path root;
+
+};
+
+size_t tbb_hasher( const LinkKey &key )
+{
+	MurmurHash h;
+	h.append( key.fileName );
+	for( SceneInterface::Path::const_iterator it = key.root.begin(), eIt = key.root.end(); it != eIt; ++it )
+	{
+		h.append( *it );
+	}
+	return tbb_hasher( h );
+}
+
+} // namespace
+
+// Maps from the file name and root of a link to the resolved scene, so that links
+// visited repeatedly don't need resolving each time, even if their files have been
+// evicted from the SharedSceneInterfaces cache. Each entry holds its file open, so
+// the number of entries is limited to SharedSceneInterfaces::getMaxScenes().
+class LinkedScene::LinkCache : public RefCounted, public LRUCache<LinkKey, ConstSceneInterfacePtr>
+{
+
+	public :
+
+		LinkCache()
+			:	LRUCache<LinkKey, ConstSceneInterfacePtr>( getter, SharedSceneInterfaces::getMaxScenes() )
+		{
+		}
+
+		ConstSceneInterfacePtr resolve( const LinkKey &key )
+		{
+			// Follow any changes made by SharedSceneInterfaces::setMaxScenes(),
+			// so that it continues to bound the number of open scenes.
+			const size_t maxScenes = SharedSceneInterfaces::getMaxScenes();
+			if( getMaxCost() != maxScenes )
+			{
+				setMaxCost( maxScenes );
+			}
+			return get( key );
+		}
+
+	private :
+
+		static ConstSceneInterfacePtr getter( const LinkKey &key, size_t &cost )
+		{
+			IECORE_PROFILE_SCOPE( "LinkedScene::LinkCache::getter" );
+			cost = 1;
+			ConstSceneInterfacePtr scene;
+			try
+			{
+				scene = SharedSceneInterfaces::get( key.fileName );
+			}
+			catch( ... )
+			{
+				// SharedSceneInterfaces would otherwise remember the
+				// failure, and never try to open the file again.
+				SharedSceneInterfaces::erase( key.fileName );
+				throw;
+			}
+			// \todo Consider throwing or printing error message if the root is missing.
+			return scene->scene( key.root, NullIfMissing );
+		}
+
+};
+
+LinkedScene::LinkedScene( const std::string &fileName, IndexedIO::OpenMode mode ) : m_mainScene(0), m_linkedScene(0), m_rootLinkDepth(0), m_readOnly(mode & IndexedIO::Read), m_atLink(false), m_sampled(true), m_timeRemapped(false), m_linkCache( new LinkCache )
 {
 	if( mode & IndexedIO::Append )
 	{
@@ -77,7 +168,7 @@ LinkedScene::LinkedScene( const std::string &fileName, IndexedIO::OpenMode mode
 	m_mainScene = new SceneCache( fileName, mode );
 }
 
-LinkedScene::LinkedScene( ConstSceneInterfacePtr mainScene ) : m_mainScene(const_cast<SceneInterface*>(mainScene.get())), m_linkedScene(0), m_rootLinkDepth(0), m_readOnly(true), m_atLink(false), m_timeRemapped(false)
+LinkedScene::LinkedScene( ConstSceneInterfacePtr mainScene ) : m_mainScene(const_cast<SceneInterface*>(mainScene.get())), m_linkedScene(0), m_rootLinkDepth(0), m_readOnly(true), m_atLink(false), m_timeRemapped(false), m_linkCache( new LinkCache )
 {
 	if( SceneCachePtr scc = runTimeCast<SceneCache>( m_mainScene ) )
 	{
@@ -87,7 +178,7 @@ LinkedScene::LinkedScene( ConstSceneInterfacePtr mainScene ) : m_mainScene(const
 	m_sampled = (runTimeCast<const SampledSceneInterface>(mainScene.get()) != NULL);
 }
 
-LinkedScene::LinkedScene( SceneInterface *mainScene, const SceneInterface *linkedScene, int rootLinkDepth, bool readOnly, bool atLink, bool timeRemapped ) : m_mainScene(mainScene), m_linkedScene(linkedScene), m_rootLinkDepth(rootLinkDepth), m_readOnly(readOnly), m_atLink(atLink), m_timeRemapped(timeRemapped)
+LinkedScene::LinkedScene( SceneInterface *mainScene, const SceneInterface *linkedScene, LinkCache *linkCache, int rootLinkDepth, bool readOnly, bool atLink, bool timeRemapped ) : m_mainScene(mainScene), m_linkedScene(linkedScene), m_rootLinkDepth(rootLinkDepth), m_readOnly(readOnly), m_atLink(atLink), m_timeRemapped(timeRemapped), m_linkCache(linkCache)
 {
 	if ( !mainScene )
 	{
@@ -971,25 +1062,25 @@ ConstSceneInterfacePtr LinkedScene::expandLink( const StringData *fileName, cons
 {
 	if ( fileName && root )
 	{
+		const LinkKey key( fileName->readable(), root->readable() );
 		ConstSceneInterfacePtr l = 0;
 		try
 		{
-			l = SharedSceneInterfaces::get( fileName->readable() );
+			l = m_linkCache->resolve( key );
 		}
 		catch ( IECore::Exception &e )
 		{
 			IECore::msg( IECore::MessageHandler::Error, "LinkedScene::expandLink", std::string( e.what() ) + " when expanding link from file \"" + m_mainScene->fileName() + "\"" );
-			linkDepth = 0;
-			return 0;
 		}
 
-		linkDepth = root->readable().size();
-		l = l->scene(root->readable(), NullIfMissing);
-		if ( !l )
+		if( !l )
 		{
-			// \todo Consider throwing or printing error message.
-			linkDepth = 0;
+			// Don't keep failures, so that the link can be resolved
+			// if the file is fixed and the scene is visited again.
+			m_linkCache->erase( key );
 		}
+
+		linkDepth = l ? root->readable().size() : 0;
 		return l;
 	}
 	linkDepth = 0;
@@ -1065,7 +1156,7 @@ SceneInterfacePtr LinkedScene::child( const Name &name, MissingBehaviour missing
 		ConstSceneInterfacePtr c = m_linkedScene->child( name, SceneInterface::NullIfMissing );
 		if ( c )
 		{
-			return new LinkedScene( m_mainScene.get(), c.get(), m_rootLinkDepth, m_readOnly, false, m_timeRemapped );
+			return new LinkedScene( m_mainScene.get(), c.get(), m_linkCache.get(), m_rootLinkDepth, m_readOnly, false, m_timeRemapped );
 		}
 		if( !m_atLink )
 		{
@@ -1114,7 +1205,7 @@ SceneInterfacePtr LinkedScene::child( const Name &name, MissingBehaviour missing
 			ConstSceneInterfacePtr l = expandLink( fileName.get(), root.get(), linkDepth );
 			if ( l )
 			{
-				return new LinkedScene( c.get(), l.get(), linkDepth, m_readOnly, true, timeRemapped );
+				return new LinkedScene( c.get(), l.get(), m_linkCache.get(), linkDepth, m_readOnly, true, timeRemapped );
 			}
 		}
 		else if( c->hasAttribute( linkAttribute ) )
@@ -1128,12 +1219,12 @@ SceneInterfacePtr LinkedScene::child( const Name &name, MissingBehaviour missing
 			ConstSceneInterfacePtr l = expandLink( d->member< const StringData >( g_fileName ), d->member< const InternedStringVectorData >( g_root ), linkDepth );
 			if ( l )
 			{
-				return new LinkedScene( c.get(), l.get(), linkDepth, m_readOnly, true, timeRemapped );
+				return new LinkedScene( c.get(), l.get(), m_linkCache.get(), linkDepth, m_readOnly, true, timeRemapped );
 			}
 		}
 	}
 
-	return new LinkedScene( c.get(), 0, 0, m_readOnly, false, false );
+	return new LinkedScene( c.get(), 0, m_linkCache.get(), 0, m_readOnly, false, false );
 	
 }
 
@@ -1242,7 +1333,7 @@ SceneInterfacePtr LinkedScene::scene( const Path &path, MissingBehaviour missing
 		}
 		atLink = false;
 	}
-	return new LinkedScene( s.get(), l.get(), linkDepth, m_readOnly, atLink, timeRemapped );
+	return new LinkedScene( s.get(), l.get(), m_linkCache.get(), linkDepth, m_readOnly, atLink, timeRemapped );
 }
 
 ConstSceneInterfacePtr LinkedScene::scene( const Path &path, LinkedScene::MissingBehaviour missingBehaviour ) const
@@ -3,7 +3,14 @@
 
 #include "OpenEXR/ImathVec.h"
 
+#include "boost/format.hpp"
+
+#include "tbb/tbb.h"
+
 #include "IECore/MeshAlgo.h"
+#include "IECore/DataAlgo.h"
+#include "IECore/DespatchTypedData.h"
+#include "IECore/private/PrimitiveMerge.h"
 
 using namespace IECore;
 using namespace Imath;
@@ -53,6 +60,214 @@ std::string TexturePrimVarNames::indicesName() const
 	return uvSetName + "Indices";
 }
 
+class MergeTopology
+{
+
+	public :
+
+		MergeTopology(
+			const std::vector<const MeshPrimitive *> &meshes,
+			const std::vector<size_t> &faceOffsets,
+			const std::vector<size_t> &vertexIdOffsets,
+			const std::vector<size_t> &vertexOffsets,
+			std::vector<int> &verticesPerFace,
+			std::vector<int> &vertexIds
+		)
+			:	m_meshes( meshes ), m_faceOffsets( faceOffsets ), m_vertexIdOffsets( vertexIdOffsets ), m_vertexOffsets( vertexOffsets ),
+				m_verticesPerFace( verticesPerFace ), m_vertexIds( vertexIds )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				const std::vector<int> &verticesPerFace = m_meshes[i]->verticesPerFace()->readable();
+				std::copy( verticesPerFace.begin(), verticesPerFace.end(), m_verticesPerFace.begin() + m_faceOffsets[i] );
+
+				const std::vector<int> &vertexIds = m_meshes[i]->vertexIds()->readable();
+				const int vertexOffset = m_vertexOffsets[i];
+				std::vector<int>::iterator outIt = m_vertexIds.begin() + m_vertexIdOffsets[i];
+				for( std::vector<int>::const_iterator it = vertexIds.begin(), eIt = vertexIds.end(); it != eIt; ++it, ++outIt )
+				{
+					*outIt = *it + vertexOffset;
+				}
+			}
+		}
+
+	private :
+
+		const std::vector<const MeshPrimitive *> &m_meshes;
+		const std::vector<size_t> &m_faceOffsets;
+		const std::vector<size_t> &m_vertexIdOffsets;
+		const std::vector<size_t> &m_vertexOffsets;
+		std::vector<int> &m_verticesPerFace;
+		std::vector<int> &m_vertexIds;
+
+};
+
+// Builds the index tables used to triangulate a mesh and expand its primitive
+// variables to FaceVarying. For each vertex of each output triangle, we record
+// the index of the originating face-vertex and the originating face.
+class TriangulateFaces
+{
+
+	public :
+
+		TriangulateFaces(
+			const std::vector<int> &verticesPerFace,
+			const std::vector<int> &vertexIds,
+			const std::vector<size_t> &faceVertexOffsets,
+			const std::vector<size_t> &triangleOffsets,
+			std::vector<int> &newVertexIds,
+			std::vector<int> &faceVertexIndices,
+			std::vector<int> &faceIndices
+		)
+			:	m_verticesPerFace( verticesPerFace ), m_vertexIds( vertexIds ), m_faceVertexOffsets( faceVertexOffsets ), m_triangleOffsets( triangleOffsets ),
+				m_newVertexIds( newVertexIds ), m_faceVertexIndices( faceVertexIndices ), m_faceIndices( faceIndices )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t faceIndex = r.begin(); faceIndex != r.end(); ++faceIndex )
+			{
+				const int numFaceVertices = m_verticesPerFace[faceIndex];
+				const int i0 = m_faceVertexOffsets[faceIndex];
+				size_t outIndex = m_triangleOffsets[faceIndex] * 3;
+				// a simple triangle fan, matching TriangulateOp.
+				for( int i = 1; i < numFaceVertices - 1; ++i )
+				{
+					const int faceVertices[3] = { i0, i0 + i, i0 + i + 1 };
+					for( int j = 0; j < 3; ++j, ++outIndex )
+					{
+						m_faceVertexIndices[outIndex] = faceVertices[j];
+						m_newVertexIds[outIndex] = m_vertexIds[faceVertices[j]];
+						m_faceIndices[outIndex] = faceIndex;
+					}
+				}
+			}
+		}
+
+	private :
+
+		const std::vector<int> &m_verticesPerFace;
+		const std::vector<int> &m_vertexIds;
+		const std::vector<size_t> &m_faceVertexOffsets;
+		const std::vector<size_t> &m_triangleOffsets;
+		std::vector<int> &m_newVertexIds;
+		std::vector<int> &m_faceVertexIndices;
+		std::vector<int> &m_faceIndices;
+
+};
+
+// Computes a normal for each face, using the same method as MeshNormalsOp.
+class FaceNormals
+{
+
+	public :
+
+		FaceNormals( const std::vector<int> &verticesPerFace, const std::vector<int> &vertexIds, const std::vector<size_t> &faceVertexOffsets, const std::vector<V3f> &p, std::vector<V3f> &normals )
+			:	m_verticesPerFace( verticesPerFace ), m_vertexIds( vertexIds ), m_faceVertexOffsets( faceVertexOffsets ), m_p( p ), m_normals( normals )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t faceIndex = r.begin(); faceIndex != r.end(); ++faceIndex )
+			{
+				if( m_verticesPerFace[faceIndex] < 3 )
+				{
+					m_normals[faceIndex] = V3f( 0 );
+					continue;
+				}
+
+				const int *vertexId = &(m_vertexIds[m_faceVertexOffsets[faceIndex]]);
+				const V3f &p0 = m_p[vertexId[0]];
+				const V3f &p1 = m_p[vertexId[1]];
+				const V3f &p2 = m_p[vertexId[2]];
+				m_normals[faceIndex] = ( p2 - p1 ).cross( p0 - p1 ).normalize();
+			}
+		}
+
+	private :
+
+		const std::vector<int> &m_verticesPerFace;
+		const std::vector<int> &m_vertexIds;
+		const std::vector<size_t> &m_faceVertexOffsets;
+		const std::vector<V3f> &m_p;
+		std::vector<V3f> &m_normals;
+
+};
+
+template<typename T>
+class Gather
+{
+
+	public :
+
+		Gather( const std::vector<T> &src, const std::vector<int> &indices, std::vector<T> &dst )
+			:	m_src( src ), m_indices( indices ), m_dst( dst )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_dst[i] = m_src[m_indices[i]];
+			}
+		}
+
+	private :
+
+		const std::vector<T> &m_src;
+		const std::vector<int> &m_indices;
+		std::vector<T> &m_dst;
+
+};
+
+template<typename T>
+void gather( const std::vector<T> &src, const std::vector<int> &indices, std::vector<T> &dst )
+{
+	dst.resize( indices.size() );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, indices.size() ), Gather<T>( src, indices, dst ) );
+}
+
+// std::vector<bool> packs its elements into shared words, so it
+// isn't safe to write to from multiple threads.
+void gather( const std::vector<bool> &src, const std::vector<int> &indices, std::vector<bool> &dst )
+{
+	dst.resize( indices.size() );
+	for( size_t i = 0, e = indices.size(); i < e; ++i )
+	{
+		dst[i] = src[indices[i]];
+	}
+}
+
+struct PromoteToFaceVarying
+{
+
+	typedef DataPtr ReturnType;
+
+	PromoteToFaceVarying( const std::vector<int> &indices )
+		:	m_indices( indices )
+	{
+	}
+
+	template<typename T>
+	ReturnType operator()( const T *data )
+	{
+		typename T::Ptr result = new T;
+		gather( data->readable(), m_indices, result->writable() );
+		setGeometricInterpretation( result.get(), getGeometricInterpretation( data ) );
+		return result;
+	}
+
+	const std::vector<int> &m_indices;
+
+};
+
 } // anonymous namespace
 
 namespace IECore
@@ -225,5 +440,180 @@ std::pair<PrimitiveVariable, PrimitiveVariable> calculateTangents(
 	return std::make_pair( tangentPrimVar, bitangentPrimVar );
 }
 
+MeshPrimitivePtr merge(
+	const std::vector<const MeshPrimitive *> &meshes,
+	bool removeNonMatchingPrimVars, /* = false */
+	std::vector<Imath::V2i> *faceRanges /* = 0 */
+)
+{
+	if( meshes.empty() )
+	{
+		throw InvalidArgumentException( "MeshAlgo::merge : No meshes to merge." );
+	}
+
+	const std::vector<const Primitive *> primitives( meshes.begin(), meshes.end() );
+
+	std::vector<size_t> faceOffsets, vertexIdOffsets, vertexOffsets;
+	Detail::primitiveMergeOffsets( primitives, PrimitiveVariable::Uniform, faceOffsets );
+	Detail::primitiveMergeOffsets( primitives, PrimitiveVariable::FaceVarying, vertexIdOffsets );
+	Detail::primitiveMergeOffsets( primitives, PrimitiveVariable::Vertex, vertexOffsets );
+
+	IntVectorDataPtr verticesPerFaceData = new IntVectorData;
+	std::vector<int> &verticesPerFace = verticesPerFaceData->writable();
+	verticesPerFace.resize( faceOffsets.back() );
+
+	IntVectorDataPtr vertexIdsData = new IntVectorData;
+	std::vector<int> &vertexIds = vertexIdsData->writable();
+	vertexIds.resize( vertexIdOffsets.back() );
+
+	MergeTopology mergeTopology( meshes, faceOffsets, vertexIdOffsets, vertexOffsets, verticesPerFace, vertexIds );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, meshes.size() ), mergeTopology );
+
+	MeshPrimitivePtr result = new MeshPrimitive;
+	result->setTopologyUnchecked( verticesPerFaceData, vertexIdsData, vertexOffsets.back(), meshes[0]->interpolation() );
+	Detail::mergePrimitiveVariables( primitives, result.get(), removeNonMatchingPrimVars );
+
+	if( faceRanges )
+	{
+		faceRanges->resize( meshes.size() );
+		for( size_t i = 0; i < meshes.size(); ++i )
+		{
+			(*faceRanges)[i] = V2i( faceOffsets[i], faceOffsets[i+1] );
+		}
+	}
+
+	return result;
+}
+
+MeshPrimitivePtr triangulateAndPromote( const MeshPrimitive *mesh, bool addMissingNormals /* = true */ )
+{
+	const V3fVectorData *pData = mesh->variableData<V3fVectorData>( "P", PrimitiveVariable::Vertex );
+	if( !pData )
+	{
+		throw InvalidArgumentException( "MeshAlgo::triangulateAndPromote : Mesh must have primitive variable \"P\", of type V3fVectorData and interpolation type Vertex." );
+	}
+
+	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+	const size_t numFaces = verticesPerFace.size();
+
+	// first pass : compute where each face starts in the input and output,
+	// so that the faces can then be processed independently in parallel.
+
+	std::vector<size_t> faceVertexOffsets( numFaces );
+	std::vector<size_t> triangleOffsets( numFaces );
+	size_t numFaceVertices = 0;
+	size_t numTriangles = 0;
+	for( size_t i = 0; i < numFaces; ++i )
+	{
+		faceVertexOffsets[i] = numFaceVertices;
+		triangleOffsets[i] = numTriangles;
+		numFaceVertices += verticesPerFace[i];
+		numTriangles += std::max( verticesPerFace[i] - 2, 0 );
+	}
+
+	// second pass : triangulate, building the tables needed to expand
+	// the primitive variables.
+
+	IntVectorDataPtr newVerticesPerFaceData = new IntVectorData;
+	newVerticesPerFaceData->writable().resize( numTriangles, 3 );
+
+	IntVectorDataPtr newVertexIdsData = new IntVectorData;
+	std::vector<int> &newVertexIds = newVertexIdsData->writable();
+	newVertexIds.resize( numTriangles * 3 );
+
+	std::vector<int> faceVertexIndices( numTriangles * 3 );
+	std::vector<int> faceIndices( numTriangles * 3 );
+
+	TriangulateFaces triangulateFaces( verticesPerFace, vertexIds, faceVertexOffsets, triangleOffsets, newVertexIds, faceVertexIndices, faceIndices );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numFaces ), triangulateFaces );
+
+	MeshPrimitivePtr result = new MeshPrimitive;
+	result->setTopologyUnchecked( newVerticesPerFaceData, newVertexIdsData, mesh->variableSize( PrimitiveVariable::Vertex ), mesh->interpolation() );
+
+	// compute normals if necessary. we only compute them at their natural
+	// interpolation here, and leave the expansion to the generic code below.
+
+	PrimitiveVariableMap variables = mesh->variables;
+	if( addMissingNormals && variables.find( "N" ) == variables.end() )
+	{
+		V3fVectorDataPtr faceNormalsData = new V3fVectorData;
+		faceNormalsData->setInterpretation( GeometricData::Normal );
+		std::vector<V3f> &faceNormals = faceNormalsData->writable();
+		faceNormals.resize( numFaces );
+		FaceNormals faceNormalsCalculator( verticesPerFace, vertexIds, faceVertexOffsets, pData->readable(), faceNormals );
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, numFaces ), faceNormalsCalculator );
+
+		if( mesh->interpolation() == "linear" )
+		{
+			variables["N"] = PrimitiveVariable( PrimitiveVariable::Uniform, faceNormalsData );
+		}
+		else
+		{
+			V3fVectorDataPtr vertexNormalsData = new V3fVectorData;
+			vertexNormalsData->setInterpretation( GeometricData::Normal );
+			std::vector<V3f> &vertexNormals = vertexNormalsData->writable();
+			vertexNormals.resize( pData->readable().size(), V3f( 0 ) );
+			std::vector<int>::const_iterator vertexIdIt = vertexIds.begin();
+			for( size_t i = 0; i < numFaces; ++i )
+			{
+				for( int j = 0; j < verticesPerFace[i]; ++j, ++vertexIdIt )
+				{
+					vertexNormals[*vertexIdIt] += faceNormals[i];
+				}
+			}
+			for( std::vector<V3f>::iterator it = vertexNormals.begin(), eIt = vertexNormals.end(); it != eIt; ++it )
+			{
+				it->normalize();
+			}
+			variables["N"] = PrimitiveVariable( PrimitiveVariable::Vertex, vertexNormalsData );
+		}
+	}
+
+	// expand all the primitive variables to FaceVarying
+
+	for( PrimitiveVariableMap::const_iterator it = variables.begin(), eIt = variables.end(); it != eIt; ++it )
+	{
+		if( !it->second.data )
+		{
+			continue;
+		}
+
+		const std::vector<int> *indices = 0;
+		switch( it->second.interpolation )
+		{
+			case PrimitiveVariable::Constant :
+				result->variables[it->first] = PrimitiveVariable( PrimitiveVariable::Constant, it->second.data->copy() );
+				continue;
+			case PrimitiveVariable::Uniform :
+				indices = &faceIndices;
+				break;
+			case PrimitiveVariable::Vertex :
+			case PrimitiveVariable::Varying :
+				indices = &newVertexIds;
+				break;
+			case PrimitiveVariable::FaceVarying :
+				indices = &faceVertexIndices;
+				break;
+			default :
+				continue;
+		}
+
+		if( !mesh->isPrimitiveVariableValid( it->second ) )
+		{
+			throw InvalidArgumentException( boost::str( boost::format( "MeshAlgo::triangulateAndPromote : Primitive variable \"%s\" is not valid." ) % it->first ) );
+		}
+
+		PromoteToFaceVarying promoter( *indices );
+		DataPtr data = despatchTypedData<PromoteToFaceVarying, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( it->second.data.get(), promoter );
+		if( data )
+		{
+			result->variables[it->first] = PrimitiveVariable( PrimitiveVariable::FaceVarying, data );
+		}
+	}
+
+	return result;
+}
+
 } //namespace MeshAlgo
 } //namespace IECore
@@ -33,12 +33,8 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECore/MeshMergeOp.h"
+#include "IECore/MeshAlgo.h"
 #include "IECore/CompoundParameter.h"
-#include "IECore/NullObject.h"
-#include "IECore/DespatchTypedData.h"
-#include "IECore/TypeTraits.h"
-
-#include <algorithm>
 
 using namespace IECore;
 using namespace std;
@@ -78,175 +74,36 @@ const MeshPrimitiveParameter * MeshMergeOp::meshParameter() const
 	return m_meshParameter.get();
 }
 
-template<class T>
-struct MeshMergeOp::DefaultValue
-{
-	T operator()()
-	{
-		return T();
-	}
-};
-
-template<class T>
-struct MeshMergeOp::DefaultValue<Imath::Vec3<T> >
-{
-	Imath::Vec3<T> operator()()
-	{
-		return Imath::Vec3<T>( 0 );
-	}
-};
-
-template<class T>
-struct MeshMergeOp::DefaultValue<Imath::Vec2<T> >
+void MeshMergeOp::modifyTypedPrimitive( MeshPrimitive * mesh, const CompoundObject * operands )
 {
-	Imath::Vec2<T> operator()()
-	{
-		return Imath::Vec2<T>( 0 );
-	}
-};
+	const MeshPrimitive *mesh2 = static_cast<const MeshPrimitive *>( m_meshParameter->getValue() );
 
-struct MeshMergeOp::AppendPrimVars
-{
-	typedef void ReturnType;
+	vector<const MeshPrimitive *> meshes;
+	meshes.push_back( mesh );
+	meshes.push_back( mesh2 );
+	MeshPrimitivePtr merged = MeshAlgo::merge( meshes, m_removePrimVarsParameter->getTypedValue() );
 
-	AppendPrimVars( MeshPrimitive *mesh, const MeshPrimitive *mesh2, const std::string &name, const PrimitiveVariable::Interpolation interpolation, const bool remove, std::set<DataPtr> &visitedData )
-		:	m_mesh( mesh ), m_mesh2( mesh2 ), m_name( name ), m_interpolation( interpolation ), m_remove( remove ), m_visitedData( visitedData )
-	{
-	}
+	mesh->setTopologyUnchecked( merged->verticesPerFace(), merged->vertexIds(), merged->variableSize( PrimitiveVariable::Vertex ), mesh->interpolation() );
 
-	template<typename T>
-	ReturnType operator()( T *data )
+	// Constant PrimitiveVariables are left as they were on the input mesh,
+	// and everything else is replaced with the merged data.
+	for( PrimitiveVariableMap::iterator it = mesh->variables.begin(); it != mesh->variables.end(); )
 	{
-		if ( m_visitedData.find( data ) != m_visitedData.end() )
+		if( it->second.interpolation != PrimitiveVariable::Constant )
 		{
-			return;
-		}
-		m_visitedData.insert( data );
-
-		const T *data2 = m_mesh2->variableData<T>( m_name, m_interpolation );
-		if ( data2 )
-		{
-			data->writable().insert( data->writable().end(), data2->readable().begin(), data2->readable().end() );
-		}
-		else if ( m_remove )
-		{
-			m_mesh->variables.erase( m_name );
+			mesh->variables.erase( it++ );
 		}
 		else
 		{
-			typedef typename T::ValueType::value_type ValueType;
- 			ValueType defaultValue = DefaultValue<ValueType>()();
- 			size_t size = m_mesh2->variableSize( m_interpolation );
-			
- 			data->writable().insert( data->writable().end(), size, defaultValue );
-		}
-	}
-
-	private :
-
-		MeshPrimitive *m_mesh;
-		const MeshPrimitive *m_mesh2;
-		const std::string m_name;
-		const PrimitiveVariable::Interpolation m_interpolation;
-		const bool m_remove;
-		std::set<DataPtr> &m_visitedData;
-
-};
-
-struct MeshMergeOp::PrependPrimVars
-{
-	typedef void ReturnType;
-	
-	PrependPrimVars( MeshPrimitive *mesh, const std::string &name, const PrimitiveVariable::Interpolation interpolation, const bool remove, std::map<ConstDataPtr, DataPtr> &visitedData )
-		:	m_mesh( mesh ), m_name( name ), m_interpolation( interpolation ), m_remove( remove ), m_visitedData( visitedData )
-	{
-	}
-	
-	template<typename T>
-	ReturnType operator()( const T *data )
-	{
-		PrimitiveVariableMap::iterator it = m_mesh->variables.find( m_name );
-		if ( it == m_mesh->variables.end() && !m_remove )
-		{
-			typename T::Ptr data2 = 0;
-
-			std::map<ConstDataPtr, DataPtr>::iterator dataIt = m_visitedData.find( data );
-			if ( dataIt != m_visitedData.end() )
-			{
-				data2 = runTimeCast<T>( dataIt->second );
-			}
-			
-			if ( !data2 )
-			{
-				typedef typename T::ValueType::value_type ValueType;
-				ValueType defaultValue = DefaultValue<ValueType>()();
-				size_t size = m_mesh->variableSize( m_interpolation ) - data->readable().size();
-				
-				data2 = new T();
-				data2->writable().insert( data2->writable().end(), size, defaultValue );
-				data2->writable().insert( data2->writable().end(), data->readable().begin(), data->readable().end() );
-			}
-			
-			m_mesh->variables[m_name] = PrimitiveVariable( m_interpolation, data2 );
-			
-			m_visitedData[data] = data2;
+			++it;
 		}
 	}
-	
-	private :
-
-		MeshPrimitive *m_mesh;
-		const std::string m_name;
-		const PrimitiveVariable::Interpolation m_interpolation;
-		const bool m_remove;
-		std::map<ConstDataPtr, DataPtr> &m_visitedData;
-
-};
-
-void MeshMergeOp::modifyTypedPrimitive( MeshPrimitive * mesh, const CompoundObject * operands )
-{
-	const MeshPrimitive *mesh2 = static_cast<const MeshPrimitive *>( m_meshParameter->getValue() );
-
-	const vector<int> &verticesPerFace1 = mesh->verticesPerFace()->readable();
-	const vector<int> &vertexIds1 = mesh->vertexIds()->readable();
-
-	const vector<int> &verticesPerFace2 = mesh2->verticesPerFace()->readable();
-	const vector<int> &vertexIds2 = mesh2->vertexIds()->readable();
-
-	IntVectorDataPtr verticesPerFaceData = new IntVectorData;
-	vector<int> &verticesPerFace = verticesPerFaceData->writable();
-	verticesPerFace.resize( verticesPerFace1.size() + verticesPerFace2.size() );
-	vector<int>::iterator it = copy( verticesPerFace1.begin(), verticesPerFace1.end(), verticesPerFace.begin() );
-	copy( verticesPerFace2.begin(), verticesPerFace2.end(), it );
-
-	IntVectorDataPtr vertexIdsData = new IntVectorData;
-	vector<int> &vertexIds = vertexIdsData->writable();
-	vertexIds.resize( vertexIds1.size() + vertexIds2.size() );
-	it = copy( vertexIds1.begin(), vertexIds1.end(), vertexIds.begin() );
-	int vertexIdOffset = mesh->variableSize( PrimitiveVariable::Vertex );
-	transform( vertexIds2.begin(), vertexIds2.end(), it, bind2nd( plus<int>(), vertexIdOffset ) );
 
-	mesh->setTopology( verticesPerFaceData, vertexIdsData, mesh->interpolation() );
-	
-	std::set<DataPtr> visitedData;
-	PrimitiveVariableMap::iterator pvIt;
-	for( pvIt=mesh->variables.begin(); pvIt!=mesh->variables.end(); pvIt++ )
-	{
-		if( pvIt->second.interpolation!=PrimitiveVariable::Constant )
-		{
-			AppendPrimVars f( mesh, mesh2, pvIt->first, pvIt->second.interpolation, m_removePrimVarsParameter->getTypedValue(), visitedData );
-			despatchTypedData<AppendPrimVars, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( pvIt->second.data.get(), f );
-		}
-	}
-	
-	std::map<ConstDataPtr, DataPtr> visitedData2;
-	PrimitiveVariableMap::const_iterator pvIt2;
-	for ( pvIt2=mesh2->variables.begin(); pvIt2 != mesh2->variables.end(); pvIt2++ )
+	for( PrimitiveVariableMap::const_iterator it = merged->variables.begin(); it != merged->variables.end(); ++it )
 	{
-		if ( pvIt2->second.interpolation != PrimitiveVariable::Constant )
+		if( it->second.interpolation != PrimitiveVariable::Constant )
 		{
-			PrependPrimVars f( mesh, pvIt2->first, pvIt2->second.interpolation, m_removePrimVarsParameter->getTypedValue(), visitedData2 );
-			despatchTypedData<PrependPrimVars, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( pvIt2->second.data.get(), f );
+			mesh->variables.insert( *it );
 		}
 	}
 }
@@ -38,6 +38,9 @@
 #include "OpenEXR/ImathLineAlgo.h"
 #include "OpenEXR/ImathMatrix.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_reduce.h"
+
 #include "IECore/BoxOps.h"
 #include "IECore/PrimitiveVariable.h"
 #include "IECore/Exception.h"
@@ -841,6 +844,316 @@ int MeshPrimitiveEvaluator::intersectionPoints( const Imath::V3f &origin, const
 	return results.size();
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Batch ray intersection
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Traces rays against the triangleBoundTree() in packets of RayPacketSize. All the rays in
+// a packet share a single traversal of the tree, descending into a node if any of the
+// rays hits its bound, and the per-ray tests are written as loops over structure-of-arrays
+// data so that the compiler can vectorise them. Coherent rays, such as those generated for
+// occlusion or projection baking, visit mostly the same nodes, so the traversal cost is
+// amortised over the whole packet.
+class IntersectRays
+{
+
+	public :
+
+		enum { RayPacketSize = 4 };
+
+		typedef MeshPrimitiveEvaluator::TriangleBoundTree Tree;
+
+		IntersectRays(
+			const Tree &tree, const MeshPrimitiveEvaluator::TriangleBoundVector &triangles,
+			const std::vector<int> &vertexIds, const std::vector<V3f> &p,
+			const std::vector<V3f> &origins, const std::vector<V3f> &directions, float maxDistance,
+			std::vector<float> &distances, std::vector<int> &triangleIndices, std::vector<V3f> &barycentricCoordinates
+		)
+			:	m_tree( tree ), m_triangles( triangles ), m_vertexIds( vertexIds ), m_p( p ),
+				m_origins( origins ), m_directions( directions ), m_maxDistance( maxDistance ),
+				m_distances( distances ), m_triangleIndices( triangleIndices ), m_barycentricCoordinates( barycentricCoordinates ),
+				m_numHits( 0 )
+		{
+		}
+
+		IntersectRays( IntersectRays &other, tbb::split )
+			:	m_tree( other.m_tree ), m_triangles( other.m_triangles ), m_vertexIds( other.m_vertexIds ), m_p( other.m_p ),
+				m_origins( other.m_origins ), m_directions( other.m_directions ), m_maxDistance( other.m_maxDistance ),
+				m_distances( other.m_distances ), m_triangleIndices( other.m_triangleIndices ), m_barycentricCoordinates( other.m_barycentricCoordinates ),
+				m_numHits( 0 )
+		{
+		}
+
+		// range is in packets rather than rays
+		void operator()( const tbb::blocked_range<size_t> &range )
+		{
+			std::vector<Tree::NodeIndex> stack;
+			stack.reserve( 64 );
+
+			for( size_t packetIndex = range.begin(); packetIndex != range.end(); ++packetIndex )
+			{
+				tracePacket( packetIndex * RayPacketSize, stack );
+			}
+		}
+
+		void join( const IntersectRays &other )
+		{
+			m_numHits += other.m_numHits;
+		}
+
+		size_t numHits() const
+		{
+			return m_numHits;
+		}
+
+	private :
+
+		struct Packet
+		{
+			float origin[3][RayPacketSize];
+			float direction[3][RayPacketSize];
+			float inverseDirection[3][RayPacketSize];
+			float tMax[RayPacketSize];
+			int triangleIndex[RayPacketSize];
+			float u[RayPacketSize];
+			float v[RayPacketSize];
+		};
+
+		void tracePacket( size_t firstRay, std::vector<Tree::NodeIndex> &stack )
+		{
+			const size_t numRays = std::min( (size_t)RayPacketSize, m_origins.size() - firstRay );
+
+			Packet packet;
+			for( size_t i = 0; i < RayPacketSize; ++i )
+			{
+				// unused lanes are given a negative tMax so they never hit anything
+				const size_t rayIndex = firstRay + std::min( i, numRays - 1 );
+				const V3f d = m_directions[rayIndex].normalized();
+				for( int a = 0; a < 3; ++a )
+				{
+					packet.origin[a][i] = m_origins[rayIndex][a];
+					packet.direction[a][i] = d[a];
+					packet.inverseDirection[a][i] = 1.0f / d[a];
+				}
+				packet.tMax[i] = i < numRays ? m_maxDistance : -1.0f;
+				packet.triangleIndex[i] = -1;
+			}
+
+			stack.clear();
+			stack.push_back( m_tree.rootIndex() );
+			while( stack.size() )
+			{
+				const Tree::NodeIndex nodeIndex = stack.back();
+				stack.pop_back();
+
+				// we test the bound when popping rather than when pushing,
+				// so that we benefit from any hits found in the meantime.
+				const Tree::Node &node = m_tree.node( nodeIndex );
+				bool active[RayPacketSize];
+				if( !intersectsBound( packet, node.bound(), active ) )
+				{
+					continue;
+				}
+
+				if( node.isLeaf() )
+				{
+					Tree::Iterator *permLast = node.permLast();
+					for( Tree::Iterator *perm = node.permFirst(); perm != permLast; ++perm )
+					{
+						intersectTriangle( packet, *perm - m_triangles.begin(), active );
+					}
+				}
+				else
+				{
+					// visit the nearest child first, using the direction of the first active ray.
+					// in a coherent packet all the rays should agree.
+					size_t lane = 0;
+					while( !active[lane] )
+					{
+						lane++;
+					}
+
+					if( packet.direction[node.cutAxis()][lane] > 0.0f )
+					{
+						stack.push_back( Tree::highChildIndex( nodeIndex ) );
+						stack.push_back( Tree::lowChildIndex( nodeIndex ) );
+					}
+					else
+					{
+						stack.push_back( Tree::lowChildIndex( nodeIndex ) );
+						stack.push_back( Tree::highChildIndex( nodeIndex ) );
+					}
+				}
+			}
+
+			for( size_t i = 0; i < numRays; ++i )
+			{
+				const size_t rayIndex = firstRay + i;
+				const int triangleIndex = packet.triangleIndex[i];
+				m_triangleIndices[rayIndex] = triangleIndex;
+				if( triangleIndex >= 0 )
+				{
+					m_distances[rayIndex] = packet.tMax[i];
+					m_barycentricCoordinates[rayIndex] = V3f( 1.0f - packet.u[i] - packet.v[i], packet.u[i], packet.v[i] );
+					m_numHits++;
+				}
+				else
+				{
+					m_distances[rayIndex] = Imath::limits<float>::max();
+					m_barycentricCoordinates[rayIndex] = V3f( 0 );
+				}
+			}
+		}
+
+		// Slab test of the bound against all the rays in the packet. Returns true if any
+		// of the rays hit the bound before their current closest hit.
+		bool intersectsBound( const Packet &packet, const Box3f &bound, bool active[RayPacketSize] ) const
+		{
+			float tNear[RayPacketSize];
+			float tFar[RayPacketSize];
+			for( size_t i = 0; i < RayPacketSize; ++i )
+			{
+				tNear[i] = 0.0f;
+				tFar[i] = packet.tMax[i];
+			}
+
+			for( int a = 0; a < 3; ++a )
+			{
+				for( size_t i = 0; i < RayPacketSize; ++i )
+				{
+					float t0 = ( bound.min[a] - packet.origin[a][i] ) * packet.inverseDirection[a][i];
+					float t1 = ( bound.max[a] - packet.origin[a][i] ) * packet.inverseDirection[a][i];
+					if( t0 > t1 )
+					{
+						std::swap( t0, t1 );
+					}
+					// written so that NaNs (from a zero direction component and an origin
+					// on the slab boundary) leave the interval unchanged.
+					tNear[i] = t0 > tNear[i] ? t0 : tNear[i];
+					tFar[i] = t1 < tFar[i] ? t1 : tFar[i];
+				}
+			}
+
+			bool any = false;
+			for( size_t i = 0; i < RayPacketSize; ++i )
+			{
+				active[i] = tNear[i] <= tFar[i];
+				any = any || active[i];
+			}
+			return any;
+		}
+
+		// Moller-Trumbore intersection of the triangle against all the active rays in the packet,
+		// updating the closest hit for each.
+		void intersectTriangle( Packet &packet, size_t triangleIndex, const bool active[RayPacketSize] ) const
+		{
+			const size_t vertIdOffset = triangleIndex * 3;
+			const V3f &p0 = m_p[ m_vertexIds[vertIdOffset] ];
+			const V3f e1 = m_p[ m_vertexIds[vertIdOffset+1] ] - p0;
+			const V3f e2 = m_p[ m_vertexIds[vertIdOffset+2] ] - p0;
+
+			for( size_t i = 0; i < RayPacketSize; ++i )
+			{
+				if( !active[i] )
+				{
+					continue;
+				}
+
+				const V3f d( packet.direction[0][i], packet.direction[1][i], packet.direction[2][i] );
+				const V3f pVec = d.cross( e2 );
+				const float det = e1.dot( pVec );
+				if( det == 0.0f )
+				{
+					// ray is parallel to the triangle
+					continue;
+				}
+				const float inverseDet = 1.0f / det;
+
+				const V3f tVec = V3f( packet.origin[0][i], packet.origin[1][i], packet.origin[2][i] ) - p0;
+				const float u = tVec.dot( pVec ) * inverseDet;
+				if( u < 0.0f || u > 1.0f )
+				{
+					continue;
+				}
+
+				const V3f qVec = tVec.cross( e1 );
+				const float v = d.dot( qVec ) * inverseDet;
+				if( v < 0.0f || u + v > 1.0f )
+				{
+					continue;
+				}
+
+				const float t = e2.dot( qVec ) * inverseDet;
+				if( t >= 0.0f && t < packet.tMax[i] )
+				{
+					packet.tMax[i] = t;
+					packet.triangleIndex[i] = triangleIndex;
+					packet.u[i] = u;
+					packet.v[i] = v;
+				}
+			}
+		}
+
+		const Tree &m_tree;
+		const MeshPrimitiveEvaluator::TriangleBoundVector &m_triangles;
+		const std::vector<int> &m_vertexIds;
+		const std::vector<V3f> &m_p;
+
+		const std::vector<V3f> &m_origins;
+		const std::vector<V3f> &m_directions;
+		const float m_maxDistance;
+
+		std::vector<float> &m_distances;
+		std::vector<int> &m_triangleIndices;
+		std::vector<V3f> &m_barycentricCoordinates;
+
+		size_t m_numHits;
+
+};
+
+} // namespace
+
+size_t MeshPrimitiveEvaluator::intersectRays(
+	const std::vector<Imath::V3f> &origins, const std::vector<Imath::V3f> &directions,
+	std::vector<float> &distances, std::vector<int> &triangleIndices, std::vector<Imath::V3f> &barycentricCoordinates,
+	float maxDistance
+) const
+{
+	if( origins.size() != directions.size() )
+	{
+		throw InvalidArgumentException( "MeshPrimitiveEvaluator::intersectRays : origins and directions must have the same length" );
+	}
+
+	const size_t numRays = origins.size();
+	distances.resize( numRays );
+	triangleIndices.resize( numRays );
+	barycentricCoordinates.resize( numRays );
+
+	if( m_triangles.size() == 0 )
+	{
+		std::fill( distances.begin(), distances.end(), Imath::limits<float>::max() );
+		std::fill( triangleIndices.begin(), triangleIndices.end(), -1 );
+		std::fill( barycentricCoordinates.begin(), barycentricCoordinates.end(), V3f( 0 ) );
+		return 0;
+	}
+
+	assert( m_tree );
+
+	IntersectRays intersector(
+		*m_tree, m_triangles, *m_meshVertexIds, m_verts->readable(),
+		origins, directions, maxDistance,
+		distances, triangleIndices, barycentricCoordinates
+	);
+
+	const size_t numPackets = ( numRays + IntersectRays::RayPacketSize - 1 ) / IntersectRays::RayPacketSize;
+	tbb::parallel_reduce( tbb::blocked_range<size_t>( 0, numPackets ), intersector );
+
+	return intersector.numHits();
+}
+
 bool MeshPrimitiveEvaluator::barycentricPosition( unsigned int triangleIndex, const Imath::V3f &barycentricCoordinates, PrimitiveEvaluator::Result *result ) const
 {
 	if( triangleIndex >= m_triangles.size() )
@@ -40,6 +40,7 @@
 #include "IECore/FileNameParameter.h"
 #include "IECore/CompoundParameter.h"
 #include "IECore/Timer.h"
+#include "IECore/Random.h"
 
 #include "OpenEXR/ImathRandom.h"
 
@@ -48,6 +49,7 @@
 #include <algorithm>
 #include <fstream>
 #include <cassert>
+#include <limits>
 
 using namespace IECore;
 using namespace boost;
@@ -247,7 +249,7 @@ const IntVectorData * NParticleReader::frameTimes()
 }
 
 template<typename T, typename F>
-typename T::Ptr NParticleReader::filterAttr( const F *attr, float percentage )
+typename T::Ptr NParticleReader::filterAttr( const F *attr, float percentage, unsigned long firstParticle )
 {
 	if( percentage < 100.0f )
 	{
@@ -259,6 +261,8 @@ typename T::Ptr NParticleReader::filterAttr( const F *attr, float percentage )
 		float fraction = percentage / 100.0f;
 		Rand48 r;
 		r.init( seed );
+		// skip the random numbers belonging to the particles before this chunk
+		rand48Skip( r, firstParticle );
 		for( typename F::ValueType::size_type i=0; i<in.size(); i++ )
 		{
 			if( r.nextf() <= fraction )
@@ -285,6 +289,11 @@ typename T::Ptr NParticleReader::filterAttr( const F *attr, float percentage )
 }
 
 DataPtr NParticleReader::readAttribute( const std::string &name )
+{
+	return readAttributeChunk( name, 0, std::numeric_limits<unsigned long>::max() );
+}
+
+DataPtr NParticleReader::readAttributeChunk( const std::string &name, unsigned long firstParticle, unsigned long numParticles )
 {
 	if( !open() )
 	{
@@ -296,7 +305,7 @@ DataPtr NParticleReader::readAttribute( const std::string &name )
 	std::map<int, IFFFile::Chunk::ChunkIterator>::const_iterator frameIt = frameToRootChildren.find( frame );
 	if( frameIt == frameToRootChildren.end() )
 	{
-		msg( Msg::Warning, "NParticleReader::readAttribute()", boost::format( "Frame '%d' (index '%d') does not exist in '%s'." ) % frame % frameIndex % m_iffFileName );
+		msg( Msg::Warning, "NParticleReader::readAttributeChunk()", boost::format( "Frame '%d' (index '%d') does not exist in '%s'." ) % frame % frameIndex % m_iffFileName );
 		return 0;
 	}
 	
@@ -331,15 +340,17 @@ DataPtr NParticleReader::readAttribute( const std::string &name )
 		int id = it->type().id();
 		if ( id != kSIZE && id != kDBLA && id != kDVCA && id != kFVCA )
 		{
-			msg( Msg::Warning, "NParticleReader::readAttribute()", boost::format( "CHNM '%s' found, but was followed by invalid Tag '%s'." ) % name % it->type().name() );
+			msg( Msg::Warning, "NParticleReader::readAttributeChunk()", boost::format( "CHNM '%s' found, but was followed by invalid Tag '%s'." ) % name % it->type().name() );
 			return 0;
 		}
 	}
 	
 	DataPtr result = 0;
 	
-	int numParticles = 0;
-	(attrIt+1)->read( numParticles );
+	int totalParticles = 0;
+	(attrIt+1)->read( totalParticles );
+	firstParticle = std::min( firstParticle, (unsigned long)totalParticles );
+	numParticles = std::min( numParticles, totalParticles - firstParticle );
 	
 	switch( (attrIt+2)->type().id() )
 	{
@@ -347,15 +358,18 @@ DataPtr NParticleReader::readAttribute( const std::string &name )
 			{
 				DoubleVectorDataPtr d( new DoubleVectorData );
 				d->writable().resize( numParticles );
-				(attrIt+2)->read( d->writable() );
+				if( numParticles )
+				{
+					(attrIt+2)->read( d->baseWritable(), firstParticle, numParticles );
+				}
 				switch( realType() )
 				{
 					case Native :
 					case Double :
-						result = filterAttr<DoubleVectorData, DoubleVectorData>( d.get(), particlePercentage() );
+						result = filterAttr<DoubleVectorData, DoubleVectorData>( d.get(), particlePercentage(), firstParticle );
 						break;
 					case Float :
-						result = filterAttr<FloatVectorData, DoubleVectorData>( d.get(), particlePercentage() );
+						result = filterAttr<FloatVectorData, DoubleVectorData>( d.get(), particlePercentage(), firstParticle );
 						break;
 				}
 			}
@@ -364,18 +378,21 @@ DataPtr NParticleReader::readAttribute( const std::string &name )
 			{
 				V3dVectorDataPtr d( new V3dVectorData );
 				/// \todo: by all accounts the line below should be this :
-				/// d->writable().resize( numParticles() );
+				/// d->writable().resize( numParticles );
 				/// see PDCParticleReader for an explanation
 				d->writable().resize( numParticles, V3d( 0 ) );
-				(attrIt+2)->read( d->writable() );
+				if( numParticles )
+				{
+					(attrIt+2)->read( d->baseWritable(), firstParticle * 3, numParticles * 3 );
+				}
 				switch( realType() )
 				{
 					case Native :
 					case Double :
-						result = filterAttr<V3dVectorData, V3dVectorData>( d.get(), particlePercentage() );
+						result = filterAttr<V3dVectorData, V3dVectorData>( d.get(), particlePercentage(), firstParticle );
 						break;
 					case Float :
-						result = filterAttr<V3fVectorData, V3dVectorData>( d.get(), particlePercentage() );
+						result = filterAttr<V3fVectorData, V3dVectorData>( d.get(), particlePercentage(), firstParticle );
 						break;
 				}
 			}
@@ -384,24 +401,27 @@ DataPtr NParticleReader::readAttribute( const std::string &name )
 			{
 				V3fVectorDataPtr d( new V3fVectorData );
 				/// \todo: by all accounts the line below should be this :
-				/// d->writable().resize( numParticles() );
+				/// d->writable().resize( numParticles );
 				/// see PDCParticleReader for an explanation
 				d->writable().resize( numParticles, V3f( 0 ) );
-				(attrIt+2)->read( d->writable() );
+				if( numParticles )
+				{
+					(attrIt+2)->read( d->baseWritable(), firstParticle * 3, numParticles * 3 );
+				}
 				switch( realType() )
 				{
 					case Native :
 					case Double :
-						result = filterAttr<V3dVectorData, V3fVectorData>( d.get(), particlePercentage() );
+						result = filterAttr<V3dVectorData, V3fVectorData>( d.get(), particlePercentage(), firstParticle );
 						break;
 					case Float :
-						result = filterAttr<V3fVectorData, V3fVectorData>( d.get(), particlePercentage() );
+						result = filterAttr<V3fVectorData, V3fVectorData>( d.get(), particlePercentage(), firstParticle );
 						break;
 				}
 			}
 			break;
 		default :
-			msg( Msg::Error, "NParticleReader::readAttribute()", boost::format( "CHNM '%s' found, but was followed by invalid Tag '%s'." ) % name % (attrIt+2)->type().name() );
+			msg( Msg::Error, "NParticleReader::readAttributeChunk()", boost::format( "CHNM '%s' found, but was followed by invalid Tag '%s'." ) % name % (attrIt+2)->type().name() );
 
 	}
 	return result;
@@ -0,0 +1,154 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/parallel_for.h"
+
+#include "IECore/NoiseAlgo.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+
+namespace
+{
+
+// Evaluator adaptors, so that Displace can be used with
+// both noise and turbulence.
+
+struct NoiseEvaluator
+{
+
+	NoiseEvaluator( const PerlinNoiseV3fV3f &noise )
+		:	m_noise( noise )
+	{
+	}
+
+	void operator()( const V3f *p, V3f *result, size_t n ) const
+	{
+		m_noise.noise( p, result, n );
+	}
+
+	const PerlinNoiseV3fV3f &m_noise;
+
+};
+
+struct TurbulenceEvaluator
+{
+
+	TurbulenceEvaluator( const TurbulenceV3fV3f &turbulence )
+		:	m_turbulence( turbulence )
+	{
+	}
+
+	void operator()( const V3f *p, V3f *result, size_t n ) const
+	{
+		m_turbulence.turbulence( p, result, n );
+	}
+
+	const TurbulenceV3fV3f &m_turbulence;
+
+};
+
+template<typename Evaluator>
+class Displace
+{
+
+	public :
+
+		Displace( vector<V3f> &points, const Evaluator &evaluator, float frequency, const V3f &amplitude )
+			:	m_points( points ), m_evaluator( evaluator ), m_frequency( frequency ), m_amplitude( amplitude )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			// we evaluate in fixed size chunks so that the temporary
+			// storage fits comfortably in the cache.
+			static const size_t chunkSize = 256;
+			V3f p[chunkSize];
+			V3f v[chunkSize];
+
+			for( size_t chunkBegin = range.begin(); chunkBegin < range.end(); chunkBegin += chunkSize )
+			{
+				const size_t n = std::min( range.end() - chunkBegin, chunkSize );
+				V3f *points = &m_points[chunkBegin];
+				for( size_t i = 0; i < n; ++i )
+				{
+					p[i] = points[i] * m_frequency;
+				}
+				m_evaluator( p, v, n );
+				for( size_t i = 0; i < n; ++i )
+				{
+					points[i] += m_amplitude * v[i];
+				}
+			}
+		}
+
+	private :
+
+		vector<V3f> &m_points;
+		const Evaluator &m_evaluator;
+		const float m_frequency;
+		const V3f m_amplitude;
+
+};
+
+template<typename Evaluator>
+void parallelDisplace( V3fVectorData *points, const Evaluator &evaluator, float frequency, const V3f &amplitude )
+{
+	vector<V3f> &p = points->writable();
+	Displace<Evaluator> displace( p, evaluator, frequency, amplitude );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, p.size(), 1024 ), displace );
+}
+
+} // namespace
+
+namespace IECore
+{
+
+namespace NoiseAlgo
+{
+
+void displace( V3fVectorData *points, const PerlinNoiseV3fV3f &noise, float frequency, const Imath::V3f &amplitude )
+{
+	parallelDisplace( points, NoiseEvaluator( noise ), frequency, amplitude );
+}
+
+void displace( V3fVectorData *points, const TurbulenceV3fV3f &turbulence, float frequency, const Imath::V3f &amplitude )
+{
+	parallelDisplace( points, TurbulenceEvaluator( turbulence ), frequency, amplitude );
+}
+
+} // namespace NoiseAlgo
+} // namespace IECore
@@ -33,6 +33,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/parallel_for.h"
+
 #include "IECore/Object.h"
 #include "IECore/Interpolator.h"
 #include "IECore/ObjectInterpolator.h"
@@ -40,9 +42,190 @@
 #include "IECore/CompoundObject.h"
 #include "IECore/Primitive.h"
 #include "IECore/DespatchTypedData.h"
+#include "IECore/VectorTypedData.h"
 
 using namespace IECore;
 
+//////////////////////////////////////////////////////////////////////////
+// Array kernels
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Vectors of float, V3f and Color3f make up the bulk of the data we interpolate
+// when sampling animated primitives, so they get specialised kernels. These treat
+// the data as flat arrays of floats, with loops simple enough for the compiler to
+// vectorise, and large arrays are split into chunks which are processed in parallel.
+const size_t g_grainSize = 16384;
+
+class LinearKernel
+{
+
+	public :
+
+		LinearKernel( const float *y0, const float *y1, float x, float *result )
+			:	m_y0( y0 ), m_y1( y1 ), m_x( x ), m_result( result )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			const float *y0 = m_y0;
+			const float *y1 = m_y1;
+			const float x = m_x;
+			float *result = m_result;
+			for( size_t i = range.begin(), e = range.end(); i < e; ++i )
+			{
+				result[i] = y0[i] + ( y1[i] - y0[i] ) * x;
+			}
+		}
+
+	private :
+
+		const float *m_y0;
+		const float *m_y1;
+		const float m_x;
+		float *m_result;
+
+};
+
+class CubicKernel
+{
+
+	public :
+
+		CubicKernel( const float *y0, const float *y1, const float *y2, const float *y3, float x, float *result )
+			:	m_y0( y0 ), m_y1( y1 ), m_y2( y2 ), m_y3( y3 ), m_x( x ), m_result( result )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			const float *y0 = m_y0;
+			const float *y1 = m_y1;
+			const float *y2 = m_y2;
+			const float *y3 = m_y3;
+			const float x = m_x;
+			const float x2 = x * x;
+			const float x3 = x2 * x;
+			float *result = m_result;
+			for( size_t i = range.begin(), e = range.end(); i < e; ++i )
+			{
+				// same formulation as CubicInterpolator<T>
+				const float a0 = y3[i] - y2[i] - y0[i] + y1[i];
+				const float a1 = y0[i] - y1[i] - a0;
+				const float a2 = y2[i] - y0[i];
+				result[i] = a0 * x3 + a1 * x2 + a2 * x + y1[i];
+			}
+		}
+
+	private :
+
+		const float *m_y0;
+		const float *m_y1;
+		const float *m_y2;
+		const float *m_y3;
+		const float m_x;
+		float *m_result;
+
+};
+
+// Generic versions, used for all types without a specialised kernel.
+
+template<typename T>
+void linearInterpolate( const T *y0, const T *y1, double x, typename T::Ptr &result )
+{
+	LinearInterpolator<T>()( y0, y1, x, result );
+}
+
+template<typename T>
+void cubicInterpolate( const T *y0, const T *y1, const T *y2, const T *y3, double x, typename T::Ptr &result )
+{
+	CubicInterpolator<T>()( y0, y1, y2, y3, x, result );
+}
+
+// Versions for the types with specialised kernels. These are chosen
+// in preference to the templates above by overload resolution.
+
+template<typename T>
+void linearInterpolateFloats( const T *y0, const T *y1, double x, typename T::Ptr &result )
+{
+	const size_t size = y0->readable().size();
+	if( y1->readable().size() != size )
+	{
+		throw Exception( "Interpolation arrays have different lengths" );
+	}
+
+	result->writable().resize( size );
+	if( !size )
+	{
+		return;
+	}
+
+	LinearKernel kernel( y0->baseReadable(), y1->baseReadable(), x, result->baseWritable() );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, y0->baseSize(), g_grainSize ), kernel );
+}
+
+template<typename T>
+void cubicInterpolateFloats( const T *y0, const T *y1, const T *y2, const T *y3, double x, typename T::Ptr &result )
+{
+	const size_t size = y0->readable().size();
+	if( y1->readable().size() != size || y2->readable().size() != size || y3->readable().size() != size )
+	{
+		throw Exception( "Interpolation arrays have different lengths" );
+	}
+
+	result->writable().resize( size );
+	if( !size )
+	{
+		return;
+	}
+
+	CubicKernel kernel( y0->baseReadable(), y1->baseReadable(), y2->baseReadable(), y3->baseReadable(), x, result->baseWritable() );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, y0->baseSize(), g_grainSize ), kernel );
+}
+
+void linearInterpolate( const FloatVectorData *y0, const FloatVectorData *y1, double x, FloatVectorDataPtr &result )
+{
+	linearInterpolateFloats( y0, y1, x, result );
+}
+
+// As in GeometricTypedDataInterpolator.inl, the result takes its
+// interpretation from the first value.
+void linearInterpolate( const V3fVectorData *y0, const V3fVectorData *y1, double x, V3fVectorDataPtr &result )
+{
+	linearInterpolateFloats( y0, y1, x, result );
+	result->setInterpretation( y0->getInterpretation() );
+}
+
+void linearInterpolate( const Color3fVectorData *y0, const Color3fVectorData *y1, double x, Color3fVectorDataPtr &result )
+{
+	linearInterpolateFloats( y0, y1, x, result );
+}
+
+void cubicInterpolate( const FloatVectorData *y0, const FloatVectorData *y1, const FloatVectorData *y2, const FloatVectorData *y3, double x, FloatVectorDataPtr &result )
+{
+	cubicInterpolateFloats( y0, y1, y2, y3, x, result );
+}
+
+void cubicInterpolate( const V3fVectorData *y0, const V3fVectorData *y1, const V3fVectorData *y2, const V3fVectorData *y3, double x, V3fVectorDataPtr &result )
+{
+	cubicInterpolateFloats( y0, y1, y2, y3, x, result );
+	result->setInterpretation( y0->getInterpretation() );
+}
+
+void cubicInterpolate( const Color3fVectorData *y0, const Color3fVectorData *y1, const Color3fVectorData *y2, const Color3fVectorData *y3, double x, Color3fVectorDataPtr &result )
+{
+	cubicInterpolateFloats( y0, y1, y2, y3, x, result );
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Object interpolators
+//////////////////////////////////////////////////////////////////////////
+
 namespace IECore
 {
 
@@ -66,7 +249,7 @@ struct LinearInterpolator< Object >::Adaptor
 		const T *y0 = assertedStaticCast< const T>( m_y0 );
 		const T *y1 = assertedStaticCast< const T>( m_y1 );
 
-		LinearInterpolator<T>()( y0, y1, m_x, result );
+		linearInterpolate( y0, y1, m_x, result );
 
 		return result;
 	};
@@ -155,6 +338,13 @@ void LinearInterpolator< Object >::operator()( const Object *y0, const Object *y
 					it0->second.interpolation == it1->second.interpolation
 				)
 				{
+					if( it0->second.data == it1->second.data || it0->second.data->isEqualTo( it1->second.data.get() ) )
+					{
+						// nothing to interpolate - the copy made above already shares
+						// its data with x0, so there's no need to allocate anything.
+						continue;
+					}
+
 					PrimitiveVariableMap::iterator itRes = xRes->variables.find( it0->first );
 					ObjectPtr resultData = linearObjectInterpolation( it0->second.data.get(), it1->second.data.get(), x );
 					if( resultData )
@@ -213,7 +403,7 @@ struct CubicInterpolator< Object >::Adaptor
 		const T *y2 = assertedStaticCast< const T >( m_y2 );
 		const T *y3 = assertedStaticCast< const T >( m_y3 );
 
-		CubicInterpolator<T>()( y0, y1, y2, y3, m_x, result );
+		cubicInterpolate( y0, y1, y2, y3, m_x, result );
 
 		return result;
 	}
@@ -34,6 +34,7 @@
 
 #include "IECore/Op.h"
 #include "IECore/CompoundParameter.h"
+#include "IECore/Profiler.h"
 
 using namespace IECore;
 
@@ -61,6 +62,7 @@ ObjectPtr Op::operate()
 
 ObjectPtr Op::operate( const CompoundObject *operands )
 {
+	IECORE_PROFILE_SCOPE_DYNAMIC( typeName() );
 	ObjectPtr result = doOperation( operands );
 	m_resultParameter->setValidatedValue( result );
 	return result;
@@ -39,14 +39,15 @@
 #include "IECore/MessageHandler.h"
 #include "IECore/FileNameParameter.h"
 #include "IECore/Timer.h"
+#include "IECore/Exception.h"
 #include "IECore/ParticleReader.inl"
 
+#include "boost/iostreams/device/mapped_file.hpp"
 
 #include <algorithm>
-
-
 #include <fstream>
 #include <cassert>
+#include <cstring>
 
 using namespace IECore;
 using namespace boost;
@@ -55,15 +56,15 @@ using namespace std;
 
 IE_CORE_DEFINERUNTIMETYPED( PDCParticleReader );
 
-const Reader::ReaderDescription<PDCParticleReader> PDCParticleReader::m_readerDescription( "pdc" );
+const Reader::ReaderDescription<PDCParticleReader> PDCParticleReader::m_readerDescription( "pdc", "50444320" );
 
 PDCParticleReader::PDCParticleReader( )
-	:	ParticleReader( "Reads Maya .pdc format particle caches" ), m_iStream( 0 ), m_idAttribute( 0 )
+	:	ParticleReader( "Reads Maya .pdc format particle caches" ), m_iStream( 0 ), m_mappedFile( 0 ), m_idAttribute( 0 )
 {
 }
 
 PDCParticleReader::PDCParticleReader( const std::string &fileName )
-	:	ParticleReader( "Reads Maya .pdc format particle caches" ), m_iStream( 0 ), m_idAttribute( 0 )
+	:	ParticleReader( "Reads Maya .pdc format particle caches" ), m_iStream( 0 ), m_mappedFile( 0 ), m_idAttribute( 0 )
 {
 	m_fileNameParameter->setTypedValue( fileName );
 }
@@ -71,6 +72,7 @@ PDCParticleReader::PDCParticleReader( const std::string &fileName )
 PDCParticleReader::~PDCParticleReader()
 {
 	delete m_iStream;
+	delete m_mappedFile;
 }
 
 bool PDCParticleReader::canRead( const std::string &fileName )
@@ -94,6 +96,8 @@ bool PDCParticleReader::open()
 	if( !m_iStream || m_streamFileName!=fileName() )
 	{
 		delete m_iStream;
+		delete m_mappedFile;
+		m_mappedFile = 0;
 		m_iStream = new ifstream( fileName().c_str() );
 		if( !m_iStream->is_open() || !m_iStream->good() )
 		{
@@ -204,6 +208,21 @@ bool PDCParticleReader::open()
 		m_header.valid = m_iStream->good();
 		m_streamFileName = fileName();
 		m_idAttribute = 0;
+
+		if( m_header.valid )
+		{
+			// mapping the file lets us copy attribute data straight out of the
+			// page cache, without seeking and buffering through the stream.
+			try
+			{
+				m_mappedFile = new boost::iostreams::mapped_file_source( fileName() );
+			}
+			catch( const std::exception & )
+			{
+				// we'll fall back to reading from m_iStream
+				m_mappedFile = 0;
+			}
+		}
 	}
 	return m_iStream->good() && m_header.valid;
 }
@@ -233,20 +252,68 @@ void PDCParticleReader::attributeNames( std::vector<std::string> &names )
 template<typename T>
 void PDCParticleReader::readElements( T *buffer, std::streampos pos, unsigned long n ) const
 {
-	m_iStream->seekg( pos );
-	m_iStream->read( (char *)buffer, n * sizeof( T ) );
-	if( m_header.reverseBytes )
+	const size_t size = n * sizeof( T );
+	if( m_mappedFile )
 	{
-		for( unsigned long i=0; i<n; i++ )
+		const size_t offset = (std::streamoff)pos;
+		if( offset + size > m_mappedFile->size() )
 		{
-			*buffer = reverseBytes( *buffer );
-			buffer++;
+			throw IOException( ( boost::format( "PDCParticleReader : Unexpected end of file \"%s\"." ) % m_streamFileName ).str() );
 		}
+		memcpy( buffer, m_mappedFile->data() + offset, size );
+	}
+	else
+	{
+		m_iStream->seekg( pos );
+		m_iStream->read( (char *)buffer, size );
+		assert( m_iStream->good() );
+	}
+
+	if( m_header.reverseBytes )
+	{
+		reverseBytes( buffer, n );
+	}
+}
+
+template<typename T>
+typename T::Ptr PDCParticleReader::readArray( std::streampos pos, unsigned long firstParticle, unsigned long numParticles ) const
+{
+	typedef typename T::ValueType::value_type ElementType;
+	typedef typename T::BaseType BaseType;
+
+	typename T::Ptr result = new T;
+	if( !numParticles )
+	{
+		return result;
 	}
-	assert( m_iStream->good() );
+
+	/// \todo
+	/// by all accounts the line below should be this :
+	///
+	/// result->writable().resize( numParticles );
+	///
+	/// ie it shouldn't initialize the memory. but for some reason
+	/// that runs far far slower for us (at least an order of magnitude
+	/// slower) when we're in maya or python, at least for V3d. we don't
+	/// know why but it seems to be related to libstdc++ (maya has it's own).
+	/// so we're opting for the initialized version - this seems slightly (~10%)
+	/// slower when the planets are aligned correctly, but so much faster when the
+	/// planets are aligned against us, as they seem to be whenever we're coding in maya.
+	result->writable().resize( numParticles, ElementType( 0 ) );
+	readElements(
+		result->baseWritable(),
+		pos + (std::streamoff)( firstParticle * sizeof( ElementType ) ),
+		numParticles * ( sizeof( ElementType ) / sizeof( BaseType ) )
+	);
+	return result;
 }
 
 DataPtr PDCParticleReader::readAttribute( const std::string &name )
+{
+	return readAttributeChunk( name, 0, numParticles() );
+}
+
+DataPtr PDCParticleReader::readAttributeChunk( const std::string &name, unsigned long firstParticle, unsigned long numParticles )
 {
 	if( !open() )
 	{
@@ -259,10 +326,19 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 		return 0;
 	}
 
-	const Data *idAttr = idAttribute();
-	if ( !idAttr && particlePercentage() < 100.0f )
+	const unsigned long totalParticles = m_header.numParticles;
+	firstParticle = std::min( firstParticle, totalParticles );
+	numParticles = std::min( numParticles, totalParticles - firstParticle );
+
+	const float percentage = particlePercentage();
+	ConstDataPtr idAttr = 0;
+	if( percentage < 100.0f )
 	{
-		msg( Msg::Warning, "PDCParticleReader::filterAttr", format( "Percentage filtering requested but file \"%s\" contains no particle Id attribute." ) % fileName() );
+		idAttr = idAttribute( firstParticle, numParticles );
+		if( !idAttr )
+		{
+			msg( Msg::Warning, "PDCParticleReader::filterAttr", format( "Percentage filtering requested but file \"%s\" contains no particle Id attribute." ) % fileName() );
+		}
 	}
 
 	DataPtr result = 0;
@@ -277,10 +353,8 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 			break;
 		case IntegerArray :
 			{
-				IntVectorDataPtr d( new IntVectorData );
-				d->writable().resize( numParticles() );
-				readElements( &d->writable()[0], it->second.position, numParticles() );
-				result = filterAttr<IntVectorData, IntVectorData>( d.get(), particlePercentage(), idAttr );
+				IntVectorDataPtr d = readArray<IntVectorData>( it->second.position, firstParticle, numParticles );
+				result = filterAttr<IntVectorData, IntVectorData>( d.get(), percentage, idAttr.get(), firstParticle );
 			}
 			break;
 		case Double :
@@ -301,17 +375,15 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 			break;
 		case DoubleArray :
 			{
-				DoubleVectorDataPtr d( new DoubleVectorData );
-				d->writable().resize( numParticles() );
-				readElements( &d->writable()[0], it->second.position, numParticles() );
+				DoubleVectorDataPtr d = readArray<DoubleVectorData>( it->second.position, firstParticle, numParticles );
 				switch( realType() )
 				{
 					case Native :
 					case Double :
-						result = filterAttr<DoubleVectorData, DoubleVectorData>( d.get(), particlePercentage(), idAttr );
+						result = filterAttr<DoubleVectorData, DoubleVectorData>( d.get(), percentage, idAttr.get(), firstParticle );
 						break;
 					case Float :
-						result = filterAttr<FloatVectorData, DoubleVectorData>( d.get(), particlePercentage(), idAttr );
+						result = filterAttr<FloatVectorData, DoubleVectorData>( d.get(), percentage, idAttr.get(), firstParticle );
 						break;
 				}
 			}
@@ -319,7 +391,7 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 		case Vector :
 			{
 				V3dDataPtr d( new V3dData );
-				readElements( (double *)&d->writable(), it->second.position, 3 );
+				readElements( d->baseWritable(), it->second.position, 3 );
 				switch( realType() )
 				{
 					case Native :
@@ -334,31 +406,15 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 			break;
 		case VectorArray :
 			{
-				V3dVectorDataPtr d( new V3dVectorData );
-				/// \todo
-				/// by all accounts the line below should be this :
-				///
-				/// d->writable().resize( numParticles() );
-				///
-				/// ie it shouldn't initialize the memory. but for some reason
-				/// that runs far far slower for us (at least an order of magnitude
-				/// slower) when we're in maya or python. we don't know why but it seems
-				/// to be related to libstdc++ (maya has it's own). so we're opting for
-				/// the initialized version - this seems slightly (~10%) slower when the planets
-				/// are aligned correctly, but so much faster when the planets are aligned against
-				/// us, as they seem to be whenever we're coding in maya. testing seems to show that
-				/// this resize problem only occurs with V3d, and not with V3f, or double, or even
-				/// a struct with 3 doubles in, or even a template struct with 3 doubles in.
-				d->writable().resize( numParticles(), V3d( 0 ) );
-				readElements( (double *)&d->writable()[0], it->second.position, numParticles() * 3 );
+				V3dVectorDataPtr d = readArray<V3dVectorData>( it->second.position, firstParticle, numParticles );
 				switch( realType() )
 				{
 					case Native :
 					case Double :
-						result = filterAttr<V3dVectorData, V3dVectorData>( d.get(), particlePercentage(), idAttr );
+						result = filterAttr<V3dVectorData, V3dVectorData>( d.get(), percentage, idAttr.get(), firstParticle );
 						break;
 					case Float :
-						result = filterAttr<V3fVectorData, V3dVectorData>( d.get(), particlePercentage(), idAttr );
+						result = filterAttr<V3fVectorData, V3dVectorData>( d.get(), percentage, idAttr.get(), firstParticle );
 						break;
 				}
 			}
@@ -370,39 +426,38 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 	return result;
 }
 
-const Data * PDCParticleReader::idAttribute()
+ConstDataPtr PDCParticleReader::idAttribute( unsigned long firstParticle, unsigned long numParticles )
 {
-	if( !open() )
+	const bool wholeFile = firstParticle == 0 && numParticles == (unsigned long)m_header.numParticles;
+	if( wholeFile && m_idAttribute )
 	{
-		return 0;
+		return m_idAttribute;
 	}
-	if( !m_idAttribute )
+
+	map<string, Record>::const_iterator it = m_header.attributes.find( "particleId" );
+	if( it == m_header.attributes.end() )
 	{
-		map<string, Record>::const_iterator it = m_header.attributes.find( "particleId" );
-		if( it == m_header.attributes.end() )
+		it = m_header.attributes.find( "id" );
+	}
+
+	DataPtr result = 0;
+	if( it!=m_header.attributes.end() )
+	{
+		if( it->second.type==DoubleArray )
 		{
-			it = m_header.attributes.find( "id" );
+			result = readArray<DoubleVectorData>( it->second.position, firstParticle, numParticles );
 		}
-		
-		if( it!=m_header.attributes.end() )
+		if( it->second.type==IntegerArray )
 		{
-			if( it->second.type==DoubleArray )
-			{
-				DoubleVectorDataPtr doubleVec = new DoubleVectorData;
-				doubleVec->writable().resize( numParticles() );
-				readElements( &doubleVec->writable()[0], it->second.position, numParticles() );
-				m_idAttribute = doubleVec;
-			}
-			if( it->second.type==IntegerArray )
-			{
-				IntVectorDataPtr intVec = new IntVectorData;
-				intVec->writable().resize( numParticles() );
-				readElements( &intVec->writable()[0], it->second.position, numParticles() );
-				m_idAttribute = intVec;
-			}
+			result = readArray<IntVectorData>( it->second.position, firstParticle, numParticles );
 		}
 	}
-	return m_idAttribute.get();
+
+	if( wholeFile )
+	{
+		m_idAttribute = result;
+	}
+	return result;
 }
 
 std::string PDCParticleReader::positionPrimVarName()
@@ -107,7 +107,7 @@ struct PNGImageData
 
 IE_CORE_DEFINERUNTIMETYPED( PNGImageReader );
 
-const Reader::ReaderDescription <PNGImageReader> PNGImageReader::m_readerDescription ("png");
+const Reader::ReaderDescription <PNGImageReader> PNGImageReader::m_readerDescription ("png", "89504e470d0a1a0a");
 
 PNGImageReader::PNGImageReader() :
 		ImageReader( "Reads Portable Network Graphics (PNG) files" )
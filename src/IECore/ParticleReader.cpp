@@ -45,6 +45,7 @@
 #include "IECore/NullObject.h"
 #include "IECore/DespatchTypedData.h"
 #include "IECore/TestTypedData.h"
+#include "IECore/Exception.h"
 
 #include <algorithm>
 
@@ -154,18 +155,36 @@ const BoolParameter * ParticleReader::convertPrimVarNamesParameter() const
 	return m_convertPrimVarNamesParameter.get();
 }
 
+DataPtr ParticleReader::readAttributeChunk( const std::string &name, unsigned long firstParticle, unsigned long numParticles )
+{
+	throw NotImplementedException( ( boost::format( "%s::readAttributeChunk" ) % typeName() ).str() );
+}
+
+PointsPrimitivePtr ParticleReader::readChunk( unsigned long firstParticle, unsigned long numParticles )
+{
+	const unsigned long total = this->numParticles();
+	firstParticle = std::min( firstParticle, total );
+	numParticles = std::min( numParticles, total - firstParticle );
+	return readPoints( true, firstParticle, numParticles );
+}
+
 ObjectPtr ParticleReader::doOperation( const CompoundObject * operands )
+{
+	return readPoints( false, 0, numParticles() );
+}
+
+PointsPrimitivePtr ParticleReader::readPoints( bool chunked, unsigned long firstParticle, unsigned long numParticles )
 {
 	vector<string> attributes;
 	particleAttributes( attributes );
-	PointsPrimitivePtr result = new PointsPrimitive( numParticles() );
+	PointsPrimitivePtr result = new PointsPrimitive( numParticles );
 	// because of percentage filtering we don't really know the number of points until we've loaded an attribute.
-	// we start off with numParticles() in case there aren't any varying attributes in the cache at all, but replace it
+	// we start off with the unfiltered count in case there aren't any varying attributes in the cache at all, but replace it
 	// below as soon as we have a revised (percentage filtered) value.
 	bool haveNumPoints = false;
 	for( vector<string>::const_iterator it = attributes.begin(); it!=attributes.end(); it++ )
 	{
-		DataPtr d = readAttribute( *it );
+		DataPtr d = chunked ? readAttributeChunk( *it, firstParticle, numParticles ) : readAttribute( *it );
 
 		if ( testTypedData<TypeTraits::IsVectorTypedData>( d.get() ) )
 		{
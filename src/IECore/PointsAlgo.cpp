@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "IECore/PointsAlgo.h"
+#include "IECore/Exception.h"
+#include "IECore/private/PrimitiveMerge.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+
+namespace IECore
+{
+
+namespace PointsAlgo
+{
+
+PointsPrimitivePtr merge(
+	const std::vector<const PointsPrimitive *> &points,
+	bool removeNonMatchingPrimVars, /* = false */
+	std::vector<Imath::V2i> *pointRanges /* = 0 */
+)
+{
+	if( points.empty() )
+	{
+		throw InvalidArgumentException( "PointsAlgo::merge : No points to merge." );
+	}
+
+	const vector<const Primitive *> primitives( points.begin(), points.end() );
+
+	vector<size_t> pointOffsets;
+	Detail::primitiveMergeOffsets( primitives, PrimitiveVariable::Vertex, pointOffsets );
+
+	PointsPrimitivePtr result = new PointsPrimitive( pointOffsets.back() );
+	Detail::mergePrimitiveVariables( primitives, result.get(), removeNonMatchingPrimVars );
+
+	if( pointRanges )
+	{
+		pointRanges->resize( points.size() );
+		for( size_t i = 0; i < points.size(); ++i )
+		{
+			(*pointRanges)[i] = V2i( pointOffsets[i], pointOffsets[i+1] );
+		}
+	}
+
+	return result;
+}
+
+} // namespace PointsAlgo
+
+} // namespace IECore
@@ -0,0 +1,342 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <set>
+
+#include "boost/type_traits/is_same.hpp"
+
+#include "tbb/tbb.h"
+
+#include "IECore/private/PrimitiveMerge.h"
+#include "IECore/DespatchTypedData.h"
+#include "IECore/TypeTraits.h"
+#include "IECore/DataAlgo.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+template<class T>
+struct DefaultValue
+{
+	T operator()() const
+	{
+		return T();
+	}
+};
+
+template<class T>
+struct DefaultValue<Vec2<T> >
+{
+	Vec2<T> operator()() const
+	{
+		return Vec2<T>( 0 );
+	}
+};
+
+template<class T>
+struct DefaultValue<Vec3<T> >
+{
+	Vec3<T> operator()() const
+	{
+		return Vec3<T>( 0 );
+	}
+};
+
+template<class T>
+struct DefaultValue<Color3<T> >
+{
+	Color3<T> operator()() const
+	{
+		return Color3<T>( 0 );
+	}
+};
+
+template<class T>
+struct DefaultValue<Color4<T> >
+{
+	Color4<T> operator()() const
+	{
+		return Color4<T>( 0 );
+	}
+};
+
+// Describes a primitive variable of the merged primitive, and
+// the first input it was found on.
+struct MergedVariable
+{
+	std::string name;
+	PrimitiveVariable::Interpolation interpolation;
+	size_t firstInput;
+	DataPtr data;
+};
+
+bool matches( const Primitive *primitive, const MergedVariable &variable, const Data *firstData )
+{
+	PrimitiveVariableMap::const_iterator it = primitive->variables.find( variable.name );
+	if( it == primitive->variables.end() )
+	{
+		return false;
+	}
+	return it->second.interpolation == variable.interpolation && it->second.data && it->second.data->typeId() == firstData->typeId();
+}
+
+// Copies the data for one primitive variable from a range of inputs
+// into its preallocated location in the merged result.
+template<typename T>
+class CopyPrimitiveVariable
+{
+
+	public :
+
+		typedef typename T::ValueType VectorType;
+		typedef typename VectorType::value_type ValueType;
+
+		CopyPrimitiveVariable( const vector<const Primitive *> &inputs, const MergedVariable &variable, const vector<size_t> &offsets, VectorType &result )
+			:	m_inputs( inputs ), m_variable( variable ), m_offsets( offsets ), m_result( result )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				typename VectorType::iterator outIt = m_result.begin() + m_offsets[i];
+				const size_t size = m_offsets[i+1] - m_offsets[i];
+
+				const T *data = 0;
+				PrimitiveVariableMap::const_iterator it = m_inputs[i]->variables.find( m_variable.name );
+				if( it != m_inputs[i]->variables.end() && it->second.interpolation == m_variable.interpolation )
+				{
+					data = runTimeCast<const T>( it->second.data.get() );
+				}
+
+				if( data && data->readable().size() == size )
+				{
+					std::copy( data->readable().begin(), data->readable().end(), outIt );
+				}
+				else
+				{
+					std::fill( outIt, outIt + size, DefaultValue<ValueType>()() );
+				}
+			}
+		}
+
+	private :
+
+		const vector<const Primitive *> &m_inputs;
+		const MergedVariable &m_variable;
+		const vector<size_t> &m_offsets;
+		VectorType &m_result;
+
+};
+
+struct MergeVectorData
+{
+	typedef DataPtr ReturnType;
+
+	MergeVectorData( const vector<const Primitive *> &inputs, const MergedVariable &variable, const vector<size_t> &offsets )
+		:	m_inputs( inputs ), m_variable( variable ), m_offsets( offsets )
+	{
+	}
+
+	template<typename T>
+	ReturnType operator()( const T *data )
+	{
+		typename T::Ptr result = new T;
+		setGeometricInterpretation( result.get(), getGeometricInterpretation( data ) );
+
+		typename T::ValueType &resultVector = result->writable();
+		resultVector.resize( m_offsets.back() );
+
+		CopyPrimitiveVariable<T> copier( m_inputs, m_variable, m_offsets, resultVector );
+		if( boost::is_same<typename T::ValueType::value_type, bool>::value )
+		{
+			// Neighbouring elements of a std::vector<bool> share storage, so
+			// it isn't safe to write to them concurrently.
+			copier( tbb::blocked_range<size_t>( 0, m_inputs.size() ) );
+		}
+		else
+		{
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_inputs.size() ), copier );
+		}
+
+		return result;
+	}
+
+	private :
+
+		const vector<const Primitive *> &m_inputs;
+		const MergedVariable &m_variable;
+		const vector<size_t> &m_offsets;
+
+};
+
+class MergeVariables
+{
+
+	public :
+
+		MergeVariables( const vector<const Primitive *> &inputs, const Primitive *result, const vector<size_t> *offsets, vector<MergedVariable> &variables )
+			:	m_inputs( inputs ), m_result( result ), m_offsets( offsets ), m_variables( variables )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				MergedVariable &variable = m_variables[i];
+				Data *firstData = m_inputs[variable.firstInput]->variables.find( variable.name )->second.data.get();
+				if(
+					variable.interpolation == PrimitiveVariable::Constant ||
+					m_result->variableSize( variable.interpolation ) != m_offsets[variable.interpolation].back()
+				)
+				{
+					// Either a true constant, or an interpolation which doesn't scale
+					// with the size of the primitive (Uniform on PointsPrimitive for
+					// instance). Either way the first input wins.
+					variable.data = firstData->copy();
+				}
+				else
+				{
+					MergeVectorData f( m_inputs, variable, m_offsets[variable.interpolation] );
+					variable.data = despatchTypedData<MergeVectorData, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( firstData, f );
+				}
+			}
+		}
+
+	private :
+
+		const vector<const Primitive *> &m_inputs;
+		const Primitive *m_result;
+		const vector<size_t> *m_offsets;
+		vector<MergedVariable> &m_variables;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Implementation of public functions
+//////////////////////////////////////////////////////////////////////////
+
+namespace IECore
+{
+
+namespace Detail
+{
+
+void primitiveMergeOffsets( const std::vector<const Primitive *> &inputs, PrimitiveVariable::Interpolation interpolation, std::vector<size_t> &offsets )
+{
+	offsets.resize( inputs.size() + 1 );
+	offsets[0] = 0;
+	for( size_t i = 0; i < inputs.size(); ++i )
+	{
+		offsets[i+1] = offsets[i] + inputs[i]->variableSize( interpolation );
+	}
+}
+
+void mergePrimitiveVariables( const std::vector<const Primitive *> &inputs, Primitive *result, bool removeNonMatchingPrimVars )
+{
+	// Decide which variables are going to make it into the result.
+
+	vector<MergedVariable> variables;
+	std::set<std::string> visited;
+	for( size_t i = 0; i < inputs.size(); ++i )
+	{
+		for( PrimitiveVariableMap::const_iterator it = inputs[i]->variables.begin(), eIt = inputs[i]->variables.end(); it != eIt; ++it )
+		{
+			if( !it->second.data || it->second.interpolation == PrimitiveVariable::Invalid || !visited.insert( it->first ).second )
+			{
+				continue;
+			}
+
+			MergedVariable variable;
+			variable.name = it->first;
+			variable.interpolation = it->second.interpolation;
+			variable.firstInput = i;
+
+			if( removeNonMatchingPrimVars && variable.interpolation != PrimitiveVariable::Constant )
+			{
+				bool matchesAll = true;
+				for( size_t j = 0; j < inputs.size(); ++j )
+				{
+					if( j != i && !matches( inputs[j], variable, it->second.data.get() ) )
+					{
+						matchesAll = false;
+						break;
+					}
+				}
+				if( !matchesAll )
+				{
+					continue;
+				}
+			}
+
+			variables.push_back( variable );
+		}
+	}
+
+	// Compute the offsets for each interpolation, and then
+	// merge the data for all the variables in parallel.
+
+	vector<size_t> offsets[PrimitiveVariable::FaceVarying + 1];
+	for( int i = PrimitiveVariable::Uniform; i <= PrimitiveVariable::FaceVarying; ++i )
+	{
+		primitiveMergeOffsets( inputs, (PrimitiveVariable::Interpolation)i, offsets[i] );
+	}
+
+	MergeVariables mergeVariables( inputs, result, offsets, variables );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, variables.size() ), mergeVariables );
+
+	for( vector<MergedVariable>::const_iterator it = variables.begin(), eIt = variables.end(); it != eIt; ++it )
+	{
+		if( it->data )
+		{
+			result->variables[it->name] = PrimitiveVariable( it->interpolation, it->data );
+		}
+	}
+}
+
+} // namespace Detail
+
+} // namespace IECore
@@ -0,0 +1,387 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+#include "boost/format.hpp"
+
+#include "tbb/atomic.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/mutex.h"
+#include "tbb/tick_count.h"
+
+#include "IECore/Profiler.h"
+#include "IECore/Exception.h"
+
+using namespace std;
+using namespace IECore;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal data structures
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+tbb::atomic<bool> g_enabled;
+tbb::atomic<int> g_nextThreadIndex;
+const tbb::tick_count g_epoch = tbb::tick_count::now();
+
+// The total number of recorded events is limited, so that leaving
+// the profiler enabled can't consume all available memory.
+tbb::atomic<size_t> g_numEvents;
+tbb::atomic<size_t> g_numDroppedEvents;
+
+tbb::atomic<size_t> defaultMaxEvents()
+{
+	tbb::atomic<size_t> result;
+	result = 10000000;
+	return result;
+}
+
+tbb::atomic<size_t> g_maxEvents = defaultMaxEvents();
+
+inline double now()
+{
+	return ( tbb::tick_count::now() - g_epoch ).seconds();
+}
+
+} // namespace
+
+namespace IECore
+{
+
+namespace Detail
+{
+
+struct ProfilerThreadData
+{
+
+	struct Event
+	{
+		const char *name;
+		double startTime;
+		double duration;
+		double selfTime;
+	};
+
+	ProfilerThreadData();
+
+	int index;
+	Profiler::Scope *current;
+	// Events are only added by the owning thread, but may be
+	// read or cleared by any thread, so access must be guarded
+	// by the mutex.
+	tbb::mutex eventsMutex;
+	std::vector<Event> events;
+
+};
+
+} // namespace Detail
+
+} // namespace IECore
+
+namespace
+{
+
+typedef Detail::ProfilerThreadData::Event Event;
+typedef tbb::enumerable_thread_specific<Detail::ProfilerThreadData> ThreadDataStorage;
+
+ThreadDataStorage &threadDataStorage()
+{
+	// deliberately leaked, so that scopes closing during static
+	// destruction at exit can't access destroyed storage.
+	static ThreadDataStorage *s = new ThreadDataStorage;
+	return *s;
+}
+
+// Every ProfilerThreadData registers itself here, so that we can visit
+// them all without iterating the ThreadDataStorage, which isn't safe while
+// other threads may be adding to it. The data is never destroyed, so the
+// pointers remain valid.
+struct ThreadDataRegistry
+{
+	typedef std::vector<Detail::ProfilerThreadData *> ThreadDataVector;
+	tbb::mutex mutex;
+	ThreadDataVector threadData;
+};
+
+ThreadDataRegistry &threadDataRegistry()
+{
+	// leaked for the same reason as above.
+	static ThreadDataRegistry *r = new ThreadDataRegistry;
+	return *r;
+}
+
+bool compareSelfTime( const Profiler::Statistics &a, const Profiler::Statistics &b )
+{
+	return a.selfTime > b.selfTime;
+}
+
+void writeJSONString( std::ostream &o, const char *s )
+{
+	o << '"';
+	for( ; *s; ++s )
+	{
+		switch( *s )
+		{
+			case '"' :
+				o << "\\\"";
+				break;
+			case '\\' :
+				o << "\\\\";
+				break;
+			case '\n' :
+				o << "\\n";
+				break;
+			default :
+				o << *s;
+		}
+	}
+	o << '"';
+}
+
+} // namespace
+
+Detail::ProfilerThreadData::ProfilerThreadData()
+	:	index( g_nextThreadIndex.fetch_and_increment() ), current( 0 )
+{
+	ThreadDataRegistry &registry = threadDataRegistry();
+	tbb::mutex::scoped_lock lock( registry.mutex );
+	registry.threadData.push_back( this );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Scope
+//////////////////////////////////////////////////////////////////////////
+
+Profiler::Scope::Scope( const char *name )
+	:	m_threadData( 0 )
+{
+	if( g_enabled && name )
+	{
+		begin( name );
+	}
+}
+
+Profiler::Scope::Scope( const InternedString &name )
+	:	m_threadData( 0 )
+{
+	if( g_enabled )
+	{
+		begin( name.c_str() );
+	}
+}
+
+void Profiler::Scope::begin( const char *name )
+{
+	m_threadData = &threadDataStorage().local();
+	m_parent = m_threadData->current;
+	m_threadData->current = this;
+	m_name = name;
+	m_childTime = 0;
+	m_startTime = now();
+}
+
+Profiler::Scope::~Scope()
+{
+	if( !m_threadData )
+	{
+		return;
+	}
+
+	const double duration = now() - m_startTime;
+
+	if( g_numEvents.fetch_and_increment() < g_maxEvents )
+	{
+		Event event;
+		event.name = m_name;
+		event.startTime = m_startTime;
+		event.duration = duration;
+		event.selfTime = std::max( 0.0, duration - m_childTime );
+		tbb::mutex::scoped_lock lock( m_threadData->eventsMutex );
+		m_threadData->events.push_back( event );
+	}
+	else
+	{
+		g_numEvents.fetch_and_decrement();
+		g_numDroppedEvents.fetch_and_increment();
+	}
+
+	m_threadData->current = m_parent;
+	if( m_parent )
+	{
+		m_parent->m_childTime += duration;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Profiler
+//////////////////////////////////////////////////////////////////////////
+
+Profiler::Statistics::Statistics()
+	:	count( 0 ), totalTime( 0 ), selfTime( 0 ), maxTime( 0 )
+{
+}
+
+void Profiler::setEnabled( bool enabled )
+{
+	g_enabled = enabled;
+}
+
+bool Profiler::getEnabled()
+{
+	return g_enabled;
+}
+
+void Profiler::clear()
+{
+	ThreadDataRegistry &registry = threadDataRegistry();
+	tbb::mutex::scoped_lock registryLock( registry.mutex );
+	for( ThreadDataRegistry::ThreadDataVector::const_iterator it = registry.threadData.begin(); it != registry.threadData.end(); ++it )
+	{
+		tbb::mutex::scoped_lock lock( (*it)->eventsMutex );
+		g_numEvents -= (*it)->events.size();
+		// swap rather than clear, so that the memory is released
+		std::vector<Event>().swap( (*it)->events );
+	}
+	g_numDroppedEvents = 0;
+}
+
+void Profiler::setMaxEvents( size_t maxEvents )
+{
+	g_maxEvents = maxEvents;
+}
+
+size_t Profiler::getMaxEvents()
+{
+	return g_maxEvents;
+}
+
+size_t Profiler::numDroppedEvents()
+{
+	return g_numDroppedEvents;
+}
+
+void Profiler::writeChromeTrace( std::ostream &o )
+{
+	o << "{\"traceEvents\":[";
+
+	bool first = true;
+	ThreadDataRegistry &registry = threadDataRegistry();
+	tbb::mutex::scoped_lock registryLock( registry.mutex );
+	for( ThreadDataRegistry::ThreadDataVector::const_iterator it = registry.threadData.begin(); it != registry.threadData.end(); ++it )
+	{
+		tbb::mutex::scoped_lock lock( (*it)->eventsMutex );
+		const std::vector<Event> &events = (*it)->events;
+		for( std::vector<Event>::const_iterator eIt = events.begin(); eIt != events.end(); ++eIt )
+		{
+			o << ( first ? "\n" : ",\n" );
+			first = false;
+			// times are in microseconds
+			o << "{\"name\":";
+			writeJSONString( o, eIt->name );
+			o << boost::format( ",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}" ) % (*it)->index % ( eIt->startTime * 1e6 ) % ( eIt->duration * 1e6 );
+		}
+	}
+
+	o << "\n]}\n";
+}
+
+void Profiler::writeChromeTrace( const std::string &fileName )
+{
+	std::ofstream o( fileName.c_str() );
+	if( !o.good() )
+	{
+		throw IOException( "Profiler::writeChromeTrace : Unable to open file \"" + fileName + "\"." );
+	}
+	writeChromeTrace( o );
+}
+
+void Profiler::statistics( StatisticsVector &statistics )
+{
+	// names are persistent, so we can aggregate by pointer
+	// before merging any duplicate strings by value.
+	typedef std::map<const char *, Statistics> PointerMap;
+	PointerMap pointerMap;
+
+	ThreadDataRegistry &registry = threadDataRegistry();
+	tbb::mutex::scoped_lock registryLock( registry.mutex );
+	for( ThreadDataRegistry::ThreadDataVector::const_iterator it = registry.threadData.begin(); it != registry.threadData.end(); ++it )
+	{
+		tbb::mutex::scoped_lock lock( (*it)->eventsMutex );
+		for( std::vector<Event>::const_iterator eIt = (*it)->events.begin(); eIt != (*it)->events.end(); ++eIt )
+		{
+			Statistics &s = pointerMap[eIt->name];
+			s.count++;
+			s.totalTime += eIt->duration;
+			s.selfTime += eIt->selfTime;
+			s.maxTime = std::max( s.maxTime, eIt->duration );
+		}
+	}
+
+	typedef std::map<std::string, Statistics> NameMap;
+	NameMap nameMap;
+	for( PointerMap::const_iterator it = pointerMap.begin(); it != pointerMap.end(); ++it )
+	{
+		Statistics &s = nameMap[it->first];
+		s.name = it->first;
+		s.count += it->second.count;
+		s.totalTime += it->second.totalTime;
+		s.selfTime += it->second.selfTime;
+		s.maxTime = std::max( s.maxTime, it->second.maxTime );
+	}
+
+	statistics.clear();
+	for( NameMap::const_iterator it = nameMap.begin(); it != nameMap.end(); ++it )
+	{
+		statistics.push_back( it->second );
+	}
+	std::sort( statistics.begin(), statistics.end(), compareSelfTime );
+}
+
+void Profiler::writeSummary( std::ostream &o )
+{
+	StatisticsVector s;
+	statistics( s );
+
+	o << boost::format( "%-50s %10s %12s %12s %12s\n" ) % "Name" % "Count" % "Self (s)" % "Total (s)" % "Max (s)";
+	for( StatisticsVector::const_iterator it = s.begin(); it != s.end(); ++it )
+	{
+		o << boost::format( "%-50s %10d %12.6f %12.6f %12.6f\n" ) % it->name % it->count % it->selfTime % it->totalTime % it->maxTime;
+	}
+}
@@ -33,14 +33,23 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECore/Reader.h"
+#include "IECore/Exception.h"
 #include "IECore/FileNameParameter.h"
 #include "IECore/NullObject.h"
 #include "IECore/CompoundParameter.h"
+#include "IECore/Profiler.h"
 
 #include "boost/algorithm/string/split.hpp"
 #include "boost/algorithm/string/classification.hpp"
 #include "boost/filesystem/convenience.hpp"
 
+#include "tbb/atomic.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+
 using namespace std;
 using namespace IECore;
 using namespace boost;
@@ -64,6 +73,7 @@ CompoundObjectPtr Reader::readHeader()
 
 ObjectPtr Reader::read()
 {
+	IECORE_PROFILE_SCOPE( "Reader::read" );
 	/// \todo Perhaps we should append the fileName() to any exceptions thrown by operate() before re-raising them?
 	/// Use of boost.exception might make this easier.
 	return operate();
@@ -74,11 +84,122 @@ const std::string &Reader::fileName() const
 	return m_fileNameParameter->getTypedValue();
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Format detection
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+tbb::atomic<size_t> g_creates;
+tbb::atomic<size_t> g_headerReads;
+tbb::atomic<size_t> g_canReadCalls;
+tbb::atomic<size_t> g_magicNumberMatches;
+
+size_t g_maxMagicNumberLength = 0;
+
+} // namespace
+
+// Reads the start of a file on demand, so that it is read at most once
+// no matter how many Readers need to check their magic numbers against it.
+class Reader::FileHeader
+{
+
+	public :
+
+		FileHeader( const std::string &fileName )
+			:	m_fileName( fileName ), m_read( false )
+		{
+		}
+
+		bool matches( const vector<string> &magicNumbers )
+		{
+			if( !m_read )
+			{
+				std::ifstream in( m_fileName.c_str(), std::ios::in | std::ios::binary );
+				if( in.is_open() && g_maxMagicNumberLength )
+				{
+					m_header.resize( g_maxMagicNumberLength );
+					in.read( &m_header[0], m_header.size() );
+					m_header.resize( in.gcount() );
+				}
+				m_read = true;
+				g_headerReads++;
+			}
+
+			for( vector<string>::const_iterator it = magicNumbers.begin(); it != magicNumbers.end(); ++it )
+			{
+				if( m_header.size() >= it->size() && std::equal( it->begin(), it->end(), m_header.begin() ) )
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+	private :
+
+		const std::string &m_fileName;
+		bool m_read;
+		std::string m_header;
+
+};
+
+template<typename Iterator>
+const Reader::ReaderFns *Reader::findReader( Iterator begin, Iterator end, const std::string &fileName, FileHeader &header, std::set<const ReaderFns *> &visited )
+{
+	// use magic numbers to rule readers in or out without
+	// having to call canRead().
+	vector<const ReaderFns *> matches;
+	vector<const ReaderFns *> unknowns;
+	for( Iterator it = begin; it != end; ++it )
+	{
+		const ReaderFns *r = it->second;
+		if( !visited.insert( r ).second )
+		{
+			continue;
+		}
+
+		if( r->magicNumbers.empty() )
+		{
+			unknowns.push_back( r );
+		}
+		else if( header.matches( r->magicNumbers ) )
+		{
+			matches.push_back( r );
+		}
+	}
+
+	if( matches.size() == 1 )
+	{
+		g_magicNumberMatches++;
+		return matches[0];
+	}
+
+	// otherwise fall back to canRead(), trying the readers whose
+	// magic numbers matched first.
+	matches.insert( matches.end(), unknowns.begin(), unknowns.end() );
+	for( vector<const ReaderFns *>::const_iterator it = matches.begin(); it != matches.end(); ++it )
+	{
+		g_canReadCalls++;
+		if( (*it)->canRead( fileName ) )
+		{
+			return *it;
+		}
+	}
+
+	return 0;
+}
+
 ReaderPtr Reader::create( const std::string &fileName )
 {
+	g_creates++;
+
 	bool knownExtension = false;
 	ExtensionsToFnsMap *m = extensionsToFns();
 	assert( m );
+	FileHeader header( fileName );
+	std::set<const ReaderFns *> visited;
 	string ext = extension(boost::filesystem::path(fileName));
 	if( ext!="" )
 	{
@@ -89,26 +210,20 @@ ReaderPtr Reader::create( const std::string &fileName )
 			knownExtension = true;
 			
 			ExtensionsToFnsMap::const_iterator lastElement = m->upper_bound( ext );
-			
-			for ( ; it != lastElement; ++it )
-			{			
-				if( it->second.canRead( fileName ) )
-				{
-					return it->second.creator( fileName );
-				}
+			if( const ReaderFns *r = findReader( it, lastElement, fileName, header, visited ) )
+			{
+				return r->creator( fileName );
 			}
 		}
 	}
 
-	// failed to find a reader based on extension. try all canRead functions
-	// as a last ditch attempt.
-	for( ExtensionsToFnsMap::const_iterator it=m->begin(); it!=m->end(); it++ )
+	// failed to find a reader based on extension. try all the other
+	// readers as a last ditch attempt.
+	if( const ReaderFns *r = findReader( m->begin(), m->end(), fileName, header, visited ) )
 	{
-		if( it->second.canRead( fileName ) )
-		{
-			return( it->second.creator( fileName ) );
-		}
+		return r->creator( fileName );
 	}
+
 	if ( knownExtension )
 	{
 		throw Exception( string( "Unable to load file '" ) + fileName + "'!" );
@@ -119,6 +234,29 @@ ReaderPtr Reader::create( const std::string &fileName )
 	}
 }
 
+Reader::CreateStatistics::CreateStatistics()
+	:	creates( 0 ), headerReads( 0 ), canReadCalls( 0 ), magicNumberMatches( 0 )
+{
+}
+
+Reader::CreateStatistics Reader::createStatistics()
+{
+	CreateStatistics result;
+	result.creates = g_creates;
+	result.headerReads = g_headerReads;
+	result.canReadCalls = g_canReadCalls;
+	result.magicNumberMatches = g_magicNumberMatches;
+	return result;
+}
+
+void Reader::resetCreateStatistics()
+{
+	g_creates = 0;
+	g_headerReads = 0;
+	g_canReadCalls = 0;
+	g_magicNumberMatches = 0;
+}
+
 void Reader::supportedExtensions( std::vector<std::string> &extensions )
 {
 	extensions.clear();
@@ -148,7 +286,7 @@ void Reader::supportedExtensions( TypeId typeId, std::vector<std::string> &exten
 
 	for( ExtensionsToFnsMap::const_iterator it=m->begin(); it!=m->end(); it++ )
 	{
-		if ( it->second.typeId == typeId || std::find( derivedTypes.begin(), derivedTypes.end(), it->second.typeId ) != derivedTypes.end() )
+		if ( it->second->typeId == typeId || std::find( derivedTypes.begin(), derivedTypes.end(), it->second->typeId ) != derivedTypes.end() )
 		{
 			uniqueExtensions.insert( it->first.substr( 1 ) );
 		}
@@ -158,7 +296,7 @@ void Reader::supportedExtensions( TypeId typeId, std::vector<std::string> &exten
 	std::copy( uniqueExtensions.begin(), uniqueExtensions.end(), extensions.begin() );
 }
 
-void Reader::registerReader( const std::string &extensions, CanReadFn canRead, CreatorFn creator, TypeId typeId )
+void Reader::registerReader( const std::string &extensions, CanReadFn canRead, CreatorFn creator, TypeId typeId, const std::string &magicNumbers )
 {
 	assert( canRead );
 	assert( creator );
@@ -166,12 +304,37 @@ void Reader::registerReader( const std::string &extensions, CanReadFn canRead, C
 
 	ExtensionsToFnsMap *m = extensionsToFns();
 	assert( m );
+
+	// this is shared by all the extensions, and lives as long as the map does
+	ReaderFns *r = new ReaderFns;
+	r->creator = creator;
+	r->canRead = canRead;
+	r->typeId = typeId;
+
+	vector<string> splitMagicNumbers;
+	split( splitMagicNumbers, magicNumbers, is_any_of( " " ), token_compress_on );
+	for( vector<string>::const_iterator it=splitMagicNumbers.begin(); it!=splitMagicNumbers.end(); it++ )
+	{
+		if( it->empty() )
+		{
+			continue;
+		}
+		if( it->size() % 2 || it->find_first_not_of( "0123456789abcdefABCDEF" ) != string::npos )
+		{
+			delete r;
+			throw InvalidArgumentException( "Reader::registerReader : Invalid magic number \"" + *it + "\"" );
+		}
+		string magicNumber;
+		for( size_t i = 0; i < it->size(); i += 2 )
+		{
+			magicNumber.push_back( (char)strtol( it->substr( i, 2 ).c_str(), 0, 16 ) );
+		}
+		r->magicNumbers.push_back( magicNumber );
+		g_maxMagicNumberLength = std::max( g_maxMagicNumberLength, magicNumber.size() );
+	}
+
 	vector<string> splitExt;
 	split( splitExt, extensions, is_any_of( " " ) );
-	ReaderFns r;
-	r.creator = creator;
-	r.canRead = canRead;
-	r.typeId = typeId;
 	for( vector<string>::const_iterator it=splitExt.begin(); it!=splitExt.end(); it++ )
 	{
 		m->insert( ExtensionsToFnsMap::value_type( "." + *it, r ) );
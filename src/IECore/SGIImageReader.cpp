@@ -90,7 +90,7 @@ struct SGIImageReader::Header
 	map< string, int > m_channelOffsets;
 };
 
-const Reader::ReaderDescription<SGIImageReader> SGIImageReader::m_readerDescription( "sgi rgb rgba bw" );
+const Reader::ReaderDescription<SGIImageReader> SGIImageReader::m_readerDescription( "sgi rgb rgba bw", "01da" );
 
 SGIImageReader::SGIImageReader() :
 		ImageReader( "Reads SGI RGB files." )
@@ -37,6 +37,9 @@
 
 #include "OpenEXR/ImathBoxAlgo.h"
 
+#include <cmath>
+#include <limits>
+
 #include "IECore/SceneCache.h"
 #include "IECore/FileIndexedIO.h"
 #include "IECore/HeaderGenerator.h"
@@ -44,10 +47,13 @@
 #include "IECore/ObjectInterpolator.h"
 #include "IECore/Primitive.h"
 #include "IECore/SimpleTypedData.h"
+#include "IECore/VectorTypedData.h"
+#include "IECore/CompoundData.h"
 #include "IECore/TransformationMatrixData.h"
 #include "IECore/SharedSceneInterfaces.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/ComputationCache.h"
+#include "IECore/Profiler.h"
 
 using namespace IECore;
 using namespace Imath;
@@ -84,6 +90,348 @@ const SceneInterface::Name &SceneCache::animatedObjectPrimVarsAttribute = Intern
 
 typedef std::vector<double> SampleTimes;
 
+//////////////////////////////////////////////////////////////////////////
+// Primitive variable storage
+//////////////////////////////////////////////////////////////////////////
+
+// Primitive variables written with a storage other than FullPrecision are saved as
+// CompoundData holding the encoded values along with everything needed to reconstruct
+// the original data. The presence of storageEntry identifies them as such.
+static InternedString storageEntry("sceneCache:primitiveVariableStorage");
+static InternedString storageTypeIdEntry("typeId");
+static InternedString storageInterpretationEntry("interpretation");
+static InternedString storageDataEntry("data");
+static InternedString storageMinEntry("min");
+static InternedString storageMaxEntry("max");
+
+namespace
+{
+
+template<typename T>
+const float *geometricComponents( const Data *data, size_t &numElements, size_t &dimensions, int &interpretation )
+{
+	const T *d = static_cast<const T *>( data );
+	numElements = d->readable().size();
+	dimensions = sizeof( typename T::ValueType::value_type ) / sizeof( float );
+	interpretation = d->getInterpretation();
+	return numElements ? d->baseReadable() : 0;
+}
+
+// Returns the float components of the data types which may be stored at reduced
+// precision, or 0 for any other type.
+const float *floatComponents( const Data *data, size_t &numElements, size_t &dimensions, int &interpretation )
+{
+	switch( data->typeId() )
+	{
+		case FloatVectorDataTypeId :
+			{
+				const FloatVectorData *d = static_cast<const FloatVectorData *>( data );
+				numElements = d->readable().size();
+				dimensions = 1;
+				interpretation = GeometricData::None;
+				return numElements ? d->baseReadable() : 0;
+			}
+		case V2fVectorDataTypeId :
+			return geometricComponents<V2fVectorData>( data, numElements, dimensions, interpretation );
+		case V3fVectorDataTypeId :
+			return geometricComponents<V3fVectorData>( data, numElements, dimensions, interpretation );
+		default :
+			return 0;
+	}
+}
+
+template<typename T>
+float *createGeometricComponents( size_t numElements, int interpretation, DataPtr &result )
+{
+	typename T::Ptr d = new T;
+	d->writable().resize( numElements );
+	d->setInterpretation( (GeometricData::Interpretation)interpretation );
+	result = d;
+	return d->baseWritable();
+}
+
+// Creates data of the specified type, returning a pointer to its float components.
+float *createFloatComponents( TypeId typeId, size_t numElements, int interpretation, DataPtr &result )
+{
+	switch( typeId )
+	{
+		case FloatVectorDataTypeId :
+			{
+				FloatVectorDataPtr d = new FloatVectorData;
+				d->writable().resize( numElements );
+				result = d;
+				return d->baseWritable();
+			}
+		case V2fVectorDataTypeId :
+			return createGeometricComponents<V2fVectorData>( numElements, interpretation, result );
+		case V3fVectorDataTypeId :
+			return createGeometricComponents<V3fVectorData>( numElements, interpretation, result );
+		default :
+			throw Exception( "SceneCache : Unsupported type for encoded primitive variable." );
+	}
+}
+
+inline unsigned short quantiseUnit( float x )
+{
+	// maps [-1,1] to [0,65535]
+	return (unsigned short)( std::min( std::max( x * 0.5f + 0.5f, 0.0f ), 1.0f ) * 65535.0f + 0.5f );
+}
+
+inline float signNotZero( float x )
+{
+	return x >= 0.0f ? 1.0f : -1.0f;
+}
+
+// The decoding functions are written as simple loops over the components,
+// without any branching on the storage type, so that the compiler is free
+// to vectorise them.
+
+void decodeHalf( const half *in, size_t n, float *out )
+{
+	for( size_t i = 0; i < n; ++i )
+	{
+		out[i] = in[i];
+	}
+}
+
+void decodeFixedPoint( const unsigned short *in, size_t numElements, size_t dimensions, const float *min, const float *max, float *out )
+{
+	float step[3];
+	for( size_t d = 0; d < dimensions; ++d )
+	{
+		step[d] = ( max[d] - min[d] ) / 65535.0f;
+	}
+
+	for( size_t i = 0; i < numElements; ++i )
+	{
+		for( size_t d = 0; d < dimensions; ++d )
+		{
+			out[d] = min[d] + (float)in[d] * step[d];
+		}
+		in += dimensions;
+		out += dimensions;
+	}
+}
+
+void decodeOctahedral( const unsigned short *in, size_t numElements, float *out )
+{
+	for( size_t i = 0; i < numElements; ++i )
+	{
+		float x = (float)in[0] / 32767.5f - 1.0f;
+		float y = (float)in[1] / 32767.5f - 1.0f;
+		const float z = 1.0f - fabs( x ) - fabs( y );
+		if( z < 0.0f )
+		{
+			// lower hemisphere, unfold
+			const float ox = x;
+			x = ( 1.0f - fabs( y ) ) * signNotZero( ox );
+			y = ( 1.0f - fabs( ox ) ) * signNotZero( y );
+		}
+		const float length = sqrtf( x * x + y * y + z * z );
+		out[0] = x / length;
+		out[1] = y / length;
+		out[2] = z / length;
+		in += 2;
+		out += 3;
+	}
+}
+
+// Returns data encoded using the specified storage, or 0 if the data
+// can't be stored in that way.
+DataPtr encodePrimitiveVariableData( const Data *data, SceneCache::PrimitiveVariableStorage storage )
+{
+	size_t numElements = 0, dimensions = 0;
+	int interpretation = GeometricData::None;
+	const float *in = floatComponents( data, numElements, dimensions, interpretation );
+	if( !in || storage == SceneCache::FullPrecision )
+	{
+		return 0;
+	}
+
+	CompoundDataPtr result = new CompoundData;
+	CompoundDataMap &members = result->writable();
+	members[storageEntry] = new IntData( storage );
+	members[storageTypeIdEntry] = new IntData( data->typeId() );
+	members[storageInterpretationEntry] = new IntData( interpretation );
+
+	const size_t n = numElements * dimensions;
+	switch( storage )
+	{
+		case SceneCache::HalfPrecision :
+			{
+				HalfVectorDataPtr encoded = new HalfVectorData;
+				std::vector<half> &out = encoded->writable();
+				out.resize( n );
+				for( size_t i = 0; i < n; ++i )
+				{
+					out[i] = in[i];
+				}
+				members[storageDataEntry] = encoded;
+			}
+			break;
+		case SceneCache::FixedPoint :
+			{
+				FloatVectorDataPtr minData = new FloatVectorData( std::vector<float>( dimensions, std::numeric_limits<float>::max() ) );
+				FloatVectorDataPtr maxData = new FloatVectorData( std::vector<float>( dimensions, -std::numeric_limits<float>::max() ) );
+				std::vector<float> &min = minData->writable();
+				std::vector<float> &max = maxData->writable();
+				for( size_t i = 0; i < numElements; ++i )
+				{
+					for( size_t d = 0; d < dimensions; ++d )
+					{
+						min[d] = std::min( min[d], in[i*dimensions+d] );
+						max[d] = std::max( max[d], in[i*dimensions+d] );
+					}
+				}
+
+				float scale[3];
+				for( size_t d = 0; d < dimensions; ++d )
+				{
+					scale[d] = max[d] > min[d] ? 65535.0f / ( max[d] - min[d] ) : 0.0f;
+				}
+
+				UShortVectorDataPtr encoded = new UShortVectorData;
+				std::vector<unsigned short> &out = encoded->writable();
+				out.resize( n );
+				for( size_t i = 0; i < numElements; ++i )
+				{
+					for( size_t d = 0; d < dimensions; ++d )
+					{
+						const size_t j = i * dimensions + d;
+						out[j] = (unsigned short)std::min( ( in[j] - min[d] ) * scale[d] + 0.5f, 65535.0f );
+					}
+				}
+
+				members[storageDataEntry] = encoded;
+				members[storageMinEntry] = minData;
+				members[storageMaxEntry] = maxData;
+			}
+			break;
+		case SceneCache::Octahedral :
+			{
+				if( dimensions != 3 )
+				{
+					return 0;
+				}
+				UShortVectorDataPtr encoded = new UShortVectorData;
+				std::vector<unsigned short> &out = encoded->writable();
+				out.resize( numElements * 2 );
+				for( size_t i = 0; i < numElements; ++i )
+				{
+					const float *v = in + i * 3;
+					const float l1 = fabs( v[0] ) + fabs( v[1] ) + fabs( v[2] );
+					float x = 0.0f, y = 0.0f;
+					if( l1 > 0.0f )
+					{
+						// project onto the octahedron, folding the lower hemisphere
+						// over the upper one.
+						x = v[0] / l1;
+						y = v[1] / l1;
+						if( v[2] < 0.0f )
+						{
+							const float ox = x;
+							x = ( 1.0f - fabs( y ) ) * signNotZero( ox );
+							y = ( 1.0f - fabs( ox ) ) * signNotZero( y );
+						}
+					}
+					out[i*2] = quantiseUnit( x );
+					out[i*2+1] = quantiseUnit( y );
+				}
+				members[storageDataEntry] = encoded;
+			}
+			break;
+		default :
+			return 0;
+	}
+
+	return result;
+}
+
+// If data was encoded by encodePrimitiveVariableData(), returns the decoded
+// data, otherwise returns 0.
+DataPtr decodePrimitiveVariableData( const Data *data )
+{
+	const CompoundData *compoundData = runTimeCast<const CompoundData>( data );
+	if( !compoundData )
+	{
+		return 0;
+	}
+
+	const IntData *storageData = compoundData->member<IntData>( storageEntry );
+	if( !storageData )
+	{
+		return 0;
+	}
+
+	const TypeId typeId = (TypeId)compoundData->member<IntData>( storageTypeIdEntry, true )->readable();
+	const int interpretation = compoundData->member<IntData>( storageInterpretationEntry, true )->readable();
+
+	DataPtr result = 0;
+	switch( storageData->readable() )
+	{
+		case SceneCache::HalfPrecision :
+			{
+				const std::vector<half> &in = compoundData->member<HalfVectorData>( storageDataEntry, true )->readable();
+				const size_t dimensions = typeId == FloatVectorDataTypeId ? 1 : ( typeId == V2fVectorDataTypeId ? 2 : 3 );
+				float *out = createFloatComponents( typeId, in.size() / dimensions, interpretation, result );
+				if( in.size() )
+				{
+					decodeHalf( &in[0], in.size(), out );
+				}
+			}
+			break;
+		case SceneCache::FixedPoint :
+			{
+				const std::vector<unsigned short> &in = compoundData->member<UShortVectorData>( storageDataEntry, true )->readable();
+				const std::vector<float> &min = compoundData->member<FloatVectorData>( storageMinEntry, true )->readable();
+				const std::vector<float> &max = compoundData->member<FloatVectorData>( storageMaxEntry, true )->readable();
+				const size_t dimensions = min.size();
+				if( !dimensions || dimensions > 3 || max.size() != dimensions )
+				{
+					throw Exception( "SceneCache : Invalid fixed point primitive variable." );
+				}
+				float *out = createFloatComponents( typeId, in.size() / dimensions, interpretation, result );
+				if( in.size() )
+				{
+					decodeFixedPoint( &in[0], in.size() / dimensions, dimensions, &min[0], &max[0], out );
+				}
+			}
+			break;
+		case SceneCache::Octahedral :
+			{
+				const std::vector<unsigned short> &in = compoundData->member<UShortVectorData>( storageDataEntry, true )->readable();
+				float *out = createFloatComponents( typeId, in.size() / 2, interpretation, result );
+				if( in.size() )
+				{
+					decodeOctahedral( &in[0], in.size() / 2, out );
+				}
+			}
+			break;
+		default :
+			throw Exception( boost::str( boost::format( "SceneCache : Unknown primitive variable storage %d." ) % storageData->readable() ) );
+	}
+
+	return result;
+}
+
+void decodePrimitiveVariables( PrimitiveVariableMap &variables )
+{
+	for( PrimitiveVariableMap::iterator it = variables.begin(); it != variables.end(); ++it )
+	{
+		if( !it->second.data )
+		{
+			continue;
+		}
+		DataPtr decoded = decodePrimitiveVariableData( it->second.data.get() );
+		if( decoded )
+		{
+			it->second.data = decoded;
+		}
+	}
+}
+
+} // namespace
+
 class SceneCache::Implementation : public RefCounted
 {
 	public :
@@ -654,7 +1002,9 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 
 		static PrimitiveVariableMap readObjectPrimitiveVariablesAtSample( const IndexedIOPtr &io, const std::vector<InternedString> &primVarNames, size_t sample )
 		{
-			return Primitive::loadPrimitiveVariables( io->subdirectory( objectEntry ).get(), sampleEntry(sample), primVarNames );
+			PrimitiveVariableMap result = Primitive::loadPrimitiveVariables( io->subdirectory( objectEntry ).get(), sampleEntry(sample), primVarNames );
+			decodePrimitiveVariables( result );
+			return result;
 		}
 
 		PrimitiveVariableMap readObjectPrimitiveVariables( const std::vector<InternedString> &primVarNames, double time ) const
@@ -674,6 +1024,8 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 			IndexedIOPtr objectIO = m_indexedIO->subdirectory( objectEntry );
 			PrimitiveVariableMap map1 = Primitive::loadPrimitiveVariables( objectIO.get(), sampleEntry(sample1), primVarNames );
 			PrimitiveVariableMap map2 = Primitive::loadPrimitiveVariables( objectIO.get(), sampleEntry(sample2), primVarNames );
+			decodePrimitiveVariables( map1 );
+			decodePrimitiveVariables( map2 );
 
 			for ( PrimitiveVariableMap::iterator it1 = map1.begin(); it1 != map1.end(); it1++ )
 			{
@@ -1044,6 +1396,7 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 		// static function used by the cache mechanism to actually load the object data from file.
 		static ObjectPtr doReadTransformAtSample( const SimpleCacheKey &key )
 		{
+			IECORE_PROFILE_SCOPE( "SceneCache::doReadTransformAtSample" );
 			IndexedIOPtr io = key.first->m_indexedIO->subdirectory( transformEntry, IndexedIO::NullIfMissing );
 			if ( !io )
 			{
@@ -1062,7 +1415,13 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 		// static function used by the cache mechanism to actually load the object data from file.
 		static ObjectPtr doReadObjectAtSample( const SimpleCacheKey &key )
 		{
-			return Object::load( key.first->m_indexedIO->subdirectory( objectEntry ), sampleEntry(key.second) );
+			IECORE_PROFILE_SCOPE( "SceneCache::doReadObjectAtSample" );
+			ObjectPtr result = Object::load( key.first->m_indexedIO->subdirectory( objectEntry ), sampleEntry(key.second) );
+			if( Primitive *primitive = runTimeCast<Primitive>( result.get() ) )
+			{
+				decodePrimitiveVariables( primitive->variables );
+			}
+			return result;
 		}
 
 		static MurmurHash attributeHash( const AttributeCacheKey &key )
@@ -1081,6 +1440,7 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 		// static function used by the cache mechanism to actually load the attribute data from file.
 		static ObjectPtr doReadAttributeAtSample( const AttributeCacheKey &key )
 		{
+			IECORE_PROFILE_SCOPE( "SceneCache::doReadAttributeAtSample" );
 			return Object::load( get<0>(key)->m_indexedIO->subdirectory(attributesEntry)->subdirectory(get<1>(key)), sampleEntry(get<2>(key)) );
 		}
 
@@ -1309,7 +1669,7 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			size_t sampleIndex = m_objectSampleTimes.size();
 			m_objectSampleTimes.push_back( time );
 			IndexedIOPtr io = m_indexedIO->subdirectory( objectEntry, IndexedIO::CreateIfMissing );
-			object->save( io, sampleEntry(sampleIndex) );
+			encodePrimitiveVariables( object )->save( io, sampleEntry(sampleIndex) );
 			
 			const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( object );
 			if ( renderable )
@@ -1422,6 +1782,19 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			return result;
 		}
 
+		void setPrimitiveVariableStorage( const SceneCache::Name &primVarName, SceneCache::PrimitiveVariableStorage storage )
+		{
+			writable();
+			root()->m_primitiveVariableStorage[primVarName] = storage;
+		}
+
+		SceneCache::PrimitiveVariableStorage getPrimitiveVariableStorage( const SceneCache::Name &primVarName ) const
+		{
+			const PrimitiveVariableStorageMap &storage = root()->m_primitiveVariableStorage;
+			PrimitiveVariableStorageMap::const_iterator it = storage.find( primVarName );
+			return it != storage.end() ? it->second : SceneCache::FullPrecision;
+		}
+
 		static WriterImplementation *writer( Implementation *impl, bool throwException = true )
 		{
 			WriterImplementation *writer = dynamic_cast< WriterImplementation* >( impl );
@@ -1434,6 +1807,64 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 
 	private :
 
+		WriterImplementation *root()
+		{
+			WriterImplementation *result = this;
+			while( result->m_parent )
+			{
+				result = result->m_parent;
+			}
+			return result;
+		}
+
+		const WriterImplementation *root() const
+		{
+			return const_cast<WriterImplementation *>( this )->root();
+		}
+
+		// Returns a copy of object with its primitive variables encoded according
+		// to the storage set with setPrimitiveVariableStorage(), or object itself
+		// if no encoding is needed.
+		ConstObjectPtr encodePrimitiveVariables( const Object *object ) const
+		{
+			const PrimitiveVariableStorageMap &storage = root()->m_primitiveVariableStorage;
+			const Primitive *primitive = runTimeCast<const Primitive>( object );
+			if( storage.empty() || !primitive )
+			{
+				return object;
+			}
+
+			PrimitivePtr result = 0;
+			for( PrimitiveVariableStorageMap::const_iterator it = storage.begin(); it != storage.end(); ++it )
+			{
+				PrimitiveVariableMap::const_iterator vIt = primitive->variables.find( it->first.value() );
+				if( it->second == SceneCache::FullPrecision || vIt == primitive->variables.end() || !vIt->second.data )
+				{
+					continue;
+				}
+
+				DataPtr encoded = encodePrimitiveVariableData( vIt->second.data.get(), it->second );
+				if( !encoded )
+				{
+					msg( Msg::Warning, "SceneCache::writeObject", boost::format( "Storing primitive variable \"%s\" at full precision, because its type is not supported by the requested storage." ) % it->first.value() );
+					continue;
+				}
+
+				if( !result )
+				{
+					// this is cheap, as the data itself is shared until modified
+					result = runTimeCast<Primitive>( primitive->copy() );
+				}
+				result->variables[vIt->first].data = encoded;
+			}
+
+			if( result )
+			{
+				return result;
+			}
+			return object;
+		}
+
 		typedef std::vector< Imath::Box3d > BoxSamples;
 		typedef ConstDataPtr TransformSample;
 		typedef std::vector< TransformSample > TransformSamples;
@@ -1994,7 +2425,11 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 		typedef std::map< SampleTimes, uint64_t > SampleTimesMap;
 		typedef std::map< SceneCache::Name, SampleTimes > AttributeSamplesMap;
 
+		typedef std::map< SceneCache::Name, SceneCache::PrimitiveVariableStorage > PrimitiveVariableStorageMap;
+
 		SampleTimesMap *m_sampleTimesMap;
+		// only used at the root, see root()
+		PrimitiveVariableStorageMap m_primitiveVariableStorage;
 		SampleTimes m_boundSampleTimes;		// implicit or explicit bound sample times
 		SampleTimes m_transformSampleTimes;
 		AttributeSamplesMap m_attributeSampleTimes;
@@ -2133,12 +2568,14 @@ double SceneCache::boundSampleInterval( double time, size_t &floorIndex, size_t
 
 Imath::Box3d SceneCache::readBoundAtSample( size_t sampleIndex ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readBoundAtSample" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readBoundAtSample( sampleIndex );
 }
 
 Imath::Box3d SceneCache::readBound( double time ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readBound" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readBound( time );
 }
@@ -2169,24 +2606,28 @@ double SceneCache::transformSampleInterval( double time, size_t &floorIndex, siz
 
 ConstDataPtr SceneCache::readTransformAtSample( size_t sampleIndex ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readTransformAtSample" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readTransformAtSample( sampleIndex );
 }
 
 Imath::M44d SceneCache::readTransformAsMatrixAtSample( size_t sampleIndex ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readTransformAsMatrixAtSample" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readTransformAsMatrixAtSample( sampleIndex );
 }
 
 ConstDataPtr SceneCache::readTransform( double time ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readTransform" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readTransform( time );
 }
 
 Imath::M44d SceneCache::readTransformAsMatrix( double time ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readTransformAsMatrix" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readTransformAsMatrix( time );
 }
@@ -2227,12 +2668,14 @@ double SceneCache::attributeSampleInterval( const Name &name, double time, size_
 
 ConstObjectPtr SceneCache::readAttributeAtSample( const Name &name, size_t sampleIndex ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readAttributeAtSample" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readAttributeAtSample( name, sampleIndex );
 }
 
 ConstObjectPtr SceneCache::readAttribute( const Name &name, double time ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readAttribute" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readAttribute( name, time );
 }
@@ -2302,24 +2745,28 @@ double SceneCache::objectSampleInterval( double time, size_t &floorIndex, size_t
 
 ConstObjectPtr SceneCache::readObjectAtSample( size_t sampleIndex ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readObjectAtSample" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readObjectAtSample( sampleIndex );
 }
 
 ConstObjectPtr SceneCache::readObject( double time ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readObject" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readObject( time );
 }
 
 PrimitiveVariableMap SceneCache::readObjectPrimitiveVariables( const std::vector<InternedString> &primVarNames, double time ) const
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::readObjectPrimitiveVariables" );
 	ReaderImplementation *reader = ReaderImplementation::reader( m_implementation.get() );
 	return reader->readObjectPrimitiveVariables( primVarNames, time );
 }
 
 void SceneCache::writeObject( const Object *object, double time )
 {
+	IECORE_PROFILE_SCOPE( "SceneCache::writeObject" );
 	WriterImplementation *writer = WriterImplementation::writer( m_implementation.get() );
 	writer->writeObject( object, time );
 }
@@ -2416,3 +2863,15 @@ bool SceneCache::readOnly() const
 {
 	return dynamic_cast< const ReaderImplementation* >( m_implementation.get() ) != NULL;
 }
+
+void SceneCache::setPrimitiveVariableStorage( const Name &primVarName, PrimitiveVariableStorage storage )
+{
+	WriterImplementation *writer = WriterImplementation::writer( m_implementation.get() );
+	writer->setPrimitiveVariableStorage( primVarName, storage );
+}
+
+SceneCache::PrimitiveVariableStorage SceneCache::getPrimitiveVariableStorage( const Name &primVarName ) const
+{
+	WriterImplementation *writer = WriterImplementation::writer( m_implementation.get() );
+	return writer->getPrimitiveVariableStorage( primVarName );
+}
@@ -32,8 +32,17 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <cstdlib>
+#include <set>
+
+#include "boost/bind.hpp"
+#include "boost/lexical_cast.hpp"
+
+#include "tbb/mutex.h"
+
 #include "IECore/LRUCache.h"
 #include "IECore/SharedSceneInterfaces.h"
+#include "IECore/Profiler.h"
 
 using namespace IECore;
 
@@ -48,23 +57,83 @@ class SharedSceneInterfaces::Cache : public SceneLRUCache
 	public :
 		
 		Cache( SceneLRUCache::Cost maxCost )
-			: SceneLRUCache( fileCacheGetter, maxCost )
+			:	SceneLRUCache(
+					boost::bind( &Cache::fileCacheGetter, this, _1, _2 ),
+					boost::bind( &Cache::removalCallback, this, _1, _2 ),
+					maxCost
+				),
+				m_numOpens( 0 ), m_numReopens( 0 )
+		{
+		}
+
+		size_t numOpens() const
 		{
+			tbb::mutex::scoped_lock lock( m_statisticsMutex );
+			return m_numOpens;
 		}
-	
+
+		size_t numReopens() const
+		{
+			tbb::mutex::scoped_lock lock( m_statisticsMutex );
+			return m_numReopens;
+		}
+
+		void resetStatistics()
+		{
+			tbb::mutex::scoped_lock lock( m_statisticsMutex );
+			m_removedFiles.clear();
+			m_numOpens = 0;
+			m_numReopens = 0;
+		}
+
 	private :
 		
-		static SceneInterfacePtr fileCacheGetter( const std::string &fileName, size_t &cost )
+		SceneInterfacePtr fileCacheGetter( const std::string &fileName, size_t &cost )
 		{
+			IECORE_PROFILE_SCOPE( "SharedSceneInterfaces::fileCacheGetter" );
 			SceneInterfacePtr result = SceneInterface::create( fileName, IECore::IndexedIO::Read );
 			cost = 1;
+
+			tbb::mutex::scoped_lock lock( m_statisticsMutex );
+			m_numOpens++;
+			if( m_removedFiles.erase( fileName ) )
+			{
+				m_numReopens++;
+			}
+
 			return result;
 		}
+
+		void removalCallback( const std::string &fileName, const ConstSceneInterfacePtr &scene )
+		{
+			tbb::mutex::scoped_lock lock( m_statisticsMutex );
+			// We only need to remember the files which have been discarded,
+			// but over a long session there may still be arbitrarily many of
+			// them, so we start afresh when there are too many. This means
+			// that reopens may be undercounted for very large working sets.
+			if( m_removedFiles.size() >= 10000 )
+			{
+				m_removedFiles.clear();
+			}
+			m_removedFiles.insert( fileName );
+		}
+
+		mutable tbb::mutex m_statisticsMutex;
+		std::set<std::string> m_removedFiles;
+		size_t m_numOpens;
+		size_t m_numReopens;
+
 };
 
+static size_t defaultMaxScenes()
+{
+	const char *m = getenv( "IECORE_SHAREDSCENEINTERFACES_MAXSCENES" );
+	return m ? boost::lexical_cast<size_t>( m ) : 200;
+}
+
 SharedSceneInterfaces::Cache &SharedSceneInterfaces::cache()
 {
-	static Cache cache( 200 );
+	static Cache cache( defaultMaxScenes() );
 	return cache;
 }
 
@@ -86,3 +155,33 @@ void SharedSceneInterfaces::clear()
 {
 	cache().clear();
 }
+
+void SharedSceneInterfaces::setMaxScenes( size_t maxScenes )
+{
+	cache().setMaxCost( maxScenes );
+}
+
+size_t SharedSceneInterfaces::getMaxScenes()
+{
+	return cache().getMaxCost();
+}
+
+size_t SharedSceneInterfaces::numScenes()
+{
+	return cache().currentCost();
+}
+
+size_t SharedSceneInterfaces::numOpens()
+{
+	return cache().numOpens();
+}
+
+size_t SharedSceneInterfaces::numReopens()
+{
+	return cache().numReopens();
+}
+
+void SharedSceneInterfaces::resetStatistics()
+{
+	cache().resetStatistics();
+}
@@ -35,6 +35,7 @@
 #include "IECore/Export.h"
 #include "IECore/SplineData.h"
 #include "IECore/TypedData.inl"
+#include "IECore/LRUCache.h"
 
 #include <iostream>
 
@@ -146,3 +147,95 @@ template class IECORE_API TypedData<Splineff>;
 template class IECORE_API TypedData<Splinedd>;
 template class IECORE_API TypedData<SplinefColor3f>;
 template class IECORE_API TypedData<SplinefColor4f>;
+
+//////////////////////////////////////////////////////////////////////////
+// Baked spline cache
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The cache is keyed on the hash of the data, but the getter also needs
+// the data itself to bake from. As in CachedConverter, we carry the data
+// in the key but only ever access it from within the getter, during the
+// call to get() which supplied it.
+template<typename T>
+struct BakedSplineCacheKey
+{
+
+	BakedSplineCacheKey()
+		:	data( NULL )
+	{
+	}
+
+	BakedSplineCacheKey( const T *d )
+		:	data( d ), hash( d->Object::hash() )
+	{
+	}
+
+	bool operator == ( const BakedSplineCacheKey &other ) const
+	{
+		return hash == other.hash;
+	}
+
+	mutable const T *data;
+	MurmurHash hash;
+
+};
+
+template<typename T>
+inline size_t tbb_hasher( const BakedSplineCacheKey<T> &key )
+{
+	return tbb_hasher( key.hash );
+}
+
+template<typename T>
+struct BakedSplineCache
+{
+
+	typedef BakedSpline<typename T::ValueType::XType, typename T::ValueType::YType> BakedSplineType;
+	typedef boost::shared_ptr<const BakedSplineType> BakedSplinePtr;
+	typedef BakedSplineCacheKey<T> Key;
+	typedef LRUCache<Key, BakedSplinePtr> Cache;
+
+	static BakedSplinePtr get( const T *data )
+	{
+		return cache.get( Key( data ) );
+	}
+
+	static BakedSplinePtr getter( const Key &key, size_t &cost )
+	{
+		BakedSplinePtr result( new BakedSplineType( key.data->readable() ) );
+		key.data = NULL;
+		cost = sizeof( BakedSplineType ) + result->resolution() * sizeof( typename BakedSplineType::YType );
+		return result;
+	}
+
+	static Cache cache;
+
+};
+
+template<typename T>
+typename BakedSplineCache<T>::Cache BakedSplineCache<T>::cache( BakedSplineCache<T>::getter, 1024 * 1024 * 16 );
+
+} // namespace
+
+boost::shared_ptr<const BakedSplineff> IECore::bakedSpline( const SplineffData *data )
+{
+	return BakedSplineCache<SplineffData>::get( data );
+}
+
+boost::shared_ptr<const BakedSplinedd> IECore::bakedSpline( const SplineddData *data )
+{
+	return BakedSplineCache<SplineddData>::get( data );
+}
+
+boost::shared_ptr<const BakedSplinefColor3f> IECore::bakedSpline( const SplinefColor3fData *data )
+{
+	return BakedSplineCache<SplinefColor3fData>::get( data );
+}
+
+boost::shared_ptr<const BakedSplinefColor4f> IECore::bakedSpline( const SplinefColor4fData *data )
+{
+	return BakedSplineCache<SplinefColor4fData>::get( data );
+}
@@ -57,6 +57,7 @@
 #include "IECore/StreamIndexedIO.h"
 #include "IECore/VectorTypedData.h"
 #include "IECore/MurmurHash.h"
+#include "IECore/Profiler.h"
 
 #define HARDLINK				127
 #define SUBINDEX_DIR			126
@@ -2482,6 +2483,7 @@ void StreamIndexedIO::write(const IndexedIO::EntryID &name, const InternedString
 
 void StreamIndexedIO::read(const IndexedIO::EntryID &name, InternedString *&x, unsigned long arrayLength) const
 {
+	IECORE_PROFILE_SCOPE( "StreamIndexedIO::read" );
 	assert( m_node );
 	readable(name);
 
@@ -2590,6 +2592,7 @@ void StreamIndexedIO::rawWrite(const IndexedIO::EntryID &name, const T &x)
 template<typename T>
 void StreamIndexedIO::read(const IndexedIO::EntryID &name, T *&x, unsigned long arrayLength) const
 {
+	IECORE_PROFILE_SCOPE( "StreamIndexedIO::read" );
 	assert( m_node );
 	readable(name);
 
@@ -2613,6 +2616,7 @@ void StreamIndexedIO::read(const IndexedIO::EntryID &name, T *&x, unsigned long
 template<typename T>
 void StreamIndexedIO::rawRead(const IndexedIO::EntryID &name, T *&x, unsigned long arrayLength) const
 {
+	IECORE_PROFILE_SCOPE( "StreamIndexedIO::read" );
 	assert( m_node );
 	readable(name);
 
@@ -2639,6 +2643,7 @@ void StreamIndexedIO::rawRead(const IndexedIO::EntryID &name, T *&x, unsigned lo
 template<typename T>
 void StreamIndexedIO::read(const IndexedIO::EntryID &name, T &x) const
 {
+	IECORE_PROFILE_SCOPE( "StreamIndexedIO::read" );
 	assert( m_node );
 	readable(name);
 
@@ -2662,6 +2667,7 @@ void StreamIndexedIO::read(const IndexedIO::EntryID &name, T &x) const
 template<typename T>
 void StreamIndexedIO::rawRead(const IndexedIO::EntryID &name, T &x) const
 {
+	IECORE_PROFILE_SCOPE( "StreamIndexedIO::read" );
 	assert( m_node );
 	readable(name);
 
@@ -32,9 +32,9 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/parallel_for.h"
+
 #include "IECore/SummedAreaOp.h"
-#include "IECore/DespatchTypedData.h"
-#include "IECore/TypeTraits.h"
 
 using namespace IECore;
 using namespace std;
@@ -51,57 +51,83 @@ SummedAreaOp::~SummedAreaOp()
 {
 }
 
-struct SummedAreaOp::SumArea
+namespace
 {
-	typedef void ReturnType;
 
-	SumArea( const Imath::Box2i &dataWindow )
-		:	m_dataWindow( dataWindow )
-	{
-	}
-
-	template<typename T>
-	ReturnType operator()( T * data )
-	{
-		typedef typename T::ValueType Container;
-		typedef typename Container::value_type V;
+// Accumulates the row sums down each column, completing the
+// summed area table once modifyChannelRows() has summed each row.
+class SumColumns
+{
 
-		Container &buffer = data->writable();
+	public :
 
-		// deal with first row alone, as it doesn't have values above it
-		unsigned pixelIndex=0;
-		V rowSum = 0;
-		for( int x=m_dataWindow.min.x; x<=m_dataWindow.max.x; x++, pixelIndex++ )
+		SumColumns( const vector<float *> &channels, int width, int height )
+			:	m_channels( channels ), m_width( width ), m_height( height )
 		{
-			rowSum += buffer[pixelIndex];
-			buffer[pixelIndex] = rowSum;
 		}
-		// now do the other rows
-		unsigned upperPixelIndex = 0;
-		pixelIndex = m_dataWindow.size().x + 1;
-		for( int y=m_dataWindow.min.y + 1; y<=m_dataWindow.max.y; y++ )
+
+		void operator()( const tbb::blocked_range<int> &range ) const
 		{
-			rowSum = 0;
-			for( int x=m_dataWindow.min.x; x<=m_dataWindow.max.x; x++ )
+			for( vector<float *>::const_iterator it = m_channels.begin(); it != m_channels.end(); ++it )
 			{
-				rowSum += buffer[pixelIndex];
-				buffer[pixelIndex++] = rowSum + buffer[upperPixelIndex++];
+				float *buffer = *it;
+				for( int y = 1; y < m_height; ++y )
+				{
+					float *row = buffer + y * m_width;
+					const float *upperRow = row - m_width;
+					for( int x = range.begin(); x != range.end(); ++x )
+					{
+						row[x] += upperRow[x];
+					}
+				}
 			}
 		}
-	}
 
 	private :
 
-		Box2i m_dataWindow;
+		const vector<float *> &m_channels;
+		int m_width;
+		int m_height;
 
 };
 
+} // namespace
+
 void SummedAreaOp::modifyChannels( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, ChannelVector &channels )
 {
-	SumArea summer( dataWindow );
-	for( unsigned i=0; i<channels.size(); i++ )
+	// first sum each row in parallel, using modifyChannelRows().
+	ChannelOp::modifyChannels( displayWindow, dataWindow, channels );
+
+	// then add each row to the one below it, working in parallel
+	// on blocks of columns. the rows must be visited in order, but
+	// each column is independent of the others. note that calling
+	// writable() again here won't trigger a copy, as the base class
+	// has already done that.
+	vector<float *> channelPointers;
+	for( ChannelVector::iterator it = channels.begin(); it != channels.end(); ++it )
 	{
-		despatchTypedData<SumArea, TypeTraits::IsNumericVectorTypedData>( channels[i].get(), summer );
+		channelPointers.push_back( &(*it)->writable()[0] );
 	}
+
+	const int width = dataWindow.size().x + 1;
+	const int height = dataWindow.size().y + 1;
+	tbb::parallel_for( tbb::blocked_range<int>( 0, width, 64 ), SumColumns( channelPointers, width, height ) );
 }
 
+void SummedAreaOp::modifyChannelRows( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow, const ChannelPointerVector &channels, int beginRow, int endRow )
+{
+	const int width = dataWindow.size().x + 1;
+	for( ChannelPointerVector::const_iterator it = channels.begin(); it != channels.end(); ++it )
+	{
+		for( int y = beginRow; y < endRow; ++y )
+		{
+			float *row = *it + y * width;
+			float rowSum = 0;
+			for( int x = 0; x < width; ++x )
+			{
+				rowSum += row[x];
+				row[x] = rowSum;
+			}
+		}
+	}
+}
@@ -64,7 +64,7 @@ using namespace std;
 
 IE_CORE_DEFINERUNTIMETYPED( TIFFImageReader );
 
-const Reader::ReaderDescription<TIFFImageReader> TIFFImageReader::m_readerDescription("tiff tif tdl tx");
+const Reader::ReaderDescription<TIFFImageReader> TIFFImageReader::m_readerDescription("tiff tif tdl tx", "49492a00 4d4d002a 002a4949 2a004d4d");
 
 TIFFImageReader::TIFFImageReader()
 		:	ImageReader( "Reads Tagged Image File Format (TIFF) files" ),
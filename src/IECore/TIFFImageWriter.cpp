@@ -50,13 +50,17 @@
 #include "IECore/Parameter.h"
 #include "IECore/NumericParameter.h"
 #include "IECore/private/ScopedTIFFErrorHandler.h"
-#include "IECore/DataConvert.h"
 #include "IECore/ScaledDataConversion.h"
 #include "IECore/TypeTraits.h"
 #include "IECore/DespatchTypedData.h"
 #include "IECore/BoxOps.h"
 
 #include "tiffio.h"
+#include "zlib.h"
+
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
 
 using namespace IECore;
 using namespace IECore::Detail;
@@ -146,32 +150,81 @@ std::string TIFFImageWriter::destinationColorSpace() const
 	return "srgb";
 }
 
-template<typename ChannelData>
-struct TIFFImageWriter::ChannelConverter
+template<typename T>
+struct TIFFImageWriter::ChannelInterleaver
 {
-	typedef typename ChannelData::Ptr ReturnType;
+	typedef void ReturnType;
 
 	std::string m_channelName;
-
-	ChannelConverter( const std::string &channelName ) : m_channelName( channelName )
+	Box2i m_channelDataWindow;
+	Box2i m_dataWindow;
+	int m_channelOffset;
+	int m_samplesPerPixel;
+	std::vector<T> &m_imageBuffer;
+
+	ChannelInterleaver( const std::string &channelName, const Box2i &channelDataWindow, const Box2i &dataWindow, int channelOffset, int samplesPerPixel, std::vector<T> &imageBuffer )
+		:	m_channelName( channelName ), m_channelDataWindow( channelDataWindow ), m_dataWindow( dataWindow ),
+			m_channelOffset( channelOffset ), m_samplesPerPixel( samplesPerPixel ), m_imageBuffer( imageBuffer )
 	{
 	}
 
-	template<typename T>
-	ReturnType operator()( T * data )
+	template<typename D>
+	ReturnType operator()( D *data )
 	{
 		assert( data );
 
-		return DataConvert < T, ChannelData, ScaledDataConversion< typename T::ValueType::value_type, typename ChannelData::ValueType::value_type> >()
-		(
-			static_cast<const T *>( data )
+		tbb::parallel_for(
+			tbb::blocked_range<int>( m_dataWindow.min.y, m_dataWindow.max.y + 1 ),
+			InterleaveRows<typename D::ValueType::value_type>( &data->readable()[0], *this )
 		);
+	}
+
+	// Converts rows of a single channel and writes them into its slot in the
+	// interleaved image buffer. Rows are independent, so they are processed
+	// in parallel.
+	template<typename V>
+	class InterleaveRows
+	{
+
+		public :
+
+			InterleaveRows( const V *source, const ChannelInterleaver &interleaver )
+				:	m_source( source ), m_interleaver( interleaver )
+			{
+			}
+
+			void operator()( const tbb::blocked_range<int> &range ) const
+			{
+				ScaledDataConversion<V, T> converter;
+
+				const Box2i &channelDataWindow = m_interleaver.m_channelDataWindow;
+				const Box2i &dataWindow = m_interleaver.m_dataWindow;
+				const int samplesPerPixel = m_interleaver.m_samplesPerPixel;
+				const int sourceWidth = channelDataWindow.size().x + 1;
+				const int targetWidth = dataWindow.size().x + 1;
+
+				for( int y = range.begin(); y != range.end(); ++y )
+				{
+					const V *source = m_source + ( y - channelDataWindow.min.y ) * sourceWidth + ( dataWindow.min.x - channelDataWindow.min.x );
+					T *target = &m_interleaver.m_imageBuffer[0] + ( ( y - dataWindow.min.y ) * targetWidth ) * samplesPerPixel + m_interleaver.m_channelOffset;
+					for( int x = 0; x < targetWidth; ++x, ++source, target += samplesPerPixel )
+					{
+						*target = converter( *source );
+					}
+				}
+			}
+
+		private :
+
+			const V *m_source;
+			const ChannelInterleaver &m_interleaver;
+
 	};
 
 	struct ErrorHandler
 	{
-		template<typename T, typename F>
-		void operator()( const T *data, const F& functor )
+		template<typename D, typename F>
+		void operator()( const D *data, const F& functor )
 		{
 			assert( data );
 
@@ -180,6 +233,56 @@ struct TIFFImageWriter::ChannelConverter
 	};
 };
 
+namespace
+{
+
+// Compresses strips using zlib, in the form expected by libtiff for
+// COMPRESSION_DEFLATE. libtiff itself can only compress one strip at a time,
+// so we compress them all in parallel up front and then write them with
+// TIFFWriteRawStrip().
+class DeflateStrips
+{
+
+	public :
+
+		DeflateStrips( const char *buffer, size_t bufSize, size_t stripSize, std::vector<std::vector<Bytef> > &strips )
+			:	m_buffer( buffer ), m_bufSize( bufSize ), m_stripSize( stripSize ), m_strips( strips )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			for( size_t strip = range.begin(); strip != range.end(); ++strip )
+			{
+				const size_t offset = strip * m_stripSize;
+				const uLong sourceLength = std::min( m_stripSize, m_bufSize - offset );
+
+				std::vector<Bytef> &compressed = m_strips[strip];
+				uLongf compressedLength = compressBound( sourceLength );
+				compressed.resize( compressedLength );
+				if( compress2( &compressed[0], &compressedLength, (const Bytef *)m_buffer + offset, sourceLength, Z_DEFAULT_COMPRESSION ) == Z_OK )
+				{
+					compressed.resize( compressedLength );
+				}
+				else
+				{
+					// an empty strip signifies failure
+					compressed.clear();
+				}
+			}
+		}
+
+	private :
+
+		const char *m_buffer;
+		size_t m_bufSize;
+		size_t m_stripSize;
+		std::vector<std::vector<Bytef> > &m_strips;
+
+};
+
+} // namespace
+
 template<typename T>
 void TIFFImageWriter::encodeChannels( const ImagePrimitive * image, const vector<string> &names, const Imath::Box2i &dataWindow, tiff *tiffImage, size_t bufSize, unsigned int numStrips ) const
 {
@@ -202,28 +305,39 @@ void TIFFImageWriter::encodeChannels( const ImagePrimitive * image, const vector
 		DataPtr dataContainer = image->variables.find(i->c_str())->second.data;
 		assert( dataContainer );
 
-		typedef TypedData< vector<T> > ChannelData;
-		ChannelConverter<ChannelData> converter( *i );
-		typename ChannelData::Ptr channelData = despatchTypedData<
-			ChannelConverter<ChannelData>,
+		ChannelInterleaver<T> interleaver( *i, image->getDataWindow(), dataWindow, channelOffset, samplesPerPixel, imageBuffer );
+		despatchTypedData<
+			ChannelInterleaver<T>,
 			TypeTraits::IsNumericVectorTypedData,
-			typename ChannelConverter<ChannelData>::ErrorHandler
-		>( dataContainer.get(), converter );
+			typename ChannelInterleaver<T>::ErrorHandler
+		>( dataContainer.get(), interleaver );
+	}
 
-		typedef boost::multi_array_ref< const T, 2 > SourceArray2D;
-		typedef boost::multi_array_ref< T, 3 > TargetArray3D;
+	uint16 compression = COMPRESSION_NONE;
+	TIFFGetField( tiffImage, TIFFTAG_COMPRESSION, &compression );
+
+	if( compression == COMPRESSION_DEFLATE )
+	{
+		/// Compress all the strips in parallel, and then write them in order
+		int tss = TIFFStripSize(tiffImage);
+		assert( tss > 0 );
 
-		const SourceArray2D sourceData( &channelData->readable()[0], extents[ image->getDataWindow().size().y + 1 ][ image->getDataWindow().size().x + 1 ] );
-		TargetArray3D targetData( &imageBuffer[0], extents[ height ][ width ][ samplesPerPixel ] );
+		std::vector<std::vector<Bytef> > strips( numStrips );
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, numStrips ), DeflateStrips( (const char *)&imageBuffer[0], bufSize, tss, strips ) );
 
-		for ( int y = dataWindow.min.y; y <= dataWindow.max.y ; y++ )
+		for ( tstrip_t strip = 0; strip < numStrips; ++strip )
 		{
-			for ( int x = dataWindow.min.x; x <= dataWindow.max.x ; x++ )
+			if( strips[strip].empty() )
 			{
-				targetData[ y - dataWindow.min.y ][ x - dataWindow.min.x ][ channelOffset ]
-					= sourceData[ y - image->getDataWindow().min.y ][ x - image->getDataWindow().min.x ];
+				throw IOException( ( boost::format( "TIFFImageWriter: Error compressing strip %d for %s" ) % strip % fileName() ).str() );
+			}
+
+			if( TIFFWriteRawStrip( tiffImage, strip, &strips[strip][0], strips[strip].size() ) == -1 )
+			{
+				throw IOException( ( boost::format( "TIFFImageWriter: Error writing strip %d to %s" ) % strip % fileName() ).str() );
 			}
 		}
+		return;
 	}
 
 	/// Write the image buffer to the TIFF file, strip by strip
@@ -346,7 +460,6 @@ void TIFFImageWriter::writeImage( const vector<string> &names, const ImagePrimit
 		/// \todo different compression methods have a bearing on other attributes, eg. the strip size
 		/// handle these issues a bit better and perhaps more explicitly here.
 		int compression = parameters()->parameter<IntParameter>("compression")->getNumericValue();
-		TIFFSetField( tiffImage, TIFFTAG_COMPRESSION, compression );
 
 		int bitDepth = m_bitDepthParameter->getNumericValue();
 		if ( compression == COMPRESSION_JPEG && bitDepth != 8 )
@@ -358,6 +471,8 @@ void TIFFImageWriter::writeImage( const vector<string> &names, const ImagePrimit
 			compression = COMPRESSION_DEFLATE;
 		}
 
+		TIFFSetField( tiffImage, TIFFTAG_COMPRESSION, compression );
+
 		/// \todo Add a parameter to let us write signed images
 		switch ( bitDepth )
 		{
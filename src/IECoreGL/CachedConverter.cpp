@@ -36,12 +36,22 @@
 #include "boost/format.hpp"
 #include "boost/bind.hpp"
 #include "boost/bind/placeholders.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/condition_variable.hpp"
+
+#include "tbb/task.h"
+#include "tbb/mutex.h"
 
 #include "IECore/LRUCache.h"
 #include "IECore/MurmurHash.h"
+#include "IECore/MessageHandler.h"
+#include "IECore/VisibleRenderable.h"
 
 #include "IECoreGL/ToGLConverter.h"
 #include "IECoreGL/CachedConverter.h"
+#include "IECoreGL/BoxPrimitive.h"
+#include "IECoreGL/Primitive.h"
+#include "IECoreGL/Shader.h"
 
 using namespace IECoreGL;
 
@@ -67,6 +77,11 @@ struct CacheKey
 		: object( o ), hash( o->hash() )
 	{
 	}
+
+	CacheKey( const IECore::MurmurHash &h )
+		: object( NULL ), hash( h )
+	{
+	}
 	
 	bool operator == ( const CacheKey &other ) const
 	{
@@ -88,7 +103,7 @@ inline size_t tbb_hasher( const CacheKey &cacheKey )
 struct CachedConverter::MemberData
 {
 	MemberData( size_t maxMemory )
-		:	cache( getter, boost::bind( &MemberData::removalCallback, this, ::_1, ::_2 ), maxMemory )
+		:	cache( getter, boost::bind( &MemberData::removalCallback, this, ::_1, ::_2 ), maxMemory ), numRunningTasks( 0 )
 	{
 	}
 	
@@ -122,7 +137,115 @@ struct CachedConverter::MemberData
 	typedef IECore::LRUCache<CacheKey, IECore::RunTimeTypedPtr> Cache;
 	Cache cache;
 	std::vector<IECore::RunTimeTypedPtr> deferredRemovals;
-	
+
+	// Asynchronous conversion. Conversions are started by convertAsync()
+	// and run as enqueued tbb tasks. The tasks only perform the cpu side
+	// of the conversion - none of the ToGLConverters for the primitive types
+	// accepted by asyncConvertible() make any gl calls, leaving buffer creation
+	// until the primitive is first used. When complete the conversions are
+	// recorded in the completed list, and are moved from there into the cache
+	// by processPending(), which also creates their vertex buffers on the
+	// gl thread.
+
+	struct PendingConversion
+	{
+		PendingConversion()
+			:	complete( false ), cost( 0 )
+		{
+		}
+
+		IECore::RunTimeTypedPtr placeholder;
+		bool complete;
+		IECore::RunTimeTypedPtr result;
+		size_t cost;
+	};
+
+	class ConversionTask : public tbb::task
+	{
+
+		public :
+
+			ConversionTask( MemberData *data, IECore::ConstObjectPtr object, const IECore::MurmurHash &hash )
+				:	m_data( data ), m_object( object ), m_hash( hash )
+			{
+			}
+
+			virtual tbb::task *execute()
+			{
+				IECore::RunTimeTypedPtr result;
+				try
+				{
+					ToGLConverterPtr converter = ToGLConverter::create( m_object );
+					result = converter->convert();
+				}
+				catch( const std::exception &e )
+				{
+					IECore::msg( IECore::Msg::Error, "CachedConverter::convertAsync", e.what() );
+				}
+
+				const size_t cost = m_object->memoryUsage();
+				m_object = 0;
+				m_data->conversionComplete( m_hash, result, cost );
+				// m_data may be destroyed as soon as this returns, so
+				// it must be the last thing we do.
+				m_data->taskFinished();
+				return NULL;
+			}
+
+		private :
+
+			MemberData *m_data;
+			IECore::ConstObjectPtr m_object;
+			IECore::MurmurHash m_hash;
+
+	};
+
+	void conversionComplete( const IECore::MurmurHash &hash, IECore::RunTimeTypedPtr result, size_t cost )
+	{
+		tbb::mutex::scoped_lock lock( pendingMutex );
+		PendingMap::iterator it = pending.find( hash );
+		assert( it != pending.end() );
+		it->second.complete = true;
+		it->second.result = result;
+		it->second.cost = cost;
+		completed.push_back( hash );
+	}
+
+	void taskStarted()
+	{
+		boost::lock_guard<boost::mutex> lock( runningTasksMutex );
+		numRunningTasks++;
+	}
+
+	void taskFinished()
+	{
+		// we notify while holding the lock, so that waitForTasks()
+		// can't return and destroy us before we're done.
+		boost::lock_guard<boost::mutex> lock( runningTasksMutex );
+		if( !--numRunningTasks )
+		{
+			runningTasksCondition.notify_all();
+		}
+	}
+
+	void waitForTasks()
+	{
+		boost::unique_lock<boost::mutex> lock( runningTasksMutex );
+		while( numRunningTasks )
+		{
+			runningTasksCondition.wait( lock );
+		}
+	}
+
+	typedef std::map<IECore::MurmurHash, PendingConversion> PendingMap;
+	tbb::mutex pendingMutex;
+	PendingMap pending;
+	std::vector<IECore::MurmurHash> completed;
+
+	boost::mutex runningTasksMutex;
+	boost::condition_variable runningTasksCondition;
+	size_t numRunningTasks;
+
 };
 
 CachedConverter::CachedConverter( size_t maxMemory )
@@ -132,6 +255,9 @@ CachedConverter::CachedConverter( size_t maxMemory )
 
 CachedConverter::~CachedConverter()
 {
+	// the background tasks reference m_data, so we must wait for them
+	// to finish before destroying it.
+	m_data->waitForTasks();
 	delete m_data;
 }
 
@@ -140,6 +266,119 @@ IECore::ConstRunTimeTypedPtr CachedConverter::convert( const IECore::Object *obj
 	return m_data->cache.get( CacheKey( object ) );
 }
 
+bool CachedConverter::asyncConvertible( const IECore::Object *object )
+{
+	return
+		object->isInstanceOf( IECore::MeshPrimitiveTypeId ) ||
+		object->isInstanceOf( IECore::CurvesPrimitiveTypeId ) ||
+		object->isInstanceOf( IECore::PointsPrimitiveTypeId )
+	;
+}
+
+IECore::ConstRunTimeTypedPtr CachedConverter::convertAsync( const IECore::Object *object, bool &ready )
+{
+	if( !asyncConvertible( object ) )
+	{
+		ready = true;
+		return convert( object );
+	}
+
+	CacheKey key( object );
+
+	tbb::mutex::scoped_lock lock( m_data->pendingMutex );
+
+	// we check the cache while holding the lock, so that processPending()
+	// can't move a completed conversion from pending into the cache while
+	// we're not looking.
+	if( m_data->cache.cached( key ) )
+	{
+		lock.release();
+		ready = true;
+		return m_data->cache.get( key );
+	}
+
+	ready = false;
+
+	MemberData::PendingMap::iterator it = m_data->pending.find( key.hash );
+	if( it != m_data->pending.end() )
+	{
+		return it->second.placeholder;
+	}
+
+	MemberData::PendingConversion &pendingConversion = m_data->pending[key.hash];
+	pendingConversion.placeholder = new BoxPrimitive( static_cast<const IECore::VisibleRenderable *>( object )->bound() );
+
+	m_data->taskStarted();
+	MemberData::ConversionTask *task = new( tbb::task::allocate_root() ) MemberData::ConversionTask( m_data, object, key.hash );
+	tbb::task::enqueue( *task );
+
+	return pendingConversion.placeholder;
+}
+
+size_t CachedConverter::processPending( size_t maxMemory )
+{
+	tbb::mutex::scoped_lock lock( m_data->pendingMutex );
+
+	std::vector<IECore::ConstRunTimeTypedPtr> transferred;
+	size_t result = 0;
+	size_t memory = 0;
+	std::vector<IECore::MurmurHash>::iterator it, eIt;
+	for( it = m_data->completed.begin(), eIt = m_data->completed.end(); it != eIt; ++it )
+	{
+		MemberData::PendingMap::iterator pIt = m_data->pending.find( *it );
+		assert( pIt != m_data->pending.end() && pIt->second.complete );
+
+		if( it != m_data->completed.begin() && memory + pIt->second.cost > maxMemory )
+		{
+			break;
+		}
+
+		if( pIt->second.result )
+		{
+			m_data->cache.set( CacheKey( *it ), pIt->second.result, pIt->second.cost );
+			transferred.push_back( pIt->second.result );
+			result++;
+		}
+		else
+		{
+			// the failure has already been reported by the task. we cache
+			// the placeholder in place of the result, so that we don't
+			// retry the conversion and report the error again every time
+			// convertAsync() is called for the same object.
+			m_data->cache.set( CacheKey( *it ), pIt->second.placeholder, sizeof( BoxPrimitive ) );
+		}
+
+		memory += pIt->second.cost;
+		m_data->pending.erase( pIt );
+	}
+
+	m_data->completed.erase( m_data->completed.begin(), it );
+	lock.release();
+
+	// this is the gpu half of the conversion. we create the vertex buffers
+	// for the attributes used by the standard vertex shader now, within the
+	// memory budget above, rather than stalling the first render. buffers
+	// are shared via the default CachedConverter, so the temporary setup can
+	// be discarded, and any further attributes required by custom shaders will
+	// be created on demand as usual.
+	for( std::vector<IECore::ConstRunTimeTypedPtr>::const_iterator tIt = transferred.begin(), tEIt = transferred.end(); tIt != tEIt; ++tIt )
+	{
+		if( const Primitive *primitive = IECore::runTimeCast<const Primitive>( tIt->get() ) )
+		{
+			Shader::SetupPtr setup = new Shader::Setup( Shader::facingRatio() );
+			primitive->addPrimitiveVariablesToShaderSetup( setup.get() );
+		}
+	}
+
+	return result;
+}
+
+size_t CachedConverter::numPending() const
+{
+	tbb::mutex::scoped_lock lock( m_data->pendingMutex );
+	return m_data->pending.size();
+}
+
 size_t CachedConverter::getMaxMemory() const
 {
 	return m_data->cache.getMaxCost();
@@ -151,6 +390,12 @@ void CachedConverter::setMaxMemory( size_t maxMemory )
 	clearUnused();
 }
 
+void CachedConverter::clear()
+{
+	m_data->cache.clear();
+	clearUnused();
+}
+
 void CachedConverter::clearUnused()
 {
 	m_data->deferredRemovals.clear();
@@ -37,11 +37,9 @@
 #include "boost/format.hpp"
 
 #include "IECore/MeshPrimitive.h"
-#include "IECore/TriangulateOp.h"
-#include "IECore/MeshNormalsOp.h"
+#include "IECore/MeshAlgo.h"
 #include "IECore/DespatchTypedData.h"
 #include "IECore/MessageHandler.h"
-#include "IECore/FaceVaryingPromotionOp.h"
 
 #include "IECoreGL/ToGLMeshConverter.h"
 #include "IECoreGL/MeshPrimitive.h"
@@ -64,37 +62,17 @@ ToGLMeshConverter::~ToGLMeshConverter()
 
 IECore::RunTimeTypedPtr ToGLMeshConverter::doConversion( IECore::ConstObjectPtr src, IECore::ConstCompoundObjectPtr operands ) const
 {
-	IECore::MeshPrimitivePtr mesh = boost::static_pointer_cast<IECore::MeshPrimitive>( src->copy() ); // safe because the parameter validated it for us
+	IECore::ConstMeshPrimitivePtr srcMesh = boost::static_pointer_cast<const IECore::MeshPrimitive>( src ); // safe because the parameter validated it for us
 	
-	if( !mesh->variableData<IECore::V3fVectorData>( "P", IECore::PrimitiveVariable::Vertex ) )
+	if( !srcMesh->variableData<IECore::V3fVectorData>( "P", IECore::PrimitiveVariable::Vertex ) )
 	{
 		throw IECore::Exception( "Must specify primitive variable \"P\", of type V3fVectorData and interpolation type Vertex." );
 	}
 
-	if( mesh->variables.find( "N" )==mesh->variables.end() )
-	{
-		// the mesh has no normals - we need to explicitly add some. if it's a polygon
-		// mesh (interpolation==linear) then we add per-face normals for a faceted look
-		// and if it's a subdivision mesh we add smooth per-vertex normals.
-		IECore::MeshNormalsOpPtr normalOp = new IECore::MeshNormalsOp();
-		normalOp->inputParameter()->setValue( mesh );
-		normalOp->copyParameter()->setTypedValue( false );
-		normalOp->interpolationParameter()->setNumericValue(
-			mesh->interpolation() == "linear" ? IECore::PrimitiveVariable::Uniform : IECore::PrimitiveVariable::Vertex
-		);
-		normalOp->operate();
-	}
-	
-	IECore::TriangulateOpPtr op = new IECore::TriangulateOp();
-	op->inputParameter()->setValue( mesh );
-	op->throwExceptionsParameter()->setTypedValue( false ); // it's better to see something than nothing
-	op->copyParameter()->setTypedValue( false );
-	op->operate();
-
-	IECore::FaceVaryingPromotionOpPtr faceVaryingOp = new IECore::FaceVaryingPromotionOp;
-	faceVaryingOp->inputParameter()->setValue( mesh );
-	faceVaryingOp->copyParameter()->setTypedValue( false );
-	faceVaryingOp->operate();
+	// triangulate, add normals if they're missing and promote everything to facevarying
+	// all in one go. if it's a polygon mesh (interpolation==linear) the normals are per-face
+	// for a faceted look and if it's a subdivision mesh they're smooth per-vertex normals.
+	IECore::MeshPrimitivePtr mesh = IECore::MeshAlgo::triangulateAndPromote( srcMesh.get() );
 
 	MeshPrimitivePtr glMesh = new MeshPrimitive( mesh->vertexIds() );
 
@@ -50,13 +50,36 @@ static IECore::RunTimeTypedPtr convert( CachedConverter &c, IECore::ObjectPtr o
 	return boost::const_pointer_cast<IECore::RunTimeTyped>( c.convert( o.get() ) );
 }
 
+static tuple convertAsync( CachedConverter &c, IECore::ObjectPtr o )
+{
+	bool ready = false;
+	IECore::RunTimeTypedPtr result;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		result = boost::const_pointer_cast<IECore::RunTimeTyped>( c.convertAsync( o.get(), ready ) );
+	}
+	return make_tuple( result, ready );
+}
+
+static size_t processPending( CachedConverter &c, size_t maxMemory )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return c.processPending( maxMemory );
+}
+
 void IECoreGL::bindCachedConverter()
 {
 	IECorePython::RefCountedClass<CachedConverter, IECore::RefCounted>( "CachedConverter" )
 		.def( init<size_t>() )
 		.def( "convert", &convert )
+		.def( "asyncConvertible", &CachedConverter::asyncConvertible )
+		.staticmethod( "asyncConvertible" )
+		.def( "convertAsync", &convertAsync )
+		.def( "processPending", &processPending, ( arg( "maxMemory" ) = 64 * 1024 * 1024 ) )
+		.def( "numPending", &CachedConverter::numPending )
 		.def( "getMaxMemory", &CachedConverter::getMaxMemory )
 		.def( "setMaxMemory", &CachedConverter::setMaxMemory )
+		.def( "clear", &CachedConverter::clear )
 		.def( "clearUnused", &CachedConverter::clearUnused )
 		.def( "defaultCachedConverter", &CachedConverter::defaultCachedConverter, return_value_policy<IECorePython::CastToIntrusivePtr>() )
 		.staticmethod( "defaultCachedConverter" )
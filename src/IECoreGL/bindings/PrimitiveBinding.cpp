@@ -51,6 +51,7 @@ void bindPrimitive()
 {
 	scope s = IECorePython::RunTimeTypedClass<Primitive>()
 		.def( "addPrimitiveVariable", &Primitive::addPrimitiveVariable )
+		.def( "bound", &Primitive::bound )
 	;
 	bindTypedStateComponent< Primitive::DrawBound >( "DrawBound" );
 	bindTypedStateComponent< Primitive::DrawWireframe >( "DrawWireframe" );
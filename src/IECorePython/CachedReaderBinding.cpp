@@ -35,6 +35,7 @@
 // This include needs to be the very first to prevent problems with warnings
 // regarding redefinition of _POSIX_C_SOURCE
 #include "boost/python.hpp"
+#include "boost/python/make_constructor.hpp"
 
 #include "IECore/CachedReader.h"
 #include "IECore/Object.h"
@@ -42,6 +43,7 @@
 #include "IECorePython/CachedReaderBinding.h"
 #include "IECorePython/RefCountedBinding.h"
 #include "IECorePython/ScopedGILRelease.h"
+#include "IECorePython/ScopedGILLock.h"
 
 using namespace boost::python;
 using namespace IECore;
@@ -63,16 +65,45 @@ static ObjectPtr read( CachedReader &r, const std::string &f )
 	}
 }
 
+struct PostProcessorCreator
+{
+
+	PostProcessorCreator( object fn )
+		:	m_fn( fn )
+	{
+	}
+
+	ModifyOpPtr operator()()
+	{
+		ScopedGILLock gilLock;
+		ModifyOpPtr result = extract<ModifyOpPtr>( m_fn() );
+		return result;
+	}
+
+	private :
+
+		object m_fn;
+
+};
+
+static CachedReaderPtr constructWithPostProcessorCreator( const SearchPath &paths, ObjectPoolPtr objectPool, object postProcessorCreator )
+{
+	return new CachedReader( paths, objectPool, PostProcessorCreator( postProcessorCreator ) );
+}
+
 void bindCachedReader()
 {
 	RefCountedClass<CachedReader, RefCounted>( "CachedReader" )
 		.def( init<const SearchPath &, optional<ObjectPoolPtr> >() )
 		.def( init<const SearchPath &, ConstModifyOpPtr, optional<ObjectPoolPtr> >() )
+		.def( "__init__", make_constructor( &constructWithPostProcessorCreator, default_call_policies(), ( boost::python::arg_( "searchPath" ), boost::python::arg_( "objectPool" ), boost::python::arg_( "postProcessorCreator" ) ) ) )
 		.def( "read", &read )
 		.def( "clear", (void (CachedReader::*)( const std::string &) )&CachedReader::clear )
 		.def( "clear", (void (CachedReader::*)( void ) )&CachedReader::clear )
 		.def( "insert", &CachedReader::insert )
 		.def( "cached", &CachedReader::cached )
+		.def( "setErrorTimeToLive", &CachedReader::setErrorTimeToLive )
+		.def( "getErrorTimeToLive", &CachedReader::getErrorTimeToLive )
 		.add_property( "searchPath", make_function( &CachedReader::getSearchPath, return_value_policy<copy_const_reference>() ), &CachedReader::setSearchPath )
 		.def( "defaultCachedReader", &CachedReader::defaultCachedReader, return_value_policy<CastToIntrusivePtr>() ).staticmethod( "defaultCachedReader" )
 		.def( "objectPool", &CachedReader::objectPool, return_value_policy<CastToIntrusivePtr>() )
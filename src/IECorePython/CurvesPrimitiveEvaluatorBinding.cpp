@@ -36,7 +36,10 @@
 
 #include "IECore/CurvesPrimitiveEvaluator.h"
 #include "IECore/CurvesPrimitive.h"
+#include "IECore/Exception.h"
+#include "IECore/VectorTypedData.h"
 #include "IECorePython/CurvesPrimitiveEvaluatorBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 #include "IECorePython/RunTimeTypedBinding.h"
 #include "IECorePython/RefCountedBinding.h"
 
@@ -53,6 +56,35 @@ static bool pointAtV( const CurvesPrimitiveEvaluator &e, unsigned curveIndex, fl
 	return e.pointAtV( curveIndex, v, r );
 }
 
+static tuple pointsAtV( const CurvesPrimitiveEvaluator &e, const UIntVectorData *curveIndices, const FloatVectorData *v )
+{
+	V3fVectorDataPtr points = new V3fVectorData;
+	V3fVectorDataPtr vTangents = new V3fVectorData;
+	bool valid;
+	{
+		ScopedGILRelease gilRelease;
+		valid = e.pointsAtV( curveIndices->readable(), v->readable(), points->writable(), &vTangents->writable() );
+	}
+
+	if( !valid )
+	{
+		throw InvalidArgumentException( "CurvesPrimitiveEvaluator.pointsAtV : Invalid curve index or v value." );
+	}
+
+	return make_tuple( points, vTangents );
+}
+
+static tuple closestPoints( const CurvesPrimitiveEvaluator &e, const V3fVectorData *points )
+{
+	UIntVectorDataPtr curveIndices = new UIntVectorData;
+	FloatVectorDataPtr v = new FloatVectorData;
+	{
+		ScopedGILRelease gilRelease;
+		e.closestPoints( points->readable(), curveIndices->writable(), v->writable() );
+	}
+	return make_tuple( curveIndices, v );
+}
+
 static IntVectorDataPtr verticesPerCurve( const CurvesPrimitiveEvaluator &e )
 {
 	return new IntVectorData( e.verticesPerCurve() );
@@ -73,6 +105,8 @@ void bindCurvesPrimitiveEvaluator()
 	scope s = RunTimeTypedClass<CurvesPrimitiveEvaluator>()
 		.def( init<CurvesPrimitivePtr>() )
 		.def( "pointAtV", &pointAtV )
+		.def( "pointsAtV", &pointsAtV, ( arg( "curveIndices" ), arg( "v" ) ) )
+		.def( "closestPoints", &closestPoints, ( arg( "points" ) ) )
 		.def( "curveLength", &CurvesPrimitiveEvaluator::curveLength,
 			(
 				arg( "curveIndex" ),
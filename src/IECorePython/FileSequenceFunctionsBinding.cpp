@@ -79,12 +79,12 @@ struct FileSequenceFunctionsHelper
 		return result;
 	}
 
-	static object ls( const std::string &path, size_t minSequenceSize = 2 )
+	static object ls( const std::string &path, size_t minSequenceSize = 2, bool useCache = false )
 	{
 		if ( boost::regex_match( path, FileSequence::fileNameValidator() ) )
 		{
 			FileSequencePtr sequence = 0;
-			IECore::ls( path, sequence, minSequenceSize );
+			IECore::ls( path, sequence, minSequenceSize, useCache );
 
 			if ( sequence )
 			{
@@ -95,7 +95,7 @@ struct FileSequenceFunctionsHelper
 		{
 			list result;
 			std::vector< FileSequencePtr > sequences;
-			IECore::ls( path, sequences, minSequenceSize );
+			IECore::ls( path, sequences, minSequenceSize, useCache );
 			for ( std::vector< FileSequencePtr >::const_iterator it = sequences.begin(); it != sequences.end(); ++it )
 			{
 				result.append( *it );
@@ -129,7 +129,7 @@ struct FileSequenceFunctionsHelper
 void bindFileSequenceFunctions()
 {
 	def( "findSequences", &FileSequenceFunctionsHelper::findSequences, ( arg_("namesList"), arg_( "minSequenceSize" ) = 2 ) );
-	def( "ls", &FileSequenceFunctionsHelper::ls, ( arg_("path"), arg_( "minSequenceSize" ) = 2 ) );
+	def( "ls", &FileSequenceFunctionsHelper::ls, ( arg_("path"), arg_( "minSequenceSize" ) = 2, arg_( "useCache" ) = false ) );
 	def( "frameListFromList", &FileSequenceFunctionsHelper::frameListFromList );
 }
 
@@ -0,0 +1,124 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+
+#include "IECore/ImageCache.h"
+
+#include "IECorePython/ImageCacheBinding.h"
+#include "IECorePython/RefCountedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+using namespace boost::python;
+using namespace Imath;
+using namespace IECore;
+
+namespace IECorePython
+{
+
+static Box2i dataWindow( ImageCache &cache, const std::string &fileName )
+{
+	ScopedGILRelease gilRelease;
+	return cache.dataWindow( fileName );
+}
+
+static Box2i displayWindow( ImageCache &cache, const std::string &fileName )
+{
+	ScopedGILRelease gilRelease;
+	return cache.displayWindow( fileName );
+}
+
+static list channelNames( ImageCache &cache, const std::string &fileName )
+{
+	std::vector<std::string> names;
+	{
+		ScopedGILRelease gilRelease;
+		cache.channelNames( fileName, names );
+	}
+
+	list result;
+	for( std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
+static float samplePixel( ImageCache &cache, const std::string &fileName, const std::string &channelName, int x, int y )
+{
+	ScopedGILRelease gilRelease;
+	return cache.sample( fileName, channelName, x, y );
+}
+
+static float samplePosition( ImageCache &cache, const std::string &fileName, const std::string &channelName, const V2f &p )
+{
+	ScopedGILRelease gilRelease;
+	return cache.sample( fileName, channelName, p );
+}
+
+static FloatVectorDataPtr readRegion( ImageCache &cache, const std::string &fileName, const std::string &channelName, const Box2i &region )
+{
+	ScopedGILRelease gilRelease;
+	return cache.readRegion( fileName, channelName, region );
+}
+
+static ImageCachePtr defaultImageCache()
+{
+	ScopedGILRelease gilRelease;
+	return ImageCache::defaultImageCache();
+}
+
+void bindImageCache()
+{
+	RefCountedClass<ImageCache, RefCounted>( "ImageCache" )
+		.def( init<size_t, size_t, int>( ( arg( "maxMemory" ), arg( "maxOpenFiles" ) = 100, arg( "tileSize" ) = 64 ) ) )
+		.def( "getTileSize", &ImageCache::getTileSize )
+		.def( "setMaxMemoryUsage", &ImageCache::setMaxMemoryUsage )
+		.def( "getMaxMemoryUsage", &ImageCache::getMaxMemoryUsage )
+		.def( "memoryUsage", &ImageCache::memoryUsage )
+		.def( "setMaxOpenFiles", &ImageCache::setMaxOpenFiles )
+		.def( "getMaxOpenFiles", &ImageCache::getMaxOpenFiles )
+		.def( "clear", &ImageCache::clear )
+		.def( "dataWindow", &dataWindow )
+		.def( "displayWindow", &displayWindow )
+		.def( "channelNames", &channelNames )
+		.def( "sample", &samplePixel )
+		.def( "sample", &samplePosition )
+		.def( "readRegion", &readRegion )
+		.def( "defaultImageCache", &defaultImageCache )
+		.staticmethod( "defaultImageCache" )
+	;
+}
+
+} // namespace IECorePython
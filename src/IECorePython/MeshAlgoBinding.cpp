@@ -35,8 +35,10 @@
 #include "boost/python.hpp"
 
 #include "IECore/MeshAlgo.h"
+#include "IECore/VectorTypedData.h"
 #include "IECorePython/MeshAlgoBinding.h"
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 using namespace boost::python;
 using namespace IECore;
@@ -73,6 +75,25 @@ struct StdPairToTupleConverter
 	}
 };
 
+MeshPrimitivePtr merge( const boost::python::list &meshes, bool removeNonMatchingPrimVars, V2iVectorDataPtr faceRanges )
+{
+	std::vector<const MeshPrimitive *> m;
+	const int numMeshes = boost::python::len( meshes );
+	for( int i = 0; i < numMeshes; ++i )
+	{
+		m.push_back( extract<const MeshPrimitive *>( meshes[i] ) );
+	}
+
+	IECorePython::ScopedGILRelease gilRelease;
+	return MeshAlgo::merge( m, removeNonMatchingPrimVars, faceRanges ? &faceRanges->writable() : 0 );
+}
+
+MeshPrimitivePtr triangulateAndPromote( const MeshPrimitive *mesh, bool addMissingNormals )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return MeshAlgo::triangulateAndPromote( mesh, addMissingNormals );
+}
+
 } // namespace anonymous
 
 namespace IECorePython
@@ -88,6 +109,8 @@ void bindMeshAlgo()
 	StdPairToTupleConverter<IECore::PrimitiveVariable, IECore::PrimitiveVariable>();
 
 	def( "calculateTangents", &MeshAlgo::calculateTangents, ( arg_( "uvSet" ) = "st", arg_( "orthoTangents" ) = true, arg_( "position" ) = "P" ) );
+	def( "merge", &merge, ( arg_( "meshes" ), arg_( "removeNonMatchingPrimVars" ) = false, arg_( "faceRanges" ) = object() ) );
+	def( "triangulateAndPromote", &triangulateAndPromote, ( arg_( "mesh" ), arg_( "addMissingNormals" ) = true ) );
 }
 
 } // namespace IECorePython
@@ -35,7 +35,9 @@
 #include "boost/python.hpp"
 
 #include "IECore/MeshPrimitiveEvaluator.h"
+#include "IECore/VectorTypedData.h"
 #include "IECorePython/MeshPrimitiveEvaluatorBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 #include "IECorePython/RunTimeTypedBinding.h"
 #include "IECorePython/RefCountedBinding.h"
 
@@ -52,11 +54,24 @@ static bool barycentricPosition( const MeshPrimitiveEvaluator &e, unsigned int t
 	return e.barycentricPosition( t, b, r );
 }
 
+static tuple intersectRays( const MeshPrimitiveEvaluator &e, const V3fVectorData *origins, const V3fVectorData *directions, float maxDistance )
+{
+	FloatVectorDataPtr distances = new FloatVectorData;
+	IntVectorDataPtr triangleIndices = new IntVectorData;
+	V3fVectorDataPtr barycentricCoordinates = new V3fVectorData;
+	{
+		ScopedGILRelease gilRelease;
+		e.intersectRays( origins->readable(), directions->readable(), distances->writable(), triangleIndices->writable(), barycentricCoordinates->writable(), maxDistance );
+	}
+	return make_tuple( distances, triangleIndices, barycentricCoordinates );
+}
+
 void bindMeshPrimitiveEvaluator()
 {
 	object m = RunTimeTypedClass<MeshPrimitiveEvaluator>()
 		.def( init< MeshPrimitivePtr > () )
 		.def( "barycentricPosition", &barycentricPosition )
+		.def( "intersectRays", &intersectRays, ( arg( "origins" ), arg( "directions" ), arg( "maxDistance" ) = Imath::limits<float>::max() ) )
 		.def( "uvBound", &MeshPrimitiveEvaluator::uvBound )	
 	;
 
@@ -40,9 +40,11 @@
 #include "IECore/CompoundMessageHandler.h"
 #include "IECore/FilteredMessageHandler.h"
 #include "IECore/LevelFilteredMessageHandler.h"
+#include "IECore/AsyncMessageHandler.h"
 #include "IECorePython/MessageHandlerBinding.h"
 #include "IECorePython/RefCountedBinding.h"
 #include "IECorePython/ScopedGILLock.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 using namespace boost::python;
 using namespace IECore;
@@ -90,6 +92,46 @@ LevelFilteredMessageHandlerPtr levelFilteredMessageHandlerConstructor(MessageHan
 	return new LevelFilteredMessageHandler( handle, level );
 }
 
+// The last reference to a handler created in Python is usually released
+// with the GIL held, and the base class destructor waits for the output
+// thread to finish. If the downstream handler needs the GIL to output the
+// queued messages, that would deadlock, so we flush with the GIL released
+// first. Nothing else can queue messages once the last reference is gone,
+// so the base class then has nothing left to output.
+class PythonAsyncMessageHandler : public AsyncMessageHandler
+{
+
+	public :
+
+		PythonAsyncMessageHandler( MessageHandlerPtr handler, size_t maxQueueSize, size_t maxRepeats, double repeatWindow )
+			:	AsyncMessageHandler( handler, maxQueueSize, maxRepeats, repeatWindow )
+		{
+		}
+
+		virtual ~PythonAsyncMessageHandler()
+		{
+			// We may or may not hold the GIL already, so we make
+			// sure of it before releasing it.
+			ScopedGILLock gilLock;
+			ScopedGILRelease gilRelease;
+			flush();
+		}
+
+};
+
+AsyncMessageHandlerPtr asyncMessageHandlerConstructor( MessageHandlerPtr handler, size_t maxQueueSize, size_t maxRepeats, double repeatWindow )
+{
+	return new PythonAsyncMessageHandler( handler, maxQueueSize, maxRepeats, repeatWindow );
+}
+
+void asyncMessageHandlerFlush( AsyncMessageHandler &h )
+{
+	// The downstream handler may need the GIL to output
+	// the queued messages.
+	ScopedGILRelease gilRelease;
+	h.flush();
+}
+
 } // namespace
 
 void IECorePython::bindMessageHandler()
@@ -141,6 +183,13 @@ void IECorePython::bindMessageHandler()
 		.def( "defaultLevel", &LevelFilteredMessageHandler::defaultLevel ).staticmethod( "defaultLevel" )
 	;
 
+	RefCountedClass<AsyncMessageHandler, FilteredMessageHandler>( "AsyncMessageHandler" )
+		.def( "__init__", make_constructor( &asyncMessageHandlerConstructor, default_call_policies(), ( boost::python::arg_( "handler" ), boost::python::arg_( "maxQueueSize" ) = 10000, boost::python::arg_( "maxRepeats" ) = 10, boost::python::arg_( "repeatWindow" ) = 10.0 ) ) )
+		.def( "flush", &asyncMessageHandlerFlush )
+		.def( "numDropped", &AsyncMessageHandler::numDropped )
+		.def( "numCoalesced", &AsyncMessageHandler::numCoalesced )
+	;
+
 	scope mhS( mh );
 
 	enum_<MessageHandler::Level>( "Level" )
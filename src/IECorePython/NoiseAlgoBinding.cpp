@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+
+#include "IECore/NoiseAlgo.h"
+#include "IECorePython/NoiseAlgoBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+using namespace boost::python;
+using namespace Imath;
+using namespace IECore;
+
+namespace
+{
+
+void displaceNoise( V3fVectorData *points, const PerlinNoiseV3fV3f &noise, float frequency, const V3f &amplitude )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	NoiseAlgo::displace( points, noise, frequency, amplitude );
+}
+
+void displaceTurbulence( V3fVectorData *points, const TurbulenceV3fV3f &turbulence, float frequency, const V3f &amplitude )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	NoiseAlgo::displace( points, turbulence, frequency, amplitude );
+}
+
+} // namespace
+
+namespace IECorePython
+{
+
+void bindNoiseAlgo()
+{
+	object noiseAlgoModule( borrowed( PyImport_AddModule( "IECore.NoiseAlgo" ) ) );
+	scope().attr( "NoiseAlgo" ) = noiseAlgoModule;
+
+	scope noiseAlgoScope( noiseAlgoModule );
+
+	def( "displace", &displaceNoise, ( arg_( "points" ), arg_( "noise" ), arg_( "frequency" ) = 1.0f, arg_( "amplitude" ) = V3f( 1.0f ) ) );
+	def( "displace", &displaceTurbulence, ( arg_( "points" ), arg_( "turbulence" ), arg_( "frequency" ) = 1.0f, arg_( "amplitude" ) = V3f( 1.0f ) ) );
+}
+
+} // namespace IECorePython
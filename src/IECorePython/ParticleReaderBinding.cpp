@@ -60,6 +60,8 @@ void bindParticleReader()
 		.def( "numParticles", &ParticleReader::numParticles )
 		.def( "attributeNames", &attributeNames )
 		.def( "readAttribute", &ParticleReader::readAttribute )
+		.def( "readAttributeChunk", &ParticleReader::readAttributeChunk, ( arg_( "name" ), arg_( "firstParticle" ), arg_( "numParticles" ) ) )
+		.def( "readChunk", &ParticleReader::readChunk, ( arg_( "firstParticle" ), arg_( "numParticles" ) ) )
 	;
 }
 
@@ -57,9 +57,9 @@ static typename TypedData<vector<typename T::Value> >::Ptr noiseVector( const T
 	vector<typename T::Value> &vv = v->writable();
 	const vector<typename T::Point> &pp = p->readable();
 	vv.resize( pp.size() );
-	for( typename vector<typename T::Point>::size_type i=0; i<pp.size(); i++ )
+	if( pp.size() )
 	{
-		vv[i] = n.noise( pp[i] );
+		n.noise( &pp[0], &vv[0], pp.size() );
 	}
 	return v;
 }
@@ -0,0 +1,152 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+#include "boost/shared_ptr.hpp"
+
+#include <sstream>
+
+#include "IECore/Profiler.h"
+
+#include "IECorePython/ProfilerBinding.h"
+
+using namespace boost::python;
+using namespace IECore;
+
+namespace IECorePython
+{
+
+namespace
+{
+
+// Python context manager for Profiler::Scope, so that Python
+// code can be instrumented with :
+//
+// with IECore.Profiler.Scope( "name" ) :
+//     ...
+//
+// Unlike IECORE_PROFILE_SCOPE, this records regardless of
+// whether or not IECore was built with profiling instrumentation.
+class ScopeWrapper
+{
+
+	public :
+
+		ScopeWrapper( const std::string &name )
+			:	m_name( name )
+		{
+		}
+
+		void enter()
+		{
+			m_scope.reset( new Profiler::Scope( m_name ) );
+		}
+
+		bool exit( object excType, object excValue, object excTraceBack )
+		{
+			m_scope.reset();
+			return false; // don't suppress exceptions
+		}
+
+	private :
+
+		// InternedString, so that the name remains valid
+		// for as long as the Profiler needs it.
+		InternedString m_name;
+		boost::shared_ptr<Profiler::Scope> m_scope;
+
+};
+
+void writeChromeTrace( const std::string &fileName )
+{
+	Profiler::writeChromeTrace( fileName );
+}
+
+dict statistics()
+{
+	Profiler::StatisticsVector s;
+	Profiler::statistics( s );
+
+	dict result;
+	for( Profiler::StatisticsVector::const_iterator it = s.begin(), eIt = s.end(); it != eIt; ++it )
+	{
+		dict d;
+		d["count"] = it->count;
+		d["totalTime"] = it->totalTime;
+		d["selfTime"] = it->selfTime;
+		d["maxTime"] = it->maxTime;
+		result[it->name] = d;
+	}
+	return result;
+}
+
+std::string summary()
+{
+	std::ostringstream o;
+	Profiler::writeSummary( o );
+	return o.str();
+}
+
+} // namespace
+
+void bindProfiler()
+{
+	scope s = class_<Profiler, boost::noncopyable>( "Profiler", no_init )
+		.def( "setEnabled", &Profiler::setEnabled )
+		.staticmethod( "setEnabled" )
+		.def( "getEnabled", &Profiler::getEnabled )
+		.staticmethod( "getEnabled" )
+		.def( "clear", &Profiler::clear )
+		.staticmethod( "clear" )
+		.def( "setMaxEvents", &Profiler::setMaxEvents )
+		.staticmethod( "setMaxEvents" )
+		.def( "getMaxEvents", &Profiler::getMaxEvents )
+		.staticmethod( "getMaxEvents" )
+		.def( "numDroppedEvents", &Profiler::numDroppedEvents )
+		.staticmethod( "numDroppedEvents" )
+		.def( "writeChromeTrace", &writeChromeTrace )
+		.staticmethod( "writeChromeTrace" )
+		.def( "statistics", &statistics )
+		.staticmethod( "statistics" )
+		.def( "summary", &summary )
+		.staticmethod( "summary" )
+	;
+
+	class_<ScopeWrapper, boost::noncopyable>( "Scope", init<const std::string &>() )
+		.def( "__enter__", &ScopeWrapper::enter )
+		.def( "__exit__", &ScopeWrapper::exit )
+	;
+}
+
+} // namespace IECorePython
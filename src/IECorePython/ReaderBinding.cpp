@@ -117,9 +117,9 @@ struct ReaderCanRead
 
 };
 
-static void registerReader( const std::string &extensions, object &canRead, object &creator, TypeId typeId )
+static void registerReader( const std::string &extensions, object &canRead, object &creator, TypeId typeId, const std::string &magicNumbers )
 {
-	Reader::registerReader( extensions, ReaderCanRead( canRead ), ReaderCreator( creator ), typeId );
+	Reader::registerReader( extensions, ReaderCanRead( canRead ), ReaderCreator( creator ), typeId, magicNumbers );
 }
 
 class ReaderWrap : public Reader, public Wrapper<Reader>
@@ -185,7 +185,7 @@ void bindReader()
 {
 	using boost::python::arg;
 
-	RunTimeTypedClass<Reader, ReaderWrap>()
+	scope s = RunTimeTypedClass<Reader, ReaderWrap>()
 		.def( init<const std::string &>( ( arg( "description" ) ) ) )
 		.def( init<const std::string &, ParameterPtr>( ( arg( "description" ), arg( "resultParameter" ) ) ) )
 		.def( "readHeader", &Reader::readHeader )
@@ -195,8 +195,17 @@ void bindReader()
 		.def( "supportedExtensions", ( list(*)( ) ) &supportedExtensions )
 		.def( "supportedExtensions", ( list(*)( IECore::TypeId ) ) &supportedExtensions )
 		.staticmethod( "supportedExtensions" )
-		.def( "registerReader", &registerReader )
+		.def( "registerReader", &registerReader, ( arg( "extensions" ), arg( "canRead" ), arg( "creator" ), arg( "typeId" ), arg( "magicNumbers" ) = "" ) )
 		.staticmethod( "registerReader" )
+		.def( "createStatistics", &Reader::createStatistics ).staticmethod( "createStatistics" )
+		.def( "resetCreateStatistics", &Reader::resetCreateStatistics ).staticmethod( "resetCreateStatistics" )
+	;
+
+	class_<Reader::CreateStatistics>( "CreateStatistics" )
+		.def_readonly( "creates", &Reader::CreateStatistics::creates )
+		.def_readonly( "headerReads", &Reader::CreateStatistics::headerReads )
+		.def_readonly( "canReadCalls", &Reader::CreateStatistics::canReadCalls )
+		.def_readonly( "magicNumberMatches", &Reader::CreateStatistics::magicNumberMatches )
 	;
 }
 
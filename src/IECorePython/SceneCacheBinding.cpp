@@ -59,9 +59,18 @@ static SceneCachePtr constructor2( IECore::IndexedIOPtr indexedIO )
 
 void bindSceneCache()
 {
-	RunTimeTypedClass<SceneCache>()
+	scope s = RunTimeTypedClass<SceneCache>()
 		.def( "__init__", make_constructor( &constructor ), "Opens a scene file for read or write." )
 		.def( "__init__", make_constructor( &constructor2 ), "Opens a scene from a previously opened file handle." )
+		.def( "setPrimitiveVariableStorage", &SceneCache::setPrimitiveVariableStorage )
+		.def( "getPrimitiveVariableStorage", &SceneCache::getPrimitiveVariableStorage )
+	;
+
+	enum_<SceneCache::PrimitiveVariableStorage>( "PrimitiveVariableStorage" )
+		.value( "FullPrecision", SceneCache::FullPrecision )
+		.value( "HalfPrecision", SceneCache::HalfPrecision )
+		.value( "FixedPoint", SceneCache::FixedPoint )
+		.value( "Octahedral", SceneCache::Octahedral )
 	;
 }
 
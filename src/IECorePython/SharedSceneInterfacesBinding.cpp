@@ -56,6 +56,12 @@ void bindSharedSceneInterfaces()
 		.def( "get", nonConstGet ).staticmethod( "get" )
 		.def( "erase", SharedSceneInterfaces::erase ).staticmethod( "erase" )
 		.def( "clear", SharedSceneInterfaces::clear ).staticmethod( "clear" )
+		.def( "setMaxScenes", SharedSceneInterfaces::setMaxScenes ).staticmethod( "setMaxScenes" )
+		.def( "getMaxScenes", SharedSceneInterfaces::getMaxScenes ).staticmethod( "getMaxScenes" )
+		.def( "numScenes", SharedSceneInterfaces::numScenes ).staticmethod( "numScenes" )
+		.def( "numOpens", SharedSceneInterfaces::numOpens ).staticmethod( "numOpens" )
+		.def( "numReopens", SharedSceneInterfaces::numReopens ).staticmethod( "numReopens" )
+		.def( "resetStatistics", SharedSceneInterfaces::resetStatistics ).staticmethod( "resetStatistics" )
 	;
 }
 
@@ -39,6 +39,8 @@
 #include "IECorePython/SplineBinding.h"
 #include "IECorePython/IECoreBinding.h"
 #include "IECore/Spline.h"
+#include "IECore/BakedSpline.h"
+#include "IECore/VectorTypedData.h"
 
 using namespace boost::python;
 using namespace Imath;
@@ -193,6 +195,43 @@ static boost::python::tuple solve( const T &s, typename T::XType x )
 	return boost::python::make_tuple( t, boost::python::make_tuple( segment[0], segment[1], segment[2], segment[3] ) );
 }
 
+template<typename T>
+static typename TypedData<std::vector<typename T::YType> >::Ptr evaluate( const T &s, const TypedData<std::vector<typename T::XType> > *x )
+{
+	typename TypedData<std::vector<typename T::YType> >::Ptr result = new TypedData<std::vector<typename T::YType> >;
+	result->writable().resize( x->readable().size() );
+	if( x->readable().size() )
+	{
+		s.evaluate( &(x->readable()[0]), &(result->writable()[0]), x->readable().size() );
+	}
+	return result;
+}
+
+template<typename T>
+void bindBakedSpline( const char *name )
+{
+	class_<T, boost::shared_ptr<T> >( name, no_init )
+		.def(
+			init<const typename T::SplineType &, typename T::XType, size_t, size_t>(
+				(
+					arg( "spline" ),
+					arg( "tolerance" ) = typename T::XType( 1e-4 ),
+					arg( "minResolution" ) = 65,
+					arg( "maxResolution" ) = 65537
+				)
+			)
+		)
+		.def( "xMin", &T::xMin )
+		.def( "xMax", &T::xMax )
+		.def( "resolution", &T::resolution )
+		.def( "maxError", &T::maxError )
+		.def( "__call__", &T::operator() )
+		.def( "evaluate", &evaluate<T> )
+	;
+
+	register_ptr_to_python<boost::shared_ptr<const T> >();
+}
+
 template<typename T>
 void bindSpline( const char *name )
 {
@@ -218,6 +257,7 @@ void bindSpline( const char *name )
 		.def( "integral", (typename T::YType (T::*)() const )&T::integral )
 		.def( "integral", (typename T::YType (T::*)( typename T::XType, typename T::XType ) const )&T::integral )
 		.def( "derivative", &T::derivative )
+		.def( "evaluate", &evaluate<T> )
 	;
 }
 
@@ -227,6 +267,11 @@ void bindSpline()
 	bindSpline<Splinedd>( "Splinedd" );
 	bindSpline<SplinefColor3f>( "SplinefColor3f" );
 	bindSpline<SplinefColor4f>( "SplinefColor4f" );
+
+	bindBakedSpline<BakedSplineff>( "BakedSplineff" );
+	bindBakedSpline<BakedSplinedd>( "BakedSplinedd" );
+	bindBakedSpline<BakedSplinefColor3f>( "BakedSplinefColor3f" );
+	bindBakedSpline<BakedSplinefColor4f>( "BakedSplinefColor4f" );
 }
 
 }
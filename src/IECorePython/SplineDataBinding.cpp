@@ -83,6 +83,12 @@ static typename T::ValueType &getValue( T &that )
 	return that.writable();
 }
 
+template<class T>
+static boost::shared_ptr<const BakedSpline<typename T::ValueType::XType, typename T::ValueType::YType> > baked( const T &that )
+{
+	return bakedSpline( &that );
+}
+
 template< typename T >
 void bindSplineData()
 {
@@ -94,6 +100,7 @@ void bindSplineData()
 		.add_property( "value", make_function( &getValue<T>, return_internal_reference<>() ), &setValue<T> )
 		.def( "__repr__", &repr<T> )
 		.def( "hasBase", &T::hasBase ).staticmethod( "hasBase" )
+		.def( "bakedSpline", &baked<T>, "Returns a cached BakedSpline for fast evaluation of the spline." )
 	;
 }
 
@@ -35,15 +35,31 @@
 #include "boost/python.hpp"
 
 #include "IECore/Turbulence.h"
+#include "IECore/VectorTypedData.h"
 #include "IECorePython/TurbulenceBinding.h"
 
 using namespace boost;
 using namespace boost::python;
+using namespace std;
 using namespace IECore;
 
 namespace IECorePython
 {
 
+template<typename T>
+static typename TypedData<vector<typename T::Value> >::Ptr turbulenceVector( const T &t, typename TypedData<vector<typename T::Point> >::Ptr p )
+{
+	typename TypedData<vector<typename T::Value> >::Ptr v = new TypedData<vector<typename T::Value> >;
+	vector<typename T::Value> &vv = v->writable();
+	const vector<typename T::Point> &pp = p->readable();
+	vv.resize( pp.size() );
+	if( pp.size() )
+	{
+		t.turbulence( &pp[0], &vv[0], pp.size() );
+	}
+	return v;
+}
+
 template<typename T>
 void bindTurb( const char *name )
 {
@@ -57,6 +73,7 @@ void bindTurb( const char *name )
 			) )
 		.def( "turbulence", (typename T::Value (T::*)( const typename T::Point & ) const )&T::turbulence )
 		.def( "turbulence", (typename T::Value (T::*)( const typename T::Point &, typename T::PointBaseType ) const )&T::turbulence )
+		.def( "turbulenceVector", &turbulenceVector<T>, "Returns an array of turbulence values when given an array of points." )
 		.add_property( "octaves", &T::getOctaves, &T::setOctaves )
 		.add_property( "gain", make_function( &T::getGain, return_value_policy<copy_const_reference>() ), &T::setGain )
 		.add_property( "lacunarity", &T::getLacunarity, &T::setLacunarity )
@@ -302,6 +302,11 @@
 #include "IECorePython/ClippingPlaneBinding.h"
 #include "IECorePython/DataAlgoBinding.h"
 #include "IECorePython/MeshAlgoBinding.h"
+#include "IECorePython/CurvesAlgoBinding.h"
+#include "IECorePython/PointsAlgoBinding.h"
+#include "IECorePython/NoiseAlgoBinding.h"
+#include "IECorePython/ImageCacheBinding.h"
+#include "IECorePython/ProfilerBinding.h"
 #include "IECore/IECore.h"
 
 using namespace IECorePython;
@@ -598,6 +603,11 @@ BOOST_PYTHON_MODULE(_IECore)
 	bindClippingPlane();
 	bindDataAlgo();
 	bindMeshAlgo();
+	bindCurvesAlgo();
+	bindPointsAlgo();
+	bindNoiseAlgo();
+	bindImageCache();
+	bindProfiler();
 
 #ifdef IECORE_WITH_DEEPEXR
 
@@ -617,6 +627,7 @@ BOOST_PYTHON_MODULE(_IECore)
 	def( "withDeepEXR", &IECore::withDeepEXR );
 	def( "withFreeType", &IECore::withFreeType );
 	def( "withPNG", &IECore::withPNG );
+	def( "withProfiling", &IECore::withProfiling );
 	def( "initThreads", &PyEval_InitThreads );
 	def( "hardwareConcurrency", &tbb::tbb_thread::hardware_concurrency );
 
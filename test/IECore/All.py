@@ -255,6 +255,12 @@ from ExternalProceduralTest import ExternalProceduralTest
 from ClippingPlaneTest import ClippingPlaneTest
 from DataAlgoTest import DataAlgoTest
 from MeshAlgoTest import MeshAlgoTest
+from CurvesAlgoTest import CurvesAlgoTest
+from PointsAlgoTest import PointsAlgoTest
+from NoiseAlgoTest import NoiseAlgoTest
+from ImageCacheTest import ImageCacheTest
+from ProfilerTest import ProfilerTest
+from AsyncMessageHandlerTest import AsyncMessageHandlerTest
 from DisplayDriverServerTest import DisplayDriverServerTest
 
 if IECore.withDeepEXR() :
@@ -0,0 +1,192 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import time
+import unittest
+
+import IECore
+
+class AsyncMessageHandlerTest( unittest.TestCase ) :
+
+	def testOutput( self ) :
+
+		c = IECore.CapturingMessageHandler()
+		h = IECore.AsyncMessageHandler( c )
+
+		h.handle( IECore.Msg.Level.Error, "A", "AAA" )
+		h.handle( IECore.Msg.Level.Warning, "B", "BBB" )
+		h.flush()
+
+		self.assertEqual( len( c.messages ), 2 )
+		self.assertEqual( c.messages[0].level, IECore.Msg.Level.Error )
+		self.assertEqual( c.messages[0].context, "A" )
+		self.assertEqual( c.messages[0].message, "AAA" )
+		self.assertEqual( c.messages[1].level, IECore.Msg.Level.Warning )
+		self.assertEqual( c.messages[1].context, "B" )
+		self.assertEqual( c.messages[1].message, "BBB" )
+
+	def testCoalescing( self ) :
+
+		c = IECore.CapturingMessageHandler()
+		h = IECore.AsyncMessageHandler( c, maxRepeats = 2 )
+
+		for i in range( 0, 10 ) :
+			h.handle( IECore.Msg.Level.Warning, "A", "AAA" )
+		h.flush()
+
+		self.assertEqual( h.numCoalesced(), 8 )
+		self.assertEqual( h.numDropped(), 0 )
+		self.assertEqual( len( c.messages ), 3 )
+		self.assertEqual( c.messages[0].message, "AAA" )
+		self.assertEqual( c.messages[1].message, "AAA" )
+		self.assertEqual( c.messages[2].message, "AAA (repeated 8 more times)" )
+
+		# Repeat counts are reset by flush()
+		h.handle( IECore.Msg.Level.Warning, "A", "AAA" )
+		h.flush()
+		self.assertEqual( len( c.messages ), 4 )
+		self.assertEqual( c.messages[3].message, "AAA" )
+
+	def testNoCoalescing( self ) :
+
+		c = IECore.CapturingMessageHandler()
+		h = IECore.AsyncMessageHandler( c, maxRepeats = 0 )
+
+		for i in range( 0, 10 ) :
+			h.handle( IECore.Msg.Level.Warning, "A", "AAA" )
+		h.flush()
+
+		self.assertEqual( h.numCoalesced(), 0 )
+		self.assertEqual( len( c.messages ), 10 )
+
+	def testDropping( self ) :
+
+		c = IECore.CapturingMessageHandler()
+		h = IECore.AsyncMessageHandler( c, maxQueueSize = 1, maxRepeats = 0 )
+
+		for i in range( 0, 1000 ) :
+			h.handle( IECore.Msg.Level.Info, "A", str( i ) )
+		h.flush()
+
+		numDropped = h.numDropped()
+		self.assertGreater( numDropped, 0 )
+		self.assertEqual( len( c.messages ), 1000 - numDropped + 1 )
+		self.assertEqual( c.messages[-1].level, IECore.Msg.Level.Warning )
+		self.assertEqual( c.messages[-1].context, "AsyncMessageHandler" )
+		self.assertEqual( c.messages[-1].message, "%d messages were dropped because the queue was full" % numDropped )
+
+	def testInvalidQueueSize( self ) :
+
+		self.assertRaises( Exception, IECore.AsyncMessageHandler, IECore.NullMessageHandler(), 0 )
+
+	def testAsCurrentHandler( self ) :
+
+		c = IECore.CapturingMessageHandler()
+		h = IECore.AsyncMessageHandler( c )
+
+		with h :
+			IECore.msg( IECore.Msg.Level.Error, "A", "AAA" )
+
+		h.flush()
+		self.assertEqual( len( c.messages ), 1 )
+		self.assertEqual( c.messages[0].message, "AAA" )
+
+	def testRepeatWindow( self ) :
+
+		c = IECore.CapturingMessageHandler()
+		h = IECore.AsyncMessageHandler( c, maxRepeats = 1, repeatWindow = 0.1 )
+
+		def waitForMessages( n ) :
+			deadline = time.time() + 10
+			while len( c.messages ) < n :
+				self.failUnless( time.time() < deadline, "Timed out waiting for messages" )
+				time.sleep( 0.01 )
+
+		for i in range( 0, 3 ) :
+			h.handle( IECore.Msg.Level.Warning, "A", "AAA" )
+		waitForMessages( 1 )
+
+		# once the window has elapsed, the repeats are summarised
+		# and the message is output again, without needing a flush().
+		time.sleep( 0.2 )
+		h.handle( IECore.Msg.Level.Warning, "A", "AAA" )
+		waitForMessages( 3 )
+
+		self.assertEqual( [ m.message for m in c.messages ], [ "AAA", "AAA (repeated 2 more times)", "AAA" ] )
+
+		# repeats of a message which then stops are summarised when
+		# later messages are processed.
+		h.handle( IECore.Msg.Level.Warning, "A", "AAA" )
+		time.sleep( 0.2 )
+		h.handle( IECore.Msg.Level.Warning, "B", "BBB" )
+		waitForMessages( 5 )
+
+		self.assertEqual( [ m.message for m in c.messages[3:] ], [ "AAA (repeated 1 more times)", "BBB" ] )
+		self.assertEqual( h.numCoalesced(), 3 )
+
+	def testDestructionWithoutFlush( self ) :
+
+		c = IECore.CapturingMessageHandler()
+		h = IECore.AsyncMessageHandler( c )
+
+		for i in range( 0, 100 ) :
+			h.handle( IECore.Msg.Level.Info, "A", str( i ) )
+
+		del h
+
+		self.assertEqual( len( c.messages ), 100 )
+		self.assertEqual( c.messages[-1].message, "99" )
+
+	def testRepeatCountsAreBounded( self ) :
+
+		c = IECore.CapturingMessageHandler()
+		h = IECore.AsyncMessageHandler( c, maxQueueSize = 20000, maxRepeats = 1 )
+
+		h.handle( IECore.Msg.Level.Warning, "A", "AAA" )
+		h.handle( IECore.Msg.Level.Warning, "A", "AAA" )
+		for i in range( 0, 20000 ) :
+			h.handle( IECore.Msg.Level.Info, "B", str( i ) )
+		h.flush()
+
+		self.assertEqual( h.numDropped(), 0 )
+		self.assertEqual( len( c.messages ), 20002 )
+
+		# The summary should have been output when the number of distinct
+		# messages reached the limit, rather than waiting for flush().
+		summaries = [ i for i, m in enumerate( c.messages ) if m.message == "AAA (repeated 1 more times)" ]
+		self.assertEqual( len( summaries ), 1 )
+		self.assertLess( summaries[0], 20000 )
+
+if __name__ == "__main__":
+	unittest.main()
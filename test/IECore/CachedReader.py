@@ -34,6 +34,7 @@
 
 import unittest
 import threading
+import time
 
 from IECore import *
 import os
@@ -228,6 +229,55 @@ class CachedReaderTest( unittest.TestCase ) :
 		# it failed the first time
 		self.assertNotEqual( firstException, secondException )
 		
+	def testPostProcessorCreator( self ) :
+
+		created = []
+		def creator() :
+			op = TriangulateOp()
+			created.append( op )
+			return op
+
+		r = CachedReader( SearchPath( "./test/IECore/data/cobFiles", ":" ), ObjectPool(100 * 1024 * 1024), creator )
+		m = r.read( "polySphereQuads.cob" )
+		for v in m.verticesPerFace :
+			self.assertEqual( v, 3 )
+
+		# the post-processor should be reused for subsequent loads
+		r.clear()
+		m = r.read( "polySphereQuads.cob" )
+		for v in m.verticesPerFace :
+			self.assertEqual( v, 3 )
+
+		self.assertEqual( len( created ), 1 )
+
+	def testErrorTimeToLive( self ) :
+
+		def read( r ) :
+			try :
+				r.read( "iDontExist" )
+			except Exception, e :
+				return str( e )
+			self.fail( "Expected exception" )
+
+		r = CachedReader( SearchPath( "./", ":" ), ObjectPool(100 * 1024 * 1024) )
+		self.assertEqual( r.getErrorTimeToLive(), float( "inf" ) )
+
+		# with a time to live of 0, errors aren't remembered,
+		# so each attempt gives the original error.
+		r.setErrorTimeToLive( 0 )
+		self.assertEqual( r.getErrorTimeToLive(), 0 )
+		e1 = read( r )
+		e2 = read( r )
+		self.assertEqual( e1, e2 )
+
+		# with a time to live, errors are remembered
+		# until they expire.
+		r.setErrorTimeToLive( 0.5 )
+		self.assertEqual( read( r ), e1 )
+		self.assertNotEqual( read( r ), e1 )
+		time.sleep( 1 )
+		self.assertEqual( read( r ), e1 )
+
 	def testThreadingAndClear( self ) :
 		
 		# this tests a fix to the clear() method in the LRU cache,
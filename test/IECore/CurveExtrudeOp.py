@@ -58,6 +58,34 @@ class CurveExtrudeOpTest( unittest.TestCase ) :
 
 			self.assert_( child.arePrimitiveVariablesValid() )
 
+	def testSyntheticGroom( self ) :
+
+		rand = IECore.Rand32()
+
+		numCurves = 2000
+		p = IECore.V3fVectorData()
+		for c in range( 0, numCurves ) :
+			root = rand.nextV3f() * 10
+			for i in range( 0, 6 ) :
+				p.append( root + IECore.V3f( i * 0.1, 0, 0 ) + rand.nextV3f() * 0.01 )
+
+		curves = IECore.CurvesPrimitive( IECore.IntVectorData( [ 6 ] * numCurves ), IECore.CubicBasisf.catmullRom(), False, p )
+		curves["constantwidth"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Constant, IECore.FloatData( 0.02 ) )
+		curves["id"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Uniform, IECore.IntVectorData( range( 0, numCurves ) ) )
+
+		patchGroup = IECore.CurveExtrudeOp()( curves = curves, resolution = IECore.V2i( 6, 10 ) )
+		self.assertEqual( len( patchGroup.children() ), numCurves )
+
+		for i, child in enumerate( patchGroup.children() ) :
+
+			self.assert_( child.arePrimitiveVariablesValid() )
+			self.assertEqual( child["id"].data.value, i )
+
+			# the patches should be output in the same order as the curves,
+			# so the first ring should surround the second curve vertex.
+			ringCenter = sum( child["P"].data[0:6], IECore.V3f( 0 ) ) / 6
+			self.failUnless( ( ringCenter - p[i*6+1] ).length() < 0.05 )
+
 if __name__ == "__main__":
     unittest.main()
 
@@ -324,7 +324,53 @@ class CurveLineariserTest( unittest.TestCase ) :
 		)
 		
 		self.runTest( c )
-			
+
+	@staticmethod
+	def syntheticGroom( numCurves, basis = IECore.CubicBasisf.bSpline(), verticesPerCurve = 8 ) :
+
+		rand = IECore.Rand32()
+
+		p = IECore.V3fVectorData()
+		width = IECore.FloatVectorData()
+		for c in range( 0, numCurves ) :
+			root = rand.nextV3f() * 10
+			for i in range( 0, verticesPerCurve ) :
+				p.append( root + IECore.V3f( 0, i * 0.1, 0 ) + rand.nextV3f() * 0.05 )
+				width.append( 0.01 * ( 1.0 - float( i ) / verticesPerCurve ) )
+
+		curves = IECore.CurvesPrimitive( IECore.IntVectorData( [ verticesPerCurve ] * numCurves ), basis, False, p )
+		curves["width"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Vertex, width )
+		curves["Cs"] = IECore.PrimitiveVariable(
+			IECore.PrimitiveVariable.Interpolation.Varying,
+			IECore.Color3fVectorData( [ IECore.Color3f( rand.nextf() ) for i in range( 0, curves.variableSize( IECore.PrimitiveVariable.Interpolation.Varying ) ) ] )
+		)
+		curves["id"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Uniform, IECore.IntVectorData( range( 0, numCurves ) ) )
+
+		return curves
+
+	def testSyntheticGroom( self ) :
+
+		curves = self.syntheticGroom( 10000 )
+
+		curves2 = IECore.CurveLineariser()( input=curves, verticesPerSegment=10 )
+
+		self.assertEqual( curves2.numCurves(), curves.numCurves() )
+		self.assertEqual( curves2.verticesPerCurve(), IECore.IntVectorData( [ 50 ] * curves.numCurves() ) )
+		self.assertEqual( curves2["id"], curves["id"] )
+		self.assert_( curves2.arePrimitiveVariablesValid() )
+
+		# check a sample of the curves against the evaluator, to make sure
+		# each one was written to the right place in the output.
+		e = IECore.CurvesPrimitiveEvaluator( curves )
+		r = e.createResult()
+		p2 = curves2["P"].data
+		width2 = curves2["width"].data
+		for curveIndex in range( 0, curves.numCurves(), 997 ) :
+			for i in range( 0, 50 ) :
+				self.failUnless( e.pointAtV( curveIndex, float( i ) / 49, r ) )
+				self.failUnless( r.point().equalWithAbsError( p2[curveIndex*50+i], 0.00001 ) )
+				self.assertAlmostEqual( r.floatPrimVar( curves["width"] ), width2[curveIndex*50+i], 5 )
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -58,6 +58,20 @@ class CurveTangentsOpTest( unittest.TestCase ) :
 				
 		for v in curves["myTangent"].data :
 			self.failUnless( v.equalWithAbsError( V3f( 1, 0, 0 ), 0.000001 ) )					
-		
+
+	def testLinearTangentsGeneration( self ) :
+
+		i = IntVectorData( [ 4 ] )
+		p = V3fVectorData( [ V3f( 0.0 ), V3f( 1.0, 0.0, 0.0 ), V3f( 2.0, 0.0, 0.0 ), V3f( 3.0, 0.0, 0.0 ) ] )
+		c = CurvesPrimitive( i, CubicBasisf.linear(), False, p )
+
+		curves = CurveTangentsOp() (
+			input = c,
+			vTangentPrimVarName = "myTangent",
+		)
+
+		for v in curves["myTangent"].data :
+			self.failUnless( v.equalWithAbsError( V3f( 1, 0, 0 ), 0.000001 ) )
+
 if __name__ == "__main__":
     unittest.main()
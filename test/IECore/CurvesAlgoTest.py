@@ -0,0 +1,82 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+import IECore
+
+class CurvesAlgoTest( unittest.TestCase ) :
+
+	def testMerge( self ) :
+
+		c1 = IECore.CurvesPrimitive(
+			IECore.IntVectorData( [ 4 ] ),
+			IECore.CubicBasisf.catmullRom(),
+			False,
+			IECore.V3fVectorData( [ IECore.V3f( i ) for i in range( 0, 4 ) ] )
+		)
+		c1["width"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Varying, IECore.FloatVectorData( [ 1, 2 ] ) )
+
+		c2 = IECore.CurvesPrimitive(
+			IECore.IntVectorData( [ 4, 5 ] ),
+			IECore.CubicBasisf.catmullRom(),
+			False,
+			IECore.V3fVectorData( [ IECore.V3f( i ) for i in range( 4, 13 ) ] )
+		)
+		c2["id"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Uniform, IECore.IntVectorData( [ 10, 11 ] ) )
+
+		curveRanges = IECore.V2iVectorData()
+		merged = IECore.CurvesAlgo.merge( [ c1, c2 ], curveRanges = curveRanges )
+		self.failUnless( merged.arePrimitiveVariablesValid() )
+
+		self.assertEqual( merged.verticesPerCurve(), IECore.IntVectorData( [ 4, 4, 5 ] ) )
+		self.assertEqual( merged.basis(), IECore.CubicBasisf.catmullRom() )
+		self.assertEqual( curveRanges, IECore.V2iVectorData( [ IECore.V2i( 0, 1 ), IECore.V2i( 1, 3 ) ] ) )
+
+		self.assertEqual( merged["P"].data, IECore.V3fVectorData( [ IECore.V3f( i ) for i in range( 0, 13 ) ], IECore.GeometricData.Interpretation.Point ) )
+		self.assertEqual( merged["width"].data, IECore.FloatVectorData( [ 1, 2, 0, 0, 0, 0, 0 ] ) )
+		self.assertEqual( merged["id"].data, IECore.IntVectorData( [ 0, 10, 11 ] ) )
+
+		merged = IECore.CurvesAlgo.merge( [ c1, c2 ], removeNonMatchingPrimVars = True )
+		self.failUnless( merged.arePrimitiveVariablesValid() )
+		self.assertEqual( merged.keys(), [ "P" ] )
+
+	def testMergeMismatchedBasis( self ) :
+
+		c1 = IECore.CurvesPrimitive( IECore.IntVectorData( [ 4 ] ), IECore.CubicBasisf.catmullRom() )
+		c2 = IECore.CurvesPrimitive( IECore.IntVectorData( [ 4 ] ), IECore.CubicBasisf.linear() )
+
+		self.assertRaises( RuntimeError, IECore.CurvesAlgo.merge, [ c1, c2 ] )
+
+if __name__ == "__main__":
+	unittest.main()
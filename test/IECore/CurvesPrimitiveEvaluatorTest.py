@@ -1221,6 +1221,27 @@ class CurvesPrimitiveEvaluatorTest( unittest.TestCase ) :
 						self.failUnless( abs( (p2 - p).length() ) < 0.05 )
 						self.assertEqual( c2, c )
 
+	def testVTangentDirection( self ) :
+
+		p = IECore.V3fVectorData( [ IECore.V3f( x, 0, 0 ) for x in range( 0, 4 ) ] )
+
+		for basis in ( IECore.CubicBasisf.linear(), IECore.CubicBasisf.bSpline(), IECore.CubicBasisf.catmullRom() ) :
+
+			for periodic in ( False, True ) :
+
+				if periodic and basis != IECore.CubicBasisf.linear() :
+					continue
+
+				c = IECore.CurvesPrimitive( IECore.IntVectorData( [ 4 ] ), basis, periodic, p )
+				e = IECore.CurvesPrimitiveEvaluator( c )
+				r = e.createResult()
+
+				# The tangent must point in the direction of increasing v,
+				# regardless of basis.
+				for v in ( 0.1, 0.5, 0.6 ) :
+					e.pointAtV( 0, v, r )
+					self.failUnless( r.vTangent().normalized().equalWithAbsError( IECore.V3f( 1, 0, 0 ), 0.0001 ) )
+
 	def testTopologyMethods( self ) :
 	
 		c = IECore.CurvesPrimitive( IECore.IntVectorData( [ 6, 6 ] ), IECore.CubicBasisf.linear(), False, IECore.V3fVectorData( [ IECore.V3f( 0 ) ] * 12 ) )
@@ -1235,7 +1256,94 @@ class CurvesPrimitiveEvaluatorTest( unittest.TestCase ) :
 		e = IECore.PrimitiveEvaluator.create( c )
 		
 		self.failUnless( isinstance( e, IECore.CurvesPrimitiveEvaluator ) )
-			
+
+	def __randomCurves( self, basis, periodic, rand ) :
+
+		p = IECore.V3fVectorData()
+		vertsPerCurve = IECore.IntVectorData()
+
+		numCurves = int( rand.nextf( 1, 10 ) )
+		for c in range( 0, numCurves ) :
+
+			numSegments = int( rand.nextf( 1, 10 ) )
+			if periodic :
+				numVerts = max( 3, basis.step * numSegments )
+			else :
+				numVerts = 4 + basis.step * ( numSegments - 1 )
+
+			vertsPerCurve.append( numVerts )
+			for i in range( 0, numVerts ) :
+				p.append( rand.nextV3f() + IECore.V3f( c * 2 ) )
+
+		return IECore.CurvesPrimitive( vertsPerCurve, basis, periodic, p )
+
+	def testPointsAtV( self ) :
+
+		rand = IECore.Rand32()
+
+		for basis in ( IECore.CubicBasisf.linear(), IECore.CubicBasisf.bezier(), IECore.CubicBasisf.bSpline(), IECore.CubicBasisf.catmullRom() ) :
+			for periodic in ( False, True ) :
+
+				if periodic and basis == IECore.CubicBasisf.bezier() :
+					continue
+
+				curves = self.__randomCurves( basis, periodic, rand )
+				e = IECore.CurvesPrimitiveEvaluator( curves )
+				result = e.createResult()
+
+				curveIndices = IECore.UIntVectorData()
+				v = IECore.FloatVectorData()
+				for c in range( 0, curves.numCurves() ) :
+					for vi in range( 0, 50 ) :
+						curveIndices.append( c )
+						v.append( float( vi ) / 49 )
+
+				points, vTangents = e.pointsAtV( curveIndices, v )
+				self.assertEqual( len( points ), len( v ) )
+				self.assertEqual( len( vTangents ), len( v ) )
+
+				for i in range( 0, len( v ) ) :
+					self.failUnless( e.pointAtV( curveIndices[i], v[i], result ) )
+					self.failUnless( points[i].equalWithAbsError( result.point(), 0.0001 ) )
+					self.failUnless( vTangents[i].equalWithAbsError( result.vTangent(), 0.001 ) )
+
+	def testPointsAtVInvalidQueries( self ) :
+
+		c = IECore.CurvesPrimitive( IECore.IntVectorData( [ 2 ] ), IECore.CubicBasisf.linear(), False, IECore.V3fVectorData( [ IECore.V3f( 0 ), IECore.V3f( 1 ) ] ) )
+		e = IECore.CurvesPrimitiveEvaluator( c )
+
+		self.assertRaises( Exception, e.pointsAtV, IECore.UIntVectorData( [ 0 ] ), IECore.FloatVectorData( [ 0, 1 ] ) )
+		self.assertRaises( Exception, e.pointsAtV, IECore.UIntVectorData( [ 1 ] ), IECore.FloatVectorData( [ 0 ] ) )
+		self.assertRaises( Exception, e.pointsAtV, IECore.UIntVectorData( [ 0 ] ), IECore.FloatVectorData( [ 1.5 ] ) )
+
+		points, vTangents = e.pointsAtV( IECore.UIntVectorData( [ 0 ] ), IECore.FloatVectorData( [ 0.5 ] ) )
+		self.assertEqual( points[0], IECore.V3f( 0.5 ) )
+		self.assertEqual( vTangents[0], IECore.V3f( 1 ) )
+
+	def testClosestPoints( self ) :
+
+		rand = IECore.Rand32()
+
+		for basis in ( IECore.CubicBasisf.linear(), IECore.CubicBasisf.bSpline(), IECore.CubicBasisf.catmullRom() ) :
+
+			curves = self.__randomCurves( basis, False, rand )
+			e = IECore.CurvesPrimitiveEvaluator( curves )
+			result = e.createResult()
+
+			points = IECore.V3fVectorData( [ rand.nextV3f() * curves.numCurves() * 2 for i in range( 0, 1000 ) ] )
+			curveIndices, v = e.closestPoints( points )
+			self.assertEqual( len( curveIndices ), len( points ) )
+			self.assertEqual( len( v ), len( points ) )
+
+			for i in range( 0, len( points ) ) :
+				self.failUnless( e.closestPoint( points[i], result ) )
+				self.assertEqual( curveIndices[i], result.curveIndex() )
+				self.assertAlmostEqual( v[i], result.uv()[1], 5 )
+
+		e = IECore.CurvesPrimitiveEvaluator( IECore.CurvesPrimitive( IECore.IntVectorData(), IECore.CubicBasisf.linear(), False, IECore.V3fVectorData() ) )
+		curveIndices, v = e.closestPoints( IECore.V3fVectorData( [ IECore.V3f( 0 ) ] ) )
+		self.assertEqual( len( curveIndices ), 0 )
+
 if __name__ == "__main__":
 	unittest.main()
 
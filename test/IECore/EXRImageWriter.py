@@ -229,6 +229,30 @@ class TestEXRWriter(unittest.TestCase):
 		w = EXRImageWriter()
 		w['compression'].setValue( w['compression'].getPresets()['zip'] )
 
+	def testTiled( self ) :
+
+		displayWindow = Box2i(
+			V2i( 0, 0 ),
+			V2i( 99, 99 )
+		)
+
+		dataWindow = Box2i(
+			V2i( 10, 3 ),
+			V2i( 90, 97 )
+		)
+
+		imgOrig = self.__makeFloatImage( dataWindow, displayWindow )
+
+		w = EXRImageWriter( imgOrig, "test/IECore/data/exrFiles/output.exr" )
+		w["tileSize"].setNumericValue( 16 )
+		w.write()
+
+		imgNew = Reader.create( "test/IECore/data/exrFiles/output.exr" ).read()
+		self.assertEqual( imgNew.dataWindow, dataWindow )
+		self.assertEqual( imgNew.displayWindow, displayWindow )
+		for c in [ "R", "G", "B" ] :
+			self.assertEqual( imgNew[c].data, imgOrig[c].data )
+
 	def testBlindDataToHeader( self ) :
 
 		displayWindow = Box2i(
@@ -458,6 +458,47 @@ class testLs( unittest.TestCase ) :
 		l = ls( "test/sequences/lsTest/a.###.tif" )
 		self.assertFalse( l )
 
+	def testNameSplitting( self ) :
+
+		l = findSequences( [ "a1.b.001.mp3", "a1.b.002.mp3", "c1d-10x", "c1d-11x", "f.1", "f.2", "g#1", "g#2" ] )
+		self.assertEqual(
+			l,
+			[
+				FileSequence( "a1.b.###.mp3", FrameRange( 1, 2 ) ),
+				FileSequence( "c1d#x", FrameRange( -11, -10 ) ),
+				FileSequence( "f.#", FrameRange( 1, 2 ) ),
+			]
+		)
+
+	def testManyNames( self ) :
+
+		names = []
+		for i in range( 0, 20 ) :
+			names.extend( [ "s%d.%04d.exr" % ( i, f ) for f in range( 0, 1000 ) ] )
+		names.reverse()
+
+		l = findSequences( names )
+		self.assertEqual( l, [ FileSequence( "s%d.####.exr" % i, FrameRange( 0, 999 ) ) for i in sorted( range( 0, 20 ), key = str ) ] )
+
+	def testCache( self ) :
+
+		self.tearDown()
+		os.system( "mkdir -p test/sequences/lsTest" )
+
+		s1 = FileSequence( "test/sequences/lsTest/a.####.tif", FrameRange( 1, 10 ) )
+		for f in s1.fileNames() :
+			os.system( "touch '" + f + "'" )
+
+		self.assertEqual( ls( "test/sequences/lsTest/a.####.tif", useCache = True ), s1 )
+		self.assertEqual( ls( "test/sequences/lsTest", useCache = True ), [ FileSequence( "a.####.tif", FrameRange( 1, 10 ) ) ] )
+
+		# modifications made immediately after a listing must not be hidden by the cache
+		s2 = FileSequence( "test/sequences/lsTest/a.####.tif", FrameRange( 1, 11 ) )
+		os.system( "touch '" + s2.fileNameForFrame( 11 ) + "'" )
+
+		self.assertEqual( ls( "test/sequences/lsTest/a.####.tif", useCache = True ), s2 )
+		self.assertEqual( ls( "test/sequences/lsTest", useCache = True ), [ FileSequence( "a.####.tif", FrameRange( 1, 11 ) ) ] )
+
 	def tearDown( self ) :
 
 		if os.path.exists( "test/sequences" ) :
@@ -0,0 +1,187 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+import threading
+
+import IECore
+
+class ImageCacheTest( unittest.TestCase ) :
+
+	fileName = "test/IECore/data/exrFiles/colorBarsWithDataWindow.exr"
+
+	def testHeader( self ) :
+
+		r = IECore.Reader.create( self.fileName )
+		c = IECore.ImageCache( 1024 * 1024 )
+
+		self.assertEqual( c.dataWindow( self.fileName ), r.dataWindow() )
+		self.assertEqual( c.displayWindow( self.fileName ), r.displayWindow() )
+		self.assertEqual( sorted( c.channelNames( self.fileName ) ), sorted( r.channelNames() ) )
+
+	def testSample( self ) :
+
+		r = IECore.Reader.create( self.fileName )
+		dataWindow = r.dataWindow()
+		width = dataWindow.size().x + 1
+
+		c = IECore.ImageCache( 1024 * 1024, tileSize = 16 )
+		self.assertEqual( c.getTileSize(), 16 )
+
+		for channel in r.channelNames() :
+			data = r.readChannel( channel )
+			for y in range( dataWindow.min.y - 2, dataWindow.max.y + 3 ) :
+				for x in range( dataWindow.min.x - 2, dataWindow.max.x + 3 ) :
+					if dataWindow.intersects( IECore.V2i( x, y ) ) :
+						expected = data[(y-dataWindow.min.y)*width + x - dataWindow.min.x]
+					else :
+						expected = 0
+					self.assertEqual( c.sample( self.fileName, channel, x, y ), expected )
+
+		self.failUnless( c.memoryUsage() > 0 )
+		self.failUnless( c.memoryUsage() <= c.getMaxMemoryUsage() )
+
+	def testBilinearSample( self ) :
+
+		c = IECore.ImageCache( 1024 * 1024 )
+		dataWindow = c.dataWindow( self.fileName )
+
+		p = dataWindow.min + IECore.V2i( 3 )
+		self.assertEqual( c.sample( self.fileName, "R", IECore.V2f( p.x + 0.5, p.y + 0.5 ) ), c.sample( self.fileName, "R", p.x, p.y ) )
+
+		v = c.sample( self.fileName, "R", IECore.V2f( p.x + 1, p.y + 0.5 ) )
+		self.assertAlmostEqual( v, 0.5 * ( c.sample( self.fileName, "R", p.x, p.y ) + c.sample( self.fileName, "R", p.x + 1, p.y ) ), 6 )
+
+	def testReadRegion( self ) :
+
+		r = IECore.Reader.create( self.fileName )
+		dataWindow = r.dataWindow()
+		c = IECore.ImageCache( 1024 * 1024, tileSize = 8 )
+
+		region = IECore.Box2i( dataWindow.min - IECore.V2i( 3 ), dataWindow.max + IECore.V2i( 5 ) )
+		data = c.readRegion( self.fileName, "G", region )
+		width = region.size().x + 1
+		self.assertEqual( len( data ), width * ( region.size().y + 1 ) )
+		for y in range( region.min.y, region.max.y + 1 ) :
+			for x in range( region.min.x, region.max.x + 1 ) :
+				self.assertEqual( data[(y-region.min.y)*width + x - region.min.x], c.sample( self.fileName, "G", x, y ) )
+
+		r["dataWindow"].setValue( IECore.Box2iData( dataWindow ) )
+		self.assertEqual( c.readRegion( self.fileName, "G", dataWindow ), r.readChannel( "G" ) )
+
+	def testMemoryLimit( self ) :
+
+		c = IECore.ImageCache( 1024, tileSize = 8 )
+		dataWindow = c.dataWindow( self.fileName )
+		c.readRegion( self.fileName, "R", dataWindow )
+		self.failUnless( c.memoryUsage() <= 1024 )
+
+		c.setMaxMemoryUsage( 0 )
+		self.assertEqual( c.memoryUsage(), 0 )
+
+	def testOpenFileLimit( self ) :
+
+		c = IECore.ImageCache( 1024 * 1024, maxOpenFiles = 1 )
+		self.assertEqual( c.getMaxOpenFiles(), 1 )
+
+		fileNames = [ "test/IECore/data/exrFiles/checkerAnimated.%04d.exr" % i for i in range( 1, 4 ) ]
+		for i in range( 0, 2 ) :
+			for f in fileNames :
+				r = IECore.Reader.create( f )
+				dataWindow = r.dataWindow()
+				r["dataWindow"].setValue( IECore.Box2iData( dataWindow ) )
+				self.assertEqual( c.readRegion( f, "R", dataWindow ), r.readChannel( "R" ) )
+			c.clear()
+
+	def testTIFF( self ) :
+
+		# The TIFFImageReader decodes the whole image into memory, so
+		# the file should be accounted for in the memory usage.
+		fileName = "test/IECore/data/tiff/uvMap.200x100.rgba.8bit.tif"
+		r = IECore.Reader.create( fileName )
+		dataWindow = r.dataWindow()
+		r["dataWindow"].setValue( IECore.Box2iData( dataWindow ) )
+		imageSize = ( dataWindow.size().x + 1 ) * ( dataWindow.size().y + 1 ) * len( r.channelNames() ) * 4
+
+		c = IECore.ImageCache( 10 * imageSize, tileSize = 16 )
+		for channel in r.channelNames() :
+			self.assertEqual( c.readRegion( fileName, channel, dataWindow ), r.readChannel( channel ) )
+		self.failUnless( c.memoryUsage() >= imageSize )
+
+		# And with a limit too small to hold the decoded image, we should
+		# still be able to read it, without exceeding the limit.
+		c = IECore.ImageCache( imageSize / 2, tileSize = 16 )
+		for channel in r.channelNames() :
+			self.assertEqual( c.readRegion( fileName, channel, dataWindow ), r.readChannel( channel ) )
+			self.failUnless( c.memoryUsage() <= c.getMaxMemoryUsage() )
+
+		c.setMaxMemoryUsage( 0 )
+		self.assertEqual( c.memoryUsage(), 0 )
+
+	def testErrors( self ) :
+
+		c = IECore.ImageCache( 1024 * 1024 )
+		self.assertRaises( RuntimeError, c.sample, "iDontExist.exr", "R", 0, 0 )
+		self.assertRaises( RuntimeError, c.sample, self.fileName, "iDontExist", 0, 0 )
+		self.assertRaises( RuntimeError, c.sample, "test/IECore/data/cobFiles/pSphereShape1.cob", "R", 0, 0 )
+
+	def testThreading( self ) :
+
+		c = IECore.ImageCache( 4 * 1024, tileSize = 4 )
+		dataWindow = c.dataWindow( self.fileName )
+		expected = IECore.ImageCache( 1024 * 1024 ).readRegion( self.fileName, "B", dataWindow )
+
+		errors = []
+		def f() :
+			try :
+				for i in range( 0, 5 ) :
+					self.assertEqual( c.readRegion( self.fileName, "B", dataWindow ), expected )
+			except Exception, e :
+				errors.append( e )
+
+		threads = [ threading.Thread( target = f ) for i in range( 0, 8 ) ]
+		for t in threads :
+			t.start()
+		for t in threads :
+			t.join()
+
+		self.assertEqual( errors, [] )
+
+	def testDefaultImageCache( self ) :
+
+		self.failUnless( isinstance( IECore.ImageCache.defaultImageCache(), IECore.ImageCache ) )
+		self.failUnless( IECore.ImageCache.defaultImageCache().isSame( IECore.ImageCache.defaultImageCache() ) )
+
+if __name__ == "__main__":
+	unittest.main()
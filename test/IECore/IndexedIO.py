@@ -35,6 +35,7 @@
 
 """Unit test for IndexedIO binding"""
 import os
+import shutil
 import unittest
 import math
 import random
@@ -54,6 +55,19 @@ class TestIndexedIO(unittest.TestCase):
 		io2 = IndexedIO.create( "test/myFile.fio", IndexedIO.OpenMode.Write )
 		self.assertRaises(RuntimeError, IndexedIO.create, "myFileWith.invalidExtension", [], IndexedIO.OpenMode.Write )
 
+	def testCreateFromContents( self ) :
+
+		io = IndexedIO.create( "test/myFile.fio", [], IndexedIO.OpenMode.Write )
+		io.write( "a", 1 )
+		del io
+
+		shutil.copy( "test/myFile.fio", "test/myFile.unknownExtension" )
+
+		io = IndexedIO.create( "test/myFile.unknownExtension", [], IndexedIO.OpenMode.Read )
+		self.assertEqual( io.read( "a" ), IntData( 1 ) )
+
+		self.assertRaises( RuntimeError, IndexedIO.create, "test/IECore/data/empty", [], IndexedIO.OpenMode.Read )
+
 	def testSupportedExtensions( self ) :
 
 		e = IndexedIO.supportedExtensions()
@@ -78,8 +92,9 @@ class TestIndexedIO(unittest.TestCase):
 
 	def tearDown(self):
 
-		if os.path.isfile("test/myFile.fio"):
-			os.remove("test/myFile.fio")
+		for f in [ "test/myFile.fio", "test/myFile.unknownExtension" ] :
+			if os.path.isfile( f ):
+				os.remove( f )
 
 class TestMemoryIndexedIO(unittest.TestCase):
 
@@ -692,6 +692,71 @@ class LinkedSceneTest( unittest.TestCase ) :
 		i2 = l.child( "instance2" )
 		self.assertEqual( i2.childNames(), [] )
 
+		# failures aren't cached, so the links resolve
+		# once the file is available again.
+		shutil.copyfile( "test/IECore/data/sccFiles/animatedSpheres.scc", "/tmp/toBeRemoved.scc" )
+		i0 = l.child( "instance0" )
+		self.assertEqual( sorted(i0.childNames()), [ "A", "B" ] )
+		i2 = l.child( "instance2" )
+		self.assertEqual( i2.childNames(), [ "a" ] )
+		del l, i0, i1, i2
+
+		os.remove( "/tmp/toBeRemoved.scc" )
+
+	def testResolvedLinksAreCached( self ) :
+
+		import shutil
+		fileNames = [ "/tmp/linkTarget%d.scc" % i for i in range( 0, 4 ) ]
+		for f in fileNames :
+			shutil.copyfile( "test/IECore/data/sccFiles/animatedSpheres.scc", f )
+
+		l = IECore.LinkedScene( "/tmp/test.lscc", IECore.IndexedIO.OpenMode.Write )
+		for i in range( 0, 20 ) :
+			m = IECore.SceneCache( fileNames[i % len( fileNames )], IECore.IndexedIO.OpenMode.Read )
+			l.createChild( "instance%d" % i ).writeLink( m )
+		del l, m
+
+		maxScenes = IECore.SharedSceneInterfaces.getMaxScenes()
+		try :
+
+			IECore.SharedSceneInterfaces.clear()
+			IECore.SharedSceneInterfaces.setMaxScenes( len( fileNames ) )
+			self.assertEqual( IECore.SharedSceneInterfaces.getMaxScenes(), len( fileNames ) )
+			IECore.SharedSceneInterfaces.resetStatistics()
+
+			l = IECore.LinkedScene( "/tmp/test.lscc", IECore.IndexedIO.OpenMode.Read )
+			for n in range( 0, 2 ) :
+				for i in range( 0, 20 ) :
+					self.assertEqual( sorted( l.child( "instance%d" % i ).childNames() ), [ "A", "B" ] )
+					self.assertEqual( sorted( l.scene( [ "instance%d" % i ] ).childNames() ), [ "A", "B" ] )
+
+			# each file is only opened once.
+			self.assertEqual( IECore.SharedSceneInterfaces.numOpens(), len( fileNames ) )
+			self.assertEqual( IECore.SharedSceneInterfaces.numReopens(), 0 )
+			self.assertEqual( IECore.SharedSceneInterfaces.numScenes(), len( fileNames ) )
+
+			# the resolved links are limited by the same setting as the shared
+			# cache, so that they don't hold more files open than requested.
+			# reducing the limit means that links must be resolved again,
+			# reopening the files evicted from the shared cache.
+			IECore.SharedSceneInterfaces.resetStatistics()
+			IECore.SharedSceneInterfaces.setMaxScenes( 1 )
+			for i in range( 0, 20 ) :
+				self.assertEqual( sorted( l.child( "instance%d" % i ).childNames() ), [ "A", "B" ] )
+
+			self.assertEqual( IECore.SharedSceneInterfaces.numScenes(), 1 )
+			self.assertGreater( IECore.SharedSceneInterfaces.numReopens(), 0 )
+
+			IECore.SharedSceneInterfaces.resetStatistics()
+			self.assertEqual( IECore.SharedSceneInterfaces.numOpens(), 0 )
+			self.assertEqual( IECore.SharedSceneInterfaces.numReopens(), 0 )
+
+		finally :
+
+			IECore.SharedSceneInterfaces.setMaxScenes( maxScenes )
+			for f in fileNames :
+				os.remove( f )
+
 	def testLinkBoundTransformMismatch( self ) :
 		
 		scene = IECore.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Write )
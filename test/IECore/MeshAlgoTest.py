@@ -175,5 +175,132 @@ class MeshAlgoTest( unittest.TestCase ) :
 		for v in vTangent.data :
 			self.failUnless( v.equalWithAbsError( V3f( 1, 0, 0 ), 0.000001 ) )
 
+	def testMerge( self ) :
+
+		meshes = [
+			MeshPrimitive.createPlane( Box2f( V2f( i ), V2f( i + 1 ) ), V2i( i + 1 ) )
+			for i in range( 0, 5 )
+		]
+		MeshNormalsOp()( input=meshes[2], copyInput=False )
+
+		faceRanges = V2iVectorData()
+		merged = MeshAlgo.merge( meshes, faceRanges = faceRanges )
+		self.failUnless( merged.arePrimitiveVariablesValid() )
+		self.assertEqual( set( merged.keys() ), set( [ "P", "s", "t", "N" ] ) )
+
+		self.assertEqual( len( faceRanges ), len( meshes ) )
+		vertexOffset = 0
+		faceVaryingOffset = 0
+		for mesh, faceRange in zip( meshes, faceRanges ) :
+
+			self.assertEqual( faceRange[1] - faceRange[0], mesh.numFaces() )
+			self.assertEqual( merged.verticesPerFace[faceRange[0]:faceRange[1]], mesh.verticesPerFace )
+
+			numVertices = mesh.variableSize( PrimitiveVariable.Interpolation.Vertex )
+			numFaceVaryings = mesh.variableSize( PrimitiveVariable.Interpolation.FaceVarying )
+
+			self.assertEqual(
+				merged.vertexIds[faceVaryingOffset:faceVaryingOffset+numFaceVaryings],
+				IntVectorData( [ i + vertexOffset for i in mesh.vertexIds ] )
+			)
+			self.assertEqual( merged["P"].data[vertexOffset:vertexOffset+numVertices], mesh["P"].data )
+			self.assertEqual( merged["s"].data[faceVaryingOffset:faceVaryingOffset+numFaceVaryings], mesh["s"].data )
+
+			if "N" in mesh :
+				self.assertEqual( merged["N"].data[vertexOffset:vertexOffset+numVertices], mesh["N"].data )
+			else :
+				self.assertEqual( merged["N"].data[vertexOffset:vertexOffset+numVertices], V3fVectorData( [ V3f( 0 ) ] * numVertices ) )
+
+			vertexOffset += numVertices
+			faceVaryingOffset += numFaceVaryings
+
+		self.assertEqual( merged["P"].data.getInterpretation(), GeometricData.Interpretation.Point )
+
+		merged = MeshAlgo.merge( meshes, removeNonMatchingPrimVars = True )
+		self.failUnless( merged.arePrimitiveVariablesValid() )
+		self.assertEqual( set( merged.keys() ), set( [ "P", "s", "t" ] ) )
+
+	def testMergeMatchesMeshMergeOp( self ) :
+
+		p1 = MeshPrimitive.createPlane( Box2f( V2f( -1 ), V2f( 0 ) ) )
+		MeshNormalsOp()( input=p1, copyInput=False )
+		p2 = MeshPrimitive.createPlane( Box2f( V2f( 0 ), V2f( 1 ) ) )
+
+		self.assertEqual( MeshAlgo.merge( [ p1, p2 ] ), MeshMergeOp()( input=p1, mesh=p2 ) )
+
+	def testMergeNothing( self ) :
+
+		self.assertRaises( RuntimeError, MeshAlgo.merge, [] )
+
+	def __polygonMesh( self ) :
+
+		# a quad, a triangle and a pentagon
+		verticesPerFace = IntVectorData( [ 4, 3, 5 ] )
+		vertexIds = IntVectorData( [ 0, 1, 4, 3, 1, 2, 4, 3, 4, 7, 6, 5 ] )
+		p = V3fVectorData( [ V3f( 0, 0, 0 ), V3f( 1, 0, 0 ), V3f( 2, 0, 0 ), V3f( 0, 1, 0 ), V3f( 1, 1, 0 ), V3f( -0.5, 2, 0 ), V3f( 0.5, 2.5, 0 ), V3f( 1.5, 2, 0 ) ] )
+
+		m = MeshPrimitive( verticesPerFace, vertexIds, "linear", p )
+		m["Cs"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Uniform, Color3fVectorData( [ Color3f( 1, 0, 0 ), Color3f( 0, 1, 0 ), Color3f( 0, 0, 1 ) ] ) )
+		m["s"] = PrimitiveVariable( PrimitiveVariable.Interpolation.FaceVarying, FloatVectorData( [ i * 0.1 for i in range( 0, 12 ) ] ) )
+		m["t"] = PrimitiveVariable( PrimitiveVariable.Interpolation.FaceVarying, FloatVectorData( [ i * 0.2 for i in range( 0, 12 ) ] ) )
+		m["w"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Varying, FloatVectorData( range( 0, 8 ) ) )
+		m["names"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Uniform, StringVectorData( [ "a", "b", "c" ] ) )
+		m["flags"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, BoolVectorData( [ True, False ] * 4 ) )
+		m["c"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Constant, IntData( 10 ) )
+
+		return m
+
+	def testTriangulateAndPromote( self ) :
+
+		for interpolation in ( "linear", "catmullClark" ) :
+
+			m = self.__polygonMesh()
+			m.interpolation = interpolation
+
+			# compute the expected result using the equivalent chain of ops
+			expected = MeshNormalsOp()(
+				input = m,
+				interpolation = PrimitiveVariable.Interpolation.Uniform if interpolation == "linear" else PrimitiveVariable.Interpolation.Vertex
+			)
+			expected = TriangulateOp()( input = expected, throwExceptions = False )
+			expected = FaceVaryingPromotionOp()( input = expected )
+
+			result = MeshAlgo.triangulateAndPromote( m )
+			self.failUnless( result.arePrimitiveVariablesValid() )
+
+			self.assertEqual( result.verticesPerFace, IntVectorData( [ 3 ] * 6 ) )
+			self.assertEqual( result.vertexIds, expected.vertexIds )
+			self.assertEqual( result.interpolation, interpolation )
+			self.assertEqual( set( result.keys() ), set( expected.keys() ) )
+
+			for name in result.keys() :
+				self.assertEqual( result[name].interpolation, expected[name].interpolation )
+				if result[name].interpolation == PrimitiveVariable.Interpolation.Constant :
+					self.assertEqual( result[name].data, expected[name].data )
+				else :
+					self.assertEqual( result[name].interpolation, PrimitiveVariable.Interpolation.FaceVarying )
+					self.assertEqual( list( result[name].data ), list( expected[name].data ) )
+
+			self.assertEqual( result["P"].data.getInterpretation(), GeometricData.Interpretation.Point )
+			self.assertEqual( result["N"].data.getInterpretation(), GeometricData.Interpretation.Normal )
+
+	def testTriangulateAndPromoteExistingNormals( self ) :
+
+		m = self.__polygonMesh()
+		m["N"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Constant, V3fData( V3f( 0, 0, 1 ) ) )
+
+		result = MeshAlgo.triangulateAndPromote( m )
+		self.assertEqual( result["N"], m["N"] )
+
+		del m["N"]
+		result = MeshAlgo.triangulateAndPromote( m, addMissingNormals = False )
+		self.failIf( "N" in result )
+
+	def testTriangulateAndPromoteRequiresP( self ) :
+
+		m = self.__polygonMesh()
+		del m["P"]
+		self.assertRaises( RuntimeError, MeshAlgo.triangulateAndPromote, m )
+
 if __name__ == "__main__":
 	unittest.main()
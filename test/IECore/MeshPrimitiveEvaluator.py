@@ -374,6 +374,83 @@ class TestMeshPrimitiveEvaluator( unittest.TestCase ) :
 					hits = mpe.intersectionPoints( origin, direction )
 					self.failIf( hits )
 
+	def testIntersectRays( self ) :
+
+		random.seed( 10 )
+		rand = Rand48( 10 )
+
+		P = V3fVectorData()
+		for i in range( 0, 500 * 3 ) :
+			P.append( V3f( random.uniform(-10, 10), random.uniform(-10, 10), random.uniform(-10, 10) ) )
+
+		m = MeshPrimitive( IntVectorData( [ 3 ] * 500 ), IntVectorData( range( 0, 500 * 3 ) ) )
+		m["P"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, P )
+		mpe = MeshPrimitiveEvaluator( m )
+		r = mpe.createResult()
+		r2 = mpe.createResult()
+
+		origins = V3fVectorData()
+		directions = V3fVectorData()
+		for i in range( 0, 1001 ) :
+			origins.append( Rand48.solidSpheref( rand ) * 2 )
+			directions.append( Rand48.hollowSpheref( rand ) * random.uniform( 0.5, 2 ) )
+
+		for maxDistance in ( 1000, 5 ) :
+
+			distances, triangleIndices, barycentricCoordinates = mpe.intersectRays( origins, directions, maxDistance )
+			self.assertEqual( len( distances ), len( origins ) )
+			self.assertEqual( len( triangleIndices ), len( origins ) )
+			self.assertEqual( len( barycentricCoordinates ), len( origins ) )
+
+			numHits = 0
+			for i in range( 0, len( origins ) ) :
+
+				hit = mpe.intersectionPoint( origins[i], directions[i], r, maxDistance )
+				if hit :
+					numHits += 1
+					self.assertEqual( triangleIndices[i], r.triangleIndex() )
+					self.failUnless( barycentricCoordinates[i].equalWithAbsError( r.barycentricCoordinates(), 0.0001 ) )
+					self.assertAlmostEqual( distances[i], ( r.point() - origins[i] ).length(), 3 )
+
+					self.failUnless( mpe.barycentricPosition( triangleIndices[i], barycentricCoordinates[i], r2 ) )
+					self.failUnless( r2.point().equalWithAbsError( origins[i] + directions[i].normalized() * distances[i], 0.001 ) )
+				else :
+					self.assertEqual( triangleIndices[i], -1 )
+
+			self.failUnless( numHits > 0 )
+
+	def testIntersectRaysEmptyMesh( self ) :
+
+		m = MeshPrimitive()
+		m["P"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, V3fVectorData() )
+		mpe = MeshPrimitiveEvaluator( m )
+
+		distances, triangleIndices, barycentricCoordinates = mpe.intersectRays( V3fVectorData( [ V3f( 0 ) ] ), V3fVectorData( [ V3f( 1, 0, 0 ) ] ) )
+		self.assertEqual( triangleIndices, IntVectorData( [ -1 ] ) )
+
+		self.assertRaises( Exception, mpe.intersectRays, V3fVectorData( [ V3f( 0 ) ] ), V3fVectorData() )
+
+	def testIntersectRaysCoherentGrid( self ) :
+
+		m = Reader.create( "test/IECore/data/cobFiles/pSphereShape1.cob" ).read()
+		mpe = PrimitiveEvaluator.create( m )
+		r = mpe.createResult()
+
+		# coherent rays from a grid, as might be used for baking a projection
+		origins = V3fVectorData()
+		directions = V3fVectorData()
+		for y in range( 0, 100 ) :
+			for x in range( 0, 100 ) :
+				origins.append( V3f( x / 50.0 - 1, y / 50.0 - 1, 5 ) )
+				directions.append( V3f( 0, 0, -1 ) )
+
+		distances, triangleIndices, barycentricCoordinates = mpe.intersectRays( origins, directions )
+		self.failUnless( len( [ i for i in triangleIndices if i >= 0 ] ) > 0 )
+
+		for i in range( 0, len( origins ) ) :
+			if triangleIndices[i] >= 0 and mpe.intersectionPoint( origins[i], directions[i], r ) :
+				self.failUnless( ( origins[i] + directions[i] * distances[i] ).equalWithAbsError( r.point(), 0.0001 ) )
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -333,6 +333,24 @@ class TestNParticleReader( unittest.TestCase ) :
 			self.assert_( abs( p.y ) < 119.41 )
 			self.assert_( abs( p.z ) < 554.64 )
 	
+	def testChunks( self ) :
+
+		r = IECore.Reader.create( "test/IECore/data/iffFiles/nParticleMultipleFrames.mc" )
+		r.parameters()["frameIndex"].setValue( 5 )
+		r.parameters()["realType"].setValue( "native" )
+
+		for percentage in ( 100, 50 ) :
+
+			r.parameters()["percentage"].setValue( IECore.FloatData( percentage ) )
+
+			for attributeName in ( "testParticleShape_position", "testParticleShape_birthTime" ) :
+
+				chunked = []
+				for firstParticle in range( 0, r.numParticles(), 3 ) :
+					chunked.extend( r.readAttributeChunk( attributeName, firstParticle, 3 ) )
+
+				self.assertEqual( chunked, list( r.readAttribute( attributeName ) ) )
+
 	def testParameterTypes( self ) :
 
 		p = IECore.NParticleReader()
@@ -0,0 +1,74 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+import IECore
+
+class NoiseAlgoTest( unittest.TestCase ) :
+
+	def points( self ) :
+
+		return IECore.V3fVectorData( [ IECore.V3f( i/7.0, i/13.0 - 5, -i/3.0 ) for i in range( 0, 5000 ) ] )
+
+	def testDisplaceWithNoise( self ) :
+
+		n = IECore.PerlinNoiseV3fV3f( 0 )
+		p = self.points()
+		d = p.copy()
+
+		IECore.NoiseAlgo.displace( d, n, frequency = 2, amplitude = IECore.V3f( 1, 2, 3 ) )
+		self.assertEqual( len( d ), len( p ) )
+		for i in range( 0, len( p ) ) :
+			expected = p[i] + IECore.V3f( 1, 2, 3 ) * n.noise( p[i] * 2 )
+			self.failUnless( d[i].equalWithAbsError( expected, 1e-6 ) )
+
+	def testDisplaceWithTurbulence( self ) :
+
+		t = IECore.TurbulenceV3fV3f( octaves = 3, turbulent = False )
+		p = self.points()
+		d = p.copy()
+
+		IECore.NoiseAlgo.displace( d, t, amplitude = IECore.V3f( 0.5 ) )
+		for i in range( 0, len( p ) ) :
+			expected = p[i] + IECore.V3f( 0.5 ) * t.turbulence( p[i] )
+			self.failUnless( d[i].equalWithAbsError( expected, 1e-6 ) )
+
+	def testEmpty( self ) :
+
+		d = IECore.V3fVectorData()
+		IECore.NoiseAlgo.displace( d, IECore.PerlinNoiseV3fV3f() )
+		self.assertEqual( len( d ), 0 )
+
+if __name__ == "__main__":
+	unittest.main()
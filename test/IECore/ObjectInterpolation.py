@@ -169,6 +169,53 @@ class TestObjectInterpolation( unittest.TestCase ) :
 		m3 = linearObjectInterpolation( m1, m2, 0.5 )		
 		self.assertEqual( m3["v"], PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, FloatVectorData( [ 1, 2, 3, 4 ] ) ) )
 		
+	def testLargeVectorInterpolation( self ) :
+
+		# large enough to be split into multiple chunks
+		# for parallel processing.
+		size = 100000
+		for vectorType, elementType in [
+			( FloatVectorData, float ),
+			( V3fVectorData, V3f ),
+			( Color3fVectorData, Color3f ),
+		] :
+
+			y = [ vectorType( [ elementType( i + j ) for i in range( 0, size ) ] ) for j in range( 0, 4 ) ]
+
+			l = linearObjectInterpolation( y[1], y[2], 0.5 )
+			self.assertEqual( l, vectorType( [ elementType( i + 1.5 ) for i in range( 0, size ) ] ) )
+
+			c = cubicObjectInterpolation( y[0], y[1], y[2], y[3], 0.5 )
+			self.assertEqual( c, vectorType( [ elementType( i + 1.5 ) for i in range( 0, size ) ] ) )
+
+	def testVectorInterpolationWithMismatchedLengths( self ) :
+
+		self.assertRaises( Exception, linearObjectInterpolation, V3fVectorData( [ V3f( 1 ) ] ), V3fVectorData( [ V3f( 1 ), V3f( 2 ) ] ), 0.5 )
+
+	def testVectorInterpolationPreservesInterpretation( self ) :
+
+		y = [ V3fVectorData( [ V3f( i ) ], GeometricData.Interpretation.Normal ) for i in range( 0, 4 ) ]
+
+		l = linearObjectInterpolation( y[1], y[2], 0.5 )
+		self.assertEqual( l.getInterpretation(), GeometricData.Interpretation.Normal )
+
+		c = cubicObjectInterpolation( y[0], y[1], y[2], y[3], 0.5 )
+		self.assertEqual( c.getInterpretation(), GeometricData.Interpretation.Normal )
+
+	def testPrimitiveInterpolationWithUnchangedVariables( self ) :
+
+		m1 = MeshPrimitive.createPlane( Box2f( V2f( -1 ), V2f( 1 ) ) )
+		m1["Cs"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, Color3fVectorData( [ Color3f( i ) for i in range( 0, 4 ) ] ) )
+		m2 = m1.copy()
+		m2["P"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, V3fVectorData( [ p * 2 for p in m1["P"].data ], GeometricData.Interpretation.Point ) )
+
+		m3 = linearObjectInterpolation( m1, m2, 0.5 )
+		self.assertEqual( m3["P"].data, V3fVectorData( [ p * 1.5 for p in m1["P"].data ], GeometricData.Interpretation.Point ) )
+		self.assertEqual( m3["P"].data.getInterpretation(), GeometricData.Interpretation.Point )
+		self.assertEqual( m3["Cs"], m1["Cs"] )
+		self.assertEqual( m3["s"], m1["s"] )
+		self.assertEqual( m3["t"], m1["t"] )
+
 	def testPrimitiveInterpolationWithBlindData( self ) :
 	
 		m1 = MeshPrimitive.createPlane( Box2f( V2f( -1 ), V2f( 1 ) ) )
@@ -337,6 +337,36 @@ class TestPDCReader( unittest.TestCase ) :
 		self.assertEqual( len( c.messages ), 1 )
 		self.assertEqual( c.messages[0].level, IECore.Msg.Level.Warning )
 		
+	def testChunks( self ) :
+
+		r = IECore.PDCParticleReader( "test/IECore/data/pdcFiles/particleShape1.250.pdc" )
+		r["realType"].setValue( "native" )
+
+		for percentage in ( 100, 50 ) :
+
+			r["percentage"].setTypedValue( percentage )
+
+			for attributeName in ( "position", "particleId", "mass" ) :
+
+				chunked = []
+				for firstParticle in range( 0, r.numParticles(), 7 ) :
+					chunked.extend( r.readAttributeChunk( attributeName, firstParticle, 7 ) )
+
+				self.assertEqual( chunked, list( r.readAttribute( attributeName ) ) )
+
+			p = r.read()
+			numPoints = 0
+			for firstParticle in range( 0, r.numParticles(), 7 ) :
+				c = r.readChunk( firstParticle, 7 )
+				self.assertEqual( c.keys(), p.keys() )
+				self.assertEqual( list( c["P"].data ), list( p["P"].data )[numPoints:numPoints+c.numPoints] )
+				numPoints += c.numPoints
+
+			self.assertEqual( numPoints, p.numPoints )
+
+		self.assertEqual( len( r.readAttributeChunk( "position", 100, 10 ) ), 0 )
+		self.assertEqual( r.readAttributeChunk( "iDontExist", 0, 10 ), None )
+
 	def tearDown( self ) :
 
 		if os.path.isfile( "test/particleShape1.250.pdc" ) :
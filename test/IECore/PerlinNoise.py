@@ -331,6 +331,26 @@ class TestPerlinNoise( unittest.TestCase ) :
 				self.failUnless( n( p, 0.5 ) != 0 )		
 				self.failUnless( n( p, 0.6 ) == 0 )			
 
+	def testNoiseVector( self ) :
+
+		# the batch evaluation should give identical
+		# results to evaluating each point individually.
+
+		n = IECore.PerlinNoiseV3fV3f( 0 )
+		p = IECore.V3fVectorData( [ IECore.V3f( i/7.0 - 3, i/13.0 - 5, -i/3.0 ) for i in range( 0, 1001 ) ] )
+		v = n.noiseVector( p )
+		self.assertEqual( len( v ), len( p ) )
+		for i in range( 0, len( p ) ) :
+			self.assertEqual( v[i], n.noise( p[i] ) )
+
+		n = IECore.PerlinNoiseV2ff( 1 )
+		p = IECore.V2fVectorData( [ IECore.V2f( i/7.0, -i/11.0 ) for i in range( 0, 37 ) ] )
+		v = n.noiseVector( p )
+		for i in range( 0, len( p ) ) :
+			self.assertEqual( v[i], n.noise( p[i] ) )
+
+		self.assertEqual( n.noiseVector( IECore.V2fVectorData() ), IECore.FloatVectorData() )
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -0,0 +1,66 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+import IECore
+
+class PointsAlgoTest( unittest.TestCase ) :
+
+	def testMerge( self ) :
+
+		points = []
+		for i in range( 0, 10 ) :
+			p = IECore.PointsPrimitive( IECore.V3fVectorData( [ IECore.V3f( i, j, 0 ) for j in range( 0, i + 1 ) ] ) )
+			if i % 2 :
+				p["Cs"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Vertex, IECore.Color3fVectorData( [ IECore.Color3f( 1 ) ] * ( i + 1 ) ) )
+			points.append( p )
+
+		pointRanges = IECore.V2iVectorData()
+		merged = IECore.PointsAlgo.merge( points, pointRanges = pointRanges )
+		self.failUnless( merged.arePrimitiveVariablesValid() )
+		self.assertEqual( merged.numPoints, sum( [ p.numPoints for p in points ] ) )
+
+		for i, p in enumerate( points ) :
+			r = pointRanges[i]
+			self.assertEqual( r[1] - r[0], p.numPoints )
+			self.assertEqual( merged["P"].data[r[0]:r[1]], p["P"].data )
+			expectedCs = IECore.Color3f( 1 ) if i % 2 else IECore.Color3f( 0 )
+			self.assertEqual( merged["Cs"].data[r[0]:r[1]], IECore.Color3fVectorData( [ expectedCs ] * p.numPoints ) )
+
+		merged = IECore.PointsAlgo.merge( points, removeNonMatchingPrimVars = True )
+		self.failUnless( merged.arePrimitiveVariablesValid() )
+		self.failIf( "Cs" in merged )
+
+if __name__ == "__main__":
+	unittest.main()
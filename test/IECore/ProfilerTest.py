@@ -0,0 +1,185 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import json
+import time
+import unittest
+import threading
+
+import IECore
+
+class ProfilerTest( unittest.TestCase ) :
+
+	traceFileName = "test/IECore/profilerTrace.json"
+
+	def setUp( self ) :
+
+		IECore.Profiler.clear()
+		IECore.Profiler.setEnabled( True )
+
+	def testEnabled( self ) :
+
+		self.assertTrue( IECore.Profiler.getEnabled() )
+
+		IECore.Profiler.setEnabled( False )
+		self.assertFalse( IECore.Profiler.getEnabled() )
+
+		with IECore.Profiler.Scope( "ProfilerTest.disabled" ) :
+			pass
+
+		self.assertEqual( IECore.Profiler.statistics(), {} )
+
+	def testNesting( self ) :
+
+		with IECore.Profiler.Scope( "ProfilerTest.outer" ) :
+			time.sleep( 0.05 )
+			for i in range( 0, 2 ) :
+				with IECore.Profiler.Scope( "ProfilerTest.inner" ) :
+					time.sleep( 0.05 )
+
+		s = IECore.Profiler.statistics()
+		self.assertEqual( s["ProfilerTest.outer"]["count"], 1 )
+		self.assertEqual( s["ProfilerTest.inner"]["count"], 2 )
+
+		outer = s["ProfilerTest.outer"]
+		inner = s["ProfilerTest.inner"]
+		self.assertGreaterEqual( inner["totalTime"], 0.1 )
+		self.assertGreaterEqual( inner["maxTime"], 0.05 )
+		self.assertAlmostEqual( inner["selfTime"], inner["totalTime"], 6 )
+		self.assertGreaterEqual( outer["totalTime"], 0.15 )
+		self.assertAlmostEqual( outer["selfTime"], outer["totalTime"] - inner["totalTime"], 6 )
+
+		self.assertTrue( "ProfilerTest.outer" in IECore.Profiler.summary() )
+
+		IECore.Profiler.clear()
+		self.assertEqual( IECore.Profiler.statistics(), {} )
+
+	def testThreads( self ) :
+
+		def f() :
+			for i in range( 0, 10 ) :
+				with IECore.Profiler.Scope( "ProfilerTest.thread" ) :
+					pass
+
+		threads = [ threading.Thread( target = f ) for i in range( 0, 4 ) ]
+		for t in threads :
+			t.start()
+		for t in threads :
+			t.join()
+
+		self.assertEqual( IECore.Profiler.statistics()["ProfilerTest.thread"]["count"], 40 )
+
+	def testQueriesDuringRecording( self ) :
+
+		stop = threading.Event()
+		def f() :
+			while not stop.is_set() :
+				with IECore.Profiler.Scope( "ProfilerTest.thread" ) :
+					pass
+
+		threads = [ threading.Thread( target = f ) for i in range( 0, 4 ) ]
+		for t in threads :
+			t.start()
+
+		try :
+			for i in range( 0, 20 ) :
+				IECore.Profiler.statistics()
+				IECore.Profiler.writeChromeTrace( self.traceFileName )
+				IECore.Profiler.clear()
+		finally :
+			stop.set()
+			for t in threads :
+				t.join()
+
+	def testMaxEvents( self ) :
+
+		maxEvents = IECore.Profiler.getMaxEvents()
+		try :
+
+			IECore.Profiler.setMaxEvents( 5 )
+			self.assertEqual( IECore.Profiler.getMaxEvents(), 5 )
+
+			for i in range( 0, 8 ) :
+				with IECore.Profiler.Scope( "ProfilerTest.limited" ) :
+					pass
+
+			self.assertEqual( IECore.Profiler.statistics()["ProfilerTest.limited"]["count"], 5 )
+			self.assertEqual( IECore.Profiler.numDroppedEvents(), 3 )
+
+			IECore.Profiler.clear()
+			self.assertEqual( IECore.Profiler.numDroppedEvents(), 0 )
+			with IECore.Profiler.Scope( "ProfilerTest.limited" ) :
+				pass
+			self.assertEqual( IECore.Profiler.statistics()["ProfilerTest.limited"]["count"], 1 )
+
+		finally :
+
+			IECore.Profiler.setMaxEvents( maxEvents )
+
+	def testChromeTrace( self ) :
+
+		with IECore.Profiler.Scope( "ProfilerTest.outer" ) :
+			with IECore.Profiler.Scope( "ProfilerTest.inner" ) :
+				pass
+
+		IECore.Profiler.writeChromeTrace( self.traceFileName )
+
+		with open( self.traceFileName ) as f :
+			trace = json.load( f )
+
+		events = dict( ( e["name"], e ) for e in trace["traceEvents"] )
+		self.assertEqual( set( events.keys() ), set( [ "ProfilerTest.outer", "ProfilerTest.inner" ] ) )
+		for e in events.values() :
+			self.assertEqual( e["ph"], "X" )
+		self.assertLessEqual( events["ProfilerTest.outer"]["ts"], events["ProfilerTest.inner"]["ts"] )
+		self.assertGreaterEqual( events["ProfilerTest.outer"]["dur"], events["ProfilerTest.inner"]["dur"] )
+
+	@unittest.skipIf( not IECore.withProfiling(), "Profiling instrumentation not compiled in" )
+	def testInstrumentation( self ) :
+
+		m = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) )
+		IECore.MeshNormalsOp()( input = m )
+		self.assertEqual( IECore.Profiler.statistics()["MeshNormalsOp"]["count"], 1 )
+
+	def tearDown( self ) :
+
+		IECore.Profiler.setEnabled( False )
+		IECore.Profiler.clear()
+
+		if os.path.exists( self.traceFileName ) :
+			os.remove( self.traceFileName )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -38,6 +38,7 @@
 
 #include <math.h>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -55,6 +56,52 @@ namespace IECore
 
 void addRadixSortTest( boost::unit_test::test_suite* test );
 
+/// Returns the most negative value representable by T. Note that for
+/// floating point types numeric_limits<T>::min() is the smallest
+/// positive value, so we can't use that.
+template<typename T>
+double radixSortTestLowest()
+{
+	return std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::min() : -std::numeric_limits<T>::max();
+}
+
+/// Appends values which are unlikely to be generated randomly
+/// but which the sort must still order correctly.
+template<typename T>
+void appendRadixSortTestSpecialValues( std::vector<T> &values )
+{
+	values.push_back( std::numeric_limits<T>::min() );
+	values.push_back( std::numeric_limits<T>::max() );
+	values.push_back( T( 0 ) );
+}
+
+template<>
+inline void appendRadixSortTestSpecialValues<float>( std::vector<float> &values )
+{
+	values.push_back( -0.0f );
+	values.push_back( 0.0f );
+	// denormals
+	values.push_back( std::numeric_limits<float>::denorm_min() );
+	values.push_back( -std::numeric_limits<float>::denorm_min() );
+	values.push_back( std::numeric_limits<float>::min() / 4.0f );
+	values.push_back( -std::numeric_limits<float>::min() / 4.0f );
+	// smallest normals
+	values.push_back( std::numeric_limits<float>::min() );
+	values.push_back( -std::numeric_limits<float>::min() );
+	values.push_back( std::numeric_limits<float>::max() );
+	values.push_back( -std::numeric_limits<float>::max() );
+	values.push_back( 1.0f );
+	values.push_back( -1.0f );
+}
+
+/// Equality which distinguishes -0.0 from 0.0, which the sort is entitled
+/// to order differently.
+template<typename T>
+bool radixSortTestIdentical( const T &a, const T &b )
+{
+	return std::memcmp( &a, &b, sizeof( T ) ) == 0;
+}
+
 struct RadixSortTest
 {
 	template<typename T>
@@ -63,7 +110,7 @@ struct RadixSortTest
 		unsigned seed = 42;
 		boost::mt19937 generator( static_cast<boost::mt19937::result_type>( seed ) );
 
-		boost::uniform_real<> uni_dist( std::numeric_limits<T>::min(), std::numeric_limits<T>::max() );
+		boost::uniform_real<> uni_dist( radixSortTestLowest<T>(), std::numeric_limits<T>::max() );
 		boost::variate_generator<boost::mt19937&, boost::uniform_real<> > uni( generator, uni_dist );
 
 		// Run 50 tests, each sorting 100000 numbers
@@ -78,13 +125,14 @@ struct RadixSortTest
 			{
 				input.push_back( static_cast<T>( uni() ) );
 			}
+			appendRadixSortTestSpecialValues( input );
 
 			RadixSort sorter;
 
 			const std::vector<unsigned int> &indices = sorter( input );
-			BOOST_CHECK_EQUAL( indices.size(), numValuesPerTest );
+			BOOST_CHECK_EQUAL( indices.size(), input.size() );
 
-			for ( unsigned n = 1; n < numValuesPerTest; n++ )
+			for ( unsigned n = 1; n < input.size(); n++ )
 			{
 				BOOST_CHECK(( input[ indices[n] ] >= input[ indices[n - 1] ] ) );
 			}
@@ -92,6 +140,71 @@ struct RadixSortTest
 	}
 };
 
+struct ParallelRadixSortTest
+{
+	template<typename T>
+	void test()
+	{
+		unsigned seed = 42;
+		boost::mt19937 generator( static_cast<boost::mt19937::result_type>( seed ) );
+
+		boost::uniform_real<> uni_dist( radixSortTestLowest<T>(), std::numeric_limits<T>::max() );
+		boost::variate_generator<boost::mt19937&, boost::uniform_real<> > uni( generator, uni_dist );
+
+		// Test a range of sizes, including ones which aren't a multiple of the internal block size
+		const unsigned sizes[] = { 0, 1, 1000, 100000, 1000003 };
+
+		for ( unsigned i = 0; i < sizeof( sizes ) / sizeof( unsigned ); i ++ )
+		{
+			std::vector<T> keys;
+			std::vector<unsigned> values;
+
+			for ( unsigned n = 0; n < sizes[i]; n++ )
+			{
+				// Make sure we get some duplicates so we can test stability
+				keys.push_back( n % 7 ? static_cast<T>( uni() ) : T( 0 ) );
+				values.push_back( n );
+			}
+
+			if( sizes[i] > 1 )
+			{
+				appendRadixSortTestSpecialValues( keys );
+				while( values.size() < keys.size() )
+				{
+					values.push_back( values.size() );
+				}
+			}
+
+			std::vector<unsigned int> indices;
+			parallelRadixSortIndices( keys, indices );
+			BOOST_CHECK_EQUAL( indices.size(), keys.size() );
+
+			for ( unsigned n = 1; n < indices.size(); n++ )
+			{
+				BOOST_CHECK( keys[ indices[n] ] >= keys[ indices[n - 1] ] );
+			}
+
+			const std::vector<T> originalKeys = keys;
+			parallelRadixSort( keys, values );
+			BOOST_CHECK_EQUAL( keys.size(), originalKeys.size() );
+			BOOST_CHECK_EQUAL( values.size(), originalKeys.size() );
+
+			for ( unsigned n = 0; n < keys.size(); n++ )
+			{
+				BOOST_CHECK( radixSortTestIdentical( keys[n], originalKeys[ values[n] ] ) );
+				if( n )
+				{
+					BOOST_CHECK( keys[n] >= keys[n - 1] );
+					if( radixSortTestIdentical( keys[n], keys[n - 1] ) )
+					{
+						BOOST_CHECK( values[n] > values[n - 1] );
+					}
+				}
+			}
+		}
+	}
+};
+
 struct RadixSortTestSuite : public boost::unit_test::test_suite
 {
 
@@ -102,6 +215,12 @@ struct RadixSortTestSuite : public boost::unit_test::test_suite
 		add( BOOST_CLASS_TEST_CASE( &RadixSortTest::test<float>, instance ) );
 		add( BOOST_CLASS_TEST_CASE( &RadixSortTest::test<unsigned int>, instance ) );
 		add( BOOST_CLASS_TEST_CASE( &RadixSortTest::test<int>, instance ) );
+
+		static boost::shared_ptr<ParallelRadixSortTest> parallelInstance( new ParallelRadixSortTest() );
+
+		add( BOOST_CLASS_TEST_CASE( &ParallelRadixSortTest::test<float>, parallelInstance ) );
+		add( BOOST_CLASS_TEST_CASE( &ParallelRadixSortTest::test<unsigned int>, parallelInstance ) );
+		add( BOOST_CLASS_TEST_CASE( &ParallelRadixSortTest::test<int>, parallelInstance ) );
 	}
 
 };
@@ -32,6 +32,8 @@
 #
 ##########################################################################
 
+import os
+import shutil
 import unittest
 import IECore
 
@@ -84,6 +86,37 @@ class TestReader(unittest.TestCase):
 		self.assertRaises( RuntimeError, IECore.Reader.create, 'test/IECore/data/null' )
 		self.assertRaises( RuntimeError, IECore.Reader.create, 'test/IECore/data/null.cin' )
 		
+	def testMagicNumbers( self ) :
+
+		IECore.Reader.resetCreateStatistics()
+
+		r = IECore.Reader.create( "test/IECore/data/tiff/bluegreen_noise.400x300.tif" )
+		self.failUnless( isinstance( r, IECore.TIFFImageReader ) )
+
+		s = IECore.Reader.createStatistics()
+		self.assertEqual( s.creates, 1 )
+		self.assertEqual( s.headerReads, 1 )
+		self.assertEqual( s.canReadCalls, 0 )
+		self.assertEqual( s.magicNumberMatches, 1 )
+
+		# files with unknown extensions should be identified
+		# from their header too.
+
+		shutil.copy( "test/IECore/data/dpx/ramp.dpx", "test/IECore/ramp.unknownExtension" )
+		r = IECore.Reader.create( "test/IECore/ramp.unknownExtension" )
+		self.failUnless( isinstance( r, IECore.DPXImageReader ) )
+
+		s = IECore.Reader.createStatistics()
+		self.assertEqual( s.creates, 2 )
+		self.assertEqual( s.headerReads, 2 )
+		self.assertEqual( s.canReadCalls, 0 )
+		self.assertEqual( s.magicNumberMatches, 2 )
+
+		IECore.Reader.resetCreateStatistics()
+		s = IECore.Reader.createStatistics()
+		self.assertEqual( s.creates, 0 )
+		self.assertEqual( s.headerReads, 0 )
+
 	def testCanRead( self ) :
 	
 		# every reader subclass should have a canRead() static method, unless it's an abstract base class
@@ -103,6 +136,11 @@ class TestReader(unittest.TestCase):
 		for reader in allReaders :
 			self.failUnless( hasattr( reader, "canRead" ) )
 
+	def tearDown( self ) :
+
+		if os.path.exists( "test/IECore/ramp.unknownExtension" ) :
+			os.remove( "test/IECore/ramp.unknownExtension" )
+
 if __name__ == "__main__":
 	unittest.main()
 
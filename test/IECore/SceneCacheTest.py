@@ -874,8 +874,73 @@ class SceneCacheTest( unittest.TestCase ) :
 		t0 = checkHash( IECore.SceneInterface.HashType.HierarchyHash, m, 0 )
 		t1 = checkHash( IECore.SceneInterface.HashType.HierarchyHash, m, 1 )
 		self.assertEqual( t0[0] + t1[0], len(t0[1].union(t1[1])) )		# all locations differ
-	
-	
+
+	def testPrimitiveVariableStorage( self ) :
+
+		mesh = IECore.MeshPrimitive.createSphere( 10 )
+		self.assertTrue( "N" in mesh )
+		mesh["velocity"] = IECore.PrimitiveVariable(
+			IECore.PrimitiveVariable.Interpolation.Vertex,
+			IECore.V3fVectorData( [ IECore.V3f( p.x, -p.y * 2, 0.5 ) for p in mesh["P"].data ], IECore.GeometricData.Interpretation.Vector )
+		)
+		mesh["width"] = IECore.PrimitiveVariable(
+			IECore.PrimitiveVariable.Interpolation.Vertex,
+			IECore.FloatVectorData( [ p.z for p in mesh["P"].data ] )
+		)
+		mesh["index"] = IECore.PrimitiveVariable(
+			IECore.PrimitiveVariable.Interpolation.Vertex,
+			IECore.IntVectorData( range( 0, len( mesh["P"].data ) ) )
+		)
+
+		s = IECore.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Write )
+		self.assertEqual( s.getPrimitiveVariableStorage( "P" ), IECore.SceneCache.PrimitiveVariableStorage.FullPrecision )
+		s.setPrimitiveVariableStorage( "P", IECore.SceneCache.PrimitiveVariableStorage.FixedPoint )
+		s.setPrimitiveVariableStorage( "N", IECore.SceneCache.PrimitiveVariableStorage.Octahedral )
+		s.setPrimitiveVariableStorage( "velocity", IECore.SceneCache.PrimitiveVariableStorage.HalfPrecision )
+		s.setPrimitiveVariableStorage( "width", IECore.SceneCache.PrimitiveVariableStorage.FixedPoint )
+		s.setPrimitiveVariableStorage( "index", IECore.SceneCache.PrimitiveVariableStorage.HalfPrecision )
+		self.assertEqual( s.getPrimitiveVariableStorage( "P" ), IECore.SceneCache.PrimitiveVariableStorage.FixedPoint )
+
+		m = s.createChild( "m" )
+		mh = IECore.CapturingMessageHandler()
+		with mh :
+			m.writeObject( mesh, 0 )
+		# the IntVectorData isn't supported, so it's stored at full precision with a warning
+		self.assertEqual( len( mh.messages ), 1 )
+
+		del m, s
+
+		s = IECore.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Read )
+		m = s.child( "m" )
+
+		def assertClose( a, b, tolerance ) :
+
+			self.assertEqual( type( a ), type( b ) )
+			self.assertEqual( len( a ), len( b ) )
+			if hasattr( a, "getInterpretation" ) :
+				self.assertEqual( a.getInterpretation(), b.getInterpretation() )
+			for i in range( 0, len( a ) ) :
+				if isinstance( a[i], float ) :
+					self.assertAlmostEqual( a[i], b[i], delta = tolerance )
+				else :
+					self.assertTrue( a[i].equalWithAbsError( b[i], tolerance ) )
+
+		def checkVariables( variables ) :
+
+			assertClose( variables["P"].data, mesh["P"].data, 20 / 65535.0 )
+			assertClose( variables["N"].data, mesh["N"].data, 0.0001 )
+			assertClose( variables["velocity"].data, mesh["velocity"].data, 0.02 )
+			assertClose( variables["width"].data, mesh["width"].data, 20 / 65535.0 )
+			self.assertEqual( variables["index"].data, mesh["index"].data )
+
+		readMesh = m.readObject( 0 )
+		self.assertEqual( readMesh.keys(), mesh.keys() )
+		self.assertTrue( readMesh.arePrimitiveVariablesValid() )
+		checkVariables( readMesh )
+		checkVariables( m.readObjectPrimitiveVariables( [ "P", "N", "velocity", "width", "index" ], 0 ) )
+
+		self.assertRaises( RuntimeError, s.setPrimitiveVariableStorage, "P", IECore.SceneCache.PrimitiveVariableStorage.HalfPrecision )
+
 if __name__ == "__main__":
 	unittest.main()
 
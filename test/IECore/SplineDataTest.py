@@ -156,6 +156,32 @@ class SplineDataTest( unittest.TestCase ) :
 			os.remove( "test/IECore/SplineData.cob" )
 
 
+	def testBakedSpline( self ) :
+
+		s = IECore.SplinefColor3f(
+			IECore.CubicBasisf.catmullRom(),
+			(
+				( 0, IECore.Color3f( 0 ) ),
+				( 0, IECore.Color3f( 0 ) ),
+				( 0.5, IECore.Color3f( 1, 0, 0 ) ),
+				( 1, IECore.Color3f( 0, 0, 1 ) ),
+				( 1, IECore.Color3f( 0, 0, 1 ) ),
+			)
+		)
+		d = IECore.SplinefColor3fData( s )
+
+		b = d.bakedSpline()
+		self.failUnless( isinstance( b, IECore.BakedSplinefColor3f ) )
+		self.failUnless( b.maxError() <= 1e-4 )
+		for i in range( 0, 11 ) :
+			x = i / 10.0
+			self.failUnless( b( x ).equalWithAbsError( s( x ), 1e-3 ) )
+
+		# equal data shares the same baked spline
+		b2 = d.copy().bakedSpline()
+		self.assertEqual( b2.resolution(), b.resolution() )
+		self.assertEqual( b2( 0.3 ), b( 0.3 ) )
+
 if __name__ == "__main__":
     unittest.main()
 
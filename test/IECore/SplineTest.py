@@ -255,6 +255,92 @@ class SplineTest( unittest.TestCase ) :
 		( integral, summedArea ) = computeIntegrals(s, [12,20])
 		self.assertAlmostEqual( integral, summedArea, 3 )
 
+	def testEvaluate( self ) :
+
+		s = IECore.Splineff(
+			IECore.CubicBasisf.catmullRom(),
+			( ( 0, 0 ), ( 0, 0 ), ( 0.3, 0.8 ), ( 1, 1 ), ( 1, 1 ) )
+		)
+
+		x = IECore.FloatVectorData( [ i / 99.0 for i in range( 0, 100 ) ] )
+		y = s.evaluate( x )
+		self.failUnless( isinstance( y, IECore.FloatVectorData ) )
+		self.assertEqual( len( y ), len( x ) )
+		for i in range( 0, len( x ) ) :
+			self.assertEqual( y[i], s( x[i] ) )
+
+		self.assertEqual( s.evaluate( IECore.FloatVectorData() ), IECore.FloatVectorData() )
+
+	def testBakedSpline( self ) :
+
+		s = IECore.Splineff(
+			IECore.CubicBasisf.catmullRom(),
+			( ( 0, 0 ), ( 0, 0 ), ( 0.3, 0.8 ), ( 0.6, 0.2 ), ( 1, 1 ), ( 1, 1 ) )
+		)
+
+		b = IECore.BakedSplineff( s )
+		self.assertEqual( b.xMin(), 0 )
+		self.assertEqual( b.xMax(), 1 )
+		self.failUnless( b.maxError() <= 1e-4 )
+		self.failUnless( b.resolution() >= 65 )
+
+		random.seed( 0 )
+		for i in range( 0, 1000 ) :
+			x = random.uniform( 0, 1 )
+			self.assertAlmostEqual( b( x ), s( x ), 3 )
+
+		# values outside the interval clamp to the ends
+		self.assertAlmostEqual( b( -1 ), s( 0 ), 6 )
+		self.assertAlmostEqual( b( 2 ), s( 1 ), 6 )
+
+		x = IECore.FloatVectorData( [ i / 99.0 for i in range( 0, 100 ) ] )
+		y = b.evaluate( x )
+		for i in range( 0, len( x ) ) :
+			self.assertEqual( y[i], b( x[i] ) )
+
+	def testBakedSplineResolution( self ) :
+
+		s = IECore.Splineff(
+			IECore.CubicBasisf.catmullRom(),
+			( ( 0, 0 ), ( 0, 0 ), ( 0.5, 1 ), ( 1, 0 ), ( 1, 0 ) )
+		)
+
+		# a fixed resolution
+		b = IECore.BakedSplineff( s, minResolution = 17, maxResolution = 17 )
+		self.assertEqual( b.resolution(), 17 )
+
+		# tighter tolerances need more resolution
+		b1 = IECore.BakedSplineff( s, tolerance = 1e-2, minResolution = 2 )
+		b2 = IECore.BakedSplineff( s, tolerance = 1e-5, minResolution = 2 )
+		self.failUnless( b1.maxError() <= 1e-2 )
+		self.failUnless( b2.maxError() <= 1e-5 )
+		self.failUnless( b2.resolution() > b1.resolution() )
+
+		# but never more than the maximum
+		b = IECore.BakedSplineff( s, tolerance = 0, minResolution = 2, maxResolution = 100 )
+		self.failUnless( b.resolution() <= 100 )
+		self.failUnless( b.maxError() > 0 )
+
+	def testBakedColorSpline( self ) :
+
+		s = IECore.SplinefColor3f(
+			IECore.CubicBasisf.linear(),
+			(
+				( 0, IECore.Color3f( 0 ) ),
+				( 0, IECore.Color3f( 0 ) ),
+				( 1, IECore.Color3f( 1, 0.5, 0.25 ) ),
+				( 1, IECore.Color3f( 1, 0.5, 0.25 ) ),
+			)
+		)
+
+		b = IECore.BakedSplinefColor3f( s )
+		for x in [ 0, 0.25, 0.5, 0.75, 1 ] :
+			self.failUnless( b( x ).equalWithAbsError( s( x ), 1e-5 ) )
+
+	def testBakedSplineRequiresEnoughPoints( self ) :
+
+		self.assertRaises( Exception, IECore.BakedSplineff, IECore.Splineff() )
+
 if __name__ == "__main__":
     unittest.main()
 
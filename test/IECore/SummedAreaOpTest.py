@@ -53,5 +53,30 @@ class SummedAreaOpTest( unittest.TestCase ) :
 		self.assertEqual( yy[2], 4 )
 		self.assertEqual( yy[3], 10 )
 
+	def testLargeImage( self ) :
+
+		# big enough to be split across several threads,
+		# and with a data window that doesn't start at the origin.
+		b = IECore.Box2i( IECore.V2i( -10, 5 ), IECore.V2i( 289, 204 ) )
+		width = b.size().x + 1
+		height = b.size().y + 1
+
+		y = IECore.FloatVectorData( [ ( x * 7 + x / 13 ) % 4 for x in range( 0, width * height ) ] )
+		i = IECore.ImagePrimitive( b, b )
+		i["Y"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Vertex, y )
+
+		ii = IECore.SummedAreaOp()( input=i, channels=IECore.StringVectorData( ["Y"] ) )
+		yy = ii["Y"].data
+
+		expected = [ 0 ] * ( width * height )
+		for r in range( 0, height ) :
+			rowSum = 0
+			for c in range( 0, width ) :
+				index = r * width + c
+				rowSum += y[index]
+				expected[index] = rowSum + ( expected[index-width] if r else 0 )
+
+		self.assertEqual( list( yy ), expected )
+
 if __name__ == "__main__":
     unittest.main()
@@ -166,6 +166,66 @@ struct SweepAndPruneTest
 			}
 		}
 	}
+
+	template<typename T>
+	void testParallel()
+	{
+		unsigned seed = 42;
+		boost::mt19937 generator( static_cast<boost::mt19937::result_type>( seed ) );
+
+		typedef typename BoxTraits<T>::BaseType VecType;
+
+		boost::uniform_real<> uni_dist( 0.0f, 1.0f );
+		boost::variate_generator<boost::mt19937&, boost::uniform_real<> > uni( generator, uni_dist );
+
+		// Check that the parallel sweep finds exactly the same pairs as the serial one
+		const unsigned numTests = 10u;
+		const unsigned numBoxesPerTest = 10000u;
+
+		for ( unsigned i = 0; i < numTests; i ++ )
+		{
+			std::vector<T> input;
+
+			for ( unsigned n = 0; n < numBoxesPerTest; n++ )
+			{
+				T b;
+
+				VecType corner( uni() * 20.0, uni() * 20.0, uni() * 20.0 );
+				VecType size( uni(), uni(), uni() );
+
+				b.extendBy( corner );
+				b.extendBy( corner + size );
+
+				input.push_back( b );
+			}
+
+			typedef typename std::vector<T>::iterator BoundIterator;
+
+			typedef SweepAndPrune<BoundIterator, TestCallback> SAP;
+
+			SAP sap;
+			typename SAP::Callback cb( input.begin(), numBoxesPerTest );
+			sap.intersectingBounds( input.begin(), input.end(), cb, SAP::XZY );
+
+			typename SAP::IntersectingPairs pairs;
+			sap.parallelIntersectingBounds( input.begin(), input.end(), pairs, SAP::XZY );
+
+			typename TestCallback<BoundIterator>::IntersectingBoundIndices parallelIndices;
+			for ( typename SAP::IntersectingPairs::const_iterator it = pairs.begin(); it != pairs.end(); ++it )
+			{
+				BOOST_CHECK( it->first->intersects( *it->second ) );
+
+				unsigned int idx0 = std::distance( input.begin(), it->first );
+				unsigned int idx1 = std::distance( input.begin(), it->second );
+				parallelIndices.insert( typename TestCallback<BoundIterator>::IntersectingBoundIndices::value_type( idx0, idx1 ) );
+				parallelIndices.insert( typename TestCallback<BoundIterator>::IntersectingBoundIndices::value_type( idx1, idx0 ) );
+			}
+
+			BOOST_CHECK_EQUAL( parallelIndices.size(), pairs.size() * 2 );
+			BOOST_CHECK( parallelIndices == cb.m_indices );
+		}
+	}
+
 };
 
 struct SweepAndPruneTestSuite : public boost::unit_test::test_suite
@@ -177,6 +237,8 @@ struct SweepAndPruneTestSuite : public boost::unit_test::test_suite
 
 		add( BOOST_CLASS_TEST_CASE( &SweepAndPruneTest::test<Imath::Box3f>, instance ) );
 		add( BOOST_CLASS_TEST_CASE( &SweepAndPruneTest::test<Imath::Box3d>, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &SweepAndPruneTest::testParallel<Imath::Box3f>, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &SweepAndPruneTest::testParallel<Imath::Box3d>, instance ) );
 	}
 
 };
@@ -312,6 +312,39 @@ class TestTIFFImageWriter(unittest.TestCase):
 
 		self.assert_( "A" in imgNew )
 
+	def testCompressionMethods( self ) :
+
+		displayWindow = Box2i(
+			V2i( 0, 0 ),
+			V2i( 99, 99 )
+		)
+
+		dataWindow = Box2i(
+			V2i( 10, 3 ),
+			V2i( 90, 97 )
+		)
+
+		imgOrig = self.__makeFloatImage( dataWindow, displayWindow, withAlpha = True )
+
+		for bitDepth in [ 8, 16, 32 ] :
+
+			images = []
+			for compression in [ "none", "lzw", "deflate" ] :
+
+				self.setUp()
+
+				w = Writer.create( imgOrig, "test/IECore/data/tiff/output.tif" )
+				w["bitdepth"].setValue( w["bitdepth"].getPresets()[str(bitDepth)] )
+				w["compression"].setValue( w["compression"].getPresets()[compression] )
+				w.write()
+
+				images.append( Reader.create( "test/IECore/data/tiff/output.tif" ).read() )
+
+				self.tearDown()
+
+			for image in images[1:] :
+				self.assertEqual( image, images[0] )
+
 	def testWriteComplex( self ) :
 
 		displayWindow = Box2i(
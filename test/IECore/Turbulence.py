@@ -113,6 +113,23 @@ class TestTurbulence( unittest.TestCase ) :
 		f = t.turbulence( IECore.V2f( 21.3, 51.2 ) )
 		self.assert_( f == f )
 
+	def testTurbulenceVector( self ) :
+
+		for turbulent in ( True, False ) :
+
+			t = IECore.TurbulenceV3fColor3f(
+				octaves = 5,
+				gain = IECore.Color3f( 0.5, 0.4, 0.3 ),
+				lacunarity = 2.1,
+				turbulent = turbulent
+			)
+
+			p = IECore.V3fVectorData( [ IECore.V3f( i/7.0, i/13.0 - 5, -i/3.0 ) for i in range( 0, 301 ) ] )
+			v = t.turbulenceVector( p )
+			self.assertEqual( len( v ), len( p ) )
+			for i in range( 0, len( p ) ) :
+				self.assertEqual( v[i], t.turbulence( p[i] ) )
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -34,6 +34,7 @@
 
 import unittest
 import threading
+import time
 
 import IECore
 import IECoreGL
@@ -170,5 +171,125 @@ class CachedConverterTest( unittest.TestCase ) :
 			# do the deferred removals now we're back on the main thread
 			c.clearUnused()
 		
+	def testConvertAsync( self ) :
+
+		c = IECoreGL.CachedConverter( 500 * 1024 * 1024 )
+
+		m = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) )
+		self.failUnless( c.asyncConvertible( m ) )
+
+		placeholder, ready = c.convertAsync( m )
+		self.failIf( ready )
+		self.failUnless( isinstance( placeholder, IECoreGL.Primitive ) )
+		self.assertEqual( placeholder.typeName(), "IECoreGL::BoxPrimitive" )
+		self.assertEqual( placeholder.bound(), m.bound() )
+
+		# asking again before completion gives the same placeholder, and
+		# doesn't start another conversion.
+		placeholder2, ready = c.convertAsync( m.copy() )
+		self.failIf( ready )
+		self.failUnless( placeholder2.isSame( placeholder ) )
+		self.assertEqual( c.numPending(), 1 )
+
+		deadline = time.time() + 10
+		while c.numPending() :
+			self.failUnless( time.time() < deadline, "Timed out waiting for conversion" )
+			c.processPending()
+			time.sleep( 0.01 )
+
+		gm, ready = c.convertAsync( m )
+		self.failUnless( ready )
+		self.failUnless( isinstance( gm, IECoreGL.MeshPrimitive ) )
+		self.failUnless( gm.isSame( c.convert( m ) ) )
+
+	def testConvertAsyncNotConvertible( self ) :
+
+		c = IECoreGL.CachedConverter( 500 * 1024 * 1024 )
+
+		dataWindow = IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 15 ) )
+		i = IECore.ImagePrimitive.createRGBFloat( IECore.Color3f( 1, 0.5, 0.25 ), dataWindow, dataWindow )
+		self.failIf( c.asyncConvertible( i ) )
+
+		# textures need a gl context so are converted immediately
+		t, ready = c.convertAsync( i )
+		self.failUnless( ready )
+		self.failUnless( isinstance( t, IECoreGL.Texture ) )
+		self.assertEqual( c.numPending(), 0 )
+
+	def testProcessPendingMemoryLimit( self ) :
+
+		c = IECoreGL.CachedConverter( 500 * 1024 * 1024 )
+
+		points = []
+		for i in range( 0, 10 ) :
+			points.append( IECore.PointsPrimitive( IECore.V3fVectorData( [ IECore.V3f( i ) ] * 1000 ) ) )
+			c.convertAsync( points[-1] )
+
+		self.assertEqual( c.numPending(), 10 )
+
+		# with no memory to spare, only a single conversion should be
+		# transferred each time.
+		numTransferred = 0
+		deadline = time.time() + 10
+		while c.numPending() :
+			self.failUnless( time.time() < deadline, "Timed out waiting for conversions" )
+			n = c.processPending( 0 )
+			self.failUnless( n <= 1 )
+			numTransferred += n
+			time.sleep( 0.01 )
+
+		self.assertEqual( numTransferred, 10 )
+
+		for p in points :
+			gp, ready = c.convertAsync( p )
+			self.failUnless( ready )
+			self.failUnless( isinstance( gp, IECoreGL.PointsPrimitive ) )
+
+	def testConvertAsyncFailure( self ) :
+
+		c = IECoreGL.CachedConverter( 500 * 1024 * 1024 )
+
+		# without "P" the conversion will fail
+		p = IECore.PointsPrimitive( IECore.V3fVectorData( [ IECore.V3f( 1 ) ] * 10 ) )
+		del p["P"]
+
+		placeholder, ready = c.convertAsync( p )
+		self.failIf( ready )
+
+		deadline = time.time() + 10
+		while c.numPending() :
+			self.failUnless( time.time() < deadline, "Timed out waiting for conversion" )
+			self.assertEqual( c.processPending(), 0 )
+			time.sleep( 0.01 )
+
+		# the failure should be remembered, rather than the
+		# conversion being started again.
+		for i in range( 0, 2 ) :
+			gp, ready = c.convertAsync( p )
+			self.failUnless( ready )
+			self.failUnless( gp.isSame( placeholder ) )
+			self.assertEqual( c.numPending(), 0 )
+
+		# until the cache is cleared
+		c.clear()
+		gp, ready = c.convertAsync( p )
+		self.failIf( ready )
+		self.assertEqual( c.numPending(), 1 )
+
+		while c.numPending() :
+			self.failUnless( time.time() < deadline, "Timed out waiting for conversion" )
+			c.processPending()
+			time.sleep( 0.01 )
+
+	def testDestroyWithConversionsRunning( self ) :
+
+		c = IECoreGL.CachedConverter( 500 * 1024 * 1024 )
+		for i in range( 0, 10 ) :
+			c.convertAsync( IECore.PointsPrimitive( IECore.V3fVectorData( [ IECore.V3f( i ) ] * 100000 ) ) )
+
+		# the destructor must wait for the background conversions
+		# to complete, rather than destroying the data they're using.
+		del c
+
 if __name__ == "__main__":
     unittest.main()